@@ -0,0 +1,984 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "../idlib/math/Simd_Generic.h"
+#include "../idlib/math/Simd_MMX.h"
+#include "../idlib/math/Simd_3DNow.h"
+#include "../idlib/math/Simd_SSE.h"
+#include "../idlib/math/Simd_SSE2.h"
+#include "../idlib/math/Simd_SSE3.h"
+#include "../idlib/math/Simd_AVX2.h"
+#include "../idlib/math/Simd_AltiVec.h"
+
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+/*
+===============================================================================
+
+	SIMD benchmark
+
+	Runs the idSIMDProcessor functions for every processor the CPU supports
+	over a range of data counts and writes the timings as JSON or CSV.
+	Only idlib is linked in so the benchmark runs without the engine, a
+	file system or a GPU.
+
+	usage: simdbench [-format json|csv] [-output file] [-processor name]
+					 [-function name] [-samples n] [-sampleTime usec]
+
+===============================================================================
+*/
+
+#define RANDOM_SEED			1013904223L
+#define MAX_COUNT			65536
+#define NUM_JOINTS			128
+#define DEFAULT_SAMPLES		16
+#define DEFAULT_SAMPLE_TIME	1000.0		// microseconds
+#define MAX_CALLS			( 1 << 20 )
+
+static const int benchCounts[] = { 16, 256, 4096, MAX_COUNT };
+
+/*
+==============================================================
+
+	idCommon
+
+==============================================================
+*/
+
+#define STDERR_PRINT( pre, post )	\
+	va_list argptr;					\
+	va_start( argptr, fmt );		\
+	fprintf( stderr, pre );			\
+	vfprintf( stderr, fmt, argptr );\
+	fprintf( stderr, post );		\
+	va_end( argptr )
+
+
+class idCommonLocal : public idCommon {
+public:
+							idCommonLocal( void ) {}
+
+	virtual void			Init( int argc, const char **argv, const char *cmdline ) {}
+	virtual void			Shutdown( void ) {}
+	virtual void			Quit( void ) {}
+	virtual bool			IsInitialized( void ) const { return true; }
+	virtual void			Frame( void ) {}
+	virtual void			GUIFrame( bool execCmd, bool network  ) {}
+	virtual void			Async( void ) {}
+	virtual void			StartupVariable( const char *match, bool once ) {}
+	virtual void			InitTool( const toolFlag_t tool, const idDict *dict ) {}
+	virtual void			ActivateTool( bool active ) {}
+	virtual void			WriteConfigToFile( const char *filename ) {}
+	virtual void			WriteFlaggedCVarsToFile( const char *filename, int flags, const char *setCmd ) {}
+	virtual void			BeginRedirect( char *buffer, int buffersize, void (*flush)( const char * ) ) {}
+	virtual void			EndRedirect( void ) {}
+	virtual void			SetRefreshOnPrint( bool set ) {}
+	virtual void			Printf( const char *fmt, ... ) { STDERR_PRINT( "", "" ); }
+	virtual void			VPrintf( const char *fmt, va_list arg ) { vfprintf( stderr, fmt, arg ); }
+	virtual void			DPrintf( const char *fmt, ... ) {}
+	virtual void			Warning( const char *fmt, ... ) { STDERR_PRINT( "WARNING: ", "\n" ); }
+	virtual void			DWarning( const char *fmt, ...) {}
+	virtual void			PrintWarnings( void ) {}
+	virtual void			ClearWarnings( const char *reason ) {}
+	virtual void			Error( const char *fmt, ... ) { STDERR_PRINT( "ERROR: ", "\n" ); exit( 1 ); }
+	virtual void			FatalError( const char *fmt, ... ) { STDERR_PRINT( "FATAL ERROR: ", "\n" ); exit( 1 ); }
+	virtual const idLangDict *GetLanguageDict() { return NULL; }
+	virtual const char *	KeysFromBinding( const char *bind ) { return NULL; }
+	virtual const char *	BindingFromKey( const char *key ) { return NULL; }
+	virtual int				ButtonState( int key ) { return 0; }
+	virtual int				KeyState( int key ) { return 0; }
+};
+
+idCommonLocal		commonLocal;
+idCommon *			common = &commonLocal;
+idCVarSystem *		cvarSystem = NULL;
+idCVar *			idCVar::staticVars = NULL;
+
+/*
+==============================================================
+
+	idSys
+
+==============================================================
+*/
+
+class idSysLocal : public idSys {
+public:
+	virtual void			DebugPrintf( const char *fmt, ... ) {}
+	virtual void			DebugVPrintf( const char *fmt, va_list arg ) {}
+
+	virtual double			GetClockTicks( void ) { return 0.0; }
+	virtual double			ClockTicksPerSecond( void ) { return 1.0; }
+	virtual cpuid_t			GetProcessorId( void ) { return Sys_GetProcessorId(); }
+	virtual const char *	GetProcessorString( void ) { return Sys_GetProcessorString(); }
+	virtual const char *	FPU_GetState( void ) { return ""; }
+	virtual bool			FPU_StackIsEmpty( void ) { return true; }
+	virtual void			FPU_SetFTZ( bool enable ) {}
+	virtual void			FPU_SetDAZ( bool enable ) {}
+	virtual void			FPU_EnableExceptions( int exceptions ) {}
+
+	virtual bool			LockMemory( void *ptr, int bytes ) { return false; }
+	virtual bool			UnlockMemory( void *ptr, int bytes ) { return false; }
+
+	virtual void			GetCallStack( address_t *callStack, const int callStackSize ) { memset( callStack, 0, callStackSize * sizeof( callStack[0] ) ); }
+	virtual const char *	GetCallStackStr( const address_t *callStack, const int callStackSize ) { return ""; }
+	virtual const char *	GetCallStackCurStr( int depth ) { return ""; }
+	virtual void			ShutdownSymbols( void ) {}
+
+	virtual int				DLL_Load( const char *dllName ) { return 0; }
+	virtual void *			DLL_GetProcAddress( int dllHandle, const char *procName ) { return NULL; }
+	virtual void			DLL_Unload( int dllHandle ) {}
+	virtual void			DLL_GetFileName( const char *baseName, char *dllName, int maxLength ) {}
+
+	virtual sysEvent_t		GenerateMouseButtonEvent( int button, bool down ) { sysEvent_t ev; memset( &ev, 0, sizeof( ev ) ); return ev; }
+	virtual sysEvent_t		GenerateMouseMoveEvent( int deltax, int deltay ) { sysEvent_t ev; memset( &ev, 0, sizeof( ev ) ); return ev; }
+
+	virtual void			OpenURL( const char *url, bool quit ) {}
+	virtual void			StartProcess( const char *exeName, bool quit ) {}
+};
+
+idSysLocal			sysLocal;
+idSys *				sys = &sysLocal;
+
+/*
+==============================================================
+
+	benchmark data
+
+==============================================================
+*/
+
+static float *			benchFloats[3];
+static byte *			benchBytes;
+static short *			benchShorts;
+static idVec2 *			benchVec2;
+static idVec3 *			benchVec3[2];
+static idVec4 *			benchVec4;
+static idPlane *		benchPlanes;
+static idDrawVert *		benchVerts;
+static int *			benchIndexes;
+static int *			benchRemap;
+static dominantTri_s *	benchDominantTris;
+static idJointQuat *	benchJointQuats[3];
+static idJointMat *		benchJointMats[2];
+static int *			benchJointIndex;
+static int *			benchParents;
+static idVec4 *			benchWeights;
+static int *			benchWeightIndex;
+static idBounds *		benchBounds;
+static const idBounds **benchBoundsPtrs;
+static float *			benchModelMatrices;
+static const float **	benchModelMatrixPtrs;
+static idPlane			benchCullPlanes[6];
+static idMatX *			benchMatrix;
+static idVecX *			benchVector;
+static int				benchMatrixSize;
+
+/*
+============
+Bench_AllocData
+============
+*/
+static void Bench_AllocData( void ) {
+	int i, j;
+	idRandom srnd( RANDOM_SEED );
+
+	// the sound functions write up to six floats per sample
+	for ( i = 0; i < 3; i++ ) {
+		benchFloats[i] = (float *) Mem_Alloc16( 8 * MAX_COUNT * sizeof( float ) );
+		for ( j = 0; j < 8 * MAX_COUNT; j++ ) {
+			benchFloats[i][j] = srnd.CRandomFloat() * 10.0f;
+		}
+	}
+
+	benchBytes = (byte *) Mem_Alloc16( MAX_COUNT * sizeof( byte ) );
+	benchShorts = (short *) Mem_Alloc16( 2 * MAX_COUNT * sizeof( short ) );
+	for ( i = 0; i < 2 * MAX_COUNT; i++ ) {
+		benchShorts[i] = (short) srnd.RandomInt( 65536 ) - 32768;
+	}
+
+	benchVec2 = (idVec2 *) Mem_Alloc16( MAX_COUNT * sizeof( idVec2 ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		benchVec2[i].Set( srnd.CRandomFloat(), srnd.CRandomFloat() );
+	}
+	for ( i = 0; i < 2; i++ ) {
+		benchVec3[i] = (idVec3 *) Mem_Alloc16( MAX_COUNT * sizeof( idVec3 ) );
+		for ( j = 0; j < MAX_COUNT; j++ ) {
+			benchVec3[i][j].Set( srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f );
+		}
+	}
+	benchVec4 = (idVec4 *) Mem_Alloc16( 2 * MAX_COUNT * sizeof( idVec4 ) );
+
+	benchPlanes = (idPlane *) Mem_Alloc16( MAX_COUNT * sizeof( idPlane ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		benchPlanes[i].SetNormal( idVec3( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() ) );
+		benchPlanes[i].Normalize();
+		benchPlanes[i][3] = srnd.CRandomFloat() * 10.0f;
+	}
+
+	benchVerts = (idDrawVert *) Mem_Alloc16( MAX_COUNT * sizeof( idDrawVert ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		benchVerts[i].Clear();
+		benchVerts[i].xyz.Set( srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f, srnd.CRandomFloat() * 10.0f );
+		benchVerts[i].st.Set( srnd.CRandomFloat(), srnd.CRandomFloat() );
+		benchVerts[i].normal.Set( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+		benchVerts[i].normal.Normalize();
+		benchVerts[i].tangents[0].Set( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+		benchVerts[i].tangents[1].Set( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+	}
+
+	// the triangle indexes stay local to a small window of vertices like in real meshes
+	benchIndexes = (int *) Mem_Alloc16( 3 * MAX_COUNT * sizeof( int ) );
+	benchRemap = (int *) Mem_Alloc16( MAX_COUNT * sizeof( int ) );
+
+	benchDominantTris = (dominantTri_s *) Mem_Alloc16( MAX_COUNT * sizeof( dominantTri_s ) );
+
+	for ( i = 0; i < 3; i++ ) {
+		benchJointQuats[i] = (idJointQuat *) Mem_Alloc16( MAX_COUNT * sizeof( idJointQuat ) );
+	}
+	for ( i = 0; i < 2; i++ ) {
+		benchJointMats[i] = (idJointMat *) Mem_Alloc16( MAX_COUNT * sizeof( idJointMat ) );
+	}
+	benchJointIndex = (int *) Mem_Alloc16( MAX_COUNT * sizeof( int ) );
+	benchParents = (int *) Mem_Alloc16( MAX_COUNT * sizeof( int ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		benchJointQuats[0][i].q = idAngles( srnd.CRandomFloat() * 180.0f, srnd.CRandomFloat() * 180.0f, srnd.CRandomFloat() * 180.0f ).ToQuat();
+		benchJointQuats[0][i].t.Set( srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f );
+		benchJointQuats[1][i].q = idAngles( srnd.CRandomFloat() * 180.0f, srnd.CRandomFloat() * 180.0f, srnd.CRandomFloat() * 180.0f ).ToQuat();
+		benchJointQuats[1][i].t.Set( srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f );
+		benchJointMats[0][i].SetRotation( benchJointQuats[0][i].q.ToMat3() );
+		benchJointMats[0][i].SetTranslation( benchJointQuats[0][i].t );
+		benchJointIndex[i] = i;
+		// keep the hierarchy shallow so repeated transforms stay well conditioned
+		benchParents[i] = ( i - 1 ) >> 2;
+	}
+
+	benchWeights = (idVec4 *) Mem_Alloc16( MAX_COUNT * sizeof( idVec4 ) );
+	benchWeightIndex = (int *) Mem_Alloc16( 2 * MAX_COUNT * sizeof( int ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		benchWeights[i].Set( srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f, srnd.CRandomFloat() * 2.0f, 1.0f );
+		benchWeightIndex[i*2+0] = srnd.RandomInt( NUM_JOINTS ) * sizeof( idJointMat );
+		benchWeightIndex[i*2+1] = 1;
+	}
+
+	benchBounds = (idBounds *) Mem_Alloc16( MAX_COUNT * sizeof( idBounds ) );
+	benchBoundsPtrs = (const idBounds **) Mem_Alloc16( MAX_COUNT * sizeof( idBounds * ) );
+	benchModelMatrices = (float *) Mem_Alloc16( MAX_COUNT * 16 * sizeof( float ) );
+	benchModelMatrixPtrs = (const float **) Mem_Alloc16( MAX_COUNT * sizeof( float * ) );
+	for ( i = 0; i < MAX_COUNT; i++ ) {
+		float *m = benchModelMatrices + i * 16;
+		idMat3 axis = idAngles( srnd.RandomFloat() * 360.0f, srnd.RandomFloat() * 360.0f, srnd.RandomFloat() * 360.0f ).ToMat3();
+		for ( j = 0; j < 3; j++ ) {
+			benchBounds[i][0][j] = -srnd.RandomFloat() * 4.0f;
+			benchBounds[i][1][j] = srnd.RandomFloat() * 4.0f;
+			m[j*4+0] = axis[j][0];
+			m[j*4+1] = axis[j][1];
+			m[j*4+2] = axis[j][2];
+			m[j*4+3] = 0.0f;
+			m[3*4+j] = srnd.CRandomFloat() * 20.0f;
+		}
+		m[15] = 1.0f;
+		benchBoundsPtrs[i] = &benchBounds[i];
+		benchModelMatrixPtrs[i] = m;
+	}
+
+	for ( i = 0; i < 6; i++ ) {
+		idVec3 normal( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+		normal.Normalize();
+		benchCullPlanes[i].SetNormal( normal );
+		benchCullPlanes[i][3] = -5.0f - srnd.RandomFloat() * 10.0f;
+	}
+
+	benchMatrix = new idMatX[4];
+	benchVector = new idVecX[2];
+	benchMatrixSize = 0;
+}
+
+/*
+============
+Bench_FreeData
+============
+*/
+static void Bench_FreeData( void ) {
+	int i;
+
+	for ( i = 0; i < 3; i++ ) {
+		Mem_Free16( benchFloats[i] );
+		Mem_Free16( benchJointQuats[i] );
+	}
+	for ( i = 0; i < 2; i++ ) {
+		Mem_Free16( benchVec3[i] );
+		Mem_Free16( benchJointMats[i] );
+	}
+	Mem_Free16( benchBytes );
+	Mem_Free16( benchShorts );
+	Mem_Free16( benchVec2 );
+	Mem_Free16( benchVec4 );
+	Mem_Free16( benchPlanes );
+	Mem_Free16( benchVerts );
+	Mem_Free16( benchIndexes );
+	Mem_Free16( benchRemap );
+	Mem_Free16( benchDominantTris );
+	Mem_Free16( benchJointIndex );
+	Mem_Free16( benchParents );
+	Mem_Free16( benchWeights );
+	Mem_Free16( benchWeightIndex );
+	Mem_Free16( benchBounds );
+	Mem_Free16( benchBoundsPtrs );
+	Mem_Free16( benchModelMatrices );
+	Mem_Free16( benchModelMatrixPtrs );
+
+	delete[] benchMatrix;
+	delete[] benchVector;
+}
+
+/*
+============
+Bench_SetupMesh
+
+  creates count triangles and dominant triangles over count vertices
+============
+*/
+static void Bench_SetupMesh( int count ) {
+	int i;
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < count * 3; i++ ) {
+		benchIndexes[i] = ( i / 3 + srnd.RandomInt( 16 ) ) % count;
+	}
+	for ( i = 0; i < count; i++ ) {
+		benchDominantTris[i].v2 = ( i + 1 + srnd.RandomInt( 8 ) ) % count;
+		benchDominantTris[i].v3 = ( i + 9 + srnd.RandomInt( 8 ) ) % count;
+		benchDominantTris[i].normalizationScale[0] = srnd.CRandomFloat();
+		benchDominantTris[i].normalizationScale[1] = srnd.CRandomFloat();
+		benchDominantTris[i].normalizationScale[2] = srnd.CRandomFloat();
+	}
+}
+
+/*
+============
+Bench_SetupMatrix
+
+  the matrix functions use a square matrix with about count elements
+============
+*/
+static void Bench_SetupMatrix( int count ) {
+	int n = Max( (int) idMath::Sqrt( (float) count ), 1 );
+
+	if ( n == benchMatrixSize ) {
+		return;
+	}
+	benchMatrixSize = n;
+
+	// symmetric positive definite so it can be factored
+	benchMatrix[0].Random( n, n, RANDOM_SEED, -1.0f, 1.0f );
+	benchMatrix[1].SetSize( n, n );
+	benchMatrix[1].TransposeMultiply( benchMatrix[0], benchMatrix[0] );
+	for ( int i = 0; i < n; i++ ) {
+		benchMatrix[1][i][i] += (float) n;
+	}
+	benchMatrix[2] = benchMatrix[1];
+	benchMatrix[2].LDLT_Factor();
+	benchMatrix[3].SetSize( n, n );
+
+	benchVector[0].Random( n, RANDOM_SEED, -1.0f, 1.0f );
+	benchVector[1].SetSize( n );
+}
+
+static int Bench_MatrixSize( int count ) {
+	Bench_SetupMatrix( count );
+	return benchMatrixSize;
+}
+
+/*
+==============================================================
+
+	benchmark functions
+
+	Functions that modify their input restore it first so every call does
+	the same amount of work, the restore is included in the timings.
+
+==============================================================
+*/
+
+typedef void (*benchKernel_t)( idSIMDProcessor *p, const int count );
+
+static void Add_c( idSIMDProcessor *p, const int count ) { p->Add( benchFloats[2], 2.0f, benchFloats[0], count ); }
+static void Add( idSIMDProcessor *p, const int count ) { p->Add( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void Sub_c( idSIMDProcessor *p, const int count ) { p->Sub( benchFloats[2], 2.0f, benchFloats[0], count ); }
+static void Sub( idSIMDProcessor *p, const int count ) { p->Sub( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void Mul_c( idSIMDProcessor *p, const int count ) { p->Mul( benchFloats[2], 2.0f, benchFloats[0], count ); }
+static void Mul( idSIMDProcessor *p, const int count ) { p->Mul( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void Div_c( idSIMDProcessor *p, const int count ) { p->Div( benchFloats[2], 2.0f, benchFloats[0], count ); }
+static void Div( idSIMDProcessor *p, const int count ) { p->Div( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void MulAdd_c( idSIMDProcessor *p, const int count ) { p->MulAdd( benchFloats[2], 0.5f, benchFloats[0], count ); }
+static void MulAdd( idSIMDProcessor *p, const int count ) { p->MulAdd( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void MulSub_c( idSIMDProcessor *p, const int count ) { p->MulSub( benchFloats[2], 0.5f, benchFloats[0], count ); }
+static void MulSub( idSIMDProcessor *p, const int count ) { p->MulSub( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+
+static void Dot_Vec3_Vec3( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchVec3[0][0], benchVec3[1], count ); }
+static void Dot_Vec3_Plane( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchVec3[0][0], benchPlanes, count ); }
+static void Dot_Vec3_DrawVert( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchVec3[0][0], benchVerts, count ); }
+static void Dot_Plane_Vec3( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchPlanes[0], benchVec3[1], count ); }
+static void Dot_Plane_Plane( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchPlanes[0], benchPlanes, count ); }
+static void Dot_Plane_DrawVert( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchPlanes[0], benchVerts, count ); }
+static void Dot_Vec3s( idSIMDProcessor *p, const int count ) { p->Dot( benchFloats[2], benchVec3[0], benchVec3[1], count ); }
+static void Dot_Floats( idSIMDProcessor *p, const int count ) { float dot; p->Dot( dot, benchFloats[0], benchFloats[1], count ); }
+
+static void CmpGT( idSIMDProcessor *p, const int count ) { p->CmpGT( benchBytes, benchFloats[0], 0.0f, count ); }
+static void CmpGT_Bit( idSIMDProcessor *p, const int count ) { p->CmpGT( benchBytes, 2, benchFloats[0], 0.0f, count ); }
+static void CmpGE( idSIMDProcessor *p, const int count ) { p->CmpGE( benchBytes, benchFloats[0], 0.0f, count ); }
+static void CmpGE_Bit( idSIMDProcessor *p, const int count ) { p->CmpGE( benchBytes, 2, benchFloats[0], 0.0f, count ); }
+static void CmpLT( idSIMDProcessor *p, const int count ) { p->CmpLT( benchBytes, benchFloats[0], 0.0f, count ); }
+static void CmpLT_Bit( idSIMDProcessor *p, const int count ) { p->CmpLT( benchBytes, 2, benchFloats[0], 0.0f, count ); }
+static void CmpLE( idSIMDProcessor *p, const int count ) { p->CmpLE( benchBytes, benchFloats[0], 0.0f, count ); }
+static void CmpLE_Bit( idSIMDProcessor *p, const int count ) { p->CmpLE( benchBytes, 2, benchFloats[0], 0.0f, count ); }
+
+static void MinMax_Float( idSIMDProcessor *p, const int count ) { float min, max; p->MinMax( min, max, benchFloats[0], count ); }
+static void MinMax_Vec2( idSIMDProcessor *p, const int count ) { idVec2 min, max; p->MinMax( min, max, benchVec2, count ); }
+static void MinMax_Vec3( idSIMDProcessor *p, const int count ) { idVec3 min, max; p->MinMax( min, max, benchVec3[0], count ); }
+static void MinMax_DrawVert( idSIMDProcessor *p, const int count ) { idVec3 min, max; p->MinMax( min, max, benchVerts, count ); }
+static void MinMax_DrawVertIndexed( idSIMDProcessor *p, const int count ) { idVec3 min, max; p->MinMax( min, max, benchVerts, benchIndexes, count ); }
+
+static void Clamp( idSIMDProcessor *p, const int count ) { p->Clamp( benchFloats[2], benchFloats[0], -1.0f, 1.0f, count ); }
+static void ClampMin( idSIMDProcessor *p, const int count ) { p->ClampMin( benchFloats[2], benchFloats[0], -1.0f, count ); }
+static void ClampMax( idSIMDProcessor *p, const int count ) { p->ClampMax( benchFloats[2], benchFloats[0], 1.0f, count ); }
+
+static void Memcpy( idSIMDProcessor *p, const int count ) { p->Memcpy( benchFloats[2], benchFloats[0], count * sizeof( float ) ); }
+static void Memset( idSIMDProcessor *p, const int count ) { p->Memset( benchFloats[2], 0, count * sizeof( float ) ); }
+
+static void Zero16( idSIMDProcessor *p, const int count ) { p->Zero16( benchFloats[2], count ); }
+static void Negate16( idSIMDProcessor *p, const int count ) { p->Negate16( benchFloats[2], count ); }
+static void Copy16( idSIMDProcessor *p, const int count ) { p->Copy16( benchFloats[2], benchFloats[0], count ); }
+static void Add16( idSIMDProcessor *p, const int count ) { p->Add16( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void Sub16( idSIMDProcessor *p, const int count ) { p->Sub16( benchFloats[2], benchFloats[0], benchFloats[1], count ); }
+static void Mul16( idSIMDProcessor *p, const int count ) { p->Mul16( benchFloats[2], benchFloats[0], 0.5f, count ); }
+static void AddAssign16( idSIMDProcessor *p, const int count ) { p->AddAssign16( benchFloats[2], benchFloats[0], count ); }
+static void SubAssign16( idSIMDProcessor *p, const int count ) { p->SubAssign16( benchFloats[2], benchFloats[0], count ); }
+static void MulAssign16( idSIMDProcessor *p, const int count ) { p->MulAssign16( benchFloats[2], 1.0f, count ); }
+
+static void MatX_MultiplyVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_MultiplyVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_MultiplyAddVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_MultiplyAddVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_MultiplySubVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_MultiplySubVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_TransposeMultiplyVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_TransposeMultiplyVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_TransposeMultiplyAddVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_TransposeMultiplyAddVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_TransposeMultiplySubVecX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_TransposeMultiplySubVecX( benchVector[1], benchMatrix[1], benchVector[0] ); }
+static void MatX_MultiplyMatX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_MultiplyMatX( benchMatrix[3], benchMatrix[0], benchMatrix[1] ); }
+static void MatX_TransposeMultiplyMatX( idSIMDProcessor *p, const int count ) { Bench_SetupMatrix( count ); p->MatX_TransposeMultiplyMatX( benchMatrix[3], benchMatrix[0], benchMatrix[1] ); }
+static void MatX_LowerTriangularSolve( idSIMDProcessor *p, const int count ) { int n = Bench_MatrixSize( count ); p->MatX_LowerTriangularSolve( benchMatrix[2], benchVector[1].ToFloatPtr(), benchVector[0].ToFloatPtr(), n ); }
+static void MatX_LowerTriangularSolveTranspose( idSIMDProcessor *p, const int count ) { int n = Bench_MatrixSize( count ); p->MatX_LowerTriangularSolveTranspose( benchMatrix[2], benchVector[1].ToFloatPtr(), benchVector[0].ToFloatPtr(), n ); }
+static void MatX_LDLTFactor( idSIMDProcessor *p, const int count ) { int n = Bench_MatrixSize( count ); benchMatrix[3] = benchMatrix[1]; p->MatX_LDLTFactor( benchMatrix[3], benchVector[1], n ); }
+
+static void BlendJoints( idSIMDProcessor *p, const int count ) {
+	memcpy( benchJointQuats[2], benchJointQuats[0], count * sizeof( idJointQuat ) );
+	p->BlendJoints( benchJointQuats[2], benchJointQuats[1], 0.3f, benchJointIndex, count );
+}
+static void ConvertJointQuatsToJointMats( idSIMDProcessor *p, const int count ) { p->ConvertJointQuatsToJointMats( benchJointMats[1], benchJointQuats[0], count ); }
+static void ConvertJointMatsToJointQuats( idSIMDProcessor *p, const int count ) { p->ConvertJointMatsToJointQuats( benchJointQuats[2], benchJointMats[0], count ); }
+static void TransformJoints( idSIMDProcessor *p, const int count ) {
+	memcpy( benchJointMats[1], benchJointMats[0], count * sizeof( idJointMat ) );
+	p->TransformJoints( benchJointMats[1], benchParents, 1, count - 1 );
+}
+static void UntransformJoints( idSIMDProcessor *p, const int count ) {
+	memcpy( benchJointMats[1], benchJointMats[0], count * sizeof( idJointMat ) );
+	p->UntransformJoints( benchJointMats[1], benchParents, 1, count - 1 );
+}
+static void TransformVerts( idSIMDProcessor *p, const int count ) { p->TransformVerts( benchVerts, count, benchJointMats[0], benchWeights, benchWeightIndex, count ); }
+
+static void TracePointCull( idSIMDProcessor *p, const int count ) { byte totalOr; p->TracePointCull( benchBytes, totalOr, 1.0f, benchCullPlanes, benchVerts, count ); }
+static void DecalPointCull( idSIMDProcessor *p, const int count ) { p->DecalPointCull( benchBytes, benchCullPlanes, benchVerts, count ); }
+static void OverlayPointCull( idSIMDProcessor *p, const int count ) { p->OverlayPointCull( benchBytes, benchVec2, benchCullPlanes, benchVerts, count ); }
+static void CullBoxes( idSIMDProcessor *p, const int count ) { p->CullBoxes( benchBytes, benchCullPlanes, 5, benchBoundsPtrs, benchModelMatrixPtrs, count ); }
+static void OverlapBounds( idSIMDProcessor *p, const int count ) { p->OverlapBounds( benchBytes, benchBounds[0], benchBounds, count ); }
+
+static void DeriveTriPlanes( idSIMDProcessor *p, const int count ) { p->DeriveTriPlanes( benchPlanes, benchVerts, count, benchIndexes, count * 3 ); }
+static void DeriveTangents( idSIMDProcessor *p, const int count ) { p->DeriveTangents( benchPlanes, benchVerts, count, benchIndexes, count * 3 ); }
+static void DeriveUnsmoothedTangents( idSIMDProcessor *p, const int count ) { p->DeriveUnsmoothedTangents( benchVerts, benchDominantTris, count ); }
+static void NormalizeTangents( idSIMDProcessor *p, const int count ) { p->NormalizeTangents( benchVerts, count ); }
+static void CreateTextureSpaceLightVectors( idSIMDProcessor *p, const int count ) { p->CreateTextureSpaceLightVectors( benchVec3[1], benchVec3[0][0], benchVerts, count, benchIndexes, count * 3 ); }
+static void CreateSpecularTextureCoords( idSIMDProcessor *p, const int count ) { p->CreateSpecularTextureCoords( benchVec4, benchVec3[0][0], benchVec3[0][1], benchVerts, count, benchIndexes, count * 3 ); }
+static void CreateShadowCache( idSIMDProcessor *p, const int count ) {
+	memset( benchRemap, 0, count * sizeof( int ) );
+	p->CreateShadowCache( benchVec4, benchRemap, benchVec3[0][0], benchVerts, count );
+}
+static void CreateVertexProgramShadowCache( idSIMDProcessor *p, const int count ) { p->CreateVertexProgramShadowCache( benchVec4, benchVerts, count ); }
+
+static void UpSamplePCMTo44kHz( idSIMDProcessor *p, const int count ) { p->UpSamplePCMTo44kHz( benchFloats[2], benchShorts, count, 22050, 2 ); }
+static void UpSampleOGGTo44kHz( idSIMDProcessor *p, const int count ) {
+	const float *ogg[2] = { benchFloats[0], benchFloats[1] };
+	p->UpSampleOGGTo44kHz( benchFloats[2], ogg, count, 22050, 2 );
+}
+static void MixSoundTwoSpeakerMono( idSIMDProcessor *p, const int count ) { p->MixSoundTwoSpeakerMono( benchFloats[2], benchFloats[0], count, benchFloats[1], benchFloats[1] + 6 ); }
+static void MixSoundTwoSpeakerStereo( idSIMDProcessor *p, const int count ) { p->MixSoundTwoSpeakerStereo( benchFloats[2], benchFloats[0], count, benchFloats[1], benchFloats[1] + 6 ); }
+static void MixSoundSixSpeakerMono( idSIMDProcessor *p, const int count ) { p->MixSoundSixSpeakerMono( benchFloats[2], benchFloats[0], count, benchFloats[1], benchFloats[1] + 6 ); }
+static void MixSoundSixSpeakerStereo( idSIMDProcessor *p, const int count ) { p->MixSoundSixSpeakerStereo( benchFloats[2], benchFloats[0], count, benchFloats[1], benchFloats[1] + 6 ); }
+static void MixedSoundToSamples( idSIMDProcessor *p, const int count ) { p->MixedSoundToSamples( benchShorts, benchFloats[0], count ); }
+
+typedef struct {
+	const char *			name;
+	benchKernel_t			kernel;
+	int						fixedCount;		// the function only supports this count
+	int						minCount;		// smaller counts are skipped
+} benchFunction_t;
+
+#define BENCH_FUNCTION( name )					{ #name, name, 0, 0 }
+#define BENCH_FUNCTION_MIN( name, minCount )	{ #name, name, 0, minCount }
+#define BENCH_FUNCTION_FIXED( name, count )		{ #name, name, count, 0 }
+
+static const benchFunction_t benchFunctions[] = {
+	BENCH_FUNCTION( Add_c ),
+	BENCH_FUNCTION( Add ),
+	BENCH_FUNCTION( Sub_c ),
+	BENCH_FUNCTION( Sub ),
+	BENCH_FUNCTION( Mul_c ),
+	BENCH_FUNCTION( Mul ),
+	BENCH_FUNCTION( Div_c ),
+	BENCH_FUNCTION( Div ),
+	BENCH_FUNCTION( MulAdd_c ),
+	BENCH_FUNCTION( MulAdd ),
+	BENCH_FUNCTION( MulSub_c ),
+	BENCH_FUNCTION( MulSub ),
+	BENCH_FUNCTION( Dot_Vec3_Vec3 ),
+	BENCH_FUNCTION( Dot_Vec3_Plane ),
+	BENCH_FUNCTION( Dot_Vec3_DrawVert ),
+	BENCH_FUNCTION( Dot_Plane_Vec3 ),
+	BENCH_FUNCTION( Dot_Plane_Plane ),
+	BENCH_FUNCTION( Dot_Plane_DrawVert ),
+	BENCH_FUNCTION( Dot_Vec3s ),
+	BENCH_FUNCTION( Dot_Floats ),
+	BENCH_FUNCTION( CmpGT ),
+	BENCH_FUNCTION( CmpGT_Bit ),
+	BENCH_FUNCTION( CmpGE ),
+	BENCH_FUNCTION( CmpGE_Bit ),
+	BENCH_FUNCTION( CmpLT ),
+	BENCH_FUNCTION( CmpLT_Bit ),
+	BENCH_FUNCTION( CmpLE ),
+	BENCH_FUNCTION( CmpLE_Bit ),
+	BENCH_FUNCTION( MinMax_Float ),
+	BENCH_FUNCTION( MinMax_Vec2 ),
+	BENCH_FUNCTION( MinMax_Vec3 ),
+	BENCH_FUNCTION( MinMax_DrawVert ),
+	BENCH_FUNCTION( MinMax_DrawVertIndexed ),
+	BENCH_FUNCTION( Clamp ),
+	BENCH_FUNCTION( ClampMin ),
+	BENCH_FUNCTION( ClampMax ),
+	BENCH_FUNCTION( Memcpy ),
+	BENCH_FUNCTION( Memset ),
+	BENCH_FUNCTION( Zero16 ),
+	BENCH_FUNCTION( Negate16 ),
+	BENCH_FUNCTION( Copy16 ),
+	BENCH_FUNCTION( Add16 ),
+	BENCH_FUNCTION( Sub16 ),
+	BENCH_FUNCTION( Mul16 ),
+	BENCH_FUNCTION( AddAssign16 ),
+	BENCH_FUNCTION( SubAssign16 ),
+	BENCH_FUNCTION( MulAssign16 ),
+	BENCH_FUNCTION( MatX_MultiplyVecX ),
+	BENCH_FUNCTION( MatX_MultiplyAddVecX ),
+	BENCH_FUNCTION( MatX_MultiplySubVecX ),
+	BENCH_FUNCTION( MatX_TransposeMultiplyVecX ),
+	BENCH_FUNCTION( MatX_TransposeMultiplyAddVecX ),
+	BENCH_FUNCTION( MatX_TransposeMultiplySubVecX ),
+	BENCH_FUNCTION( MatX_MultiplyMatX ),
+	BENCH_FUNCTION( MatX_TransposeMultiplyMatX ),
+	BENCH_FUNCTION( MatX_LowerTriangularSolve ),
+	BENCH_FUNCTION( MatX_LowerTriangularSolveTranspose ),
+	BENCH_FUNCTION( MatX_LDLTFactor ),
+	BENCH_FUNCTION( BlendJoints ),
+	BENCH_FUNCTION( ConvertJointQuatsToJointMats ),
+	BENCH_FUNCTION( ConvertJointMatsToJointQuats ),
+	BENCH_FUNCTION( TransformJoints ),
+	BENCH_FUNCTION( UntransformJoints ),
+	BENCH_FUNCTION( TransformVerts ),
+	BENCH_FUNCTION( TracePointCull ),
+	BENCH_FUNCTION( DecalPointCull ),
+	BENCH_FUNCTION( OverlayPointCull ),
+	BENCH_FUNCTION( CullBoxes ),
+	BENCH_FUNCTION( OverlapBounds ),
+	BENCH_FUNCTION_MIN( DeriveTriPlanes, 32 ),
+	BENCH_FUNCTION_MIN( DeriveTangents, 32 ),
+	BENCH_FUNCTION_MIN( DeriveUnsmoothedTangents, 32 ),
+	BENCH_FUNCTION( NormalizeTangents ),
+	BENCH_FUNCTION_MIN( CreateTextureSpaceLightVectors, 32 ),
+	BENCH_FUNCTION_MIN( CreateSpecularTextureCoords, 32 ),
+	BENCH_FUNCTION( CreateShadowCache ),
+	BENCH_FUNCTION( CreateVertexProgramShadowCache ),
+	BENCH_FUNCTION( UpSamplePCMTo44kHz ),
+	BENCH_FUNCTION( UpSampleOGGTo44kHz ),
+	BENCH_FUNCTION_FIXED( MixSoundTwoSpeakerMono, MIXBUFFER_SAMPLES ),
+	BENCH_FUNCTION_FIXED( MixSoundTwoSpeakerStereo, MIXBUFFER_SAMPLES ),
+	BENCH_FUNCTION_FIXED( MixSoundSixSpeakerMono, MIXBUFFER_SAMPLES ),
+	BENCH_FUNCTION_FIXED( MixSoundSixSpeakerStereo, MIXBUFFER_SAMPLES ),
+	BENCH_FUNCTION( MixedSoundToSamples ),
+	{ NULL, NULL, 0, 0 }
+};
+
+/*
+==============================================================
+
+	processors
+
+==============================================================
+*/
+
+typedef struct {
+	const char *			name;
+	int						required;		// cpuid flags needed to run the processor
+	idSIMDProcessor *		processor;
+} benchProcessor_t;
+
+static benchProcessor_t benchProcessors[] = {
+	{ "generic",	CPUID_NONE, NULL },
+	{ "MMX",		CPUID_MMX, NULL },
+	{ "3DNow",		CPUID_MMX | CPUID_3DNOW, NULL },
+	{ "SSE",		CPUID_MMX | CPUID_SSE, NULL },
+	{ "SSE2",		CPUID_MMX | CPUID_SSE | CPUID_SSE2, NULL },
+	{ "SSE3",		CPUID_MMX | CPUID_SSE | CPUID_SSE2 | CPUID_SSE3, NULL },
+	{ "AVX2",		CPUID_MMX | CPUID_SSE | CPUID_SSE2 | CPUID_SSE3 | CPUID_AVX2 | CPUID_FMA3, NULL },
+	{ "AltiVec",	CPUID_ALTIVEC, NULL },
+	{ NULL, 0, NULL }
+};
+
+/*
+============
+Bench_CreateProcessors
+============
+*/
+static void Bench_CreateProcessors( cpuid_t cpuid ) {
+	for ( int i = 0; benchProcessors[i].name; i++ ) {
+		benchProcessor_t &bp = benchProcessors[i];
+		if ( ( cpuid & bp.required ) != bp.required ) {
+			continue;
+		}
+		switch( i ) {
+			case 0: bp.processor = new idSIMD_Generic; break;
+			case 1: bp.processor = new idSIMD_MMX; break;
+			case 2: bp.processor = new idSIMD_3DNow; break;
+			case 3: bp.processor = new idSIMD_SSE; break;
+			case 4: bp.processor = new idSIMD_SSE2; break;
+			case 5: bp.processor = new idSIMD_SSE3; break;
+			case 6: bp.processor = new idSIMD_AVX2; break;
+			case 7: bp.processor = new idSIMD_AltiVec; break;
+		}
+		bp.processor->cpuid = cpuid;
+	}
+}
+
+/*
+============
+Bench_FreeProcessors
+============
+*/
+static void Bench_FreeProcessors( void ) {
+	for ( int i = 0; benchProcessors[i].name; i++ ) {
+		delete benchProcessors[i].processor;
+		benchProcessors[i].processor = NULL;
+	}
+}
+
+/*
+==============================================================
+
+	timing
+
+==============================================================
+*/
+
+typedef struct {
+	const char *			processor;
+	const char *			function;
+	int						count;
+	int						calls;			// calls per sample
+	double					best;			// microseconds per call of the fastest sample
+	double					average;		// microseconds per call over all samples
+} benchResult_t;
+
+/*
+============
+Bench_Microseconds
+============
+*/
+static double Bench_Microseconds( void ) {
+#ifdef _WIN32
+	static LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	if ( !frequency.QuadPart ) {
+		QueryPerformanceFrequency( &frequency );
+	}
+	QueryPerformanceCounter( &counter );
+	return (double)counter.QuadPart * 1000000.0 / (double)frequency.QuadPart;
+#else
+	struct timeval tp;
+
+	gettimeofday( &tp, NULL );
+	return (double)tp.tv_sec * 1000000.0 + (double)tp.tv_usec;
+#endif
+}
+
+/*
+============
+Bench_Time
+
+  returns the time in microseconds for the given number of calls
+============
+*/
+static double Bench_Time( const benchFunction_t &func, idSIMDProcessor *p, const int count, const int calls ) {
+	double start = Bench_Microseconds();
+	for ( int i = 0; i < calls; i++ ) {
+		func.kernel( p, count );
+	}
+	return Bench_Microseconds() - start;
+}
+
+/*
+============
+Bench_Run
+============
+*/
+static void Bench_Run( const benchProcessor_t &bp, const benchFunction_t &func, const int count, const int numSamples, const double sampleTime, benchResult_t &result ) {
+	int calls;
+	double time, best, total;
+
+	// warm up the caches, then double the calls until a sample takes long enough for the timer resolution
+	func.kernel( bp.processor, count );
+	for ( calls = 1; calls < MAX_CALLS; calls <<= 1 ) {
+		if ( Bench_Time( func, bp.processor, count, calls ) >= sampleTime ) {
+			break;
+		}
+	}
+
+	best = idMath::INFINITY;
+	total = 0.0;
+	for ( int i = 0; i < numSamples; i++ ) {
+		time = Bench_Time( func, bp.processor, count, calls );
+		if ( time < best ) {
+			best = time;
+		}
+		total += time;
+	}
+
+	result.processor = bp.name;
+	result.function = func.name;
+	result.count = count;
+	result.calls = calls;
+	result.best = best / calls;
+	result.average = total / ( numSamples * calls );
+}
+
+/*
+==============================================================
+
+	output
+
+==============================================================
+*/
+
+/*
+============
+Bench_ElementsPerSecond
+============
+*/
+static double Bench_ElementsPerSecond( const benchResult_t &result ) {
+	return result.best > 0.0 ? result.count * 1000000.0 / result.best : 0.0;
+}
+
+/*
+============
+Bench_WriteJSON
+============
+*/
+static void Bench_WriteJSON( FILE *f, const idList<benchResult_t> &results, const int numSamples, const double sampleTime ) {
+	fprintf( f, "{\n" );
+	fprintf( f, "\t\"cpu\": \"%s\",\n", Sys_GetProcessorString() );
+	fprintf( f, "\t\"cpuid\": %d,\n", (int) Sys_GetProcessorId() );
+	fprintf( f, "\t\"build\": \"%s\",\n", BUILD_STRING );
+	fprintf( f, "\t\"samples\": %d,\n", numSamples );
+	fprintf( f, "\t\"sampleTime\": %.0f,\n", sampleTime );
+	fprintf( f, "\t\"results\": [\n" );
+	for ( int i = 0; i < results.Num(); i++ ) {
+		const benchResult_t &r = results[i];
+		fprintf( f, "\t\t{ \"processor\": \"%s\", \"function\": \"%s\", \"count\": %d, \"calls\": %d, \"bestUsec\": %.4f, \"averageUsec\": %.4f, \"elementsPerSec\": %.0f }%s\n",
+					r.processor, r.function, r.count, r.calls, r.best, r.average, Bench_ElementsPerSecond( r ), ( i < results.Num() - 1 ) ? "," : "" );
+	}
+	fprintf( f, "\t]\n" );
+	fprintf( f, "}\n" );
+}
+
+/*
+============
+Bench_WriteCSV
+============
+*/
+static void Bench_WriteCSV( FILE *f, const idList<benchResult_t> &results ) {
+	fprintf( f, "processor,function,count,calls,best_usec,average_usec,elements_per_sec\n" );
+	for ( int i = 0; i < results.Num(); i++ ) {
+		const benchResult_t &r = results[i];
+		fprintf( f, "%s,%s,%d,%d,%.4f,%.4f,%.0f\n", r.processor, r.function, r.count, r.calls, r.best, r.average, Bench_ElementsPerSecond( r ) );
+	}
+}
+
+/*
+==============================================================
+
+	main
+
+==============================================================
+*/
+
+/*
+============
+Bench_Usage
+============
+*/
+static void Bench_Usage( void ) {
+	int i;
+
+	fprintf( stderr, "usage: simdbench [-format json|csv] [-output file] [-processor name] [-function name] [-samples n] [-sampleTime usec]\n" );
+	fprintf( stderr, "processors:" );
+	for ( i = 0; benchProcessors[i].name; i++ ) {
+		fprintf( stderr, " %s", benchProcessors[i].name );
+	}
+	fprintf( stderr, "\nfunctions:" );
+	for ( i = 0; benchFunctions[i].name; i++ ) {
+		fprintf( stderr, "%s%s", ( i % 6 ) ? " " : "\n\t", benchFunctions[i].name );
+	}
+	fprintf( stderr, "\n" );
+}
+
+int main( int argc, char** argv ) {
+	int i, j, k;
+	const char *format = "json";
+	const char *outputName = NULL;
+	const char *processorName = NULL;
+	const char *functionName = NULL;
+	int numSamples = DEFAULT_SAMPLES;
+	double sampleTime = DEFAULT_SAMPLE_TIME;
+	idList<benchResult_t> results;
+	benchResult_t result;
+	FILE *f;
+
+	for ( i = 1; i < argc; i++ ) {
+		if ( !idStr::Icmp( argv[i], "-format" ) && i + 1 < argc ) {
+			format = argv[++i];
+		} else if ( !idStr::Icmp( argv[i], "-output" ) && i + 1 < argc ) {
+			outputName = argv[++i];
+		} else if ( !idStr::Icmp( argv[i], "-processor" ) && i + 1 < argc ) {
+			processorName = argv[++i];
+		} else if ( !idStr::Icmp( argv[i], "-function" ) && i + 1 < argc ) {
+			functionName = argv[++i];
+		} else if ( !idStr::Icmp( argv[i], "-samples" ) && i + 1 < argc ) {
+			numSamples = Max( atoi( argv[++i] ), 1 );
+		} else if ( !idStr::Icmp( argv[i], "-sampleTime" ) && i + 1 < argc ) {
+			sampleTime = Max( atof( argv[++i] ), 1.0 );
+		} else {
+			Bench_Usage();
+			return 1;
+		}
+	}
+
+	if ( idStr::Icmp( format, "json" ) && idStr::Icmp( format, "csv" ) ) {
+		Bench_Usage();
+		return 1;
+	}
+
+	idLib::common = common;
+	idLib::cvarSystem = cvarSystem;
+	idLib::fileSystem = NULL;
+	idLib::sys = sys;
+
+	idLib::Init();
+
+	Bench_CreateProcessors( Sys_GetProcessorId() );
+	Bench_AllocData();
+
+	common->Printf( "%s\n", Sys_GetProcessorString() );
+
+	for ( i = 0; benchProcessors[i].name; i++ ) {
+		const benchProcessor_t &bp = benchProcessors[i];
+		if ( !bp.processor ) {
+			continue;
+		}
+		if ( processorName && idStr::Icmp( processorName, bp.name ) ) {
+			continue;
+		}
+		common->Printf( "benchmarking %s\n", bp.name );
+
+		for ( j = 0; benchFunctions[j].name; j++ ) {
+			const benchFunction_t &func = benchFunctions[j];
+			if ( functionName && idStr::Icmp( functionName, func.name ) ) {
+				continue;
+			}
+			for ( k = 0; k < sizeof( benchCounts ) / sizeof( benchCounts[0] ); k++ ) {
+				int count = func.fixedCount ? func.fixedCount : benchCounts[k];
+				if ( count < func.minCount ) {
+					continue;
+				}
+				Bench_SetupMesh( count );
+				Bench_Run( bp, func, count, numSamples, sampleTime, result );
+				results.Append( result );
+				if ( func.fixedCount ) {
+					break;
+				}
+			}
+		}
+	}
+
+	if ( outputName ) {
+		f = fopen( outputName, "w" );
+		if ( !f ) {
+			common->Error( "couldn't open %s", outputName );
+		}
+	} else {
+		f = stdout;
+	}
+
+	if ( !idStr::Icmp( format, "csv" ) ) {
+		Bench_WriteCSV( f, results );
+	} else {
+		Bench_WriteJSON( f, results, numSamples, sampleTime );
+	}
+
+	if ( f != stdout ) {
+		fclose( f );
+		common->Printf( "wrote %d results to %s\n", results.Num(), outputName );
+	}
+
+	results.Clear();
+	Bench_FreeData();
+	Bench_FreeProcessors();
+
+	idLib::ShutDown();
+
+	return 0;
+}
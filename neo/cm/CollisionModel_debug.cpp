@@ -323,7 +323,10 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3 &m
 		cm_drawColor.ClearModified();
 	}
 
-	model = models[ handle ];
+	model = GetContextModel( GetTraceContext(), handle );
+	if ( !model ) {
+		return;
+	}
 	viewPos = (viewOrigin - modelOrigin) * modelAxis.Transpose();
 	checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
@@ -350,6 +353,7 @@ static idCVar cm_testWalk(			"cm_testWalk",			"1",					CVAR_GAME | CVAR_BOOL,		"
 static idCVar cm_testLength(		"cm_testLength",		"1024",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testRadius(		"cm_testRadius",		"64",					CVAR_GAME | CVAR_FLOAT,		"" );
 static idCVar cm_testAngle(			"cm_testAngle",			"60",					CVAR_GAME | CVAR_FLOAT,		"" );
+static idCVar cm_testJobs(			"cm_testJobs",			"0",					CVAR_GAME | CVAR_INTEGER,	"number of parallel jobs used to verify concurrent collision queries against the serial results" );
 
 static int total_translation;
 static int min_translation = 999999;
@@ -364,6 +368,130 @@ static idVec3 *testend;
 
 #include "../sys/sys_public.h"
 
+typedef struct cm_queryTest_s {
+	const idTraceModel *	trm;
+	idMat3					trmAxis;
+	idMat3					modelAxis;
+	idVec3					rotationVec;
+	cmHandle_t				model;
+	int						firstQuery;
+	int						numQueries;
+	trace_t *				translations;
+	trace_t *				rotations;
+	int *					contents;
+} cm_queryTest_t;
+
+/*
+================
+CM_RunQueryTest
+
+  runs a batch of collision queries, may be called from any thread
+================
+*/
+static void CM_RunQueryTest( void *data ) {
+	cm_queryTest_t *test = (cm_queryTest_t *) data;
+	idRotation rotation( vec3_origin, test->rotationVec, cm_testAngle.GetFloat() );
+
+	for ( int i = test->firstQuery; i < test->firstQuery + test->numQueries; i++ ) {
+		collisionModelManager->Translation( &test->translations[i], start, testend[i], test->trm, test->trmAxis,
+												CONTENTS_SOLID|CONTENTS_PLAYERCLIP, test->model, vec3_origin, test->modelAxis );
+		rotation.SetOrigin( testend[i] );
+		collisionModelManager->Rotation( &test->rotations[i], start, rotation, test->trm, test->trmAxis,
+												CONTENTS_SOLID|CONTENTS_PLAYERCLIP, test->model, vec3_origin, test->modelAxis );
+		test->contents[i] = collisionModelManager->Contents( testend[i], test->trm, test->trmAxis, -1, test->model, vec3_origin, test->modelAxis );
+	}
+}
+
+/*
+================
+CM_CompareTraces
+================
+*/
+static bool CM_CompareTraces( const trace_t &a, const trace_t &b ) {
+	return a.fraction == b.fraction && a.endpos == b.endpos && a.endAxis == b.endAxis &&
+			a.c.type == b.c.type && a.c.point == b.c.point && a.c.normal == b.c.normal && a.c.dist == b.c.dist &&
+			a.c.contents == b.c.contents && a.c.material == b.c.material &&
+			a.c.modelFeature == b.c.modelFeature && a.c.trmFeature == b.c.trmFeature;
+}
+
+/*
+================
+CM_TestConcurrentQueries
+
+  runs the same collision queries serially and spread over parallel jobs and compares the results
+================
+*/
+static void CM_TestConcurrentQueries( const idTraceModel &trm, const idMat3 &trmAxis, const idMat3 &modelAxis, const idVec3 &rotationVec ) {
+	int i, numQueries, numJobs, numFailed, serialTime, parallelTime;
+	cm_queryTest_t serial, *tests;
+	trace_t *translations, *rotations;
+	int *contents;
+	idParallelJobList *jobList;
+	idTimer timer;
+
+	numQueries = cm_testTimes.GetInteger();
+	numJobs = idMath::ClampInt( 1, numQueries, cm_testJobs.GetInteger() );
+
+	translations = (trace_t *) Mem_Alloc( 2 * numQueries * sizeof( trace_t ) );
+	rotations = (trace_t *) Mem_Alloc( 2 * numQueries * sizeof( trace_t ) );
+	contents = (int *) Mem_Alloc( 2 * numQueries * sizeof( int ) );
+	tests = (cm_queryTest_t *) Mem_Alloc( numJobs * sizeof( cm_queryTest_t ) );
+
+	serial.trm = &trm;
+	serial.trmAxis = trmAxis;
+	serial.modelAxis = modelAxis;
+	serial.rotationVec = rotationVec;
+	serial.model = cm_testModel.GetInteger();
+	serial.firstQuery = 0;
+	serial.numQueries = numQueries;
+	serial.translations = translations;
+	serial.rotations = rotations;
+	serial.contents = contents;
+
+	timer.Clear();
+	timer.Start();
+	CM_RunQueryTest( &serial );
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	jobList = parallelJobManager->AllocJobList( "collisionTest" );
+	for ( i = 0; i < numJobs; i++ ) {
+		tests[i] = serial;
+		tests[i].firstQuery = i * numQueries / numJobs;
+		tests[i].numQueries = ( i + 1 ) * numQueries / numJobs - tests[i].firstQuery;
+		// the parallel results are stored behind the serial results
+		tests[i].translations = translations + numQueries;
+		tests[i].rotations = rotations + numQueries;
+		tests[i].contents = contents + numQueries;
+		jobList->AddJob( CM_RunQueryTest, &tests[i] );
+	}
+
+	timer.Clear();
+	timer.Start();
+	jobList->Submit();
+	jobList->Wait();
+	timer.Stop();
+	parallelTime = timer.Milliseconds();
+
+	parallelJobManager->FreeJobList( jobList );
+
+	numFailed = 0;
+	for ( i = 0; i < numQueries; i++ ) {
+		if ( !CM_CompareTraces( translations[i], translations[numQueries + i] ) ||
+				!CM_CompareTraces( rotations[i], rotations[numQueries + i] ) ||
+					contents[i] != contents[numQueries + i] ) {
+			numFailed++;
+		}
+	}
+
+	common->Printf( "%d queries in %d jobs: serial %d msec, parallel %d msec, %d mismatches\n", numQueries, numJobs, serialTime, parallelTime, numFailed );
+
+	Mem_Free( tests );
+	Mem_Free( contents );
+	Mem_Free( rotations );
+	Mem_Free( translations );
+}
+
 void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 	int i, k, t;
 	char buf[128];
@@ -483,6 +611,12 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3 &origin ) {
 		common->Printf("%s rotation: %4d milliseconds, (min = %d, max = %d, av = %1.1f)\n", buf, t, min_rotation, max_rotation, (float) total_rotation / num_rotation );
 	}
 
+	if ( cm_testJobs.GetInteger() > 0 ) {
+		idVec3 vec( random.CRandomFloat(), random.CRandomFloat(), random.RandomFloat() );
+		vec.Normalize();
+		CM_TestConcurrentQueries( itm, boxAxis, modelAxis, vec );
+	}
+
 	Mem_Free( testend );
 	testend = NULL;
 }
@@ -43,6 +43,14 @@ If you have questions concerning this license or the applicable additional terms
 #define CM_FILEID			"CM"
 #define CM_FILEVERSION		"1.00"
 
+#define CMB_FILE_DIR		"generated/"
+#define CMB_FILE_EXT		"cmb"
+#define CMB_FILEID			(('1'<<24)+('B'<<16)+('M'<<8)+'C')
+#define CMB_FILEVERSION		1
+
+idCVar cm_binaryCache(			"cm_binaryCache",			"1",	CVAR_GAME | CVAR_BOOL,	"load collision models from a binary cache and write the cache after parsing a .cm file" );
+idCVar cm_binaryCacheCompare(	"cm_binaryCacheCompare",	"0",	CVAR_GAME | CVAR_BOOL,	"also parse the .cm file when loading from the binary cache and report load times and differences" );
+
 
 /*
 ===============================================================================
@@ -328,9 +336,6 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer *src, cm_model_t *mode
 	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
 	for ( i = 0; i < model->numVertices; i++ ) {
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -352,8 +357,6 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer *src, cm_model_t *model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
@@ -468,6 +471,7 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer *src, cm_model_t *model
 		} else {
 			b->contents = ContentsFromString( token );
 		}
+		b->material = NULL;
 		b->checkcount = 0;
 		b->primitiveNum = 0;
 		// filter brush into tree
@@ -549,10 +553,10 @@ bool idCollisionModelManagerLocal::ParseCollisionModel( idLexer *src ) {
 
 /*
 ================
-idCollisionModelManagerLocal::LoadCollisionModelFile
+idCollisionModelManagerLocal::ParseCollisionModelFile
 ================
 */
-bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
+bool idCollisionModelManagerLocal::ParseCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
 	idStr fileName;
 	idToken token;
 	idLexer *src;
@@ -607,10 +611,784 @@ bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, uns
 			continue;
 		}
 
-		src->Error( "idCollisionModelManagerLocal::LoadCollisionModelFile: bad token \"%s\"", token.c_str() );
+		src->Error( "idCollisionModelManagerLocal::ParseCollisionModelFile: bad token \"%s\"", token.c_str() );
 	}
 
 	delete src;
 
 	return true;
 }
+
+/*
+================
+idCollisionModelManagerLocal::LoadCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
+	int firstModel;
+	idTimer timer;
+
+	firstModel = numModels;
+
+	if ( cm_binaryCache.GetBool() ) {
+		timer.Start();
+		if ( LoadBinaryCollisionModelFile( name, mapFileCRC ) ) {
+			timer.Stop();
+			if ( cm_binaryCacheCompare.GetBool() ) {
+				CompareCollisionModelFiles( name, mapFileCRC, firstModel, timer.Milliseconds() );
+			}
+			return true;
+		}
+	}
+
+	if ( !ParseCollisionModelFile( name, mapFileCRC ) ) {
+		return false;
+	}
+
+	// write the binary cache so the next load doesn't have to parse the text file
+	if ( cm_binaryCache.GetBool() ) {
+		WriteBinaryCollisionModelsToFile( name, firstModel, numModels, mapFileCRC );
+	}
+
+	return true;
+}
+
+
+/*
+===============================================================================
+
+Binary collision model cache
+
+  The .cmb file stores the collision models in the same layout as they are
+  used in memory. Loading a model reads the whole file at once, copies the
+  arrays and fixes up the pointers, which are stored as one based indexes
+  or byte offsets into the polygon and brush blocks. Material pointers are
+  stored as an index into the material table at the start of the file.
+
+  The cache is only valid for the build that wrote it. The header stores the
+  sizes of the raw structures and the cache is rewritten when they differ.
+
+===============================================================================
+*/
+
+typedef struct cmbHeader_s {
+	int						ident;
+	int						version;
+	unsigned int			mapFileCRC;			// geometry crc of the map, zero for other models
+	ID_TIME_T				sourceTime;			// time stamp of the .cm file the cache was written for
+	int						pointerSize;
+	int						edgeSize;
+	int						polygonSize;
+	int						brushSize;
+	int						nodeSize;
+	int						numMaterials;
+	int						numModels;
+} cmbHeader_t;
+
+typedef struct cmbModel_s {
+	idBounds				bounds;
+	int						contents;
+	int						isConvex;
+	int						nameLength;			// followed by the name padded to a multiple of four bytes
+	int						numVertices;
+	int						numEdges;
+	int						polygonMemory;
+	int						brushMemory;
+	int						numNodes;
+	int						numPolygonRefs;
+	int						numBrushRefs;
+	int						numPolygons;
+	int						numBrushes;
+	int						numInternalEdges;
+	int						numSharpEdges;
+	int						numRemovedPolys;
+	int						numMergedPolys;
+} cmbModel_t;
+
+typedef struct cmbCursor_s {
+	const byte *			ptr;
+	const byte *			end;
+} cmbCursor_t;
+
+/*
+================
+CM_BinaryData
+
+  returns a pointer to the next size bytes in the file or NULL if the file is truncated
+================
+*/
+static const byte *CM_BinaryData( cmbCursor_t &cursor, int size ) {
+	const byte *data;
+
+	if ( size < 0 || cursor.end - cursor.ptr < size ) {
+		return NULL;
+	}
+	data = cursor.ptr;
+	cursor.ptr += size;
+	return data;
+}
+
+/*
+================
+CM_PointerHashKey
+================
+*/
+static ID_INLINE int CM_PointerHashKey( const void *ptr ) {
+	return (int) ( ( (ptrdiff_t) ptr ) >> 4 );
+}
+
+/*
+================
+CM_FindPointer
+================
+*/
+template< class type >
+static int CM_FindPointer( const idHashIndex &hash, const idList<type *> &list, const type *ptr ) {
+	int i;
+
+	for ( i = hash.First( CM_PointerHashKey( ptr ) ); i != -1; i = hash.Next( i ) ) {
+		if ( list[i] == ptr ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+CM_WriteBinaryString
+================
+*/
+static void CM_WriteBinaryString( idFile *fp, const char *string, int length ) {
+	static const char pad[4] = { 0, 0, 0, 0 };
+
+	fp->Write( string, length );
+	fp->Write( pad, ( ( length + 3 ) & ~3 ) - length );
+}
+
+/*
+================
+CM_GatherNodes_r
+================
+*/
+static void CM_GatherNodes_r( cm_node_t *node, idList<cm_node_t *> &nodes ) {
+	nodes.Append( node );
+	if ( node->planeType != -1 ) {
+		CM_GatherNodes_r( node->children[0], nodes );
+		CM_GatherNodes_r( node->children[1], nodes );
+	}
+}
+
+/*
+================
+CM_GatherMaterials_r
+================
+*/
+static void CM_GatherMaterials_r( cm_node_t *node, idList<const idMaterial *> &materials ) {
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+
+	for ( pref = node->polygons; pref; pref = pref->next ) {
+		if ( pref->p->material ) {
+			materials.AddUnique( pref->p->material );
+		}
+	}
+	for ( bref = node->brushes; bref; bref = bref->next ) {
+		if ( bref->b->material ) {
+			materials.AddUnique( bref->b->material );
+		}
+	}
+	if ( node->planeType != -1 ) {
+		CM_GatherMaterials_r( node->children[0], materials );
+		CM_GatherMaterials_r( node->children[1], materials );
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModel
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModel( idFile *fp, cm_model_t *model, const idList<const idMaterial *> &materials ) {
+	int i, size, polygonMemory, brushMemory, numPolygonRefs, numBrushRefs;
+	idList<cm_node_t *> nodes;
+	idList<cm_polygon_t *> polygons;
+	idList<cm_brush_t *> brushes;
+	idList<int> polygonOffsets, brushOffsets, firstPolygonRef, firstBrushRef;
+	idHashIndex nodeHash, polygonHash, brushHash;
+	cm_polygonRef_t *pref;
+	cm_brushRef_t *bref;
+	cmbModel_t header;
+	idList<byte> buffer;
+
+	// gather the nodes in depth first order
+	if ( model->node ) {
+		CM_GatherNodes_r( model->node, nodes );
+	}
+	nodeHash.Clear( 4096, nodes.Num() );
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		nodeHash.Add( CM_PointerHashKey( nodes[i] ), i );
+	}
+
+	// gather the polygons and brushes in the order in which they are first referenced
+	checkCount++;
+	polygonMemory = brushMemory = numPolygonRefs = numBrushRefs = 0;
+	polygonHash.Clear( 4096, model->numPolygons );
+	brushHash.Clear( 4096, model->numBrushes );
+	firstPolygonRef.SetNum( nodes.Num() );
+	firstBrushRef.SetNum( nodes.Num() );
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		firstPolygonRef[i] = numPolygonRefs;
+		for ( pref = nodes[i]->polygons; pref; pref = pref->next ) {
+			numPolygonRefs++;
+			if ( pref->p->checkcount == checkCount ) {
+				continue;
+			}
+			pref->p->checkcount = checkCount;
+			polygonHash.Add( CM_PointerHashKey( pref->p ), polygons.Append( pref->p ) );
+			polygonOffsets.Append( polygonMemory );
+			polygonMemory += sizeof( cm_polygon_t ) + ( pref->p->numEdges - 1 ) * sizeof( pref->p->edges[0] );
+		}
+		firstBrushRef[i] = numBrushRefs;
+		for ( bref = nodes[i]->brushes; bref; bref = bref->next ) {
+			numBrushRefs++;
+			if ( bref->b->checkcount == checkCount ) {
+				continue;
+			}
+			bref->b->checkcount = checkCount;
+			brushHash.Add( CM_PointerHashKey( bref->b ), brushes.Append( bref->b ) );
+			brushOffsets.Append( brushMemory );
+			brushMemory += sizeof( cm_brush_t ) + ( bref->b->numPlanes - 1 ) * sizeof( bref->b->planes[0] );
+		}
+	}
+
+	memset( (void *)&header, 0, sizeof( header ) );
+	header.bounds = model->bounds;
+	header.contents = model->contents;
+	header.isConvex = model->isConvex;
+	header.nameLength = model->name.Length();
+	header.numVertices = model->numVertices;
+	header.numEdges = model->numEdges;
+	header.polygonMemory = polygonMemory;
+	header.brushMemory = brushMemory;
+	header.numNodes = nodes.Num();
+	header.numPolygonRefs = numPolygonRefs;
+	header.numBrushRefs = numBrushRefs;
+	header.numPolygons = polygons.Num();
+	header.numBrushes = brushes.Num();
+	header.numInternalEdges = model->numInternalEdges;
+	header.numSharpEdges = model->numSharpEdges;
+	header.numRemovedPolys = model->numRemovedPolys;
+	header.numMergedPolys = model->numMergedPolys;
+	fp->Write( &header, sizeof( header ) );
+	CM_WriteBinaryString( fp, model->name.c_str(), model->name.Length() );
+
+	fp->Write( model->vertices, model->numVertices * sizeof( model->vertices[0] ) );
+	fp->Write( model->edges, model->numEdges * sizeof( model->edges[0] ) );
+
+	// polygons with the material pointer replaced by the material index
+	for ( i = 0; i < polygons.Num(); i++ ) {
+		size = sizeof( cm_polygon_t ) + ( polygons[i]->numEdges - 1 ) * sizeof( polygons[i]->edges[0] );
+		buffer.SetNum( size, false );
+		cm_polygon_t *p = (cm_polygon_t *) buffer.Ptr();
+		memcpy( (void *)p, polygons[i], size );
+		p->material = (const idMaterial *) (ptrdiff_t) ( polygons[i]->material ? materials.FindIndex( polygons[i]->material ) : -1 );
+		p->checkcount = 0;
+		p->checkNum = 0;
+		fp->Write( p, size );
+	}
+
+	// brushes with the material pointer replaced by the material index
+	for ( i = 0; i < brushes.Num(); i++ ) {
+		size = sizeof( cm_brush_t ) + ( brushes[i]->numPlanes - 1 ) * sizeof( brushes[i]->planes[0] );
+		buffer.SetNum( size, false );
+		cm_brush_t *b = (cm_brush_t *) buffer.Ptr();
+		memcpy( (void *)b, brushes[i], size );
+		b->material = (const idMaterial *) (ptrdiff_t) ( brushes[i]->material ? materials.FindIndex( brushes[i]->material ) : -1 );
+		b->checkcount = 0;
+		b->checkNum = 0;
+		fp->Write( b, size );
+	}
+
+	// nodes with pointers replaced by one based indexes
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		cm_node_t node = *nodes[i];
+		node.parent = (cm_node_t *) (ptrdiff_t) ( nodes[i]->parent ? CM_FindPointer( nodeHash, nodes, nodes[i]->parent ) + 1 : 0 );
+		if ( node.planeType != -1 ) {
+			node.children[0] = (cm_node_t *) (ptrdiff_t) ( CM_FindPointer( nodeHash, nodes, nodes[i]->children[0] ) + 1 );
+			node.children[1] = (cm_node_t *) (ptrdiff_t) ( CM_FindPointer( nodeHash, nodes, nodes[i]->children[1] ) + 1 );
+		} else {
+			node.children[0] = node.children[1] = NULL;
+		}
+		node.polygons = (cm_polygonRef_t *) (ptrdiff_t) ( nodes[i]->polygons ? firstPolygonRef[i] + 1 : 0 );
+		node.brushes = (cm_brushRef_t *) (ptrdiff_t) ( nodes[i]->brushes ? firstBrushRef[i] + 1 : 0 );
+		fp->Write( &node, sizeof( node ) );
+	}
+
+	// polygon references, the references of a node are stored consecutively
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		int refNum = firstPolygonRef[i];
+		for ( pref = nodes[i]->polygons; pref; pref = pref->next ) {
+			cm_polygonRef_t ref;
+			refNum++;
+			ref.p = (cm_polygon_t *) (ptrdiff_t) polygonOffsets[CM_FindPointer( polygonHash, polygons, pref->p )];
+			ref.next = (cm_polygonRef_t *) (ptrdiff_t) ( pref->next ? refNum + 1 : 0 );
+			fp->Write( &ref, sizeof( ref ) );
+		}
+	}
+
+	// brush references
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		int refNum = firstBrushRef[i];
+		for ( bref = nodes[i]->brushes; bref; bref = bref->next ) {
+			cm_brushRef_t ref;
+			refNum++;
+			ref.b = (cm_brush_t *) (ptrdiff_t) brushOffsets[CM_FindPointer( brushHash, brushes, bref->b )];
+			ref.next = (cm_brushRef_t *) (ptrdiff_t) ( bref->next ? refNum + 1 : 0 );
+			fp->Write( &ref, sizeof( ref ) );
+		}
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile
+================
+*/
+void idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC ) {
+	int i;
+	idFile *fp;
+	idStr name, sourceName;
+	idList<const idMaterial *> materials;
+	cmbHeader_t header;
+
+	sourceName = filename;
+	sourceName.SetFileExtension( CM_FILE_EXT );
+	name = CMB_FILE_DIR;
+	name += filename;
+	name.SetFileExtension( CMB_FILE_EXT );
+
+	materials.SetGranularity( 256 );
+	for ( i = firstModel; i < lastModel; i++ ) {
+		if ( models[i]->node ) {
+			CM_GatherMaterials_r( models[i]->node, materials );
+		}
+	}
+
+	fp = fileSystem->OpenFileWrite( name );
+	if ( !fp ) {
+		common->Warning( "idCollisionModelManagerLocal::WriteBinaryCollisionModelsToFile: Error opening file %s\n", name.c_str() );
+		return;
+	}
+
+	memset( (void *)&header, 0, sizeof( header ) );
+	header.ident = CMB_FILEID;
+	header.version = CMB_FILEVERSION;
+	header.mapFileCRC = mapFileCRC;
+	fileSystem->ReadFile( sourceName, NULL, &header.sourceTime );
+	header.pointerSize = sizeof( void * );
+	header.edgeSize = sizeof( cm_edge_t );
+	header.polygonSize = sizeof( cm_polygon_t );
+	header.brushSize = sizeof( cm_brush_t );
+	header.nodeSize = sizeof( cm_node_t );
+	header.numMaterials = materials.Num();
+	header.numModels = lastModel - firstModel;
+	fp->Write( &header, sizeof( header ) );
+
+	for ( i = 0; i < materials.Num(); i++ ) {
+		int length = idStr::Length( materials[i]->GetName() );
+		fp->Write( &length, sizeof( length ) );
+		CM_WriteBinaryString( fp, materials[i]->GetName(), length );
+	}
+
+	for ( i = firstModel; i < lastModel; i++ ) {
+		WriteBinaryCollisionModel( fp, models[i], materials );
+	}
+
+	fileSystem->CloseFile( fp );
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModel
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModel( cmbCursor_t &cursor, const idList<const idMaterial *> &materials ) {
+	int i, index, size, offset;
+	const cmbModel_t *header;
+	const byte *data;
+	cm_model_t *model;
+	cm_node_t *nodes;
+	cm_polygonRef_t *polygonRefs;
+	cm_brushRef_t *brushRefs;
+	byte *polygons, *brushes;
+	cm_nodeBlock_t *nodeBlock;
+	cm_polygonRefBlock_t *polygonRefBlock;
+	cm_brushRefBlock_t *brushRefBlock;
+
+	header = (const cmbModel_t *) CM_BinaryData( cursor, sizeof( cmbModel_t ) );
+	if ( !header || header->numVertices < 0 || header->numEdges < 0 || header->numNodes < 0 ||
+			header->polygonMemory < 0 || header->brushMemory < 0 || header->numPolygonRefs < 0 || header->numBrushRefs < 0 ) {
+		return false;
+	}
+	data = CM_BinaryData( cursor, ( header->nameLength + 3 ) & ~3 );
+	if ( !data ) {
+		return false;
+	}
+
+	if ( numModels >= MAX_SUBMODELS ) {
+		common->Error( "LoadModel: no free slots" );
+		return false;
+	}
+	model = AllocModel();
+	models[numModels] = model;
+	numModels++;
+
+	model->name.Append( (const char *) data, header->nameLength );
+	model->bounds = header->bounds;
+	model->contents = header->contents;
+	model->isConvex = ( header->isConvex != 0 );
+	model->numInternalEdges = header->numInternalEdges;
+	model->numSharpEdges = header->numSharpEdges;
+	model->numRemovedPolys = header->numRemovedPolys;
+	model->numMergedPolys = header->numMergedPolys;
+
+	// vertices
+	data = CM_BinaryData( cursor, header->numVertices * sizeof( cm_vertex_t ) );
+	if ( !data ) {
+		goto failed;
+	}
+	model->numVertices = model->maxVertices = header->numVertices;
+	model->vertices = (cm_vertex_t *) Mem_Alloc( model->maxVertices * sizeof( cm_vertex_t ) );
+	memcpy( (void *)model->vertices, data, model->numVertices * sizeof( cm_vertex_t ) );
+
+	// edges
+	data = CM_BinaryData( cursor, header->numEdges * sizeof( cm_edge_t ) );
+	if ( !data ) {
+		goto failed;
+	}
+	model->numEdges = model->maxEdges = header->numEdges;
+	model->edges = (cm_edge_t *) Mem_Alloc( model->maxEdges * sizeof( cm_edge_t ) );
+	memcpy( (void *)model->edges, data, model->numEdges * sizeof( cm_edge_t ) );
+	for ( i = 0; i < model->numEdges; i++ ) {
+		model->edges[i].checkcount = 0;
+		if ( model->edges[i].vertexNum[0] < 0 || model->edges[i].vertexNum[0] >= model->numVertices ||
+				model->edges[i].vertexNum[1] < 0 || model->edges[i].vertexNum[1] >= model->numVertices ) {
+			goto failed;
+		}
+	}
+
+	// polygons, the whole block is used so polygons are never freed separately
+	data = CM_BinaryData( cursor, header->polygonMemory );
+	if ( !data ) {
+		goto failed;
+	}
+	model->polygonBlock = (cm_polygonBlock_t *) Mem_Alloc( sizeof( cm_polygonBlock_t ) + header->polygonMemory );
+	polygons = ( (byte *) model->polygonBlock ) + sizeof( cm_polygonBlock_t );
+	model->polygonBlock->next = polygons + header->polygonMemory;
+	model->polygonBlock->bytesRemaining = 0;
+	memcpy( (void *)polygons, data, header->polygonMemory );
+	for ( offset = 0; offset < header->polygonMemory; offset += size ) {
+		if ( header->polygonMemory - offset < (int)sizeof( cm_polygon_t ) ) {
+			goto failed;
+		}
+		cm_polygon_t *p = (cm_polygon_t *) ( polygons + offset );
+		if ( p->numEdges < 1 || p->numEdges > header->polygonMemory ) {
+			goto failed;
+		}
+		size = sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] );
+		index = (int) (ptrdiff_t) p->material;
+		if ( offset + size > header->polygonMemory || index < -1 || index >= materials.Num() ) {
+			goto failed;
+		}
+		for ( i = 0; i < p->numEdges; i++ ) {
+			if ( abs( p->edges[i] ) >= model->numEdges ) {
+				goto failed;
+			}
+		}
+		p->material = ( index >= 0 ) ? materials[index] : NULL;
+		p->checkNum = model->numPolygonChecks++;
+	}
+	model->numPolygons = header->numPolygons;
+	model->polygonMemory = header->polygonMemory;
+
+	// brushes
+	data = CM_BinaryData( cursor, header->brushMemory );
+	if ( !data ) {
+		goto failed;
+	}
+	model->brushBlock = (cm_brushBlock_t *) Mem_Alloc( sizeof( cm_brushBlock_t ) + header->brushMemory );
+	brushes = ( (byte *) model->brushBlock ) + sizeof( cm_brushBlock_t );
+	model->brushBlock->next = brushes + header->brushMemory;
+	model->brushBlock->bytesRemaining = 0;
+	memcpy( (void *)brushes, data, header->brushMemory );
+	for ( offset = 0; offset < header->brushMemory; offset += size ) {
+		if ( header->brushMemory - offset < (int)sizeof( cm_brush_t ) ) {
+			goto failed;
+		}
+		cm_brush_t *b = (cm_brush_t *) ( brushes + offset );
+		if ( b->numPlanes < 1 || b->numPlanes > header->brushMemory ) {
+			goto failed;
+		}
+		size = sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] );
+		index = (int) (ptrdiff_t) b->material;
+		if ( offset + size > header->brushMemory || index < -1 || index >= materials.Num() ) {
+			goto failed;
+		}
+		b->material = ( index >= 0 ) ? materials[index] : NULL;
+		b->checkNum = model->numBrushChecks++;
+	}
+	model->numBrushes = header->numBrushes;
+	model->brushMemory = header->brushMemory;
+
+	// the nodes and references are each allocated in a single completely used block
+	data = CM_BinaryData( cursor, header->numNodes * sizeof( cm_node_t ) );
+	if ( !data ) {
+		goto failed;
+	}
+	nodeBlock = (cm_nodeBlock_t *) Mem_Alloc( sizeof( cm_nodeBlock_t ) + header->numNodes * sizeof( cm_node_t ) );
+	nodeBlock->nextNode = NULL;
+	nodeBlock->next = NULL;
+	model->nodeBlocks = nodeBlock;
+	nodes = (cm_node_t *) ( ( (byte *) nodeBlock ) + sizeof( cm_nodeBlock_t ) );
+	memcpy( nodes, data, header->numNodes * sizeof( cm_node_t ) );
+	model->numNodes = header->numNodes;
+
+	data = CM_BinaryData( cursor, header->numPolygonRefs * sizeof( cm_polygonRef_t ) );
+	if ( !data ) {
+		goto failed;
+	}
+	polygonRefBlock = (cm_polygonRefBlock_t *) Mem_Alloc( sizeof( cm_polygonRefBlock_t ) + header->numPolygonRefs * sizeof( cm_polygonRef_t ) );
+	polygonRefBlock->nextRef = NULL;
+	polygonRefBlock->next = NULL;
+	model->polygonRefBlocks = polygonRefBlock;
+	polygonRefs = (cm_polygonRef_t *) ( ( (byte *) polygonRefBlock ) + sizeof( cm_polygonRefBlock_t ) );
+	memcpy( polygonRefs, data, header->numPolygonRefs * sizeof( cm_polygonRef_t ) );
+	model->numPolygonRefs = header->numPolygonRefs;
+
+	data = CM_BinaryData( cursor, header->numBrushRefs * sizeof( cm_brushRef_t ) );
+	if ( !data ) {
+		goto failed;
+	}
+	brushRefBlock = (cm_brushRefBlock_t *) Mem_Alloc( sizeof( cm_brushRefBlock_t ) + header->numBrushRefs * sizeof( cm_brushRef_t ) );
+	brushRefBlock->nextRef = NULL;
+	brushRefBlock->next = NULL;
+	model->brushRefBlocks = brushRefBlock;
+	brushRefs = (cm_brushRef_t *) ( ( (byte *) brushRefBlock ) + sizeof( cm_brushRefBlock_t ) );
+	memcpy( brushRefs, data, header->numBrushRefs * sizeof( cm_brushRef_t ) );
+	model->numBrushRefs = header->numBrushRefs;
+
+	// fix up the pointers
+	for ( i = 0; i < header->numPolygonRefs; i++ ) {
+		offset = (int) (ptrdiff_t) polygonRefs[i].p;
+		index = (int) (ptrdiff_t) polygonRefs[i].next;
+		if ( offset < 0 || offset >= header->polygonMemory || index < 0 || index > header->numPolygonRefs ) {
+			goto failed;
+		}
+		polygonRefs[i].p = (cm_polygon_t *) ( polygons + offset );
+		polygonRefs[i].next = index ? &polygonRefs[index - 1] : NULL;
+	}
+	for ( i = 0; i < header->numBrushRefs; i++ ) {
+		offset = (int) (ptrdiff_t) brushRefs[i].b;
+		index = (int) (ptrdiff_t) brushRefs[i].next;
+		if ( offset < 0 || offset >= header->brushMemory || index < 0 || index > header->numBrushRefs ) {
+			goto failed;
+		}
+		brushRefs[i].b = (cm_brush_t *) ( brushes + offset );
+		brushRefs[i].next = index ? &brushRefs[index - 1] : NULL;
+	}
+	for ( i = 0; i < header->numNodes; i++ ) {
+		cm_node_t *node = &nodes[i];
+		int parent = (int) (ptrdiff_t) node->parent;
+		int polygonRef = (int) (ptrdiff_t) node->polygons;
+		int brushRef = (int) (ptrdiff_t) node->brushes;
+		if ( parent < 0 || parent > header->numNodes || polygonRef < 0 || polygonRef > header->numPolygonRefs ||
+				brushRef < 0 || brushRef > header->numBrushRefs ) {
+			goto failed;
+		}
+		node->parent = parent ? &nodes[parent - 1] : NULL;
+		node->polygons = polygonRef ? &polygonRefs[polygonRef - 1] : NULL;
+		node->brushes = brushRef ? &brushRefs[brushRef - 1] : NULL;
+		if ( node->planeType != -1 ) {
+			// children are always stored after their parent
+			int child0 = (int) (ptrdiff_t) node->children[0];
+			int child1 = (int) (ptrdiff_t) node->children[1];
+			if ( child0 <= i + 1 || child0 > header->numNodes || child1 <= i + 1 || child1 > header->numNodes ) {
+				goto failed;
+			}
+			node->children[0] = &nodes[child0 - 1];
+			node->children[1] = &nodes[child1 - 1];
+		}
+	}
+	model->node = header->numNodes ? &nodes[0] : NULL;
+
+	// total memory used by this model
+	model->usedMemory = model->numVertices * sizeof(cm_vertex_t) +
+						model->numEdges * sizeof(cm_edge_t) +
+						model->polygonMemory +
+						model->brushMemory +
+						model->numNodes * sizeof(cm_node_t) +
+						model->numPolygonRefs * sizeof(cm_polygonRef_t) +
+						model->numBrushRefs * sizeof(cm_brushRef_t);
+
+	return true;
+
+failed:
+	// everything is block allocated so the model can be freed without walking the tree
+	model->node = NULL;
+	FreeModel( model );
+	numModels--;
+	models[numModels] = NULL;
+	return false;
+}
+
+/*
+================
+idCollisionModelManagerLocal::LoadBinaryCollisionModelFile
+================
+*/
+bool idCollisionModelManagerLocal::LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC ) {
+	idStr fileName, sourceName;
+	void *buffer;
+	int i, length, firstModel;
+	ID_TIME_T sourceTime;
+	const cmbHeader_t *header;
+	const byte *data;
+	idList<const idMaterial *> materials;
+	cmbCursor_t cursor;
+
+	fileName = CMB_FILE_DIR;
+	fileName += name;
+	fileName.SetFileExtension( CMB_FILE_EXT );
+
+	length = fileSystem->ReadFile( fileName, &buffer );
+	if ( length <= 0 || !buffer ) {
+		return false;
+	}
+
+	cursor.ptr = (const byte *) buffer;
+	cursor.end = cursor.ptr + length;
+
+	header = (const cmbHeader_t *) CM_BinaryData( cursor, sizeof( cmbHeader_t ) );
+	if ( !header || header->ident != CMB_FILEID || header->version != CMB_FILEVERSION ||
+			header->pointerSize != sizeof( void * ) || header->edgeSize != sizeof( cm_edge_t ) ||
+			header->polygonSize != sizeof( cm_polygon_t ) || header->brushSize != sizeof( cm_brush_t ) ||
+			header->nodeSize != sizeof( cm_node_t ) ) {
+		common->Printf( "%s has a different version or layout\n", fileName.c_str() );
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	if ( mapFileCRC && header->mapFileCRC != mapFileCRC ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	// the cache is stale when the .cm file it was written for changed
+	sourceName = name;
+	sourceName.SetFileExtension( CM_FILE_EXT );
+	fileSystem->ReadFile( sourceName, NULL, &sourceTime );
+	if ( sourceTime != FILE_NOT_FOUND_TIMESTAMP && sourceTime != header->sourceTime ) {
+		common->Printf( "%s is out of date\n", fileName.c_str() );
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	// material table
+	materials.SetNum( header->numMaterials < 0 ? 0 : header->numMaterials );
+	for ( i = 0; i < materials.Num(); i++ ) {
+		data = CM_BinaryData( cursor, sizeof( int ) );
+		if ( !data ) {
+			break;
+		}
+		length = *(const int *) data;
+		data = CM_BinaryData( cursor, ( length + 3 ) & ~3 );
+		if ( !data ) {
+			break;
+		}
+		idStr materialName;
+		materialName.Append( (const char *) data, length );
+		materials[i] = declManager->FindMaterial( materialName );
+	}
+
+	firstModel = numModels;
+	if ( i < materials.Num() ) {
+		i = 0;
+	} else {
+		for ( i = 0; i < header->numModels; i++ ) {
+			if ( !LoadBinaryCollisionModel( cursor, materials ) ) {
+				break;
+			}
+		}
+	}
+
+	if ( i < header->numModels || header->numModels < 0 ) {
+		common->Warning( "%s is corrupt", fileName.c_str() );
+		while( numModels > firstModel ) {
+			numModels--;
+			FreeModel( models[numModels] );
+			models[numModels] = NULL;
+		}
+		fileSystem->FreeFile( buffer );
+		return false;
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	return true;
+}
+
+/*
+================
+idCollisionModelManagerLocal::CompareCollisionModelFiles
+
+  parses the .cm file after the models were loaded from the binary cache
+  and reports the load times and any differences between the models
+================
+*/
+void idCollisionModelManagerLocal::CompareCollisionModelFiles( const char *name, unsigned int mapFileCRC, int firstModel, double binaryMsec ) {
+	int i, lastModel, numDifferent;
+	idTimer timer;
+
+	lastModel = numModels;
+
+	timer.Start();
+	if ( !ParseCollisionModelFile( name, mapFileCRC ) ) {
+		common->Printf( "%s: %.1f msec to load the binary cache, no .cm file to compare with\n", name, binaryMsec );
+		return;
+	}
+	timer.Stop();
+
+	numDifferent = 0;
+	if ( numModels - lastModel != lastModel - firstModel ) {
+		common->Warning( "%s: binary cache has %d models, .cm file has %d", name, lastModel - firstModel, numModels - lastModel );
+		numDifferent++;
+	} else {
+		for ( i = 0; i < lastModel - firstModel; i++ ) {
+			const cm_model_t *binary = models[firstModel + i];
+			const cm_model_t *text = models[lastModel + i];
+			if ( binary->name.Icmp( text->name ) != 0 ||
+					binary->numVertices != text->numVertices ||
+					binary->numEdges != text->numEdges ||
+					binary->numNodes != text->numNodes ||
+					binary->numPolygons != text->numPolygons ||
+					binary->numBrushes != text->numBrushes ||
+					binary->contents != text->contents ||
+					!binary->bounds.Compare( text->bounds, 0.1f ) ) {
+				common->Warning( "%s: model '%s' differs between the binary cache and the .cm file", name, text->name.c_str() );
+				numDifferent++;
+			}
+		}
+	}
+
+	// free the models parsed from the .cm file
+	while( numModels > lastModel ) {
+		numModels--;
+		FreeModel( models[numModels] );
+		models[numModels] = NULL;
+	}
+
+	common->Printf( "%s: %.1f msec to load the binary cache, %.1f msec to parse the .cm file (%.1fx), %d models differ\n",
+					name, binaryMsec, timer.Milliseconds(), binaryMsec > 0.0 ? timer.Milliseconds() / binaryMsec : 0.0, numDifferent );
+}
@@ -183,15 +183,9 @@ void idCollisionModelManagerLocal::Clear( void ) {
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
-	memset( trmPolygons, 0, sizeof( trmPolygons ) );
-	trmBrushes[0] = NULL;
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -297,7 +291,9 @@ idCollisionModelManagerLocal::FreePolygon
 void idCollisionModelManagerLocal::FreePolygon( cm_model_t *model, cm_polygon_t *poly ) {
 	model->numPolygons--;
 	model->polygonMemory -= sizeof( cm_polygon_t ) + ( poly->numEdges - 1 ) * sizeof( poly->edges[0] );
-	if ( model->polygonBlock == NULL ) {
+	// polygons that didn't fit in the block are allocated separately
+	if ( model->polygonBlock == NULL || (byte *) poly < (byte *) model->polygonBlock ||
+			(byte *) poly >= model->polygonBlock->next + model->polygonBlock->bytesRemaining ) {
 		Mem_Free( poly );
 	}
 }
@@ -310,7 +306,9 @@ idCollisionModelManagerLocal::FreeBrush
 void idCollisionModelManagerLocal::FreeBrush( cm_model_t *model, cm_brush_t *brush ) {
 	model->numBrushes--;
 	model->brushMemory -= sizeof( cm_brush_t ) + ( brush->numPlanes - 1 ) * sizeof( brush->planes[0] );
-	if ( model->brushBlock == NULL ) {
+	// brushes that didn't fit in the block are allocated separately
+	if ( model->brushBlock == NULL || (byte *) brush < (byte *) model->brushBlock ||
+			(byte *) brush >= model->brushBlock->next + model->brushBlock->bytesRemaining ) {
 		Mem_Free( brush );
 	}
 }
@@ -387,6 +385,10 @@ void idCollisionModelManagerLocal::FreeModel( cm_model_t *model ) {
 		nextNodeBlock = nodeBlock->next;
 		Mem_Free( nodeBlock );
 	}
+	// free the check counts of the trace contexts
+	for ( int i = 0; i < MAX_TRACE_CONTEXTS; i++ ) {
+		Mem_Free( model->checkTables[i] );
+	}
 	// free block allocated polygons
 	Mem_Free( model->polygonBlock );
 	// free block allocated brushes
@@ -419,7 +421,9 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 		FreeModel( models[i] );
 	}
 
-	FreeTrmModelStructure();
+	for ( i = 0; i < MAX_TRACE_CONTEXTS; i++ ) {
+		FreeTrmModelStructure( &traceContexts[i] );
+	}
 
 	Mem_Free( models );
 
@@ -433,22 +437,27 @@ void idCollisionModelManagerLocal::FreeMap( void ) {
 idCollisionModelManagerLocal::FreeTrmModelStructure
 ================
 */
-void idCollisionModelManagerLocal::FreeTrmModelStructure( void ) {
+void idCollisionModelManagerLocal::FreeTrmModelStructure( cm_traceContext_t *context ) {
 	int i;
+	cm_model_t *model;
 
-	assert( models );
-	if ( !models[MAX_SUBMODELS] ) {
+	model = context->trmModel;
+	if ( !model ) {
 		return;
 	}
 
 	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
-		FreePolygon( models[MAX_SUBMODELS], trmPolygons[i]->p );
+		FreePolygon( model, context->trmPolygons[i]->p );
 	}
-	FreeBrush( models[MAX_SUBMODELS], trmBrushes[0]->b );
+	FreeBrush( model, context->trmBrushes[0]->b );
 
-	models[MAX_SUBMODELS]->node->polygons = NULL;
-	models[MAX_SUBMODELS]->node->brushes = NULL;
-	FreeModel( models[MAX_SUBMODELS] );
+	model->node->polygons = NULL;
+	model->node->brushes = NULL;
+	FreeModel( model );
+
+	context->trmModel = NULL;
+	memset( context->trmPolygons, 0, sizeof( context->trmPolygons ) );
+	context->trmBrushes[0] = NULL;
 }
 
 
@@ -553,6 +562,9 @@ cm_model_t *idCollisionModelManagerLocal::AllocModel( void ) {
 	model->brushRefBlocks = NULL;
 	model->polygonBlock = NULL;
 	model->brushBlock = NULL;
+	model->numPolygonChecks = 0;
+	model->numBrushChecks = 0;
+	memset( model->checkTables, 0, sizeof( model->checkTables ) );
 	model->numPolygons = model->polygonMemory =
 	model->numBrushes = model->brushMemory =
 	model->numNodes = model->numBrushRefs =
@@ -670,6 +682,7 @@ cm_polygon_t *idCollisionModelManagerLocal::AllocPolygon( cm_model_t *model, int
 	} else {
 		poly = (cm_polygon_t *) Mem_Alloc( size );
 	}
+	poly->checkNum = model->numPolygonChecks++;
 	return poly;
 }
 
@@ -692,6 +705,7 @@ cm_brush_t *idCollisionModelManagerLocal::AllocBrush( cm_model_t *model, int num
 	} else {
 		brush = (cm_brush_t *) Mem_Alloc( size );
 	}
+	brush->checkNum = model->numBrushChecks++;
 	return brush;
 }
 
@@ -730,16 +744,19 @@ void idCollisionModelManagerLocal::AddBrushToNode( cm_model_t *model, cm_node_t
 idCollisionModelManagerLocal::SetupTrmModelStructure
 ================
 */
-void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
+void idCollisionModelManagerLocal::SetupTrmModelStructure( cm_traceContext_t *context ) {
 	int i;
 	cm_node_t *node;
 	cm_model_t *model;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 
 	// setup model
 	model = AllocModel();
 
-	assert( models );
-	models[MAX_SUBMODELS] = model;
+	context->trmModel = model;
+	trmPolygons = context->trmPolygons;
+	trmBrushes = context->trmBrushes;
 	// create node to hold the collision data
 	node = (cm_node_t *) AllocNode( model, 1 );
 	node->planeType = -1;
@@ -751,11 +768,6 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure( void ) {
 	model->numEdges = 0;
 	model->maxEdges = MAX_TRACEMODEL_EDGES+1;
 	model->edges = (cm_edge_t *) Mem_ClearedAlloc( model->maxEdges * sizeof(cm_edge_t) );
-	// create a material for the trace model polygons
-	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
-	if ( !trmMaterial ) {
-		common->FatalError( "_tracemodel material not found" );
-	}
 
 	// allocate polygons
 	for ( i = 0; i < MAX_TRACEMODEL_POLYS; i++ ) {
@@ -792,6 +804,9 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	cm_edge_t *edge;
 	cm_polygon_t *poly;
 	cm_model_t *model;
+	cm_traceContext_t *context;
+	cm_polygonRef_t **trmPolygons;
+	cm_brushRef_t **trmBrushes;
 	const traceModelVert_t *trmVert;
 	const traceModelEdge_t *trmEdge;
 	const traceModelPoly_t *trmPoly;
@@ -802,7 +817,11 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		material = trmMaterial;
 	}
 
-	model = models[MAX_SUBMODELS];
+	// every thread has its own trace model
+	context = GetTraceContext();
+	model = GetContextModel( context, TRACE_MODEL_HANDLE );
+	trmPolygons = context->trmPolygons;
+	trmBrushes = context->trmBrushes;
 	model->node->brushes = NULL;
 	model->node->polygons = NULL;
 	// if not a valid trace model
@@ -815,7 +834,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 	trmVert = trm.verts;
 	for ( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ ) {
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -826,7 +844,6 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
@@ -868,6 +885,118 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel &trm,
 /*
 ===============================================================================
 
+Trace contexts
+
+===============================================================================
+*/
+
+#ifdef ID_THREAD_LOCAL
+static ID_THREAD_LOCAL cm_traceContext_t *cm_currentTraceContext;
+#endif
+
+/*
+================
+idCollisionModelManagerLocal::GetTraceContext
+
+  returns the trace context of the calling thread
+================
+*/
+cm_traceContext_t *idCollisionModelManagerLocal::GetTraceContext( void ) {
+#ifdef ID_THREAD_LOCAL
+	cm_traceContext_t *context;
+	int contextNum;
+
+	context = cm_currentTraceContext;
+	if ( context == NULL ) {
+		contextNum = numTraceContexts.Increment() - 1;
+		if ( contextNum >= MAX_TRACE_CONTEXTS ) {
+			common->FatalError( "idCollisionModelManagerLocal::GetTraceContext: more than %d threads run collision queries", MAX_TRACE_CONTEXTS );
+		}
+		context = &traceContexts[contextNum];
+		context->contextNum = contextNum;
+		cm_currentTraceContext = context;
+	}
+	return context;
+#else
+	// without thread local storage all collision queries have to come from the same thread
+	return &traceContexts[0];
+#endif
+}
+
+/*
+================
+idCollisionModelManagerLocal::GetContextModel
+
+  the trace model handle refers to the trace model of the context
+================
+*/
+cm_model_t *idCollisionModelManagerLocal::GetContextModel( cm_traceContext_t *context, cmHandle_t model ) {
+	if ( model == TRACE_MODEL_HANDLE ) {
+		if ( !context->trmModel && models ) {
+			SetupTrmModelStructure( context );
+		}
+		return context->trmModel;
+	}
+	return models[model];
+}
+
+/*
+================
+idCollisionModelManagerLocal::AllocCheckTable
+================
+*/
+cm_checkTable_t *idCollisionModelManagerLocal::AllocCheckTable( cm_model_t *model, int contextNum ) {
+	cm_checkTable_t *checks;
+	byte *ptr;
+	int size;
+
+	size = sizeof( cm_checkTable_t ) +
+			( model->maxVertices + model->maxEdges ) * sizeof( cm_sideCheck_t ) +
+			( model->numPolygonChecks + model->numBrushChecks ) * sizeof( int );
+	ptr = (byte *) Mem_ClearedAlloc( size );
+
+	checks = (cm_checkTable_t *) ptr;
+	ptr += sizeof( cm_checkTable_t );
+	checks->vertices = (cm_sideCheck_t *) ptr;
+	ptr += model->maxVertices * sizeof( cm_sideCheck_t );
+	checks->edges = (cm_sideCheck_t *) ptr;
+	ptr += model->maxEdges * sizeof( cm_sideCheck_t );
+	checks->polygons = (int *) ptr;
+	ptr += model->numPolygonChecks * sizeof( int );
+	checks->brushes = (int *) ptr;
+
+	model->checkTables[contextNum] = checks;
+	return checks;
+}
+
+/*
+================
+idCollisionModelManagerLocal::SetupTraceWork
+
+  starts a new query with the check counts of the context for the model
+================
+*/
+void idCollisionModelManagerLocal::SetupTraceWork( cm_traceWork_t *tw, cm_traceContext_t *context, cm_model_t *model ) {
+	cm_checkTable_t *checks;
+
+	checks = model->checkTables[context->contextNum];
+	if ( !checks ) {
+		checks = AllocCheckTable( model, context->contextNum );
+	}
+
+	context->checkCount++;
+
+	tw->model = model;
+	tw->checkCount = context->checkCount;
+	tw->vertexChecks = checks->vertices;
+	tw->edgeChecks = checks->edges;
+	tw->polygonChecks = checks->polygons;
+	tw->brushChecks = checks->brushes;
+}
+
+/*
+===============================================================================
+
 Optimisation, removal of polygons contained within brushes or solid
 
 ===============================================================================
@@ -2311,7 +2440,6 @@ int idCollisionModelManagerLocal::GetVertex( cm_model_t *model, const idVec3 &v,
 		cm_vertexHash->ResizeIndex( model->maxVertices );
 	}
 	model->vertices[model->numVertices].p = vert;
-	model->vertices[model->numVertices].checkcount = 0;
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add( hashKey, model->numVertices );
@@ -3254,12 +3382,12 @@ void idCollisionModelManagerLocal::ModelInfo( cmHandle_t model ) {
 		common->Printf( "idCollisionModelManagerLocal::ModelInfo: invalid model handle\n" );
 		return;
 	}
-	if ( !models[model] ) {
+	if ( !GetContextModel( GetTraceContext(), model ) ) {
 		common->Printf( "idCollisionModelManagerLocal::ModelInfo: invalid model\n" );
 		return;
 	}
 
-	PrintModelInfo( models[model] );
+	PrintModelInfo( GetContextModel( GetTraceContext(), model ) );
 }
 
 /*
@@ -3367,8 +3495,11 @@ void idCollisionModelManagerLocal::LoadMap( const idMapFile *mapFile ) {
 	// setup hash to speed up finding shared vertices and edges
 	SetupHash();
 
-	// setup trace model structure
-	SetupTrmModelStructure();
+	// material for the trace model polygons, the trace model structures are set up per trace context
+	trmMaterial = declManager->FindMaterial( "_tracemodel", false );
+	if ( !trmMaterial ) {
+		common->FatalError( "_tracemodel material not found" );
+	}
 
 	// build collision models
 	BuildModels( mapFile );
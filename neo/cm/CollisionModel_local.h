@@ -44,6 +44,8 @@ If you have questions concerning this license or the applicable additional terms
 #define	MAX_SUBMODELS						2048
 #define	TRACE_MODEL_HANDLE					MAX_SUBMODELS
 
+#define MAX_TRACE_CONTEXTS					16		// threads that can run collision queries
+
 #define VERTEX_HASH_BOXSIZE					(1<<6)	// must be power of 2
 #define VERTEX_HASH_SIZE					(VERTEX_HASH_BOXSIZE*VERTEX_HASH_BOXSIZE)
 #define EDGE_HASH_SIZE						(1<<14)
@@ -80,17 +82,12 @@ Collision model
 
 typedef struct cm_vertex_s {
 	idVec3					p;					// vertex point
-	int						checkcount;			// for multi-check avoidance
-	unsigned long			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
 } cm_vertex_t;
 
 typedef struct cm_edge_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building and drawing models
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	unsigned long			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned long			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -102,7 +99,8 @@ typedef struct cm_polygonBlock_s {
 
 typedef struct cm_polygon_s {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building and writing models
+	int						checkNum;			// index into the check counts of a trace context
 	int						contents;			// contents behind polygon
 	const idMaterial *		material;			// material
 	idPlane					plane;				// polygon plane
@@ -126,7 +124,8 @@ typedef struct cm_brushBlock_s {
 } cm_brushBlock_t;
 
 typedef struct cm_brush_s {
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount;			// for multi-check avoidance while building and writing models
+	int						checkNum;			// index into the check counts of a trace context
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial *		material;			// material
@@ -178,6 +177,10 @@ typedef struct cm_model_s {
 	cm_brushRefBlock_t *	brushRefBlocks;		// list with blocks of brush references
 	cm_polygonBlock_t *		polygonBlock;		// memory block with all polygons
 	cm_brushBlock_t *		brushBlock;			// memory block with all brushes
+	// collision queries
+	int						numPolygonChecks;	// number of polygon check numbers handed out
+	int						numBrushChecks;		// number of brush check numbers handed out
+	struct cm_checkTable_s *checkTables[MAX_TRACE_CONTEXTS];	// per trace context, allocated on first use
 	// statistics
 	int						numPolygons;
 	int						polygonMemory;
@@ -201,6 +204,19 @@ Data used during collision detection calculations
 ===============================================================================
 */
 
+typedef struct cm_sideCheck_s {
+	int						checkcount;			// for multi-check avoidance
+	unsigned long			side;				// each bit tells at which side the vertex or edge passes one of the trace model edges or vertices
+	unsigned long			sideSet;			// each bit tells if sidedness for the trace model edge or vertex has been calculated yet
+} cm_sideCheck_t;
+
+typedef struct cm_checkTable_s {
+	cm_sideCheck_t *		vertices;			// indexed like cm_model_t->vertices
+	cm_sideCheck_t *		edges;				// indexed like cm_model_t->edges
+	int *					polygons;			// indexed with cm_polygon_t->checkNum
+	int *					brushes;			// indexed with cm_brush_t->checkNum
+} cm_checkTable_t;
+
 typedef struct cm_trmVertex_s {
 	int used;										// true if this vertex is used for collision detection
 	idVec3 p;										// vertex position
@@ -239,6 +255,11 @@ typedef struct cm_traceWork_s {
 	int numPolys;
 	cm_trmPolygon_t polys[MAX_TRACEMODEL_POLYS];	// trm polygons
 	cm_model_t *model;								// model colliding with
+	int checkCount;									// for multi-check avoidance
+	cm_sideCheck_t *vertexChecks;					// model vertex check counts and sidedness of the trace context
+	cm_sideCheck_t *edgeChecks;						// model edge check counts and sidedness of the trace context
+	int *polygonChecks;								// model polygon check counts of the trace context
+	int *brushChecks;								// model brush check counts of the trace context
 	idVec3 start;									// start of trace
 	idVec3 end;										// end of trace
 	idVec3 dir;										// trace direction
@@ -280,6 +301,33 @@ typedef struct cm_traceWork_s {
 /*
 ===============================================================================
 
+Trace context
+
+Everything a collision query changes lives in the trace context of the
+calling thread, so queries can run concurrently as long as no models are
+loaded or freed at the same time.
+
+===============================================================================
+*/
+
+typedef struct cm_traceContext_s {
+	ALIGN16( cm_traceWork_t	tw );				// work space for translations and rotations
+	int						contextNum;			// index into cm_model_t->checkTables
+	int						checkCount;			// for multi-check avoidance
+	cm_model_t *			trmModel;			// model for the trace model set up with SetupTrmModel
+	cm_polygonRef_t *		trmPolygons[MAX_TRACEMODEL_POLYS];
+	cm_brushRef_t *			trmBrushes[1];
+	bool					getContacts;		// for retrieving contact points
+	contactInfo_t *			contacts;
+	int						maxContacts;
+	int						numContacts;
+	bool					debugTranslation;	// cm_debugCollision is re-running a translation
+	bool					debugRotation;		// cm_debugCollision is re-running a rotation
+} cm_traceContext_t;
+
+/*
+===============================================================================
+
 Collision Map
 
 ===============================================================================
@@ -401,7 +449,7 @@ private:			// CollisionMap_trace.cpp
 
 private:			// CollisionMap_load.cpp
 	void			Clear( void );
-	void			FreeTrmModelStructure( void );
+	void			FreeTrmModelStructure( cm_traceContext_t *context );
 					// model deallocation
 	void			RemovePolygonReferences_r( cm_node_t *node, cm_polygon_t *p );
 	void			RemoveBrushReferences_r( cm_node_t *node, cm_brush_t *b );
@@ -441,7 +489,12 @@ private:			// CollisionMap_load.cpp
 	cm_brush_t *	AllocBrush( cm_model_t *model, int numPlanes );
 	void			AddPolygonToNode( cm_model_t *model, cm_node_t *node, cm_polygon_t *p );
 	void			AddBrushToNode( cm_model_t *model, cm_node_t *node, cm_brush_t *b );
-	void			SetupTrmModelStructure( void );
+	void			SetupTrmModelStructure( cm_traceContext_t *context );
+					// trace contexts
+	cm_traceContext_t *GetTraceContext( void );
+	cm_model_t *	GetContextModel( cm_traceContext_t *context, cmHandle_t model );
+	void			SetupTraceWork( cm_traceWork_t *tw, cm_traceContext_t *context, cm_model_t *model );
+	cm_checkTable_t *AllocCheckTable( cm_model_t *model, int contextNum );
 	void			R_FilterPolygonIntoTree( cm_model_t *model, cm_node_t *node, cm_polygonRef_t *pref, cm_polygon_t *p );
 	void			R_FilterBrushIntoTree( cm_model_t *model, cm_node_t *node, cm_brushRef_t *pref, cm_brush_t *b );
 	cm_node_t *		R_CreateAxialBSPTree( cm_model_t *model, cm_node_t *node, const idBounds &bounds );
@@ -488,7 +541,14 @@ private:			// CollisionMap_files.cpp
 	void			ParsePolygons( idLexer *src, cm_model_t *model );
 	void			ParseBrushes( idLexer *src, cm_model_t *model );
 	bool			ParseCollisionModel( idLexer *src );
+	bool			ParseCollisionModelFile( const char *name, unsigned int mapFileCRC );
 	bool			LoadCollisionModelFile( const char *name, unsigned int mapFileCRC );
+					// binary cache
+	void			WriteBinaryCollisionModel( idFile *fp, cm_model_t *model, const idList<const idMaterial *> &materials );
+	void			WriteBinaryCollisionModelsToFile( const char *filename, int firstModel, int lastModel, unsigned int mapFileCRC );
+	bool			LoadBinaryCollisionModel( struct cmbCursor_s &cursor, const idList<const idMaterial *> &materials );
+	bool			LoadBinaryCollisionModelFile( const char *name, unsigned int mapFileCRC );
+	void			CompareCollisionModelFiles( const char *name, unsigned int mapFileCRC, int firstModel, double binaryMsec );
 
 private:			// CollisionMap_debug
 	int				ContentsFromString( const char *string ) const;
@@ -509,18 +569,14 @@ private:			// collision map data
 	int				maxModels;
 	int				numModels;
 	cm_model_t **	models;
-					// polygons and brush for trm model
-	cm_polygonRef_t*trmPolygons[MAX_TRACEMODEL_POLYS];
-	cm_brushRef_t *	trmBrushes[1];
+					// material for trm model polygons
 	const idMaterial *trmMaterial;
 					// for data pruning
 	int				numProcNodes;
 	cm_procNode_t *	procNodes;
-					// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t *	contacts;
-	int				maxContacts;
-	int				numContacts;
+					// per thread query state
+	cm_traceContext_t traceContexts[MAX_TRACE_CONTEXTS];
+	idSysInterlockedInteger numTraceContexts;
 };
 
 // for debugging
@@ -863,6 +863,7 @@ bool idAF::Load( idEntity *ent, const char *fileName ) {
 	physicsObj.SetSuspendTolerance( file->noMoveTime, file->noMoveTranslation, file->noMoveRotation );
 	physicsObj.SetSuspendTime( file->minMoveTime, file->maxMoveTime );
 	physicsObj.SetSelfCollision( file->selfCollision );
+	physicsObj.SetSolver( file->solver, file->solverIterations );
 
 	// clear the list with transforms from joints to bodies
 	jointMods.SetNum( 0, false );
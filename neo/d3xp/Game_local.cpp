@@ -46,6 +46,8 @@ idUserInterfaceManager *	uiManager = NULL;
 idDeclManager *				declManager = NULL;
 idAASFileManager *			AASFileManager = NULL;
 idCollisionModelManager *	collisionModelManager = NULL;
+idParallelJobManager *		parallelJobManager = NULL;
+idProfiler *					profiler = NULL;
 idCVar *					idCVar::staticVars = NULL;
 
 idCVar com_forceGenericSIMD( "com_forceGenericSIMD", "0", CVAR_BOOL|CVAR_SYSTEM, "force generic platform independent SIMD" );
@@ -60,6 +62,9 @@ static gameExport_t			gameExport;
 // global animation lib
 idAnimManager				animationLib;
 
+// joints decoded from anims during the current frame
+idAnimPoseCache				animPoseCache;
+
 // the rest of the engine will only reference the "game" variable, while all local aspects stay hidden
 idGameLocal					gameLocal;
 idGame *					game = &gameLocal;	// statically pointed at an idGameLocal
@@ -136,6 +141,8 @@ extern "C" gameExport_t *GetGameAPI( gameImport_t *import ) {
 		declManager					= import->declManager;
 		AASFileManager				= import->AASFileManager;
 		collisionModelManager		= import->collisionModelManager;
+		parallelJobManager			= import->parallelJobManager;
+		profiler					= import->profiler;
 	}
 
 	// set interface pointers used by idLib
@@ -177,6 +184,8 @@ void TestGameAPI( void ) {
 	testImport.declManager				= ::declManager;
 	testImport.AASFileManager			= ::AASFileManager;
 	testImport.collisionModelManager	= ::collisionModelManager;
+	testImport.parallelJobManager		= ::parallelJobManager;
+	testImport.profiler					= ::profiler;
 
 	testExport = *GetGameAPI( &testImport );
 }
@@ -226,6 +235,8 @@ void idGameLocal::Clear( void ) {
 	sessionCommand.Clear();
 	locationEntities = NULL;
 	smokeParticles = NULL;
+	afJobList = NULL;
+	animJobList = NULL;
 	editEntities = NULL;
 	entityHash.Clear( 1024, MAX_GENTITIES );
 	inCinematic = false;
@@ -333,6 +344,8 @@ void idGameLocal::Init( void ) {
 
 	Clear();
 
+	Mem_InitFrameArena( g_frameArenaSize.GetInteger() * 1024 );
+
 	idEvent::Init();
 	idClass::Init();
 
@@ -375,6 +388,9 @@ void idGameLocal::Init( void ) {
 
 	smokeParticles = new idSmokeParticles;
 
+	afJobList = parallelJobManager->AllocJobList( "articulatedFigures" );
+	animJobList = parallelJobManager->AllocJobList( "entityAnimations" );
+
 	// set up the aas
 	dict = FindEntityDefDict( "aas_types" );
 	if ( !dict ) {
@@ -432,6 +448,13 @@ void idGameLocal::Shutdown( void ) {
 	delete smokeParticles;
 	smokeParticles = NULL;
 
+	parallelJobManager->FreeJobList( afJobList );
+	afJobList = NULL;
+	parallelJobManager->FreeJobList( animJobList );
+	animJobList = NULL;
+	checkAnims.Clear();
+	checkAnimJoints.Clear();
+
 	idClass::Shutdown();
 
 	// clear list with forces
@@ -452,6 +475,8 @@ void idGameLocal::Shutdown( void ) {
 	// free memory allocated by class objects
 	Clear();
 
+	Mem_ShutdownFrameArena();
+
 	// shut down the animation manager
 	animationLib.Shutdown();
 
@@ -2386,6 +2411,332 @@ void idGameLocal::RunTimeGroup2() {
 }
 #endif
  
+/*
+================
+idGameLocal::IsParallelArticulatedFigure
+
+  Returns true if the entity is a ragdoll that starts thinking by running its physics
+  and the figure can be evaluated by idPhysics_AF::EvaluateIslands.
+================
+*/
+bool idGameLocal::IsParallelArticulatedFigure( idEntity *ent ) const {
+	idEntity *part;
+
+	if ( !( ent->thinkFlags & TH_PHYSICS ) ) {
+		return false;
+	}
+	if ( !ent->IsType( idAFEntity_Generic::Type ) && !ent->IsType( idAFEntity_WithAttachedHead::Type ) ) {
+		return false;
+	}
+#ifdef _D3XP
+	// the figure has to think in the normal time group
+	if ( ent->timeGroup != TIME_GROUP1 ) {
+		return false;
+	}
+#endif
+	if ( ent->GetTeamMaster() != NULL && ent->GetTeamMaster() != ent ) {
+		return false;
+	}
+	if ( !ent->GetPhysics()->IsType( idPhysics_AF::Type ) ) {
+		return false;
+	}
+	if ( !static_cast<idPhysics_AF *>( ent->GetPhysics() )->CanEvaluateInParallel() ) {
+		return false;
+	}
+	// a blocked team part would need the figure to move back to where it was
+	for ( part = ent->GetNextTeamEntity(); part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( part->GetPhysics()->IsType( idPhysics_Parametric::Type ) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idGameLocal::EvaluateArticulatedFigures
+
+  Evaluates the physics of the figures for the given frame.  The physics of
+  each figure remembers the result so the evaluation is skipped when the
+  entity runs its physics for the same frame.
+================
+*/
+void idGameLocal::EvaluateArticulatedFigures( idEntity **figures, int numFigures, int timeStepMSec, int endTimeMSec ) {
+	int i;
+	idEntity *part;
+	idList<idPhysics_AF *, idListFrameAllocator<idPhysics_AF *> > physics;
+
+	physics.SetNum( numFigures );
+	for ( i = 0; i < numFigures; i++ ) {
+		physics[i] = static_cast<idPhysics_AF *>( figures[i]->GetPhysics() );
+	}
+
+	// disable the teams for collision detection the same way idEntity::RunPhysics does
+	for ( i = 0; i < numFigures; i++ ) {
+		for ( part = figures[i]; part != NULL; part = part->GetNextTeamEntity() ) {
+			if ( !part->fl.solidForTeam ) {
+				part->GetPhysics()->DisableClip();
+			}
+		}
+	}
+
+	idPhysics_AF::EvaluateIslands( physics.Ptr(), numFigures, timeStepMSec, endTimeMSec, afJobList );
+
+	for ( i = 0; i < numFigures; i++ ) {
+		for ( part = figures[i]; part != NULL; part = part->GetNextTeamEntity() ) {
+			if ( !part->fl.solidForTeam ) {
+				part->GetPhysics()->EnableClip();
+			}
+		}
+	}
+}
+
+/*
+================
+idGameLocal::RunArticulatedFigures
+================
+*/
+void idGameLocal::RunArticulatedFigures( void ) {
+	idEntity *ent;
+	idList<idEntity *, idListFrameAllocator<idEntity *> > figures;
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
+			continue;
+		}
+		if ( IsParallelArticulatedFigure( ent ) ) {
+			figures.Append( ent );
+		}
+	}
+
+	if ( figures.Num() > 1 ) {
+		EvaluateArticulatedFigures( figures.Ptr(), figures.Num(), time - previousTime, time );
+	}
+}
+
+/*
+================
+idGameLocal::IsParallelAnimation
+
+  Returns true if the animation frame of the entity only depends on the entity itself
+  and the game time.  Entities bound to each other are always part of the same team
+  and the frames of a team are created in order on a single job thread.
+================
+*/
+bool idGameLocal::IsParallelAnimation( idEntity *ent ) const {
+	idAnimator *animator;
+
+	animator = ent->GetAnimator();
+	if ( !animator || !animator->ModelHandle() ) {
+		return false;
+	}
+	if ( ent->IsHidden() ) {
+		return false;
+	}
+#ifdef _D3XP
+	if ( ent->timeGroup != TIME_GROUP1 ) {
+		// animated with the time of another time group
+		return false;
+	}
+#endif
+	if ( g_debugAnim.GetInteger() == ent->entityNumber || g_debugAnim.GetInteger() == -2 ) {
+		// the debug output is printed from the main thread only
+		return false;
+	}
+	return true;
+}
+
+/*
+================
+CreateTeamAnimationsJob
+
+  Creates the animation frames of all entities in the team for the current game time.
+================
+*/
+static void CreateTeamAnimationsJob( void *data ) {
+	idEntity *part;
+
+	for ( part = static_cast<idEntity *>( data ); part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( gameLocal.IsParallelAnimation( part ) ) {
+			part->GetAnimator()->CreateFrame( gameLocal.time, false );
+		}
+	}
+}
+
+/*
+================
+idGameLocal::RunEntityAnimations
+
+  Creates the animation frames of the animating entities on the job threads ahead of
+  the entity think.  Entities query their joints while thinking and the renderer does
+  when the model is updated, both of which then use the frame created here unless the
+  animation changed in the mean time.  Scripts, events and physics stay on the main thread.
+================
+*/
+void idGameLocal::RunEntityAnimations( void ) {
+	int i, j, numJoints;
+	idEntity *ent, *part;
+	idJointMat *joints;
+	idList<idEntity *, idListFrameAllocator<idEntity *> > teams;
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
+			continue;
+		}
+		if ( !( ent->thinkFlags & TH_ANIMATE ) || !IsParallelAnimation( ent ) ) {
+			continue;
+		}
+		teams.AddUnique( ent->GetTeamMaster() ? ent->GetTeamMaster() : ent );
+	}
+
+	if ( teams.Num() < 2 ) {
+		return;
+	}
+
+	checkAnims.Clear();
+	checkAnimJoints.Clear();
+
+	if ( g_parallelThinkCheck.GetBool() ) {
+		// remember the frame numbers to find the frames created by the jobs
+		for ( i = 0; i < teams.Num(); i++ ) {
+			for ( part = teams[i]; part != NULL; part = part->GetNextTeamEntity() ) {
+				if ( !IsParallelAnimation( part ) ) {
+					continue;
+				}
+				animCheck_t &check = checkAnims.Alloc();
+				check.ent = part;
+				check.frameNumber = part->GetAnimator()->GetFrameNumber();
+				check.firstJoint = 0;
+				check.numJoints = 0;
+			}
+		}
+	}
+
+	for ( i = 0; i < teams.Num(); i++ ) {
+		animJobList->AddJob( CreateTeamAnimationsJob, teams[i] );
+	}
+	animJobList->Submit();
+	animJobList->Wait();
+
+	// remember the frames created by the jobs to compare them with a serial update after the entity think
+	for ( i = 0; i < checkAnims.Num(); i++ ) {
+		animCheck_t &check = checkAnims[i];
+		idAnimator *animator = check.ent.GetEntity()->GetAnimator();
+		if ( animator->GetFrameNumber() == check.frameNumber ) {
+			checkAnims.RemoveIndex( i-- );
+			continue;
+		}
+		animator->GetJoints( &numJoints, &joints );
+		check.frameNumber = animator->GetFrameNumber();
+		check.firstJoint = checkAnimJoints.Num();
+		check.numJoints = numJoints;
+		for ( j = 0; j < numJoints; j++ ) {
+			checkAnimJoints.Append( joints[j] );
+		}
+	}
+}
+
+/*
+================
+idGameLocal::RunMonsterRoutes
+
+  Calculates the routes the moving monsters look for this frame on the job
+  threads ahead of the entity think.  The monsters still create their paths
+  while they think, but the routes towards their goal areas are then found
+  in the routing cache instead of being calculated on the main thread.
+  The routing results don't depend on the cache, so neither does the game.
+================
+*/
+void idGameLocal::RunMonsterRoutes( void ) {
+	int i, j;
+	idEntity *ent;
+	idAI *monster;
+	aasRoute_t route;
+	idList<aasRoute_t, idListFrameAllocator<aasRoute_t> > routes;
+	idList<idAAS *, idListFrameAllocator<idAAS *> > routeAAS;
+	idList<aasRoute_t, idListFrameAllocator<aasRoute_t> > batch;
+
+	for ( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() ) {
+		if ( g_cinematic.GetBool() && inCinematic && !ent->cinematic ) {
+			continue;
+		}
+		if ( !ent->IsType( idAI::Type ) ) {
+			continue;
+		}
+		monster = static_cast<idAI *>( ent );
+		if ( !monster->GetMoveRoute( route ) ) {
+			continue;
+		}
+		routes.Append( route );
+		routeAAS.Append( monster->GetAAS() );
+	}
+
+	if ( routes.Num() < 2 ) {
+		return;
+	}
+
+	// one batch per area system
+	for ( i = 0; i < aasList.Num(); i++ ) {
+		batch.SetNum( 0, false );
+		for ( j = 0; j < routes.Num(); j++ ) {
+			if ( routeAAS[j] == aasList[i] ) {
+				batch.Append( routes[j] );
+			}
+		}
+		if ( batch.Num() ) {
+			aasList[i]->RouteToGoalAreas( batch.Ptr(), batch.Num() );
+		}
+	}
+}
+
+/*
+================
+idGameLocal::CheckEntityAnimations
+
+  Verifies the animation frames created on the job threads are the same as the frames
+  created by a serial update.  Frames that were created again on the main thread during
+  the entity think, for instance after an animation change, are skipped.
+================
+*/
+void idGameLocal::CheckEntityAnimations( void ) {
+	int i, numJoints, numChecked, numFailed;
+	idEntity *ent;
+	idAnimator *animator;
+	idJointMat *joints;
+	bool usePoseCache;
+
+	usePoseCache = g_animPoseCache.GetBool();
+	numChecked = numFailed = 0;
+	for ( i = 0; i < checkAnims.Num(); i++ ) {
+		const animCheck_t &check = checkAnims[i];
+		ent = check.ent.GetEntity();
+		if ( !ent ) {
+			continue;
+		}
+		animator = ent->GetAnimator();
+		animator->GetJoints( &numJoints, &joints );
+		if ( numJoints != check.numJoints || animator->GetFrameNumber() != check.frameNumber ) {
+			continue;
+		}
+		// decode the anims again instead of using the poses cached by the job threads
+		g_animPoseCache.SetBool( false );
+		animator->CreateFrame( time, true );
+		g_animPoseCache.SetBool( usePoseCache );
+		numChecked++;
+		if ( memcmp( joints, &checkAnimJoints[check.firstJoint], numJoints * sizeof( joints[0] ) ) != 0 ) {
+			Warning( "g_parallelThinkCheck: entity '%s' has a different animation frame than a serial update", ent->name.c_str() );
+			numFailed++;
+		}
+	}
+
+	if ( g_parallelThinkCheck.GetInteger() > 1 ) {
+		Printf( "%d: parallel animation frames: %d checked, %d different\n", time, numChecked, numFailed );
+	}
+
+	checkAnims.Clear();
+	checkAnimJoints.Clear();
+}
+
 /*
 ================
 idGameLocal::RunFrame
@@ -2400,12 +2751,17 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 	idPlayer	*player;
 	const renderView_t *view;
 
+	PROFILE_SCOPE( "idGameLocal::RunFrame" );
+
 #ifdef _DEBUG
 	if ( isMultiplayer ) {
 		assert( !isClient );
 	}
 #endif
 
+	// release the temporary allocations of the previous frame
+	Mem_ResetFrameArena();
+
 	player = GetLocalPlayer();
 
 #ifdef _D3XP
@@ -2432,6 +2788,12 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		time += msec;
 		realClientTime = time;
 
+#ifdef GAME_DLL
+		// set idLib frame number for frame based memory dumps and profiling
+		idLib::frameNumber = framenum;
+		Mem_ProfileNextFrame();
+#endif
+
 #ifdef _D3XP
 		slow.Set( time, previousTime, msec, framenum, realClientTime );
 #endif
@@ -2479,9 +2841,23 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		// sort the active entity list
 		SortActiveEntityList();
 
+		// forget the anim poses decoded during the last frame
+		animPoseCache.BeginFrame();
+
 		timer_think.Clear();
 		timer_think.Start();
 
+		// evaluate articulated figures ahead of the entity think
+		if ( af_parallel.GetBool() || g_parallelThink.GetBool() ) {
+			RunArticulatedFigures();
+		}
+
+		// create the animation frames of independent entity teams and route the moving monsters ahead of the entity think
+		if ( g_parallelThink.GetBool() ) {
+			RunEntityAnimations();
+			RunMonsterRoutes();
+		}
+
 		// let entities think
 		if ( g_timeentities.GetFloat() ) {
 			num = 0;
@@ -2529,6 +2905,11 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 		RunTimeGroup2();
 #endif
 
+		// compare the animation frames created on the job threads with a serial update
+		if ( checkAnims.Num() ) {
+			CheckEntityAnimations();
+		}
+
 		// remove any entities that have stopped thinking
 		if ( numEntitiesToDeactivate ) {
 			idEntity *next_ent;
@@ -2575,6 +2956,13 @@ gameReturn_t idGameLocal::RunFrame( const usercmd_t *clientCmds ) {
 				timer_think.Milliseconds(), timer_events.Milliseconds(), num );
 		}
 
+		if ( g_showFrameArena.GetBool() ) {
+			frameArenaStats_t arena;
+			Mem_GetFrameArenaStats( arena );
+			Printf( "frame arena %d: %d allocs %dkB used %dkB overflow, peak %dkB of %dkB\n",
+				time, arena.numAllocs, arena.used >> 10, arena.overflow >> 10, arena.highWater >> 10, arena.size >> 10 );
+		}
+
 		// build the return value
 		ret.consistencyHash = 0;
 		ret.sessionCommand[0] = 0;
@@ -240,6 +240,13 @@ private:
 	int						spawnId;
 };
 
+typedef struct {
+	idEntityPtr<idEntity>	ent;
+	int						frameNumber;		// animator frame number of the frame created on a job thread
+	int						firstJoint;			// first joint in checkAnimJoints
+	int						numJoints;
+} animCheck_t;
+
 #ifdef _D3XP
 struct timeState_t {
 	int					time;
@@ -366,6 +373,13 @@ public:
 	void					QuickSlowmoReset();
 
 	bool					NeedRestart();
+
+							// articulated figures that can be evaluated ahead of the entity think
+	bool					IsParallelArticulatedFigure( idEntity *ent ) const;
+	void					EvaluateArticulatedFigures( idEntity **figures, int numFigures, int timeStepMSec, int endTimeMSec );
+
+							// entities of which the animation frame can be created ahead of the entity think
+	bool					IsParallelAnimation( idEntity *ent ) const;
 #endif
 
 	void					Tokenize( idStrList &out, const char *in );
@@ -560,6 +574,11 @@ private:
 	bool					influenceActive;		// true when a phantasm is happening
 	int						nextGibTime;
 
+	idParallelJobList *		afJobList;				// solves articulated figures on the job threads
+	idParallelJobList *		animJobList;			// creates animation frames on the job threads
+	idList<animCheck_t>		checkAnims;				// animation frames verified with g_parallelThinkCheck
+	idList<idJointMat>		checkAnimJoints;		// joints created on the job threads for the frames above
+
 	idList<int>				clientDeclRemap[MAX_CLIENTS][DECL_MAX_TYPES];
 
 	entityState_t *			clientEntityStates[MAX_CLIENTS][MAX_GENTITIES];
@@ -601,6 +620,10 @@ private:
 	void					FreePlayerPVS( void );
 	void					UpdateGravity( void );
 	void					SortActiveEntityList( void );
+	void					RunArticulatedFigures( void );
+	void					RunEntityAnimations( void );
+	void					RunMonsterRoutes( void );
+	void					CheckEntityAnimations( void );
 	void					ShowTargets( void );
 	void					RunDebugInfo( void );
 
@@ -637,6 +660,7 @@ private:
 
 extern idGameLocal			gameLocal;
 extern idAnimManager		animationLib;
+extern idAnimPoseCache		animPoseCache;
 
 //============================================================================
 
@@ -55,6 +55,12 @@ idAASLocal::idAASLocal
 */
 idAASLocal::idAASLocal( void ) {
 	file = NULL;
+	cacheList = NULL;
+	routingInParallel = false;
+	routingJobList = NULL;
+	clusterTableBlocks = NULL;
+	numTableBlocks = 0;
+	maxCacheMemory = 0;
 }
 
 /*
@@ -191,6 +197,18 @@ idVec3 idAASLocal::AreaCenter( int areaNum ) const {
 	return file->GetArea( areaNum ).center;
 }
 
+/*
+============
+idAASLocal::GetNumAreas
+============
+*/
+int idAASLocal::GetNumAreas( void ) const {
+	if ( !file ) {
+		return 0;
+	}
+	return file->GetNumAreas();
+}
+
 /*
 ============
 idAASLocal::AreaFlags
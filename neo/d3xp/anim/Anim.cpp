@@ -940,6 +940,7 @@ idAnimManager::Shutdown
 ====================
 */
 void idAnimManager::Shutdown( void ) {
+	animPoseCache.Shutdown();
 	animations.DeleteContents();
 	jointnames.Clear();
 	jointnamesHash.Free();
@@ -988,6 +989,8 @@ void idAnimManager::ReloadAnims( void ) {
 	int			i;
 	idMD5Anim	**animptr;
 
+	animPoseCache.Clear();
+
 	for( i = 0; i < animations.Num(); i++ ) {
 		animptr = animations.GetIndex( i );
 		if ( animptr && *animptr ) {
@@ -1080,8 +1083,231 @@ void idAnimManager::FlushUnusedAnims( void ) {
 		}
 	}
 
+	if ( removeAnims.Num() ) {
+		animPoseCache.Clear();
+	}
+
 	for( i = 0; i < removeAnims.Num(); i++ ) {
 		animations.Remove( removeAnims[ i ]->Name() );
 		delete removeAnims[ i ];
 	}
 }
+
+/***********************************************************************
+
+	idAnimPoseCache
+
+***********************************************************************/
+
+/*
+====================
+idAnimPoseCache::idAnimPoseCache
+====================
+*/
+idAnimPoseCache::idAnimPoseCache() {
+	poses = NULL;
+	poseJoints = NULL;
+	Clear();
+}
+
+/*
+====================
+idAnimPoseCache::Clear
+
+Drops all cached poses, must be called before anims are reloaded or freed.
+====================
+*/
+void idAnimPoseCache::Clear( void ) {
+	int i;
+
+	for ( i = 0; i < HASH_SIZE; i++ ) {
+		hashHeads[ i ] = -1;
+	}
+	numPoses.SetValue( 0 );
+	numPoseJoints.SetValue( 0 );
+	frameLookups.SetValue( 0 );
+	frameHits.SetValue( 0 );
+}
+
+/*
+====================
+idAnimPoseCache::BeginFrame
+
+Empties the cache at the start of a game frame, must be called from the main thread
+while no animation frames are created on the job threads.
+====================
+*/
+void idAnimPoseCache::BeginFrame( void ) {
+	if ( !g_animPoseCache.GetBool() ) {
+		return;
+	}
+
+	// the buffers are allocated once and never grow so other threads can read them while poses are added
+	if ( !poses ) {
+		poses = new animPose_t[ MAX_POSES ];
+		poseJoints = (idJointQuat *) Mem_Alloc16( MAX_JOINTS * sizeof( poseJoints[ 0 ] ) );
+	}
+
+	if ( g_showAnimPoseCache.GetBool() && frameLookups.GetValue() ) {
+		gameLocal.Printf( "anim pose cache: %d lookups, %d hits (%.1f%%), %d poses, %d joints\n", frameLookups.GetValue(), frameHits.GetValue(),
+							frameHits.GetValue() * 100.0f / frameLookups.GetValue(), Min( numPoses.GetValue(), MAX_POSES ), Min( numPoseJoints.GetValue(), MAX_JOINTS ) );
+	}
+
+	Clear();
+}
+
+/*
+====================
+idAnimPoseCache::Shutdown
+====================
+*/
+void idAnimPoseCache::Shutdown( void ) {
+	Clear();
+	delete[] poses;
+	poses = NULL;
+	Mem_Free16( poseJoints );
+	poseJoints = NULL;
+}
+
+/*
+====================
+idAnimPoseCache::ClearStatistics
+====================
+*/
+void idAnimPoseCache::ClearStatistics( void ) {
+	numLookups.SetValue( 0 );
+	numHits.SetValue( 0 );
+}
+
+/*
+====================
+idAnimPoseCache::HashKey
+====================
+*/
+int idAnimPoseCache::HashKey( const animPose_t &pose ) const {
+	return ( static_cast<int>( reinterpret_cast<size_t>( pose.anim ) >> 4 ) ^ ( pose.frame1 * 31 ) ^ ( pose.frame2 * 127 ) ^ ( pose.numIndexes << 8 ) ) & ( HASH_SIZE - 1 );
+}
+
+/*
+====================
+idAnimPoseCache::FindPose
+====================
+*/
+const idJointQuat *idAnimPoseCache::FindPose( const animPose_t &pose, int key ) {
+	int i;
+
+	frameLookups.Increment();
+	numLookups.Increment();
+
+	for ( i = hashHeads[ key ]; i != -1; i = poses[ i ].next ) {
+		const animPose_t &p = poses[ i ];
+		if ( p.anim == pose.anim && p.index == pose.index && p.numIndexes == pose.numIndexes && p.cycleCount == pose.cycleCount &&
+				p.frame1 == pose.frame1 && p.frame2 == pose.frame2 && p.backlerp == pose.backlerp ) {
+			frameHits.Increment();
+			numHits.Increment();
+			return &poseJoints[ p.firstJoint ];
+		}
+	}
+	return NULL;
+}
+
+/*
+====================
+idAnimPoseCache::StorePose
+
+The pose and its joints are written before the pose is linked into the hash chain,
+so other threads never see a partially stored pose. When two threads decode the
+same pose at the same time both are stored and either may be found.
+====================
+*/
+void idAnimPoseCache::StorePose( animPose_t &pose, int key, const idJointQuat *joints ) {
+	int poseNum, numJoints, head;
+
+	poseNum = numPoses.Increment() - 1;
+	if ( poseNum >= MAX_POSES ) {
+		return;
+	}
+
+	numJoints = pose.anim->NumJoints();
+	pose.firstJoint = numPoseJoints.Add( numJoints ) - numJoints;
+	if ( pose.firstJoint + numJoints > MAX_JOINTS ) {
+		// the reserved pose is never linked in
+		return;
+	}
+
+	SIMDProcessor->Memcpy( &poseJoints[ pose.firstJoint ], joints, numJoints * sizeof( joints[ 0 ] ) );
+	poses[ poseNum ] = pose;
+
+	do {
+		head = hashHeads[ key ];
+		poses[ poseNum ].next = head;
+	} while( Sys_InterlockedCompareExchange( hashHeads[ key ], head, poseNum ) != head );
+}
+
+/*
+====================
+idAnimPoseCache::GetInterpolatedFrame
+====================
+*/
+void idAnimPoseCache::GetInterpolatedFrame( const idMD5Anim *anim, frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes ) {
+	animPose_t			pose;
+	const idJointQuat	*cached;
+	int					key;
+
+	if ( !g_animPoseCache.GetBool() || !poses ) {
+		anim->GetInterpolatedFrame( frame, joints, index, numIndexes );
+		return;
+	}
+
+	pose.anim = anim;
+	pose.index = index;
+	pose.numIndexes = numIndexes;
+	pose.cycleCount = frame.cycleCount;
+	pose.frame1 = frame.frame1;
+	pose.frame2 = frame.frame2;
+	pose.backlerp = frame.backlerp;
+
+	key = HashKey( pose );
+	cached = FindPose( pose, key );
+	if ( cached ) {
+		SIMDProcessor->Memcpy( joints, cached, anim->NumJoints() * sizeof( joints[ 0 ] ) );
+		return;
+	}
+
+	anim->GetInterpolatedFrame( frame, joints, index, numIndexes );
+	StorePose( pose, key, joints );
+}
+
+/*
+====================
+idAnimPoseCache::GetSingleFrame
+====================
+*/
+void idAnimPoseCache::GetSingleFrame( const idMD5Anim *anim, int framenum, idJointQuat *joints, const int *index, int numIndexes ) {
+	animPose_t			pose;
+	const idJointQuat	*cached;
+	int					key;
+
+	if ( !g_animPoseCache.GetBool() || !poses ) {
+		anim->GetSingleFrame( framenum, joints, index, numIndexes );
+		return;
+	}
+
+	pose.anim = anim;
+	pose.index = index;
+	pose.numIndexes = numIndexes;
+	pose.cycleCount = 0;
+	pose.frame1 = framenum;
+	pose.frame2 = -1;
+	pose.backlerp = 0.0f;
+
+	key = HashKey( pose );
+	cached = FindPose( pose, key );
+	if ( cached ) {
+		SIMDProcessor->Memcpy( joints, cached, anim->NumJoints() * sizeof( joints[ 0 ] ) );
+		return;
+	}
+
+	anim->GetSingleFrame( framenum, joints, index, numIndexes );
+	StorePose( pose, key, joints );
+}
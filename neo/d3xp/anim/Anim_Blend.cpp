@@ -1850,10 +1850,10 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 	if ( numAnims == 1 ) {
 		md5anim = anim->MD5Anim( 0 );
 		if ( frame ) {
-			md5anim->GetSingleFrame( frame - 1, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+			animPoseCache.GetSingleFrame( md5anim, frame - 1, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 		} else {
 			md5anim->ConvertTimeToFrame( time, cycle, frametime );
-			md5anim->GetInterpolatedFrame( frametime, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+			animPoseCache.GetInterpolatedFrame( md5anim, frametime, jointFrame, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 		}
 	} else {
 		//
@@ -1874,9 +1874,9 @@ bool idAnimBlend::BlendAnim( int currentTime, int channel, int numJoints, idJoin
 				lerp = animWeights[ i ] / mixWeight;
 				md5anim = anim->MD5Anim( i );
 				if ( frame ) {
-					md5anim->GetSingleFrame( frame - 1, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+					animPoseCache.GetSingleFrame( md5anim, frame - 1, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 				} else {
-					md5anim->GetInterpolatedFrame( frametime, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
+					animPoseCache.GetInterpolatedFrame( md5anim, frametime, ptr, modelDef->GetChannelJoints( channel ), modelDef->NumJointsOnChannel( channel ) );
 				}
 
 				// only blend after the first anim is mixed in
@@ -3092,6 +3092,7 @@ idAnimator::idAnimator() {
 	numJoints				= 0;
 	joints					= NULL;
 	lastTransformTime		= -1;
+	frameNumber				= 0;
 	stoppedAnimatingUpdate	= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
@@ -3567,6 +3568,7 @@ void idAnimator::SetFrame( int channelNum, int animNum, int frame, int currentTi
 
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].SetFrame( modelDef, animNum, frame, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -3588,6 +3590,7 @@ void idAnimator::CycleAnim( int channelNum, int animNum, int currentTime, int bl
 	
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].CycleAnim( modelDef, animNum, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -3609,6 +3612,7 @@ void idAnimator::PlayAnim( int channelNum, int animNum, int currentTime, int ble
 	
 	PushAnims( channelNum, currentTime, blendTime );
 	channels[ channelNum ][ 0 ].PlayAnim( modelDef, animNum, currentTime, blendTime );
+	ForceUpdate();
 	if ( entity ) {
 		entity->BecomeActive( TH_ANIMATE );
 	}
@@ -4247,6 +4251,17 @@ bool idAnimator::FrameHasChanged( int currentTime ) const {
 	return false;
 }
 
+/*
+=====================
+idAnimator::GetFrameNumber
+
+  Returns a number that changes every time the joints are created.
+=====================
+*/
+int idAnimator::GetFrameNumber( void ) const {
+	return frameNumber;
+}
+
 /*
 =====================
 idAnimator::CreateFrame
@@ -4286,6 +4301,7 @@ bool idAnimator::CreateFrame( int currentTime, bool force ) {
 
 	lastTransformTime = currentTime;
 	stoppedAnimatingUpdate = false;
+	frameNumber++;
 
 	if ( entity && ( ( g_debugAnim.GetInteger() == entity->entityNumber ) || ( g_debugAnim.GetInteger() == -2 ) ) ) {
 		debugInfo = true;
@@ -84,8 +84,11 @@ public:
 
 class idSaveGame;
 class idRestoreGame;
+class idEventTimeQueue;
 
 class idEvent {
+	friend class idEventTimeQueue;
+
 private:
 	const idEventDef			*eventdef;
 	byte						*data;
@@ -94,9 +97,13 @@ private:
 	const idTypeInfo			*typeinfo;
 
 	idLinkList<idEvent>			eventNode;
+	idEventTimeQueue			*queue;			// queue the event is scheduled in, NULL when not scheduled
+	int							bucket;			// time bucket in the queue
 
 	static idDynamicBlockAlloc<byte, 16 * 1024, 256> eventDataAllocator;
 
+	void						Unschedule( void );
+
 
 public:
 	static bool					initialized;
@@ -34,6 +34,16 @@ If you have questions concerning this license or the applicable additional terms
 #define	MAX_SECTOR_DEPTH				12
 #define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
 
+#define CLIP_BATCH_SIZE					64			// number of batched traces grouped at a time
+#define CLIP_BATCH_GROUP_GROWTH			2.0f		// max growth of the group volume when adding a trace
+
+#define CLIP_TREE_MARGIN				4.0f		// fat bounds margin around the absolute bounds of a clip model
+#define CLIP_TREE_DISPLACEMENT_SCALE	2.0f		// fat bounds are extended along the displacement of a relinked clip model
+#define CLIP_TREE_MAX_DEPTH				256
+
+#define TRACE_RECORD_IDENT				(('R'<<24)+('T'<<16)+('L'<<8)+'C')
+#define TRACE_RECORD_VERSION			1
+
 typedef struct clipSector_s {
 	int						axis;		// -1 = leaf node
 	float					dist;
@@ -61,6 +71,420 @@ idVec3 vec3_boxEpsilon( CM_BOX_EPSILON, CM_BOX_EPSILON, CM_BOX_EPSILON );
 
 idBlockAlloc<clipLink_t, 1024>	clipLinkAllocator;
 
+typedef struct clipLinkStats_s {
+	int						numLinks;		// number of times a clip model was (re)linked
+	int						numRefits;		// links that stayed within the fat bounds of a tree leaf
+	int						numUnlinks;
+	int						numQueries;		// number of ClipModelsTouchingBounds calls
+	int						numQueryNodes;	// sectors or tree nodes visited by the queries
+	double					linkTicks;
+	double					queryTicks;
+} clipLinkStats_t;
+
+static clipLinkStats_t			clipLinkStats;
+
+
+/*
+===============================================================
+
+	idClipTree
+
+	Incrementally updated bounding volume tree that can be used instead of
+	the uniformly subdivided clip sectors. The leaves store fat bounds so a
+	clip model that moves a little does not have to be reinserted every time
+	it is relinked. Inserting a leaf picks the sibling with the least increase
+	in surface area and the tree is kept balanced with rotations.
+
+===============================================================
+*/
+
+typedef struct clipTreeNode_s {
+	idBounds				bounds;			// fat bounds for leaf nodes
+	int						parent;			// next free node when on the free list
+	int						children[2];	// -1 for leaf nodes
+	int						height;			// 0 for leaf nodes, -1 for free nodes
+	idClipModel *			clipModel;
+} clipTreeNode_t;
+
+class idClipTree {
+public:
+							idClipTree( void );
+
+	int						InsertLeaf( idClipModel *clipModel, const idBounds &fatBounds );
+	void					RemoveLeaf( int leaf );
+	void					Clear( void );
+
+	int						GetRoot( void ) const { return root; }
+	const clipTreeNode_t &	GetNode( int nodeNum ) const { return nodes[nodeNum]; }
+	int						GetNumLeafs( void ) const { return numLeafs; }
+	int						GetHeight( void ) const { return ( root == -1 ) ? 0 : nodes[root].height; }
+
+private:
+	idList<clipTreeNode_t>	nodes;
+	int						root;
+	int						freeList;
+	int						numLeafs;
+
+private:
+	int						AllocNode( void );
+	void					FreeNode( int nodeNum );
+	void					InsertNode( int leaf );
+	int						Balance( int nodeNum );
+	void					Refit( int nodeNum );
+};
+
+/*
+===============
+Perimeter
+
+  half the surface area, used as the insertion cost
+===============
+*/
+static ID_INLINE float Perimeter( const idBounds &bounds ) {
+	idVec3 size = bounds[1] - bounds[0];
+	return size[0] * size[1] + size[1] * size[2] + size[2] * size[0];
+}
+
+/*
+===============
+idClipTree::idClipTree
+===============
+*/
+idClipTree::idClipTree( void ) {
+	nodes.SetGranularity( 1024 );
+	root = -1;
+	freeList = -1;
+	numLeafs = 0;
+}
+
+/*
+===============
+idClipTree::Clear
+===============
+*/
+void idClipTree::Clear( void ) {
+	int i;
+
+	// make sure no clip model still references the tree
+	for ( i = 0; i < nodes.Num(); i++ ) {
+		if ( nodes[i].height == 0 && nodes[i].clipModel ) {
+			nodes[i].clipModel->clipTree = NULL;
+			nodes[i].clipModel->clipNode = -1;
+		}
+	}
+	nodes.Clear();
+	root = -1;
+	freeList = -1;
+	numLeafs = 0;
+}
+
+/*
+===============
+idClipTree::AllocNode
+===============
+*/
+int idClipTree::AllocNode( void ) {
+	int nodeNum;
+
+	if ( freeList != -1 ) {
+		nodeNum = freeList;
+		freeList = nodes[nodeNum].parent;
+	} else {
+		nodeNum = nodes.Num();
+		nodes.Append( clipTreeNode_t() );
+	}
+
+	clipTreeNode_t &node = nodes[nodeNum];
+	node.parent = -1;
+	node.children[0] = node.children[1] = -1;
+	node.height = 0;
+	node.clipModel = NULL;
+	return nodeNum;
+}
+
+/*
+===============
+idClipTree::FreeNode
+===============
+*/
+void idClipTree::FreeNode( int nodeNum ) {
+	nodes[nodeNum].parent = freeList;
+	nodes[nodeNum].height = -1;
+	nodes[nodeNum].clipModel = NULL;
+	freeList = nodeNum;
+}
+
+/*
+===============
+idClipTree::InsertLeaf
+===============
+*/
+int idClipTree::InsertLeaf( idClipModel *clipModel, const idBounds &fatBounds ) {
+	int leaf;
+
+	leaf = AllocNode();
+	nodes[leaf].bounds = fatBounds;
+	nodes[leaf].clipModel = clipModel;
+	InsertNode( leaf );
+	numLeafs++;
+	return leaf;
+}
+
+/*
+===============
+idClipTree::InsertNode
+===============
+*/
+void idClipTree::InsertNode( int leaf ) {
+	int index, sibling, oldParent, newParent, child0, child1;
+	float area, combinedArea, cost, inheritanceCost, cost0, cost1;
+	idBounds leafBounds, combined;
+
+	if ( root == -1 ) {
+		root = leaf;
+		nodes[root].parent = -1;
+		return;
+	}
+
+	// find the best sibling for the new leaf
+	leafBounds = nodes[leaf].bounds;
+	index = root;
+	while( nodes[index].height > 0 ) {
+		child0 = nodes[index].children[0];
+		child1 = nodes[index].children[1];
+
+		area = Perimeter( nodes[index].bounds );
+		combined = nodes[index].bounds + leafBounds;
+		combinedArea = Perimeter( combined );
+
+		// cost of creating a new parent for this node and the new leaf
+		cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		inheritanceCost = 2.0f * ( combinedArea - area );
+
+		combined = nodes[child0].bounds + leafBounds;
+		cost0 = Perimeter( combined ) + inheritanceCost;
+		if ( nodes[child0].height > 0 ) {
+			cost0 -= Perimeter( nodes[child0].bounds );
+		}
+
+		combined = nodes[child1].bounds + leafBounds;
+		cost1 = Perimeter( combined ) + inheritanceCost;
+		if ( nodes[child1].height > 0 ) {
+			cost1 -= Perimeter( nodes[child1].bounds );
+		}
+
+		if ( cost < cost0 && cost < cost1 ) {
+			break;
+		}
+
+		index = ( cost0 < cost1 ) ? child0 : child1;
+	}
+	sibling = index;
+
+	// create a new parent for the sibling and the leaf
+	oldParent = nodes[sibling].parent;
+	newParent = AllocNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].bounds = leafBounds + nodes[sibling].bounds;
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].children[0] = sibling;
+	nodes[newParent].children[1] = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if ( oldParent != -1 ) {
+		if ( nodes[oldParent].children[0] == sibling ) {
+			nodes[oldParent].children[0] = newParent;
+		} else {
+			nodes[oldParent].children[1] = newParent;
+		}
+	} else {
+		root = newParent;
+	}
+
+	Refit( nodes[leaf].parent );
+}
+
+/*
+===============
+idClipTree::RemoveLeaf
+===============
+*/
+void idClipTree::RemoveLeaf( int leaf ) {
+	int parent, grandParent, sibling;
+
+	assert( leaf >= 0 && leaf < nodes.Num() && nodes[leaf].height == 0 );
+
+	numLeafs--;
+
+	if ( leaf == root ) {
+		root = -1;
+		FreeNode( leaf );
+		return;
+	}
+
+	parent = nodes[leaf].parent;
+	grandParent = nodes[parent].parent;
+	sibling = ( nodes[parent].children[0] == leaf ) ? nodes[parent].children[1] : nodes[parent].children[0];
+
+	FreeNode( leaf );
+
+	if ( grandParent != -1 ) {
+		// connect the sibling to the grand parent and remove the parent
+		if ( nodes[grandParent].children[0] == parent ) {
+			nodes[grandParent].children[0] = sibling;
+		} else {
+			nodes[grandParent].children[1] = sibling;
+		}
+		nodes[sibling].parent = grandParent;
+		FreeNode( parent );
+
+		Refit( grandParent );
+	} else {
+		root = sibling;
+		nodes[sibling].parent = -1;
+		FreeNode( parent );
+	}
+}
+
+/*
+===============
+idClipTree::Refit
+
+  walk back up the tree fixing heights and bounds
+===============
+*/
+void idClipTree::Refit( int nodeNum ) {
+	int child0, child1;
+
+	while( nodeNum != -1 ) {
+		nodeNum = Balance( nodeNum );
+
+		child0 = nodes[nodeNum].children[0];
+		child1 = nodes[nodeNum].children[1];
+
+		nodes[nodeNum].height = 1 + Max( nodes[child0].height, nodes[child1].height );
+		nodes[nodeNum].bounds = nodes[child0].bounds + nodes[child1].bounds;
+
+		nodeNum = nodes[nodeNum].parent;
+	}
+}
+
+/*
+===============
+idClipTree::Balance
+
+  performs a left or right rotation if node A is imbalanced, returns the new root of the sub-tree
+===============
+*/
+int idClipTree::Balance( int iA ) {
+	int iB, iC, iF, iG, iD, iE, balance;
+
+	clipTreeNode_t *A = &nodes[iA];
+	if ( A->height < 2 ) {
+		return iA;
+	}
+
+	iB = A->children[0];
+	iC = A->children[1];
+	clipTreeNode_t *B = &nodes[iB];
+	clipTreeNode_t *C = &nodes[iC];
+
+	balance = C->height - B->height;
+
+	if ( balance > 1 ) {
+		// rotate C up
+		iF = C->children[0];
+		iG = C->children[1];
+		clipTreeNode_t *F = &nodes[iF];
+		clipTreeNode_t *G = &nodes[iG];
+
+		// swap A and C
+		C->children[0] = iA;
+		C->parent = A->parent;
+		A->parent = iC;
+
+		// A's old parent should point to C
+		if ( C->parent != -1 ) {
+			if ( nodes[C->parent].children[0] == iA ) {
+				nodes[C->parent].children[0] = iC;
+			} else {
+				nodes[C->parent].children[1] = iC;
+			}
+		} else {
+			root = iC;
+		}
+
+		// rotate
+		if ( F->height > G->height ) {
+			C->children[1] = iF;
+			A->children[1] = iG;
+			G->parent = iA;
+			A->bounds = B->bounds + G->bounds;
+			C->bounds = A->bounds + F->bounds;
+			A->height = 1 + Max( B->height, G->height );
+			C->height = 1 + Max( A->height, F->height );
+		} else {
+			C->children[1] = iG;
+			A->children[1] = iF;
+			F->parent = iA;
+			A->bounds = B->bounds + F->bounds;
+			C->bounds = A->bounds + G->bounds;
+			A->height = 1 + Max( B->height, F->height );
+			C->height = 1 + Max( A->height, G->height );
+		}
+		return iC;
+	}
+
+	if ( balance < -1 ) {
+		// rotate B up
+		iD = B->children[0];
+		iE = B->children[1];
+		clipTreeNode_t *D = &nodes[iD];
+		clipTreeNode_t *E = &nodes[iE];
+
+		// swap A and B
+		B->children[0] = iA;
+		B->parent = A->parent;
+		A->parent = iB;
+
+		// A's old parent should point to B
+		if ( B->parent != -1 ) {
+			if ( nodes[B->parent].children[0] == iA ) {
+				nodes[B->parent].children[0] = iB;
+			} else {
+				nodes[B->parent].children[1] = iB;
+			}
+		} else {
+			root = iB;
+		}
+
+		// rotate
+		if ( D->height > E->height ) {
+			B->children[1] = iD;
+			A->children[0] = iE;
+			E->parent = iA;
+			A->bounds = C->bounds + E->bounds;
+			B->bounds = A->bounds + D->bounds;
+			A->height = 1 + Max( C->height, E->height );
+			B->height = 1 + Max( A->height, D->height );
+		} else {
+			B->children[1] = iE;
+			A->children[0] = iD;
+			D->parent = iA;
+			A->bounds = C->bounds + D->bounds;
+			B->bounds = A->bounds + E->bounds;
+			A->height = 1 + Max( C->height, D->height );
+			B->height = 1 + Max( A->height, E->height );
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
 
 /*
 ===============================================================
@@ -284,6 +708,8 @@ void idClipModel::Init( void ) {
 	renderModelHandle = -1;
 	traceModelIndex = -1;
 	clipLinks = NULL;
+	clipTree = NULL;
+	clipNode = -1;
 	touchCount = -1;
 }
 
@@ -350,6 +776,8 @@ idClipModel::idClipModel( const idClipModel *model ) {
 	}
 	renderModelHandle = model->renderModelHandle;
 	clipLinks = NULL;
+	clipTree = NULL;
+	clipNode = -1;
 	touchCount = -1;
 }
 
@@ -389,7 +817,7 @@ void idClipModel::Save( idSaveGame *savefile ) const {
 	}
 	savefile->WriteInt( traceModelIndex );
 	savefile->WriteInt( renderModelHandle );
-	savefile->WriteBool( clipLinks != NULL );
+	savefile->WriteBool( IsLinked() );
 	savefile->WriteInt( touchCount );
 }
 
@@ -429,6 +857,8 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 	// the render model will be set when the clip model is linked
 	renderModelHandle = -1;
 	clipLinks = NULL;
+	clipTree = NULL;
+	clipNode = -1;
 	touchCount = -1;
 
 	if ( linked ) {
@@ -439,11 +869,13 @@ void idClipModel::Restore( idRestoreGame *savefile ) {
 /*
 ================
 idClipModel::SetPosition
+
+  a clip tree leaf stays linked, the next Link() refits or reinserts it
 ================
 */
 void idClipModel::SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis ) {
 	if ( clipLinks ) {
-		Unlink();	// unlink from old position
+		UnlinkSectors();	// unlink from old position
 	}
 	origin = newOrigin;
 	axis = newAxis;
@@ -489,8 +921,29 @@ idClipModel::Unlink
 ===============
 */
 void idClipModel::Unlink( void ) {
+	if ( clipNode != -1 ) {
+		clipTree->RemoveLeaf( clipNode );
+		clipTree = NULL;
+		clipNode = -1;
+		clipLinkStats.numUnlinks++;
+		return;
+	}
+
+	UnlinkSectors();
+}
+
+/*
+===============
+idClipModel::UnlinkSectors
+===============
+*/
+void idClipModel::UnlinkSectors( void ) {
 	clipLink_t *link;
 
+	if ( clipLinks ) {
+		clipLinkStats.numUnlinks++;
+	}
+
 	for ( link = clipLinks; link; link = clipLinks ) {
 		clipLinks = link->nextLink;
 		if ( link->prevInSector ) {
@@ -537,26 +990,80 @@ void idClipModel::Link_r( struct clipSector_s *node ) {
 	clipLinks = link;
 }
 
+/*
+===============
+idClipModel::LinkTree
+===============
+*/
+void idClipModel::LinkTree( idClip &clp, const idVec3 &oldCenter ) {
+	idBounds fatBounds;
+	idVec3 displacement;
+	int i;
+
+	if ( clipNode != -1 ) {
+		// no need to reinsert if the clip model is still within the fat bounds of its leaf
+		if ( clipTree == clp.clipTree ) {
+			const idBounds &leafBounds = clipTree->GetNode( clipNode ).bounds;
+			if (	absBounds[0][0] >= leafBounds[0][0] && absBounds[1][0] <= leafBounds[1][0] &&
+					absBounds[0][1] >= leafBounds[0][1] && absBounds[1][1] <= leafBounds[1][1] &&
+					absBounds[0][2] >= leafBounds[0][2] && absBounds[1][2] <= leafBounds[1][2] ) {
+				clipLinkStats.numRefits++;
+				return;
+			}
+		}
+		displacement = ( absBounds[0] + absBounds[1] ) * 0.5f - oldCenter;
+		Unlink();	// unlink from old position
+	} else {
+		displacement.Zero();
+	}
+
+	// expand the bounds with a margin and along the direction of movement
+	fatBounds[0] = absBounds[0] - idVec3( CLIP_TREE_MARGIN, CLIP_TREE_MARGIN, CLIP_TREE_MARGIN );
+	fatBounds[1] = absBounds[1] + idVec3( CLIP_TREE_MARGIN, CLIP_TREE_MARGIN, CLIP_TREE_MARGIN );
+	displacement *= CLIP_TREE_DISPLACEMENT_SCALE;
+	for ( i = 0; i < 3; i++ ) {
+		if ( displacement[i] < 0.0f ) {
+			fatBounds[0][i] += displacement[i];
+		} else {
+			fatBounds[1][i] += displacement[i];
+		}
+	}
+
+	clipTree = clp.clipTree;
+	clipNode = clipTree->InsertLeaf( this, fatBounds );
+}
+
 /*
 ===============
 idClipModel::Link
 ===============
 */
 void idClipModel::Link( idClip &clp ) {
+	idVec3 oldCenter;
+	double startTicks;
 
 	assert( idClipModel::entity );
 	if ( !idClipModel::entity ) {
 		return;
 	}
 
+	startTicks = idLib::sys->GetClockTicks();
+	clipLinkStats.numLinks++;
+
 	if ( clipLinks ) {
-		Unlink();	// unlink from old position
+		UnlinkSectors();	// unlink from old position
 	}
 
 	if ( bounds.IsCleared() ) {
+		if ( clipNode != -1 ) {
+			Unlink();
+		}
+		clipLinkStats.linkTicks += idLib::sys->GetClockTicks() - startTicks;
 		return;
 	}
 
+	oldCenter = ( absBounds[0] + absBounds[1] ) * 0.5f;
+
 	// set the abs box
 	if ( axis.IsRotated() ) {
 		// expand for rotation
@@ -572,7 +1079,16 @@ void idClipModel::Link( idClip &clp ) {
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 
-	Link_r( clp.clipSectors );
+	if ( clp.clipTree ) {
+		LinkTree( clp, oldCenter );
+	} else {
+		if ( clipNode != -1 ) {
+			Unlink();
+		}
+		Link_r( clp.clipSectors );
+	}
+
+	clipLinkStats.linkTicks += idLib::sys->GetClockTicks() - startTicks;
 }
 
 /*
@@ -622,7 +1138,12 @@ idClip::idClip
 idClip::idClip( void ) {
 	numClipSectors = 0;
 	clipSectors = NULL;
+	clipTree = NULL;
 	worldBounds.Zero();
+	batchClipModels = NULL;
+	batchBounds = NULL;
+	traceRecordFile = NULL;
+	numTracesToRecord = 0;
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
@@ -690,6 +1211,9 @@ void idClip::Init( void ) {
 	memset( clipSectors, 0, MAX_SECTORS * sizeof( clipSector_t ) );
 	numClipSectors = 0;
 	touchCount = -1;
+	// buffers for batched traces
+	batchClipModels = new idClipModel *[MAX_GENTITIES];
+	batchBounds = new idBounds[MAX_GENTITIES];
 	// get world map bounds
 	h = collisionModelManager->LoadModel( "worldMap", false );
 	collisionModelManager->GetModelBounds( h, worldBounds );
@@ -700,11 +1224,18 @@ void idClip::Init( void ) {
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
 	gameLocal.Printf( "max clip sector is (%1.1f, %1.1f, %1.1f)\n", maxSector[0], maxSector[1], maxSector[2] );
 
+	// use a dynamic bounding volume tree instead of the clip sectors
+	if ( g_clipTree.GetBool() ) {
+		clipTree = new idClipTree;
+		gameLocal.Printf( "linking clip models in a dynamic bounding volume tree\n" );
+	}
+
 	// initialize a default clip model
 	defaultClipModel.LoadModel( idTraceModel( idBounds( idVec3( 0, 0, 0 ) ).Expand( 8 ) ) );
 
 	// set counters to zero
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+	memset( &clipLinkStats, 0, sizeof( clipLinkStats ) );
 }
 
 /*
@@ -716,6 +1247,19 @@ void idClip::Shutdown( void ) {
 	delete[] clipSectors;
 	clipSectors = NULL;
 
+	if ( clipTree ) {
+		clipTree->Clear();
+		delete clipTree;
+		clipTree = NULL;
+	}
+
+	delete[] batchClipModels;
+	batchClipModels = NULL;
+	delete[] batchBounds;
+	batchBounds = NULL;
+
+	RecordTraces( NULL, 0 );
+
 	// free the trace model used for the temporaryClipModel
 	if ( temporaryClipModel.traceModelIndex != -1 ) {
 		idClipModel::FreeTraceModel( temporaryClipModel.traceModelIndex );
@@ -747,6 +1291,7 @@ typedef struct listParms_s {
 void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listParms_t &parms ) const {
 
 	while( node->axis != -1 ) {
+		clipLinkStats.numQueryNodes++;
 		if ( parms.bounds[0][node->axis] > node->dist ) {
 			node = node->children[0];
 		} else if ( parms.bounds[1][node->axis] < node->dist ) {
@@ -756,6 +1301,7 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 			node = node->children[1];
 		}
 	}
+	clipLinkStats.numQueryNodes++;
 
 	for ( clipLink_t *link = node->clipLinks; link; link = link->nextInSector ) {
 		idClipModel	*check = link->clipModel;
@@ -796,6 +1342,78 @@ void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s *node, listPa
 	}
 }
 
+/*
+====================
+idClip::ClipModelsTouchingBoundsTree
+====================
+*/
+void idClip::ClipModelsTouchingBoundsTree( listParms_t &parms ) const {
+	int stack[CLIP_TREE_MAX_DEPTH];
+	int stackDepth, nodeNum;
+
+	if ( clipTree->GetRoot() == -1 ) {
+		return;
+	}
+
+	stack[0] = clipTree->GetRoot();
+	stackDepth = 1;
+
+	while( stackDepth > 0 ) {
+		nodeNum = stack[--stackDepth];
+		const clipTreeNode_t &node = clipTree->GetNode( nodeNum );
+
+		clipLinkStats.numQueryNodes++;
+
+		if (	node.bounds[0][0] > parms.bounds[1][0] ||
+				node.bounds[1][0] < parms.bounds[0][0] ||
+				node.bounds[0][1] > parms.bounds[1][1] ||
+				node.bounds[1][1] < parms.bounds[0][1] ||
+				node.bounds[0][2] > parms.bounds[1][2] ||
+				node.bounds[1][2] < parms.bounds[0][2] ) {
+			continue;
+		}
+
+		if ( node.height > 0 ) {
+			assert( stackDepth + 2 <= CLIP_TREE_MAX_DEPTH );
+			stack[stackDepth++] = node.children[1];
+			stack[stackDepth++] = node.children[0];
+			continue;
+		}
+
+		idClipModel	*check = node.clipModel;
+
+		// if the clip model is enabled
+		if ( !check->enabled ) {
+			continue;
+		}
+
+		// if the clip model does not have any contents we are looking for
+		if ( !( check->contents & parms.contentMask ) ) {
+			continue;
+		}
+
+		// if the bounds really do overlap
+		if (	check->absBounds[0][0] > parms.bounds[1][0] ||
+				check->absBounds[1][0] < parms.bounds[0][0] ||
+				check->absBounds[0][1] > parms.bounds[1][1] ||
+				check->absBounds[1][1] < parms.bounds[0][1] ||
+				check->absBounds[0][2] > parms.bounds[1][2] ||
+				check->absBounds[1][2] < parms.bounds[0][2] ) {
+			continue;
+		}
+
+		if ( parms.count >= parms.maxCount ) {
+			gameLocal.Warning( "idClip::ClipModelsTouchingBoundsTree: max count" );
+			return;
+		}
+
+		// clip models are only stored in a single leaf so there are no duplicates
+		check->touchCount = touchCount;
+		parms.list[parms.count] = check;
+		parms.count++;
+	}
+}
+
 /*
 ================
 idClip::ClipModelsTouchingBounds
@@ -819,8 +1437,17 @@ int idClip::ClipModelsTouchingBounds( const idBounds &bounds, int contentMask, i
 	parms.count = 0;
 	parms.maxCount = maxCount;
 
+	double startTicks = idLib::sys->GetClockTicks();
+
 	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	if ( clipTree ) {
+		ClipModelsTouchingBoundsTree( parms );
+	} else {
+		ClipModelsTouchingBounds_r( clipSectors, parms );
+	}
+
+	clipLinkStats.numQueries++;
+	clipLinkStats.queryTicks += idLib::sys->GetClockTicks() - startTicks;
 
 	return parms.count;
 }
@@ -1062,6 +1689,10 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	trace_t trace;
 	const idTraceModel *trm;
 
+	if ( traceRecordFile ) {
+		RecordTrace( start, end, mdl, trmAxis, contentMask, passEntity );
+	}
+
 	if ( TestHugeTranslation( results, mdl, start, end, trmAxis ) ) {
 		return true;
 	}
@@ -1122,6 +1753,197 @@ bool idClip::Translation( trace_t &results, const idVec3 &start, const idVec3 &e
 	return ( results.fraction < 1.0f );
 }
 
+/*
+============
+idClip::TranslationGroup
+
+  traces a group of translations against the entities touching the group bounds,
+  the clip models and their bounds are gathered once for the whole group
+============
+*/
+void idClip::TranslationGroup( trace_t *results, const clipTrace_t *traces, const int *group, const int groupSize,
+								const idBounds *traceBounds, const float *radius, const idTraceModel **trm, const idBounds &groupBounds, int contentMask ) {
+	int i, j, k, num;
+	idClipModel *touch;
+	idEntity *passOwner;
+	idBounds bounds;
+	trace_t trace;
+	byte overlap[MAX_GENTITIES];
+
+	num = ClipModelsTouchingBounds( groupBounds, contentMask, batchClipModels, MAX_GENTITIES );
+	if ( !num ) {
+		return;
+	}
+
+	for ( i = 0; i < num; i++ ) {
+		batchBounds[i] = batchClipModels[i]->absBounds;
+	}
+
+	for ( i = 0; i < groupSize; i++ ) {
+		j = group[i];
+
+		const clipTrace_t &t = traces[j];
+		trace_t &result = results[j];
+
+		// same epsilon as ClipModelsTouchingBounds
+		bounds[0] = traceBounds[j][0] - vec3_boxEpsilon;
+		bounds[1] = traceBounds[j][1] + vec3_boxEpsilon;
+		SIMDProcessor->OverlapBounds( overlap, bounds, batchBounds, num );
+
+		if ( t.passEntity && t.passEntity->GetPhysics()->GetNumClipModels() > 0 ) {
+			passOwner = t.passEntity->GetPhysics()->GetClipModel()->GetOwner();
+		} else {
+			passOwner = NULL;
+		}
+
+		for ( k = 0; k < num; k++ ) {
+			if ( !overlap[k] ) {
+				continue;
+			}
+
+			touch = batchClipModels[k];
+
+			if ( !( touch->contents & t.contentMask ) ) {
+				continue;
+			}
+
+			// same rules as GetTraceClipModels
+			if ( t.passEntity ) {
+				if ( touch->entity == t.passEntity || touch->entity == passOwner ) {
+					continue;
+				}
+				if ( touch->owner && ( touch->owner == t.passEntity || touch->owner == passOwner ) ) {
+					continue;
+				}
+			}
+
+			if ( touch->renderModelHandle != -1 ) {
+				idClip::numRenderModelTraces++;
+				TraceRenderModel( trace, t.start, t.end, radius[j], t.trmAxis, touch );
+			} else {
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &trace, t.start, t.end, trm[j], t.trmAxis, t.contentMask,
+										touch->Handle(), touch->origin, touch->axis );
+			}
+
+			if ( trace.fraction < result.fraction ) {
+				result = trace;
+				result.c.entityNum = touch->entity->entityNumber;
+				result.c.id = touch->id;
+				if ( result.fraction == 0.0f ) {
+					break;
+				}
+			}
+		}
+	}
+}
+
+/*
+============
+idClip::TranslationBatch
+
+  Traces with overlapping bounds are put in a group that walks the clip sectors
+  only once. The bounds of the clip models found for the group are then tested
+  against each trace with SIMD.
+============
+*/
+int idClip::TranslationBatch( trace_t *results, const clipTrace_t *traces, const int numTraces ) {
+	int i, j, k, n, numHits, groupSize, contentMask;
+	int group[CLIP_BATCH_SIZE];
+	bool grouped[CLIP_BATCH_SIZE];
+	idBounds traceBounds[CLIP_BATCH_SIZE];
+	float radius[CLIP_BATCH_SIZE];
+	const idTraceModel *trm[CLIP_BATCH_SIZE];
+	idBounds groupBounds, newBounds;
+	float groupVolume;
+
+	numHits = 0;
+
+	for ( i = 0; i < numTraces; i += CLIP_BATCH_SIZE ) {
+		n = Min( numTraces - i, CLIP_BATCH_SIZE );
+
+		for ( j = 0; j < n; j++ ) {
+			const clipTrace_t &t = traces[i+j];
+			trace_t &result = results[i+j];
+
+			if ( traceRecordFile ) {
+				RecordTrace( t.start, t.end, t.mdl, t.trmAxis, t.contentMask, t.passEntity );
+			}
+
+			grouped[j] = true;
+
+			if ( TestHugeTranslation( result, t.mdl, t.start, t.end, t.trmAxis ) ) {
+				continue;
+			}
+
+			trm[j] = TraceModelForClipModel( t.mdl );
+
+			if ( !t.passEntity || t.passEntity->entityNumber != ENTITYNUM_WORLD ) {
+				// test world
+				idClip::numTranslations++;
+				collisionModelManager->Translation( &result, t.start, t.end, trm[j], t.trmAxis, t.contentMask, 0, vec3_origin, mat3_default );
+				result.c.entityNum = result.fraction != 1.0f ? ENTITYNUM_WORLD : ENTITYNUM_NONE;
+				if ( result.fraction == 0.0f ) {
+					continue;		// blocked immediately by the world
+				}
+			} else {
+				memset( &result, 0, sizeof( result ) );
+				result.fraction = 1.0f;
+				result.endpos = t.end;
+				result.endAxis = t.trmAxis;
+			}
+
+			if ( !trm[j] ) {
+				traceBounds[j].FromPointTranslation( t.start, result.endpos - t.start );
+				radius[j] = 0.0f;
+			} else {
+				traceBounds[j].FromBoundsTranslation( trm[j]->bounds, t.start, t.trmAxis, result.endpos - t.start );
+				radius[j] = trm[j]->bounds.GetRadius();
+			}
+			grouped[j] = false;
+		}
+
+		for ( j = 0; j < n; j++ ) {
+			if ( grouped[j] ) {
+				continue;
+			}
+
+			group[0] = j;
+			groupSize = 1;
+			groupBounds = traceBounds[j];
+			groupVolume = groupBounds.Expand( 1.0f ).GetVolume();
+			contentMask = traces[i+j].contentMask;
+			grouped[j] = true;
+
+			// add the traces that overlap the group without making the group bounds a lot larger
+			for ( k = j + 1; k < n; k++ ) {
+				if ( grouped[k] || !groupBounds.IntersectsBounds( traceBounds[k] ) ) {
+					continue;
+				}
+				newBounds = groupBounds + traceBounds[k];
+				if ( newBounds.Expand( 1.0f ).GetVolume() > CLIP_BATCH_GROUP_GROWTH * ( groupVolume + traceBounds[k].Expand( 1.0f ).GetVolume() ) ) {
+					continue;
+				}
+				group[groupSize++] = k;
+				groupBounds = newBounds;
+				groupVolume = groupBounds.Expand( 1.0f ).GetVolume();
+				contentMask |= traces[i+k].contentMask;
+				grouped[k] = true;
+			}
+
+			TranslationGroup( results + i, traces + i, group, groupSize, traceBounds, radius, trm, groupBounds, contentMask );
+		}
+
+		for ( j = 0; j < n; j++ ) {
+			if ( results[i+j].fraction < 1.0f ) {
+				numHits++;
+			}
+		}
+	}
+
+	return numHits;
+}
+
 /*
 ============
 idClip::Rotation
@@ -1607,6 +2429,163 @@ void idClip::PrintStatistics( void ) {
 	gameLocal.Printf( "t = %-3d, r = %-3d, m = %-3d, render = %-3d, contents = %-3d, contacts = %-3d\n",
 					numTranslations, numRotations, numMotions, numRenderModelTraces, numContents, numContacts );
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
+
+	double ticksPerMsec = idLib::sys->ClockTicksPerSecond() * 0.001;
+	gameLocal.Printf( "%s: links = %-4d (%d refit), unlinks = %-4d, link time = %1.3f ms, queries = %-4d, nodes = %-5d, query time = %1.3f ms\n",
+					clipTree ? "tree" : "sectors", clipLinkStats.numLinks, clipLinkStats.numRefits, clipLinkStats.numUnlinks,
+					clipLinkStats.linkTicks / ticksPerMsec, clipLinkStats.numQueries, clipLinkStats.numQueryNodes,
+					clipLinkStats.queryTicks / ticksPerMsec );
+	if ( clipTree ) {
+		gameLocal.Printf( "tree: leafs = %d, height = %d\n", clipTree->GetNumLeafs(), clipTree->GetHeight() );
+	}
+	memset( &clipLinkStats, 0, sizeof( clipLinkStats ) );
+}
+
+/*
+============
+idClip::RecordTraces
+============
+*/
+void idClip::RecordTraces( const char *fileName, int numTraces ) {
+	if ( traceRecordFile ) {
+		fileSystem->CloseFile( traceRecordFile );
+		traceRecordFile = NULL;
+	}
+	if ( numTraces <= 0 ) {
+		return;
+	}
+	traceRecordFile = fileSystem->OpenFileWrite( fileName );
+	if ( !traceRecordFile ) {
+		gameLocal.Warning( "idClip::RecordTraces: couldn't open %s", fileName );
+		return;
+	}
+	traceRecordFile->WriteInt( TRACE_RECORD_IDENT );
+	traceRecordFile->WriteInt( TRACE_RECORD_VERSION );
+	numTracesToRecord = numTraces;
+	gameLocal.Printf( "recording %d traces to %s\n", numTraces, fileName );
+}
+
+/*
+============
+idClip::RecordTrace
+============
+*/
+void idClip::RecordTrace( const idVec3 &start, const idVec3 &end, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity ) {
+	const idTraceModel *trm;
+
+	trm = TraceModelForClipModel( mdl );
+
+	traceRecordFile->WriteVec3( start );
+	traceRecordFile->WriteVec3( end );
+	traceRecordFile->WriteBool( trm != NULL );
+	if ( trm ) {
+		traceRecordFile->Write( trm, sizeof( *trm ) );
+	}
+	traceRecordFile->WriteMat3( trmAxis );
+	traceRecordFile->WriteInt( contentMask );
+	traceRecordFile->WriteInt( passEntity ? passEntity->entityNumber : -1 );
+
+	if ( --numTracesToRecord <= 0 ) {
+		gameLocal.Printf( "wrote %s\n", traceRecordFile->GetName() );
+		fileSystem->CloseFile( traceRecordFile );
+		traceRecordFile = NULL;
+	}
+}
+
+/*
+============
+idClip::BenchmarkTraces
+
+  replays recorded traces against the current map
+============
+*/
+void idClip::BenchmarkTraces( const char *fileName, int batchSize ) {
+	int i, ident, version, entityNum, numTraces, numHits1, numHits2, numMismatches;
+	bool hasTrm;
+	idFile *file;
+	idTraceModel trm;
+	clipTrace_t *t;
+	idList<clipTrace_t> traces;
+	idList<idClipModel *> clipModels;
+	trace_t *results1, *results2;
+	idTimer timer1, timer2;
+
+	if ( traceRecordFile ) {
+		gameLocal.Warning( "idClip::BenchmarkTraces: still recording traces" );
+		return;
+	}
+
+	file = fileSystem->OpenFileRead( fileName );
+	if ( !file ) {
+		gameLocal.Warning( "idClip::BenchmarkTraces: couldn't open %s", fileName );
+		return;
+	}
+	file->ReadInt( ident );
+	file->ReadInt( version );
+	if ( ident != TRACE_RECORD_IDENT || version != TRACE_RECORD_VERSION ) {
+		gameLocal.Warning( "idClip::BenchmarkTraces: %s is not a version %d trace recording", fileName, TRACE_RECORD_VERSION );
+		fileSystem->CloseFile( file );
+		return;
+	}
+
+	while( file->Tell() < file->Length() ) {
+		t = &traces.Alloc();
+		file->ReadVec3( t->start );
+		file->ReadVec3( t->end );
+		file->ReadBool( hasTrm );
+		t->mdl = NULL;
+		if ( hasTrm ) {
+			file->Read( &trm, sizeof( trm ) );
+			t->mdl = clipModels.Alloc() = new idClipModel( trm );
+		}
+		file->ReadMat3( t->trmAxis );
+		file->ReadInt( t->contentMask );
+		file->ReadInt( entityNum );
+		// entities that no longer exist are not passed
+		t->passEntity = ( entityNum >= 0 && entityNum < MAX_GENTITIES ) ? gameLocal.entities[entityNum] : NULL;
+	}
+	fileSystem->CloseFile( file );
+
+	numTraces = traces.Num();
+	if ( !numTraces ) {
+		clipModels.DeleteContents( true );
+		return;
+	}
+	batchSize = idMath::ClampInt( 1, numTraces, batchSize );
+
+	results1 = new trace_t[numTraces];
+	results2 = new trace_t[numTraces];
+
+	numHits1 = 0;
+	timer1.Start();
+	for ( i = 0; i < numTraces; i++ ) {
+		t = &traces[i];
+		numHits1 += Translation( results1[i], t->start, t->end, t->mdl, t->trmAxis, t->contentMask, t->passEntity );
+	}
+	timer1.Stop();
+
+	numHits2 = 0;
+	timer2.Start();
+	for ( i = 0; i < numTraces; i += batchSize ) {
+		numHits2 += TranslationBatch( results2 + i, traces.Ptr() + i, Min( batchSize, numTraces - i ) );
+	}
+	timer2.Stop();
+
+	// which entity is reported for two hits at exactly the same fraction depends on the clip model order
+	numMismatches = 0;
+	for ( i = 0; i < numTraces; i++ ) {
+		if ( results1[i].fraction != results2[i].fraction || results1[i].endpos != results2[i].endpos ) {
+			numMismatches++;
+		}
+	}
+
+	gameLocal.Printf( "%d traces, %d hits: %1.2f msec\n", numTraces, numHits1, timer1.Milliseconds() );
+	gameLocal.Printf( "%d traces in batches of %d, %d hits: %1.2f msec\n", numTraces, batchSize, numHits2, timer2.Milliseconds() );
+	gameLocal.Printf( "%d mismatches\n", numMismatches );
+
+	delete[] results1;
+	delete[] results2;
+	clipModels.DeleteContents( true );
 }
 
 /*
@@ -54,6 +54,7 @@ class idEntity;
 class idClipModel {
 
 	friend class idClip;
+	friend class idClipTree;
 
 public:
 							idClipModel( void );
@@ -72,7 +73,7 @@ public:
 
 	void					Link( idClip &clp );				// must have been linked with an entity and id before
 	void					Link( idClip &clp, idEntity *ent, int newId, const idVec3 &newOrigin, const idMat3 &newAxis, int renderModelHandle = -1 );
-	void					Unlink( void );						// unlink from sectors
+	void					Unlink( void );						// unlink from sectors or the clip tree
 	void					SetPosition( const idVec3 &newOrigin, const idMat3 &newAxis );	// unlinks the clip model
 	void					Translate( const idVec3 &translation );							// unlinks the clip model
 	void					Rotate( const idRotation &rotation );							// unlinks the clip model
@@ -124,10 +125,14 @@ private:
 	int						renderModelHandle;		// render model def handle
 
 	struct clipLink_s *		clipLinks;				// links into sectors
+	class idClipTree *		clipTree;				// tree the clip model is linked into
+	int						clipNode;				// leaf node in the clip tree
 	int						touchCount;
 
 	void					Init( void );			// initialize
 	void					Link_r( struct clipSector_s *node );
+	void					UnlinkSectors( void );
+	void					LinkTree( idClip &clp, const idVec3 &oldCenter );
 
 	static int				AllocTraceModel( const idTraceModel &trm );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -137,12 +142,12 @@ private:
 
 
 ID_INLINE void idClipModel::Translate( const idVec3 &translation ) {
-	Unlink();
+	UnlinkSectors();
 	origin += translation;
 }
 
 ID_INLINE void idClipModel::Rotate( const idRotation &rotation ) {
-	Unlink();
+	UnlinkSectors();
 	origin *= rotation;
 	axis *= rotation.ToMat3();
 }
@@ -220,7 +225,7 @@ ID_INLINE bool idClipModel::IsTraceModel( void ) const {
 }
 
 ID_INLINE bool idClipModel::IsLinked( void ) const {
-	return ( clipLinks != NULL );
+	return ( clipLinks != NULL || clipNode != -1 );
 }
 
 ID_INLINE bool idClipModel::IsEnabled( void ) const {
@@ -245,6 +250,16 @@ ID_INLINE const idTraceModel *idClipModel::GetTraceModel( void ) const {
 //
 //===============================================================
 
+// translation for idClip::TranslationBatch
+typedef struct clipTrace_s {
+	idVec3					start;
+	idVec3					end;
+	const idClipModel *		mdl;				// NULL for a point trace
+	idMat3					trmAxis;
+	int						contentMask;
+	const idEntity *		passEntity;
+} clipTrace_t;
+
 class idClip {
 
 	friend class idClipModel;
@@ -267,6 +282,9 @@ public:
 	int						Contents( const idVec3 &start,
 								const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity );
 
+	// same as calling Translation for each trace, returns the number of traces that collided
+	int						TranslationBatch( trace_t *results, const clipTrace_t *traces, const int numTraces );
+
 	// special case translations versus the rest of the world
 	bool					TracePoint( trace_t &results, const idVec3 &start, const idVec3 &end,
 								int contentMask, const idEntity *passEntity );
@@ -306,13 +324,24 @@ public:
 	void					DrawClipModels( const idVec3 &eye, const float radius, const idEntity *passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t &contact, const idClipModel *clipModel, int lifetime ) const;
 
+							// record the next translations to a file and replay them one by one and batched
+	void					RecordTraces( const char *fileName, int numTraces );
+	void					BenchmarkTraces( const char *fileName, int batchSize );
+
 private:
 	int						numClipSectors;
 	struct clipSector_s *	clipSectors;
+	class idClipTree *		clipTree;				// used instead of the clip sectors when not NULL
 	idBounds				worldBounds;
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
 	mutable int				touchCount;
+							// candidates shared by the traces of a batch
+	idClipModel **			batchClipModels;
+	idBounds *				batchBounds;
+							// trace recording
+	idFile *				traceRecordFile;
+	int						numTracesToRecord;
 							// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -324,9 +353,13 @@ private:
 private:
 	struct clipSector_s *	CreateClipSectors_r( const int depth, const idBounds &bounds, idVec3 &maxSector );
 	void					ClipModelsTouchingBounds_r( const struct clipSector_s *node, struct listParms_s &parms ) const;
+	void					ClipModelsTouchingBoundsTree( struct listParms_s &parms ) const;
 	const idTraceModel *	TraceModelForClipModel( const idClipModel *mdl ) const;
 	int						GetTraceClipModels( const idBounds &bounds, int contentMask, const idEntity *passEntity, idClipModel **clipModelList ) const;
 	void					TraceRenderModel( trace_t &trace, const idVec3 &start, const idVec3 &end, const float radius, const idMat3 &axis, idClipModel *touch ) const;
+	void					TranslationGroup( trace_t *results, const clipTrace_t *traces, const int *group, const int groupSize,
+								const idBounds *traceBounds, const float *radius, const idTraceModel **trm, const idBounds &groupBounds, int contentMask );
+	void					RecordTrace( const idVec3 &start, const idVec3 &end, const idClipModel *mdl, const idMat3 &trmAxis, int contentMask, const idEntity *passEntity );
 };
 
 
@@ -62,6 +62,94 @@ static int numArticulatedFigures = 0;
 static idTimer timer_total, timer_pc, timer_ac, timer_collision, timer_lcp;
 #endif
 
+static bool evaluatingIslands = false;		// timers and statistics are shared so they're not used while solving in jobs
+
+// warnings from the constraint solving in jobs are printed by the main thread after the jobs completed
+const int AF_MAX_SOLVE_WARNINGS = 8;
+
+typedef struct {
+	const idPhysics_AF *	figure;
+	char					text[MAX_STRING_CHARS];
+} afSolveWarning_t;
+
+static afSolveWarning_t afSolveWarnings[AF_MAX_SOLVE_WARNINGS];
+static idSysInterlockedInteger afNumSolveWarnings;
+
+/*
+================
+AF_SolveWarning
+================
+*/
+static void AF_SolveWarning( const idPhysics_AF *figure, const char *fmt, ... ) id_attribute((format(printf,2,3)));
+
+static void AF_SolveWarning( const idPhysics_AF *figure, const char *fmt, ... ) {
+	va_list argptr;
+	char text[MAX_STRING_CHARS];
+
+	va_start( argptr, fmt );
+	idStr::vsnPrintf( text, sizeof( text ), fmt, argptr );
+	va_end( argptr );
+
+	if ( !evaluatingIslands ) {
+		gameLocal.Warning( "%s", text );
+		return;
+	}
+
+	int index = afNumSolveWarnings.Increment() - 1;
+	if ( index < AF_MAX_SOLVE_WARNINGS ) {
+		afSolveWarnings[index].figure = figure;
+		idStr::Copynz( afSolveWarnings[index].text, text, sizeof( afSolveWarnings[index].text ) );
+	}
+}
+
+/*
+================
+AF_PrintSolveWarnings
+
+  prints the warnings in the order of the solved figures instead of the order the jobs completed in
+================
+*/
+static void AF_PrintSolveWarnings( idPhysics_AF * const *figures, int numFigures ) {
+	int i, j, num, order[AF_MAX_SOLVE_WARNINGS], sorted[AF_MAX_SOLVE_WARNINGS];
+
+	num = afNumSolveWarnings.GetValue();
+	for ( i = 0; i < num && i < AF_MAX_SOLVE_WARNINGS; i++ ) {
+		for ( order[i] = 0; order[i] < numFigures; order[i]++ ) {
+			if ( figures[order[i]] == afSolveWarnings[i].figure ) {
+				break;
+			}
+		}
+		// insertion sort keeps the warnings of a figure in the order they were added
+		for ( j = i; j > 0 && order[sorted[j-1]] > order[i]; j-- ) {
+			sorted[j] = sorted[j-1];
+		}
+		sorted[j] = i;
+	}
+	for ( j = 0; j < i; j++ ) {
+		gameLocal.Warning( "%s", afSolveWarnings[sorted[j]].text );
+	}
+	if ( num > AF_MAX_SOLVE_WARNINGS ) {
+		gameLocal.Warning( "%d more articulated figure solve warnings", num - AF_MAX_SOLVE_WARNINGS );
+	}
+	afNumSolveWarnings.SetValue( 0 );
+}
+
+typedef struct afSolverStats_s {
+	const char *			name;
+	int						numProblems;
+	int						numRows;
+	int						numFailed;
+	double					time;
+	float					maxError;
+	double					totalError;
+} afSolverStats_t;
+
+static afSolverStats_t afSolverStats[3] = {
+	{ "square" }, { "symmetric" }, { "gaussSeidel" }
+};
+
+const float AF_ISLAND_MARGIN				= 4.0f;		// distance below which figures are merged into one island
+
 
 
 //===============================================================
@@ -4503,7 +4591,7 @@ void idAFTree::Factor( void ) const {
 
 				child->invI = childI;
 				if ( !child->invI.InverseFastSelf() ) {
-					gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for constraint '%s'",
+					AF_SolveWarning( child->physics, "idAFTree::Factor: couldn't invert %dx%d matrix for constraint '%s'",
 									child->invI.GetNumRows(), child->invI.GetNumColumns(), child->GetName().c_str() );
 				}
 				child->J = child->invI * child->J;
@@ -4513,7 +4601,7 @@ void idAFTree::Factor( void ) const {
 
 			body->invI = body->I;
 			if ( !body->invI.InverseFastSelf() ) {
-				gameLocal.Warning( "idAFTree::Factor: couldn't invert %dx%d matrix for body %s",
+				AF_SolveWarning( child->physics, "idAFTree::Factor: couldn't invert %dx%d matrix for body %s",
 								child->invI.GetNumRows(), child->invI.GetNumColumns(), body->GetName().c_str() );
 			}
 			if ( body->primaryConstraint ) {
@@ -5219,8 +5307,28 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 		}
 	}
 
+	// start from the forces of the previous frame, the frame constraints are new every frame
+	for ( k = 0, i = 0; i < auxiliaryConstraints.Num(); i++ ) {
+		constraint = auxiliaryConstraints[i];
+		if ( i >= auxiliaryConstraints.Num() - frameConstraints.Num() ) {
+			for ( j = 0; j < constraint->J1.GetNumRows(); j++, k++ ) {
+				lm[k] = 0.0f;
+			}
+		} else {
+			for ( j = 0; j < constraint->J1.GetNumRows(); j++, k++ ) {
+				lm[k] = constraint->lm[j];
+			}
+		}
+	}
+
+	if ( af_compareSolvers.GetBool() && !evaluatingIslands ) {
+		CompareSolvers( jmk, lm, rhs, lo, hi, boxIndex );
+	}
+
 #ifdef AF_TIMINGS
-	timer_lcp.Start();
+	if ( !evaluatingIslands ) {
+		timer_lcp.Start();
+	}
 #endif
 
 	// calculate lagrange multipliers for auxiliary constraints
@@ -5229,7 +5337,9 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	}
 
 #ifdef AF_TIMINGS
-	timer_lcp.Stop();
+	if ( !evaluatingIslands ) {
+		timer_lcp.Stop();
+	}
 #endif
 
 	// calculate auxiliary constraint forces
@@ -5264,6 +5374,122 @@ void idPhysics_AF::AuxiliaryForces( float timeStep ) {
 	}
 }
 
+/*
+================
+AF_LCPError
+
+  Returns the largest violation of the bounds and complementarity conditions by the solution.
+================
+*/
+static float AF_LCPError( const idMatX &m, const idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex ) {
+	int i;
+	float a, l, h, error, maxError;
+	const float boundEpsilon = 1e-3f;
+
+	maxError = 0.0f;
+	for ( i = 0; i < x.GetSize(); i++ ) {
+		SIMDProcessor->Dot( a, m[i], x.ToFloatPtr(), x.GetSize() );
+		a -= b[i];
+
+		if ( boxIndex[i] != -1 ) {
+			l = - idMath::Fabs( lo[i] * x[boxIndex[i]] );
+			h = idMath::Fabs( hi[i] * x[boxIndex[i]] );
+		} else {
+			l = lo[i];
+			h = hi[i];
+		}
+
+		if ( x[i] < l - boundEpsilon ) {
+			error = l - x[i];
+		} else if ( x[i] > h + boundEpsilon ) {
+			error = x[i] - h;
+		} else if ( x[i] <= l + boundEpsilon && x[i] >= h - boundEpsilon ) {
+			error = 0.0f;
+		} else if ( x[i] <= l + boundEpsilon ) {
+			error = Max( -a, 0.0f );
+		} else if ( x[i] >= h - boundEpsilon ) {
+			error = Max( a, 0.0f );
+		} else {
+			error = idMath::Fabs( a );
+		}
+		maxError = Max( maxError, error );
+	}
+	return maxError;
+}
+
+/*
+================
+idPhysics_AF::CompareSolvers
+
+  Solves the auxiliary constraints with each of the lcp solvers and gathers statistics.
+================
+*/
+void idPhysics_AF::CompareSolvers( const idMatX &m, const idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex ) const {
+	int i;
+	float error;
+	idLCP *solvers[3];
+	idVecX solution;
+	idTimer timer;
+
+	solvers[0] = idLCP::AllocSquare();
+	solvers[1] = idLCP::AllocSymmetric();
+	solvers[2] = idLCP::AllocGaussSeidel();
+	if ( solver == DECLAF_SOLVER_GAUSS_SEIDEL ) {
+		solvers[2]->SetMaxIterations( lcp->GetMaxIterations() );
+	}
+
+	solution.SetData( x.GetSize(), VECX_ALLOCA( x.GetSize() ) );
+
+	for ( i = 0; i < 3; i++ ) {
+		afSolverStats_t &stats = afSolverStats[i];
+
+		solution = x;
+
+		timer.Clear();
+		timer.Start();
+		if ( !solvers[i]->Solve( m, solution, b, lo, hi, boxIndex ) ) {
+			stats.numFailed++;
+		}
+		timer.Stop();
+
+		error = AF_LCPError( m, solution, b, lo, hi, boxIndex );
+
+		stats.numProblems++;
+		stats.numRows += x.GetSize();
+		stats.time += timer.Milliseconds();
+		stats.maxError = Max( stats.maxError, error );
+		stats.totalError += error;
+
+		delete solvers[i];
+	}
+}
+
+/*
+================
+idPhysics_AF::PrintSolverStats
+================
+*/
+void idPhysics_AF::PrintSolverStats( void ) {
+	int i;
+
+	gameLocal.Printf( "solver       problems  avg rows  avg ms   failed  avg error  max error\n" );
+	for ( i = 0; i < 3; i++ ) {
+		afSolverStats_t &stats = afSolverStats[i];
+		if ( stats.numProblems == 0 ) {
+			continue;
+		}
+		gameLocal.Printf( "%-12s %8d  %8.1f  %6.4f  %6d  %9.5f  %9.5f\n", stats.name, stats.numProblems,
+							(float) stats.numRows / stats.numProblems, stats.time / stats.numProblems,
+							stats.numFailed, stats.totalError / stats.numProblems, stats.maxError );
+		stats.numProblems = 0;
+		stats.numRows = 0;
+		stats.numFailed = 0;
+		stats.time = 0.0;
+		stats.maxError = 0.0f;
+		stats.totalError = 0.0;
+	}
+}
+
 /*
 ================
 idPhysics_AF::VerifyContactConstraints
@@ -5804,6 +6030,26 @@ void idPhysics_AF::UpdateClipModels( void ) {
 	}
 }
 
+/*
+================
+idPhysics_AF::SetSolver
+================
+*/
+void idPhysics_AF::SetSolver( const declAFSolver_t newSolver, const int iterations ) {
+	if ( newSolver != solver ) {
+		delete lcp;
+		if ( newSolver == DECLAF_SOLVER_GAUSS_SEIDEL ) {
+			lcp = idLCP::AllocGaussSeidel();
+		} else {
+			lcp = idLCP::AllocSymmetric();
+		}
+		solver = newSolver;
+	}
+	if ( iterations > 0 ) {
+		lcp->SetMaxIterations( iterations );
+	}
+}
+
 /*
 ================
 idPhysics_AF::SetSuspendSpeed
@@ -6211,10 +6457,13 @@ const idBounds &idPhysics_AF::GetAbsBounds( int id ) const {
 
 /*
 ================
-idPhysics_AF::Evaluate
+idPhysics_AF::EvaluateBegin
+
+  Everything up to the constraint solving that talks to the rest of the world.
+  Returns false if the figure doesn't need to be solved this frame.
 ================
 */
-bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
+bool idPhysics_AF::EvaluateBegin( int timeStepMSec, int endTimeMSec ) {
 	float timeStep;
 
 	if ( timeScaleRampStart < MS2SEC( endTimeMSec ) && timeScaleRampEnd > MS2SEC( endTimeMSec ) ) {
@@ -6226,6 +6475,8 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	}
 	current.lastTimeStep = timeStep;
 
+	evaluateTimeStep = timeStep;
+	evaluateEndTimeMSec = endTimeMSec;
 
 	// if the articulated figure changed
 	if ( changedAF || ( linearTime != af_useLinearTime.GetBool() ) ) {
@@ -6256,11 +6507,10 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	AddPushVelocity( -current.pushVelocity );
 
 #ifdef AF_TIMINGS
-	timer_total.Start();
-#endif
-
-#ifdef AF_TIMINGS
-	timer_collision.Start();
+	if ( !evaluatingIslands ) {
+		timer_total.Start();
+		timer_collision.Start();
+	}
 #endif
 
 	// evaluate contacts
@@ -6270,27 +6520,48 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	SetupContactConstraints();
 
 #ifdef AF_TIMINGS
-	timer_collision.Stop();
+	if ( !evaluatingIslands ) {
+		timer_collision.Stop();
+	}
 #endif
 
+	return true;
+}
+
+/*
+================
+idPhysics_AF::EvaluateSolve
+
+  Solves the constraints and evolves the bodies to the next state.
+  Only touches the figure itself so it can run in a job.
+================
+*/
+void idPhysics_AF::EvaluateSolve( void ) {
+	int i;
+	float timeStep = evaluateTimeStep;
+
 	// evaluate constraint equations
 	EvaluateConstraints( timeStep );
 
 	// apply friction
-	ApplyFriction( timeStep, endTimeMSec );
+	ApplyFriction( timeStep, evaluateEndTimeMSec );
 
 	// add frame constraints
 	AddFrameConstraints();
 
-#ifdef AF_TIMINGS
-	int i, numPrimary = 0, numAuxiliary = 0;
+	numPrimaryRows = 0;
 	for ( i = 0; i < primaryConstraints.Num(); i++ ) {
-		numPrimary += primaryConstraints[i]->J1.GetNumRows();
+		numPrimaryRows += primaryConstraints[i]->J1.GetNumRows();
 	}
+	numAuxiliaryRows = 0;
 	for ( i = 0; i < auxiliaryConstraints.Num(); i++ ) {
-		numAuxiliary += auxiliaryConstraints[i]->J1.GetNumRows();
+		numAuxiliaryRows += auxiliaryConstraints[i]->J1.GetNumRows();
+	}
+
+#ifdef AF_TIMINGS
+	if ( !evaluatingIslands ) {
+		timer_pc.Start();
 	}
-	timer_pc.Start();
 #endif
 
 	// factor matrices for primary constraints
@@ -6300,19 +6571,44 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	PrimaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_pc.Stop();
-	timer_ac.Start();
+	if ( !evaluatingIslands ) {
+		timer_pc.Stop();
+		timer_ac.Start();
+	}
 #endif
 
 	// calculate and apply auxiliary constraint forces
 	AuxiliaryForces( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_ac.Stop();
+	if ( !evaluatingIslands ) {
+		timer_ac.Stop();
+	}
 #endif
 
 	// evolve current state to next state
 	Evolve( timeStep );
+}
+
+/*
+================
+idPhysics_AF::EvaluateSolveJob
+================
+*/
+void idPhysics_AF::EvaluateSolveJob( void *data ) {
+	( (idPhysics_AF *)data )->EvaluateSolve();
+}
+
+/*
+================
+idPhysics_AF::EvaluateEnd
+
+  Collision response and resting after the new state has been solved.
+================
+*/
+bool idPhysics_AF::EvaluateEnd( void ) {
+	float timeStep = evaluateTimeStep;
+	int endTimeMSec = evaluateEndTimeMSec;
 
 	// debug graphics
 	DebugDraw();
@@ -6327,14 +6623,18 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	RemoveFrameConstraints();
 
 #ifdef AF_TIMINGS
-	timer_collision.Start();
+	if ( !evaluatingIslands ) {
+		timer_collision.Start();
+	}
 #endif
 
 	// check for collisions between current and next state
 	CheckForCollisions( timeStep );
 
 #ifdef AF_TIMINGS
-	timer_collision.Stop();
+	if ( !evaluatingIslands ) {
+		timer_collision.Stop();
+	}
 #endif
 
 	// swap the current and next state
@@ -6372,14 +6672,19 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	}
 
 #ifdef AF_TIMINGS
+	// figures solved in jobs aren't timed
+	if ( evaluatingIslands ) {
+		return true;
+	}
+
 	timer_total.Stop();
 
 	if ( af_showTimings.GetInteger() == 1 ) {
 		gameLocal.Printf( "%12s: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
 						self->name.c_str(),
 						timer_total.Milliseconds(),
-						numPrimary, timer_pc.Milliseconds(),
-						numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
+						numPrimaryRows, timer_pc.Milliseconds(),
+						numAuxiliaryRows, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
 						timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
 	}
 	else if ( af_showTimings.GetInteger() == 2 ) {
@@ -6388,8 +6693,8 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 			gameLocal.Printf( "af %d: t %1.4f pc %2d, %1.4f ac %2d %1.4f lcp %1.4f cd %1.4f\n",
 							numArticulatedFigures,
 							timer_total.Milliseconds(),
-							numPrimary, timer_pc.Milliseconds(),
-							numAuxiliary, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
+							numPrimaryRows, timer_pc.Milliseconds(),
+							numAuxiliaryRows, timer_ac.Milliseconds() - timer_lcp.Milliseconds(),
 							timer_lcp.Milliseconds(), timer_collision.Milliseconds() );
 		}
 	}
@@ -6408,6 +6713,172 @@ bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
 	return true;
 }
 
+/*
+================
+idPhysics_AF::Evaluate
+================
+*/
+bool idPhysics_AF::Evaluate( int timeStepMSec, int endTimeMSec ) {
+
+	// the figure may already have been evaluated for this frame by EvaluateIslands
+	if ( preEvaluatedTime == endTimeMSec ) {
+		preEvaluatedTime = -1;
+		return preEvaluatedResult;
+	}
+	preEvaluatedTime = -1;
+
+	if ( !EvaluateBegin( timeStepMSec, endTimeMSec ) ) {
+		return false;
+	}
+
+	EvaluateSolve();
+
+	return EvaluateEnd();
+}
+
+/*
+================
+idPhysics_AF::CanEvaluateInParallel
+
+  Figures bound to a master or with constraints that trace
+  through the world can't be solved in a job.
+================
+*/
+bool idPhysics_AF::CanEvaluateInParallel( void ) const {
+	int i;
+
+	if ( masterBody != NULL ) {
+		return false;
+	}
+	for ( i = 0; i < constraints.Num(); i++ ) {
+		if ( constraints[i]->GetType() == CONSTRAINT_SUSPENSION ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idPhysics_AF::EvaluateIslands
+
+  Figures are grouped into islands by their bounds expanded with the distance
+  they can travel this frame.  The figures on an island can't touch any of the
+  figures on other islands.  Within an island the figures are evaluated one
+  after the other in the order they are passed in, so each figure sees the
+  figures before it at their new position the same way a serial evaluation
+  does.  The n-th figures of all islands are evaluated together: everything
+  that queries or changes the world runs serially and only the constraints
+  are solved in jobs.  This keeps the results the same regardless of the
+  number of job threads.  The caller is responsible for disabling team clip
+  models as idEntity::RunPhysics does.
+================
+*/
+void idPhysics_AF::EvaluateIslands( idPhysics_AF **figures, int numFigures, int timeStepMSec, int endTimeMSec, idParallelJobList *jobList ) {
+	int i, j, root, other, pass, numEvaluated;
+	float timeStep, expand;
+	idPhysics_AF *af;
+	idList<idBounds, idListFrameAllocator<idBounds> > islandBounds;
+	idList<int, idListFrameAllocator<int> > island;
+	idList<int, idListFrameAllocator<int> > islandSize;
+	idList<int, idListFrameAllocator<int> > islandPass;
+	idList<idPhysics_AF *, idListFrameAllocator<idPhysics_AF *> > solving;
+
+	if ( numFigures <= 0 ) {
+		return;
+	}
+
+	timeStep = MS2SEC( timeStepMSec );
+
+	islandBounds.SetNum( numFigures );
+	island.SetNum( numFigures );
+	islandSize.SetNum( numFigures );
+	islandPass.SetNum( numFigures );
+
+	for ( i = 0; i < numFigures; i++ ) {
+		af = figures[i];
+		expand = AF_ISLAND_MARGIN;
+		for ( j = 0; j < af->bodies.Num(); j++ ) {
+			expand = Max( expand, af->bodies[j]->current->spatialVelocity.SubVec3(0).Length() * timeStep + AF_ISLAND_MARGIN );
+		}
+		islandBounds[i] = af->GetAbsBounds().Expand( expand );
+		island[i] = i;
+		islandSize[i] = 0;
+	}
+
+	// merge figures with touching bounds into islands
+	for ( i = 0; i < numFigures; i++ ) {
+		for ( j = i + 1; j < numFigures; j++ ) {
+			if ( !islandBounds[i].IntersectsBounds( islandBounds[j] ) ) {
+				continue;
+			}
+			for ( root = i; island[root] != root; root = island[root] ) {
+			}
+			for ( other = j; island[other] != other; other = island[other] ) {
+			}
+			if ( root != other ) {
+				island[Max( root, other )] = Min( root, other );
+			}
+		}
+	}
+	for ( i = 0; i < numFigures; i++ ) {
+		for ( root = i; island[root] != root; root = island[root] ) {
+		}
+		island[i] = root;
+		// the pass in which the figure is evaluated is its position on the island
+		islandPass[i] = islandSize[root]++;
+	}
+
+	for ( pass = 0; ; pass++ ) {
+
+		evaluatingIslands = true;
+
+		// serially set up the figures evaluated in this pass
+		numEvaluated = 0;
+		solving.SetNum( 0, false );
+		for ( i = 0; i < numFigures; i++ ) {
+			if ( islandPass[i] != pass ) {
+				continue;
+			}
+			numEvaluated++;
+			af = figures[i];
+			af->preEvaluatedTime = endTimeMSec;
+			af->preEvaluatedResult = af->EvaluateBegin( timeStepMSec, endTimeMSec );
+			if ( af->preEvaluatedResult ) {
+				solving.Append( af );
+			}
+		}
+
+		if ( !numEvaluated ) {
+			evaluatingIslands = false;
+			break;
+		}
+
+		// solve the constraints in parallel
+#ifdef ID_THREAD_LOCAL
+		for ( i = 0; i < solving.Num(); i++ ) {
+			jobList->AddJob( EvaluateSolveJob, solving[i] );
+		}
+		jobList->Submit();
+		jobList->Wait();
+#else
+		// the solver temp memory is shared between threads without thread local storage
+		for ( i = 0; i < solving.Num(); i++ ) {
+			solving[i]->EvaluateSolve();
+		}
+#endif
+
+		evaluatingIslands = false;
+
+		AF_PrintSolveWarnings( solving.Ptr(), solving.Num() );
+
+		// serially finish the figures in the order they are passed in
+		for ( i = 0; i < solving.Num(); i++ ) {
+			solving[i]->preEvaluatedResult = solving[i]->EvaluateEnd();
+		}
+	}
+}
+
 /*
 ================
 idPhysics_AF::UpdateTime
@@ -6598,6 +7069,14 @@ idPhysics_AF::idPhysics_AF( void ) {
 	masterBody = NULL;
 
 	lcp = idLCP::AllocSymmetric();
+	solver = DECLAF_SOLVER_DANTZIG;
+
+	evaluateTimeStep = 0.0f;
+	evaluateEndTimeMSec = 0;
+	numPrimaryRows = 0;
+	numAuxiliaryRows = 0;
+	preEvaluatedTime = -1;
+	preEvaluatedResult = false;
 
 	memset( &current, 0, sizeof( current ) );
 	current.atRest = -1;
@@ -875,6 +875,8 @@ public:
 	void					SetCollision( const bool enable ) { enableCollision = enable; }
 							// enable or disable self collision
 	void					SetSelfCollision( const bool enable ) { selfCollision = enable; }
+							// set the solver for the auxiliary constraints, zero iterations uses the solver default
+	void					SetSolver( const declAFSolver_t newSolver, const int iterations );
 							// enable or disable coming to a dead stop
 	void					SetComeToRest( bool enable ) { comeToRest = enable; }
 							// call when structure of articulated figure changes
@@ -946,6 +948,13 @@ public:	// common physics interface
 
 	bool					EvaluateContacts( void );
 
+							// print and clear the statistics gathered with af_compareSolvers
+	static void				PrintSolverStats( void );
+
+							// evaluate independent figures with the constraint solving spread over job threads
+	static void				EvaluateIslands( idPhysics_AF **figures, int numFigures, int timeStepMSec, int endTimeMSec, idParallelJobList *jobList );
+	bool					CanEvaluateInParallel( void ) const;
+
 	void					SetPushed( int deltaTime );
 	const idVec3 &			GetPushedLinearVelocity( const int id = 0 ) const;
 	const idVec3 &			GetPushedAngularVelocity( const int id = 0 ) const;
@@ -1015,8 +1024,21 @@ private:
 
 	idAFBody *				masterBody;						// master body
 	idLCP *					lcp;							// linear complementarity problem solver
+	declAFSolver_t			solver;							// type of the lcp solver
+
+							// evaluation split over EvaluateBegin, EvaluateSolve and EvaluateEnd
+	float					evaluateTimeStep;				// time step of the evaluation in progress
+	int						evaluateEndTimeMSec;			// end time of the evaluation in progress
+	int						numPrimaryRows;					// rows in the primary constraints of the last solve
+	int						numAuxiliaryRows;				// rows in the auxiliary constraints of the last solve
+	int						preEvaluatedTime;				// end time of an evaluation already done by EvaluateIslands
+	bool					preEvaluatedResult;				// result of that evaluation
 
 private:
+	bool					EvaluateBegin( int timeStepMSec, int endTimeMSec );
+	void					EvaluateSolve( void );
+	bool					EvaluateEnd( void );
+	static void				EvaluateSolveJob( void *data );
 	void					BuildTrees( void );
 	bool					IsClosedLoop( const idAFBody *body1, const idAFBody *body2 ) const;
 	void					PrimaryFactor( void );
@@ -1027,6 +1049,7 @@ private:
 	void					ApplyFriction( float timeStep, float endTimeMSec );
 	void					PrimaryForces( float timeStep  );
 	void					AuxiliaryForces( float timeStep );
+	void					CompareSolvers( const idMatX &m, const idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex ) const;
 	void					VerifyContactConstraints( void );
 	void					SetupContactConstraints( void );
 	void					ApplyContactForces( void );
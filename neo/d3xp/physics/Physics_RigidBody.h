@@ -152,6 +152,9 @@ public:	// common physics interface
 	void					WriteToSnapshot( idBitMsgDelta &msg ) const;
 	void					ReadFromSnapshot( const idBitMsgDelta &msg );
 
+							// print and clear contact cache and island sleep statistics
+	static void				PrintStats( void );
+
 private:
 	// state of the rigid body
 	rigidBodyPState_t		current;
@@ -181,6 +184,16 @@ private:
 	bool					hasMaster;
 	bool					isOrientated;
 
+	// contact cache
+	idList<contactInfo_t>	cachedContacts;				// contacts from the last contact query
+	idVec3					contactCacheOrigin;			// clip model origin when the contacts were cached
+	idMat3					contactCacheAxis;			// clip model axis when the contacts were cached
+	int						contactCacheTime;			// time the contacts were cached, -1 if invalid
+	int						contactCacheNumEntities;	// number of touching entities when the contacts were cached
+
+	// island sleeping
+	int						sleepStartTime;				// time the body started moving slowly while in contact, -1 if not
+
 private:
 	friend void				RigidBodyDerivatives( const float t, const void *clientData, const float *state, float *derivatives );
 	void					Integrate( const float deltaTime, rigidBodyPState_t &next );
@@ -189,7 +202,12 @@ private:
 	void					ContactFriction( float deltaTime );
 	void					DropToFloorAndRest( void );
 	bool					TestIfAtRest( void ) const;
+	bool					TestIfSupported( const float stopSpeed ) const;
 	void					Rest( void );
+	bool					UseCachedContacts( void ) const;
+	bool					TestIfSleeping( void );
+	bool					IsSleepy( void ) const;
+	bool					SleepIsland( void );
 	void					DebugDraw( void );
 };
 
@@ -600,6 +600,7 @@ idVarDef *idCompiler::EmitOpcode( const opcode_t *op, idVarDef *var_a, idVarDef
 	}
 
 	statement->op	= op - opcodes;
+	statement->execOp = statement->op;
 	statement->a	= var_a;
 	statement->b	= var_b;
 	statement->c	= var_c;
@@ -1599,6 +1599,7 @@ void idProgram::BeginCompilation( void ) {
 		statement->linenumber	= 0;
 		statement->file 		= 0;
 		statement->op			= OP_RETURN;
+		statement->execOp		= OP_RETURN;
 		statement->a			= NULL;
 		statement->b			= NULL;
 		statement->c			= NULL;
@@ -1764,6 +1765,85 @@ void idProgram::CompileStats( void ) {
 	gameLocal.Printf( " Thread size: %d bytes\n\n", sizeof( idThread ) );
 }
 
+/*
+================
+idProgram::CreateSuperInstructions
+
+Combines common statement sequences into superinstructions.  The original
+statements are left untouched, so jumps into the middle of a sequence,
+the disassembly and the checksum are the same as without superinstructions.
+================
+*/
+void idProgram::CreateSuperInstructions( int firstStatement ) {
+	int			i;
+	int			numSuperInstructions;
+	statement_t	*st;
+	statement_t	*next;
+
+	for( i = firstStatement; i < statements.Num(); i++ ) {
+		statements[ i ].execOp = statements[ i ].op;
+	}
+
+	// an opcode with a result followed by an OP_IFNOT on that result
+	numSuperInstructions = 0;
+	for( i = firstStatement; i < statements.Num() - 1; i++ ) {
+		st = &statements[ i ];
+		next = &statements[ i + 1 ];
+		if ( ( next->op != OP_IFNOT ) || !st->c || ( next->a != st->c ) ) {
+			continue;
+		}
+
+		switch( st->op ) {
+		case OP_EQ_F:			st->execOp = OP_EQ_F_IFNOT; break;
+		case OP_NE_F:			st->execOp = OP_NE_F_IFNOT; break;
+		case OP_EQ_E:
+		case OP_EQ_EO:
+		case OP_EQ_OE:
+		case OP_EQ_OO:			st->execOp = OP_EQ_E_IFNOT; break;
+		case OP_NE_E:
+		case OP_NE_EO:
+		case OP_NE_OE:
+		case OP_NE_OO:			st->execOp = OP_NE_E_IFNOT; break;
+		case OP_LE:				st->execOp = OP_LE_IFNOT; break;
+		case OP_GE:				st->execOp = OP_GE_IFNOT; break;
+		case OP_LT:				st->execOp = OP_LT_IFNOT; break;
+		case OP_GT:				st->execOp = OP_GT_IFNOT; break;
+		case OP_NOT_F:			st->execOp = OP_NOT_F_IFNOT; break;
+		case OP_NOT_BOOL:		st->execOp = OP_NOT_BOOL_IFNOT; break;
+		case OP_NOT_ENT:		st->execOp = OP_NOT_ENT_IFNOT; break;
+		case OP_INDIRECT_F:		st->execOp = OP_INDIRECT_F_IFNOT; break;
+		case OP_INDIRECT_BOOL:	st->execOp = OP_INDIRECT_BOOL_IFNOT; break;
+		default:				continue;
+		}
+		numSuperInstructions++;
+	}
+
+	// an object field load followed by a float compare with the field and an OP_IFNOT on the result
+	for( i = firstStatement; i < statements.Num() - 1; i++ ) {
+		st = &statements[ i ];
+		next = &statements[ i + 1 ];
+		if ( ( st->op != OP_INDIRECT_F ) || ( ( next->a != st->c ) && ( next->b != st->c ) ) ) {
+			continue;
+		}
+
+		switch( next->execOp ) {
+		case OP_EQ_F_IFNOT:
+		case OP_NE_F_IFNOT:
+		case OP_LE_IFNOT:
+		case OP_GE_IFNOT:
+		case OP_LT_IFNOT:
+		case OP_GT_IFNOT:
+			st->execOp = OP_INDIRECT_F_COMPARE_IFNOT;
+			numSuperInstructions++;
+			break;
+		}
+	}
+
+	if ( g_debugScript.GetBool() ) {
+		gameLocal.Printf( "%d superinstructions in %d statements\n", numSuperInstructions, statements.Num() - firstStatement );
+	}
+}
+
 /*
 ================
 idProgram::CompileText
@@ -1772,12 +1852,14 @@ idProgram::CompileText
 bool idProgram::CompileText( const char *source, const char *text, bool console ) {
 	idCompiler	compiler;
 	int			i;
+	int			firstStatement;
 	idVarDef	*def;
 	idStr		ospath;
 
 	// use a full os path for GetFilenum since it calls OSPathToRelativePath to convert filenames from the parser
 	ospath = fileSystem->RelativePathToOSPath( source );
 	filenum = GetFilenum( ospath );
+	firstStatement = statements.Num();
 
 	try {
 		compiler.CompileFile( text, filename, console );
@@ -1794,6 +1876,7 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 	}
 	
 	catch( idCompileError &err ) {
+		CreateSuperInstructions( firstStatement );
 		if ( console ) {
 			gameLocal.Printf( "%s\n", err.error );
 			return false;
@@ -1802,6 +1885,8 @@ bool idProgram::CompileText( const char *source, const char *text, bool console
 		}
 	};
 
+	CreateSuperInstructions( firstStatement );
+
 	if ( !console ) {
 		CompileStats();
 	}
@@ -1856,6 +1941,663 @@ void idProgram::CompileFile( const char *filename ) {
 	}
 }
 
+/***********************************************************************
+
+  Program cache
+
+  The program compiled from the default script is written to a binary
+  cache together with the checksums of all the script files it includes.
+  As long as none of those files change the next startup loads the types,
+  defs, functions, statements and global variables from the cache instead
+  of compiling.  Pointers are stored as indices, the built-in types and
+  defs that are not part of the program get the first indices.
+
+***********************************************************************/
+
+static idTypeDef *	cacheBuiltinTypes[] = {
+	&type_void, &type_scriptevent, &type_namespace, &type_string, &type_float, &type_vector, &type_entity, &type_field,
+	&type_function, &type_virtualfunction, &type_pointer, &type_object, &type_jumpoffset, &type_argsize, &type_boolean
+};
+
+static idVarDef *	cacheBuiltinDefs[] = {
+	&def_void, &def_scriptevent, &def_namespace, &def_string, &def_float, &def_vector, &def_entity, &def_field,
+	&def_function, &def_virtualfunction, &def_pointer, &def_object, &def_jumpoffset, &def_argsize, &def_boolean
+};
+
+static const int	NUM_CACHE_BUILTINS = sizeof( cacheBuiltinTypes ) / sizeof( cacheBuiltinTypes[ 0 ] );
+
+// how the value of a def is stored in the cache
+enum {
+	CACHE_VALUE_INT,			// stack offset, object field offset, jump offset, etc.
+	CACHE_VALUE_GLOBAL,			// offset in the global variables
+	CACHE_VALUE_FUNCTION		// function index
+};
+
+/*
+================
+CachePointerKey
+================
+*/
+static int CachePointerKey( const void *ptr ) {
+	return ( int )( ( size_t )ptr >> 4 );
+}
+
+/*
+================
+CacheReadInt
+================
+*/
+static int CacheReadInt( idFile *file ) {
+	int value;
+
+	if ( file->ReadInt( value ) != sizeof( value ) ) {
+		throw idCompileError( "is truncated" );
+	}
+	return value;
+}
+
+/*
+================
+ScriptFileChecksum
+================
+*/
+static bool ScriptFileChecksum( const char *fileName, int &length, int &checksum ) {
+	void *buffer;
+
+	length = fileSystem->ReadFile( fileName, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+	checksum = MD4_BlockChecksum( buffer, length );
+	fileSystem->FreeFile( buffer );
+	return true;
+}
+
+/*
+================
+idProgram::CacheFileName
+================
+*/
+idStr idProgram::CacheFileName( const char *defaultScript ) {
+	idStr cacheName;
+
+	cacheName = defaultScript;
+	cacheName.SetFileExtension( SCRIPT_CACHE_FILEEXT );
+	return cacheName;
+}
+
+/*
+================
+idProgram::FindSourceFiles
+
+Adds the file and all the files it includes to the list.  Includes are
+resolved the way idParser does, a conditional include is always added.
+================
+*/
+void idProgram::FindSourceFiles( const char *fileName, idStrList &files ) {
+	int			i, length;
+	void		*buffer;
+	idLexer		src;
+	idToken		token;
+	idStr		path;
+	idStrList	includes;
+
+	for ( i = 0; i < files.Num(); i++ ) {
+		if ( !files[ i ].Icmp( fileName ) ) {
+			return;
+		}
+	}
+
+	length = fileSystem->ReadFile( fileName, &buffer, NULL );
+	if ( length < 0 ) {
+		throw idCompileError( va( "couldn't read '%s'", fileName ) );
+	}
+	files.Append( fileName );
+
+	src.SetFlags( LEXFL_NOERRORS | LEXFL_NOWARNINGS | LEXFL_NOSTRINGCONCAT | LEXFL_ALLOWMULTICHARLITERALS );
+	src.LoadMemory( ( const char * )buffer, length, fileName );
+	while( src.ReadToken( &token ) ) {
+		if ( token != "#" ) {
+			continue;
+		}
+		if ( !src.ReadTokenOnLine( &token ) || ( token != "include" ) ) {
+			continue;
+		}
+		if ( !src.ReadTokenOnLine( &token ) || ( token.type != TT_STRING ) ) {
+			continue;
+		}
+
+		// try relative to the current file first
+		path = fileName;
+		path.StripFilename();
+		path += "/";
+		path += token;
+		if ( fileSystem->ReadFile( path, NULL, NULL ) < 0 ) {
+			path = token;
+		}
+		includes.Append( path );
+	}
+	src.FreeSource();
+	fileSystem->FreeFile( buffer );
+
+	for ( i = 0; i < includes.Num(); i++ ) {
+		FindSourceFiles( includes[ i ], files );
+	}
+}
+
+/*
+================
+idProgram::CacheTypeIndex
+================
+*/
+int idProgram::CacheTypeIndex( const idTypeDef *type, const idHashIndex &typeHash ) const {
+	int i;
+
+	if ( !type ) {
+		return -1;
+	}
+	for ( i = 0; i < NUM_CACHE_BUILTINS; i++ ) {
+		if ( cacheBuiltinTypes[ i ] == type ) {
+			return i;
+		}
+	}
+	for ( i = typeHash.First( CachePointerKey( type ) ); i != -1; i = typeHash.Next( i ) ) {
+		if ( types[ i ] == type ) {
+			return NUM_CACHE_BUILTINS + i;
+		}
+	}
+	throw idCompileError( va( "type '%s' is not part of the program", type->Name() ) );
+	return -1;
+}
+
+/*
+================
+idProgram::CacheDefIndex
+================
+*/
+int idProgram::CacheDefIndex( const idVarDef *def ) const {
+	int i;
+
+	if ( !def ) {
+		return -1;
+	}
+	for ( i = 0; i < NUM_CACHE_BUILTINS; i++ ) {
+		if ( cacheBuiltinDefs[ i ] == def ) {
+			return i;
+		}
+	}
+	if ( ( def->num < 0 ) || ( def->num >= varDefs.Num() ) || ( varDefs[ def->num ] != def ) ) {
+		throw idCompileError( va( "def '%s' is not part of the program", def->Name() ) );
+	}
+	return NUM_CACHE_BUILTINS + def->num;
+}
+
+/*
+================
+idProgram::CacheFunctionIndex
+================
+*/
+int idProgram::CacheFunctionIndex( const function_t *func ) const {
+	int index;
+
+	if ( !func ) {
+		return -1;
+	}
+	index = func - &functions[ 0 ];
+	if ( ( index < 0 ) || ( index >= functions.Num() ) ) {
+		throw idCompileError( va( "function '%s' is not part of the program", func->Name() ) );
+	}
+	return index;
+}
+
+/*
+================
+idProgram::CacheType
+================
+*/
+idTypeDef *idProgram::CacheType( int index ) const {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( ( index >= 0 ) && ( index < NUM_CACHE_BUILTINS ) ) {
+		return cacheBuiltinTypes[ index ];
+	}
+	index -= NUM_CACHE_BUILTINS;
+	if ( ( index < 0 ) || ( index >= types.Num() ) ) {
+		throw idCompileError( "has an invalid type" );
+	}
+	return types[ index ];
+}
+
+/*
+================
+idProgram::CacheDef
+================
+*/
+idVarDef *idProgram::CacheDef( int index ) const {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( ( index >= 0 ) && ( index < NUM_CACHE_BUILTINS ) ) {
+		return cacheBuiltinDefs[ index ];
+	}
+	index -= NUM_CACHE_BUILTINS;
+	if ( ( index < 0 ) || ( index >= varDefs.Num() ) ) {
+		throw idCompileError( "has an invalid def" );
+	}
+	return varDefs[ index ];
+}
+
+/*
+================
+idProgram::CacheFunction
+================
+*/
+function_t *idProgram::CacheFunction( int index ) {
+	if ( index == -1 ) {
+		return NULL;
+	}
+	if ( ( index < 0 ) || ( index >= functions.Num() ) ) {
+		throw idCompileError( "has an invalid function" );
+	}
+	return &functions[ index ];
+}
+
+/*
+================
+idProgram::WriteCache
+================
+*/
+void idProgram::WriteCache( const char *defaultScript, float compileTime ) {
+	int				i, j, length, checksum, kind, value;
+	idStr			cacheName;
+	idStrList		sourceFiles;
+	idHashIndex		typeHash;
+	const idVarDef	*def;
+	const idTypeDef	*type;
+
+	cacheName = CacheFileName( defaultScript );
+	idFile_Memory file( cacheName );
+
+	try {
+		file.WriteString( SCRIPT_CACHE_FILEID );
+		file.WriteInt( SCRIPT_CACHE_FILEVERSION );
+		file.WriteInt( NUM_EXEC_OPCODES );
+		file.WriteFloat( compileTime );
+
+		// the files the program was compiled from
+		FindSourceFiles( defaultScript, sourceFiles );
+		FindSourceFiles( SCRIPT_DEFAULTDEFS, sourceFiles );
+		file.WriteInt( sourceFiles.Num() );
+		for ( i = 0; i < sourceFiles.Num(); i++ ) {
+			if ( !ScriptFileChecksum( sourceFiles[ i ], length, checksum ) ) {
+				throw idCompileError( va( "couldn't read '%s'", sourceFiles[ i ].c_str() ) );
+			}
+			file.WriteString( sourceFiles[ i ] );
+			file.WriteInt( length );
+			file.WriteInt( checksum );
+		}
+
+		typeHash.Clear( 1024, types.Num() );
+		for ( i = 0; i < types.Num(); i++ ) {
+			typeHash.Add( CachePointerKey( types[ i ] ), i );
+		}
+
+		file.WriteInt( fileList.Num() );
+		file.WriteInt( types.Num() );
+		file.WriteInt( varDefs.Num() );
+		file.WriteInt( functions.Num() );
+		file.WriteInt( statements.Num() );
+		file.WriteInt( numVariables );
+
+		for ( i = 0; i < fileList.Num(); i++ ) {
+			file.WriteString( fileList[ i ] );
+		}
+
+		for ( i = 0; i < types.Num(); i++ ) {
+			type = types[ i ];
+			file.WriteInt( type->type );
+			file.WriteString( type->name );
+			file.WriteInt( type->size );
+			file.WriteInt( CacheTypeIndex( type->auxType, typeHash ) );
+			file.WriteInt( CacheDefIndex( type->def ) );
+			file.WriteInt( type->parmTypes.Num() );
+			for ( j = 0; j < type->parmTypes.Num(); j++ ) {
+				file.WriteInt( CacheTypeIndex( type->parmTypes[ j ], typeHash ) );
+				file.WriteString( type->parmNames[ j ] );
+			}
+			file.WriteInt( type->functions.Num() );
+			for ( j = 0; j < type->functions.Num(); j++ ) {
+				file.WriteInt( CacheFunctionIndex( type->functions[ j ] ) );
+			}
+		}
+
+		for ( i = 0; i < varDefs.Num(); i++ ) {
+			def = varDefs[ i ];
+			file.WriteInt( CacheTypeIndex( def->TypeDef(), typeHash ) );
+			file.WriteString( def->Name() );
+			file.WriteInt( CacheDefIndex( def->scope ) );
+			file.WriteInt( def->numUsers );
+			file.WriteInt( def->initialized );
+
+			switch( def->Type() ) {
+			case ev_function:
+				kind = CACHE_VALUE_FUNCTION;
+				value = CacheFunctionIndex( def->value.functionPtr );
+				break;
+			case ev_virtualfunction:
+			case ev_jumpoffset:
+			case ev_argsize:
+				kind = CACHE_VALUE_INT;
+				value = def->value.argSize;
+				break;
+			default:
+				if ( ( def->initialized == idVarDef::stackVariable ) || ( def->scope && ( ( def->scope->Type() == ev_function ) || def->scope->TypeDef()->Inherits( &type_object ) ) ) ) {
+					kind = CACHE_VALUE_INT;
+					value = def->value.stackOffset;
+				} else {
+					kind = CACHE_VALUE_GLOBAL;
+					value = def->value.bytePtr - variables;
+					if ( ( value < 0 ) || ( value > numVariables ) ) {
+						throw idCompileError( va( "def '%s' is not a global variable", def->Name() ) );
+					}
+				}
+				break;
+			}
+			file.WriteInt( kind );
+			file.WriteInt( value );
+		}
+
+		for ( i = 0; i < functions.Num(); i++ ) {
+			const function_t &func = functions[ i ];
+			file.WriteString( func.Name() );
+			if ( func.eventdef ) {
+				// the event is looked up by name and must not have changed
+				file.WriteString( func.eventdef->GetName() );
+				file.WriteString( func.eventdef->GetArgFormat() );
+				file.WriteChar( func.eventdef->GetReturnType() );
+			} else {
+				file.WriteString( "" );
+			}
+			file.WriteInt( CacheDefIndex( func.def ) );
+			file.WriteInt( CacheTypeIndex( func.type, typeHash ) );
+			file.WriteInt( func.firstStatement );
+			file.WriteInt( func.numStatements );
+			file.WriteInt( func.parmTotal );
+			file.WriteInt( func.locals );
+			file.WriteInt( func.filenum );
+			file.WriteInt( func.parmSize.Num() );
+			for ( j = 0; j < func.parmSize.Num(); j++ ) {
+				file.WriteInt( func.parmSize[ j ] );
+			}
+		}
+
+		for ( i = 0; i < statements.Num(); i++ ) {
+			const statement_t &st = statements[ i ];
+			file.WriteShort( st.op );
+			file.WriteInt( CacheDefIndex( st.a ) );
+			file.WriteInt( CacheDefIndex( st.b ) );
+			file.WriteInt( CacheDefIndex( st.c ) );
+			file.WriteShort( st.linenumber );
+			file.WriteShort( st.file );
+		}
+
+		file.Write( variables, numVariables );
+
+		file.WriteInt( CacheDefIndex( returnDef ) );
+		file.WriteInt( CacheDefIndex( returnStringDef ) );
+		file.WriteInt( CacheDefIndex( sysDef ) );
+		file.WriteInt( CacheTypeIndex( type_pointer.PointerType(), typeHash ) );
+
+		file.WriteString( SCRIPT_CACHE_FILEID );
+	}
+
+	catch( idCompileError &err ) {
+		gameLocal.Warning( "Couldn't write script cache '%s': %s", cacheName.c_str(), err.error );
+		return;
+	}
+
+	fileSystem->WriteFile( cacheName, file.GetDataPtr(), file.Length() );
+	gameLocal.Printf( "Wrote script cache '%s' for %d files, %d bytes\n", cacheName.c_str(), sourceFiles.Num(), file.Length() );
+}
+
+/*
+================
+idProgram::ReadCache
+
+Throws an idCompileError when the cache is out of date or invalid.  The
+program data is only replaced once all source files are verified.
+================
+*/
+void idProgram::ReadCache( idFile *file, float &compileTime ) {
+	int				i, j, num, length, checksum, cachedLength, cachedChecksum;
+	int				numFiles, numTypes, numDefs, numFunctions, numStatements, kind, value;
+	char			returnType;
+	idStr			str, format;
+	idTypeDef		*type;
+	idVarDef		*def;
+	const idEventDef *ev;
+
+	file->ReadString( str );
+	if ( str != SCRIPT_CACHE_FILEID ) {
+		throw idCompileError( "is not a script cache" );
+	}
+	if ( CacheReadInt( file ) != SCRIPT_CACHE_FILEVERSION ) {
+		throw idCompileError( "has the wrong version" );
+	}
+	if ( CacheReadInt( file ) != NUM_EXEC_OPCODES ) {
+		throw idCompileError( "was written with different opcodes" );
+	}
+	file->ReadFloat( compileTime );
+
+	num = CacheReadInt( file );
+	for ( i = 0; i < num; i++ ) {
+		file->ReadString( str );
+		cachedLength = CacheReadInt( file );
+		cachedChecksum = CacheReadInt( file );
+		if ( !ScriptFileChecksum( str, length, checksum ) || ( length != cachedLength ) || ( checksum != cachedChecksum ) ) {
+			throw idCompileError( va( "is out of date, '%s' changed", str.c_str() ) );
+		}
+	}
+
+	numFiles = CacheReadInt( file );
+	numTypes = CacheReadInt( file );
+	numDefs = CacheReadInt( file );
+	numFunctions = CacheReadInt( file );
+	numStatements = CacheReadInt( file );
+	numVariables = CacheReadInt( file );
+	if ( ( numFiles < 0 ) || ( numTypes < 0 ) || ( numDefs < 0 ) || ( numFunctions < 0 ) || ( numFunctions > functions.Max() ) ||
+			( numStatements <= 0 ) || ( numStatements > statements.Max() ) || ( numVariables < 0 ) || ( numVariables > sizeof( variables ) ) ) {
+		throw idCompileError( "exceeds the program limits" );
+	}
+
+	// allocate everything first so references can be resolved in one pass
+	FreeData();
+
+	fileList.SetNum( numFiles );
+	for ( i = 0; i < numFiles; i++ ) {
+		file->ReadString( fileList[ i ] );
+	}
+
+	types.SetNum( numTypes );
+	for ( i = 0; i < numTypes; i++ ) {
+		types[ i ] = new idTypeDef( ev_void, NULL, "", 0, NULL );
+	}
+	varDefs.SetNum( numDefs );
+	for ( i = 0; i < numDefs; i++ ) {
+		varDefs[ i ] = new idVarDef();
+		varDefs[ i ]->num = i;
+	}
+	functions.SetNum( numFunctions );
+	for ( i = 0; i < numFunctions; i++ ) {
+		functions[ i ].Clear();
+		functions[ i ].parmSize.SetGranularity( 1 );
+	}
+
+	for ( i = 0; i < numTypes; i++ ) {
+		type = types[ i ];
+		type->type = ( etype_t )CacheReadInt( file );
+		file->ReadString( type->name );
+		type->size = CacheReadInt( file );
+		type->auxType = CacheType( CacheReadInt( file ) );
+		type->def = CacheDef( CacheReadInt( file ) );
+		num = CacheReadInt( file );
+		for ( j = 0; j < num; j++ ) {
+			type->parmTypes.Append( CacheType( CacheReadInt( file ) ) );
+			file->ReadString( type->parmNames.Alloc() );
+		}
+		num = CacheReadInt( file );
+		for ( j = 0; j < num; j++ ) {
+			type->functions.Append( CacheFunction( CacheReadInt( file ) ) );
+		}
+	}
+
+	// defs are added to the name lists in order so the lists are the same as after compiling
+	for ( i = 0; i < numDefs; i++ ) {
+		def = varDefs[ i ];
+		def->SetTypeDef( CacheType( CacheReadInt( file ) ) );
+		file->ReadString( str );
+		AddDefToNameList( def, str );
+		def->scope = CacheDef( CacheReadInt( file ) );
+		def->numUsers = CacheReadInt( file );
+		def->initialized = ( idVarDef::initialized_t )CacheReadInt( file );
+		kind = CacheReadInt( file );
+		value = CacheReadInt( file );
+		switch( kind ) {
+		case CACHE_VALUE_FUNCTION:
+			def->value.functionPtr = CacheFunction( value );
+			break;
+		case CACHE_VALUE_GLOBAL:
+			if ( ( value < 0 ) || ( value > numVariables ) ) {
+				throw idCompileError( "has an invalid global variable" );
+			}
+			def->value.bytePtr = &variables[ value ];
+			break;
+		case CACHE_VALUE_INT:
+			def->value.stackOffset = value;
+			break;
+		default:
+			throw idCompileError( "has an invalid def" );
+		}
+		if ( !def->TypeDef() ) {
+			throw idCompileError( "has a def without a type" );
+		}
+	}
+
+	for ( i = 0; i < numFunctions; i++ ) {
+		function_t &func = functions[ i ];
+		file->ReadString( str );
+		func.SetName( str );
+		file->ReadString( str );
+		if ( str.Length() ) {
+			file->ReadString( format );
+			file->ReadChar( returnType );
+			ev = idEventDef::FindEvent( str );
+			if ( !ev || ( format != ev->GetArgFormat() ) || ( returnType != ev->GetReturnType() ) ) {
+				throw idCompileError( va( "is out of date, event '%s' changed", str.c_str() ) );
+			}
+			func.eventdef = ev;
+		}
+		func.def = CacheDef( CacheReadInt( file ) );
+		func.type = CacheType( CacheReadInt( file ) );
+		func.firstStatement = CacheReadInt( file );
+		func.numStatements = CacheReadInt( file );
+		func.parmTotal = CacheReadInt( file );
+		func.locals = CacheReadInt( file );
+		func.filenum = CacheReadInt( file );
+		num = CacheReadInt( file );
+		if ( ( num < 0 ) || ( func.firstStatement < 0 ) || ( func.firstStatement + func.numStatements > numStatements ) ) {
+			throw idCompileError( "has an invalid function" );
+		}
+		func.parmSize.SetNum( num );
+		for ( j = 0; j < num; j++ ) {
+			func.parmSize[ j ] = CacheReadInt( file );
+		}
+	}
+
+	statements.SetNum( numStatements );
+	for ( i = 0; i < numStatements; i++ ) {
+		statement_t &st = statements[ i ];
+		short op, linenumber, filenumber;
+
+		file->ReadShort( op );
+		st.op = op;
+		if ( st.op >= NUM_OPCODES ) {
+			throw idCompileError( "has an invalid opcode" );
+		}
+		st.execOp = st.op;
+		st.a = CacheDef( CacheReadInt( file ) );
+		st.b = CacheDef( CacheReadInt( file ) );
+		st.c = CacheDef( CacheReadInt( file ) );
+		file->ReadShort( linenumber );
+		file->ReadShort( filenumber );
+		st.linenumber = linenumber;
+		st.file = filenumber;
+	}
+
+	if ( file->Read( variables, numVariables ) != numVariables ) {
+		throw idCompileError( "is truncated" );
+	}
+
+	returnDef = CacheDef( CacheReadInt( file ) );
+	returnStringDef = CacheDef( CacheReadInt( file ) );
+	sysDef = CacheDef( CacheReadInt( file ) );
+	type_pointer.SetPointerType( CacheType( CacheReadInt( file ) ) );
+
+	file->ReadString( str );
+	if ( str != SCRIPT_CACHE_FILEID ) {
+		throw idCompileError( "is truncated" );
+	}
+}
+
+/*
+================
+idProgram::LoadCache
+
+Loads the program compiled from the default script from the cache.  When
+the cache is missing or out of date the program is left empty and false
+is returned.
+================
+*/
+bool idProgram::LoadCache( const char *defaultScript ) {
+	idStr		cacheName;
+	void		*buffer;
+	int			length;
+	float		compileTime;
+	idTimer		loadTime;
+
+	cacheName = CacheFileName( defaultScript );
+	length = fileSystem->ReadFile( cacheName, &buffer, NULL );
+	if ( length < 0 ) {
+		return false;
+	}
+
+	loadTime.Start();
+
+	idFile_Memory file( cacheName, ( const char * )buffer, length );
+	try {
+		ReadCache( &file, compileTime );
+	}
+
+	catch( idCompileError &err ) {
+		fileSystem->FreeFile( buffer );
+		gameLocal.Printf( "Script cache '%s' %s\n", cacheName.c_str(), err.error );
+		BeginCompilation();
+		return false;
+	}
+
+	fileSystem->FreeFile( buffer );
+
+	CreateSuperInstructions( 0 );
+
+	loadTime.Stop();
+	gameLocal.Printf( "Loaded '%s' from '%s': %.1f ms, compiling took %.1f ms\n", defaultScript, cacheName.c_str(), loadTime.Milliseconds(), compileTime );
+
+	CompileStats();
+
+	return true;
+}
+
 /*
 ================
 idProgram::FreeData
@@ -1864,6 +2606,8 @@ idProgram::FreeData
 void idProgram::FreeData( void ) {
 	int i;
 
+	idInterpreter::ClearProfile();
+
 	// free the defs
 	varDefs.DeleteContents( true );
 	varDefNames.DeleteContents( true );
@@ -1916,7 +2660,19 @@ void idProgram::Startup( const char *defaultScript ) {
 
 	// load the default script
 	if ( defaultScript && *defaultScript ) {
-		CompileFile( defaultScript );
+		if ( !g_scriptCache.GetBool() || !LoadCache( defaultScript ) ) {
+			idTimer compileTime;
+
+			compileTime.Start();
+			CompileFile( defaultScript );
+			compileTime.Stop();
+
+			if ( g_scriptCache.GetBool() ) {
+				WriteCache( defaultScript, compileTime.Milliseconds() );
+			}
+		} else if ( g_disasm.GetBool() ) {
+			Disassemble();
+		}
 	}
 
 	FinishCompilation();
@@ -2057,6 +2813,7 @@ void idProgram::Restart( void ) {
 	int i;
 
 	idThread::Restart();
+	idInterpreter::ClearProfile();
 
 	//
 	// since there may have been a script loaded by the map or the user may
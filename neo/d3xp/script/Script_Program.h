@@ -58,6 +58,10 @@ class idRestoreGame;
 #define MAX_STATEMENTS		81920			// statement_t - 18 bytes last I checked
 #endif
 
+#define SCRIPT_CACHE_FILEID			"DewmScriptCache"
+#define SCRIPT_CACHE_FILEVERSION	1			// increase when the compiler output changes
+#define SCRIPT_CACHE_FILEEXT		"cache"
+
 typedef enum {
 	ev_error = -1, ev_void, ev_scriptevent, ev_namespace, ev_string, ev_float, ev_vector, ev_entity, ev_field, ev_function, ev_virtualfunction, ev_pointer, ev_object, ev_jumpoffset, ev_argsize, ev_boolean
 } etype_t;
@@ -103,6 +107,8 @@ Contains type information for variables and functions.
 ***********************************************************************/
 
 class idTypeDef {
+	friend class idProgram;		// reads and writes the program cache
+
 private:
 	etype_t						type;
 	idStr 						name;
@@ -427,6 +433,7 @@ extern	idVarDef	def_boolean;
 
 typedef struct statement_s {
 	unsigned short	op;
+	unsigned short	execOp;		// op or a superinstruction that also executes the next statements
 	idVarDef		*a;
 	idVarDef		*b;
 	idVarDef		*c;
@@ -470,6 +477,20 @@ private:
 	int											top_files;
 
 	void										CompileStats( void );
+	void										CreateSuperInstructions( int firstStatement );
+
+	// program cache
+	static idStr								CacheFileName( const char *defaultScript );
+	static void									FindSourceFiles( const char *fileName, idStrList &files );
+	int											CacheTypeIndex( const idTypeDef *type, const idHashIndex &typeHash ) const;
+	int											CacheDefIndex( const idVarDef *def ) const;
+	int											CacheFunctionIndex( const function_t *func ) const;
+	idTypeDef *									CacheType( int index ) const;
+	idVarDef *									CacheDef( int index ) const;
+	function_t *								CacheFunction( int index );
+	void										WriteCache( const char *defaultScript, float compileTime );
+	void										ReadCache( idFile *file, float &compileTime );
+	bool										LoadCache( const char *defaultScript );
 
 public:
 	idVarDef									*returnDef;
@@ -517,6 +538,7 @@ public:
 	function_t									&AllocFunction( idVarDef *def );
 	function_t									*GetFunction( int index );
 	int											GetFunctionIndex( const function_t *func );
+	int											NumFunctions( void ) const { return functions.Num(); }
 
 	void										SetEntity( const char *name, idEntity *ent );
 
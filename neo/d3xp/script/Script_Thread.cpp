@@ -364,6 +364,8 @@ idThread::~idThread() {
 	if ( currentThread == this ) {
 		currentThread = NULL;
 	}
+
+	interpreter.StopProfile();
 }
 
 /*
@@ -669,6 +671,8 @@ bool idThread::Execute( void ) {
 	idThread	*oldThread;
 	bool		done;
 
+	PROFILE_SCOPE( "idThread::Execute" );
+
 	if ( manualControl && ( waitingUntil > gameLocal.time ) ) {
 		return false;
 	}
@@ -245,6 +245,8 @@ public:
 	void						DoneProcessing( void ) { interpreter.doneProcessing = true; };
 	void						ContinueProcessing( void ) { interpreter.doneProcessing = false; };
 	bool						ThreadDying( void ) { return interpreter.threadDying; };
+	int							GetNumStatementsDispatched( void ) const { return interpreter.GetNumStatementsDispatched(); };
+	int							GetNumStatementsExecuted( void ) const { return interpreter.GetNumStatementsExecuted(); };
 	void						EndThread( void ) { interpreter.threadDying = true; };
 	bool						IsWaiting( void );
 	void						ClearWaitFor( void );
@@ -2342,6 +2342,7 @@ void idCommonLocal::InitCommands( void ) {
 	cmdSystem->AddCommand( "runAAS", RunAAS_f, CMD_FL_TOOL, "compiles an AAS file for a map", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runAASDir", RunAASDir_f, CMD_FL_TOOL, "compiles AAS files for all maps in a folder", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runReach", RunReach_f, CMD_FL_TOOL, "calculates reachability for an AAS file", idCmdSystem::ArgCompletion_MapName );
+	cmdSystem->AddCommand( "runAASRoutes", RunAASRoutes_f, CMD_FL_TOOL, "precalculates the routing tables for an AAS file", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "roq", RoQFileEncode_f, CMD_FL_TOOL, "encodes a roq file" );
 #endif
 
@@ -2367,6 +2368,7 @@ void idCommonLocal::InitCommands( void ) {
 	// idLib commands
 	cmdSystem->AddCommand( "memoryDump", Mem_Dump_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a memory dump" );
 	cmdSystem->AddCommand( "memoryDumpCompressed", Mem_DumpCompressed_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "creates a compressed memory dump" );
+	cmdSystem->AddCommand( "memoryProfile", Mem_Profile_f, CMD_FL_SYSTEM, "samples allocations and lists the top allocating call sites" );
 	cmdSystem->AddCommand( "showStringMemory", idStr::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by strings" );
 	cmdSystem->AddCommand( "showDictMemory", idDict::ShowMemoryUsage_f, CMD_FL_SYSTEM, "shows memory used by dictionaries" );
 	cmdSystem->AddCommand( "listDictKeys", idDict::ListKeys_f, CMD_FL_SYSTEM|CMD_FL_CHEAT, "lists all keys used by dictionaries" );
@@ -2437,7 +2439,10 @@ idCommonLocal::Frame
 =================
 */
 void idCommonLocal::Frame( void ) {
+	profiler->BeginFrame( com_frameNumber );
+
 	try {
+		PROFILE_SCOPE( "Common::Frame" );
 
 		// pump all the events
 		Sys_GenerateEvents();
@@ -2484,6 +2489,8 @@ void idCommonLocal::Frame( void ) {
 		// set idLib frame number for frame based memory dumps
 		idLib::frameNumber = com_frameNumber;
 
+		Mem_ProfileNextFrame();
+
 		// the FPU stack better be empty at this point or some bad code or compiler bug left values on the stack
 		if ( !Sys_FPU_StackIsEmpty() ) {
 			Printf( Sys_FPU_GetState() );
@@ -2669,6 +2676,8 @@ void idCommonLocal::LoadGameDLL( void ) {
 	gameImport.declManager				= ::declManager;
 	gameImport.AASFileManager			= ::AASFileManager;
 	gameImport.collisionModelManager	= ::collisionModelManager;
+	gameImport.parallelJobManager		= ::parallelJobManager;
+	gameImport.profiler					= ::profiler;
 
 	gameExport							= *GetGameAPI( &gameImport );
 
@@ -2704,6 +2713,9 @@ void idCommonLocal::UnloadGameDLL( void ) {
 
 #ifdef __DOOM_DLL__
 
+	// recorded zone names point into the game DLL
+	profiler->Clear();
+
 	if ( gameDLL ) {
 		Sys_DLL_Unload( gameDLL );
 		gameDLL = NULL;
@@ -2822,6 +2834,11 @@ void idCommonLocal::Init( int argc, const char **argv, const char *cmdline ) {
 		// initialize processor specific SIMD implementation
 		InitSIMD();
 
+		// start the job threads shared by all systems
+		parallelJobManager->Init();
+
+		profiler->Init();
+
 		// init commands
 		InitCommands();
 
@@ -2880,9 +2897,15 @@ void idCommonLocal::Shutdown( void ) {
 	// game specific shut down
 	ShutdownGame( false );
 
+	// stop the job threads
+	parallelJobManager->Shutdown();
+
 	// shut down non-portable system services
 	Sys_Shutdown();
 
+	// no other threads are left that could record zones
+	profiler->Shutdown();
+
 	// shut down the console
 	console->Shutdown();
 
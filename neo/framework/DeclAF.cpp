@@ -589,6 +589,9 @@ bool idDeclAF::WriteSettings( idFile *f ) const {
 	f->WriteFloatString( "\tcontents %s\n", ContentsToString( contents, str ) );
 	f->WriteFloatString( "\tclipMask %s\n", ContentsToString( clipMask, str ) );
 	f->WriteFloatString( "\tselfCollision %d\n", selfCollision );
+	if ( solver != DECLAF_SOLVER_DANTZIG ) {
+		f->WriteFloatString( "\tsolver %s, %d\n", SolverToString( solver ), solverIterations );
+	}
 	f->WriteFloatString( "}\n" );
 	return true;
 }
@@ -736,6 +739,38 @@ declAFJointMod_t idDeclAF::JointModFromString( const char *str ) {
 	return DECLAF_JOINTMOD_AXIS;
 }
 
+/*
+================
+idDeclAF::SolverFromString
+================
+*/
+declAFSolver_t idDeclAF::SolverFromString( const char *str ) {
+	if ( idStr::Icmp( str, "dantzig" ) == 0 ) {
+		return DECLAF_SOLVER_DANTZIG;
+	}
+	if ( idStr::Icmp( str, "gaussSeidel" ) == 0 ) {
+		return DECLAF_SOLVER_GAUSS_SEIDEL;
+	}
+	return DECLAF_SOLVER_DANTZIG;
+}
+
+/*
+================
+idDeclAF::SolverToString
+================
+*/
+const char * idDeclAF::SolverToString( declAFSolver_t solver ) {
+	switch( solver ) {
+		case DECLAF_SOLVER_DANTZIG: {
+			return "dantzig";
+		}
+		case DECLAF_SOLVER_GAUSS_SEIDEL: {
+			return "gaussSeidel";
+		}
+	}
+	return "dantzig";
+}
+
 /*
 ================
 idDeclAF::JointModToString
@@ -1411,6 +1446,14 @@ bool idDeclAF::ParseSettings( idLexer &src ) {
 			ParseContents( src, clipMask );
 		} else if ( !token.Icmp( "selfCollision" ) ) {
 			selfCollision = src.ParseBool();
+		} else if ( !token.Icmp( "solver" ) ) {
+			if ( !src.ReadToken( &token ) ) {
+				return false;
+			}
+			solver = SolverFromString( token );
+			if ( src.CheckTokenString( "," ) ) {
+				solverIterations = src.ParseInt();
+			}
 		} else if ( token == "}" ) {
 			break;
 		} else {
@@ -1576,6 +1619,8 @@ void idDeclAF::FreeData( void ) {
 	minMoveTime = -1.0f;
 	maxMoveTime = -1.0f;
 	selfCollision = true;
+	solver = DECLAF_SOLVER_DANTZIG;
+	solverIterations = 0;
 	contents = CONTENTS_CORPSE;
 	clipMask = CONTENTS_SOLID | CONTENTS_CORPSE;
 	bodies.DeleteContents( true );
@@ -55,6 +55,11 @@ typedef enum {
 	DECLAF_JOINTMOD_BOTH
 } declAFJointMod_t;
 
+typedef enum {
+	DECLAF_SOLVER_DANTZIG,
+	DECLAF_SOLVER_GAUSS_SEIDEL
+} declAFSolver_t;
+
 typedef bool (*getJointTransform_t)( void *model, const idJointMat *frame, const char *jointName, idVec3 &origin, idMat3 &axis );
 
 class idAFVector {
@@ -167,6 +172,9 @@ public:
 	static declAFJointMod_t	JointModFromString( const char *str );
 	static const char *		JointModToString( declAFJointMod_t jointMod );
 
+	static declAFSolver_t	SolverFromString( const char *str );
+	static const char *		SolverToString( declAFSolver_t solver );
+
 public:
 	bool					modified;
 	idStr					model;
@@ -186,6 +194,8 @@ public:
 	int						contents;
 	int						clipMask;
 	bool					selfCollision;
+	declAFSolver_t			solver;					// solver for the auxiliary constraints
+	int						solverIterations;		// iterations of the Gauss-Seidel solver, zero for the default
 	idList<idDeclAF_Body *>			bodies;
 	idList<idDeclAF_Constraint *>	constraints;
 
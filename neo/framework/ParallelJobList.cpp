@@ -0,0 +1,760 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+/*
+===============================================================================
+
+	Job threads.
+
+	Every job thread has a queue of submitted job lists.  A thread takes lists
+	from the back of its own queue, and when that is empty it steals from the
+	front of the other queues.  After claiming a job from a list that has more
+	jobs left, the list is put back on the thread's own queue so idle threads
+	can steal the remaining jobs.  Jobs are claimed and counted with interlocked
+	operations, so the queue locks are only held to push or pop a list.
+
+	A queue entry remembers the generation of the list it was queued for.  The
+	generation changes on every Submit() and Wait(), so stale entries left in
+	a queue are dropped instead of running jobs of a later submission.  Before
+	a list is freed its entries are removed from every queue, and the threads
+	that already took one of them are waited for.
+
+===============================================================================
+*/
+
+const int MAX_JOB_THREADS			= 8;
+const int MAX_JOB_LISTS				= 128;
+const int MAX_JOB_QUEUE				= MAX_JOB_LISTS * 2;		// a list can briefly be queued once more with a stale generation
+const int MAX_JOB_LIST_DEPENDENTS	= 16;
+
+const int JOB_THREAD_EXTERNAL		= -1;						// a thread waiting on a job list
+
+idCVar com_jobThreads( "com_jobThreads", "-1", CVAR_SYSTEM | CVAR_INTEGER | CVAR_INIT, "number of job threads, -1 = one less than the number of processors", -1, MAX_JOB_THREADS );
+
+class idParallelJobListLocal;
+
+/*
+================================================
+idJobSpinLock
+================================================
+*/
+class idJobSpinLock {
+public:
+	void						Lock( void ) { while ( lock.CompareExchange( 0, 1 ) != 0 ) { Sys_Yield(); } }
+	void						Unlock( void ) { lock.Exchange( 0 ); }
+
+private:
+	idSysInterlockedInteger		lock;
+};
+
+typedef struct {
+	idParallelJobListLocal *	jobList;
+	int							generation;
+} jobQueueEntry_t;
+
+/*
+================================================
+idJobQueue
+
+The owning thread pushes and pops at the back, other threads steal from the front.
+================================================
+*/
+class idJobQueue {
+public:
+								idJobQueue( void ) { first = 0; count = 0; }
+
+	bool						Push( const jobQueueEntry_t &entry );
+	bool						Pop( jobQueueEntry_t &entry, idParallelJobListLocal * volatile &claimed );
+	bool						Steal( jobQueueEntry_t &entry, idParallelJobListLocal * volatile &claimed );
+	void						Remove( const idParallelJobListLocal *jobList );
+
+private:
+	idJobSpinLock				lock;
+	jobQueueEntry_t				entries[MAX_JOB_QUEUE];
+	int							first;
+	int							count;
+};
+
+/*
+========================
+idJobQueue::Push
+========================
+*/
+bool idJobQueue::Push( const jobQueueEntry_t &entry ) {
+	lock.Lock();
+	if ( count >= MAX_JOB_QUEUE ) {
+		lock.Unlock();
+		return false;
+	}
+	entries[( first + count ) % MAX_JOB_QUEUE] = entry;
+	count++;
+	lock.Unlock();
+	return true;
+}
+
+/*
+========================
+idJobQueue::Pop
+
+The list is claimed under the queue lock, so Remove() never misses an entry that was taken but not run yet.
+========================
+*/
+bool idJobQueue::Pop( jobQueueEntry_t &entry, idParallelJobListLocal * volatile &claimed ) {
+	lock.Lock();
+	if ( count == 0 ) {
+		lock.Unlock();
+		return false;
+	}
+	count--;
+	entry = entries[( first + count ) % MAX_JOB_QUEUE];
+	claimed = entry.jobList;
+	lock.Unlock();
+	return true;
+}
+
+/*
+========================
+idJobQueue::Steal
+========================
+*/
+bool idJobQueue::Steal( jobQueueEntry_t &entry, idParallelJobListLocal * volatile &claimed ) {
+	lock.Lock();
+	if ( count == 0 ) {
+		lock.Unlock();
+		return false;
+	}
+	entry = entries[first];
+	first = ( first + 1 ) % MAX_JOB_QUEUE;
+	count--;
+	claimed = entry.jobList;
+	lock.Unlock();
+	return true;
+}
+
+/*
+========================
+idJobQueue::Remove
+
+Removes all entries of a list that is about to be freed.
+========================
+*/
+void idJobQueue::Remove( const idParallelJobListLocal *jobList ) {
+	int i, num;
+
+	lock.Lock();
+	num = 0;
+	for ( i = 0; i < count; i++ ) {
+		const jobQueueEntry_t &entry = entries[( first + i ) % MAX_JOB_QUEUE];
+		if ( entry.jobList != jobList ) {
+			entries[( first + num ) % MAX_JOB_QUEUE] = entry;
+			num++;
+		}
+	}
+	count = num;
+	lock.Unlock();
+}
+
+/*
+================================================
+idParallelJobListLocal
+================================================
+*/
+class idParallelJobListLocal : public idParallelJobList {
+public:
+								idParallelJobListLocal( const char *name );
+	virtual						~idParallelJobListLocal( void );
+
+	virtual void				AddJob( jobRun_t function, void *data );
+	virtual void				Submit( idParallelJobList *waitForList = NULL );
+	virtual void				Wait( void );
+	virtual bool				TryWait( void );
+	virtual bool				IsSubmitted( void ) const { return submitted; }
+	virtual int					NumJobs( void ) const { return jobs.Num(); }
+	virtual const char *		GetName( void ) const { return name.c_str(); }
+	virtual double				GetWaitTime( void ) const { return lastWaitMsec; }
+
+								// runs jobs until all of them are claimed, does nothing if the list has moved on to another generation
+	void						Run( int threadNum, int runGeneration, bool requeue );
+	void						PrintStats( void ) const;
+
+private:
+	typedef struct {
+		jobRun_t				function;
+		void *					data;
+	} job_t;
+
+	idStr						name;
+	idList<job_t>				jobs;
+	int							numJobs;			// jobs.Num() when submitted
+	bool						submitted;
+	volatile bool				completed;
+	volatile bool				waitingForList;		// queued when the list it waits for completes
+	xsignalHandle				doneSignal;
+
+	idSysInterlockedInteger		generation;
+	idSysInterlockedInteger		nextJob;
+	idSysInterlockedInteger		doneJobs;
+	idSysInterlockedInteger		activeThreads;
+
+	idJobSpinLock				dependentLock;
+	idStaticList<idParallelJobListLocal *, MAX_JOB_LIST_DEPENDENTS> dependents;
+
+	// statistics
+	int							numSubmits;
+	int							totalJobs;
+	double						lastWaitMsec;
+	double						totalWaitMsec;
+
+	bool						AddDependent( idParallelJobListLocal *jobList );
+	void						Complete( void );
+};
+
+/*
+================================================
+idParallelJobManagerLocal
+================================================
+*/
+typedef struct {
+	xthreadInfo					threadInfo;
+	xsignalHandle				wakeSignal;
+	idJobQueue					queue;
+	int							threadNum;
+	char						name[16];
+	idParallelJobListLocal * volatile runningList;	// taken from a queue and not done running yet
+
+	// statistics
+	idSysInterlockedInteger		jobsRun;
+	idSysInterlockedInteger		steals;
+	double						idleMsec;
+} jobThread_t;
+
+class idParallelJobManagerLocal : public idParallelJobManager {
+public:
+								idParallelJobManagerLocal( void );
+
+	virtual void				Init( void );
+	virtual void				Shutdown( void );
+
+	virtual idParallelJobList *	AllocJobList( const char *name );
+	virtual void				FreeJobList( idParallelJobList *jobList );
+
+	virtual int					GetNumProcessingThreads( void ) const { return numThreads; }
+
+	void						QueueJobList( idParallelJobListLocal *jobList, int generation, int threadNum );
+	void						CountJobs( int threadNum, int count );
+
+private:
+	jobThread_t					threads[MAX_JOB_THREADS];
+	xthreadInfo *				threadInfos[MAX_JOB_THREADS];
+	int							threadInfoCount;
+	int							numThreads;
+	volatile bool				shuttingDown;
+
+	idSysInterlockedInteger		nextQueue;
+	idSysInterlockedInteger		numIdleThreads;
+	idSysInterlockedInteger		externalJobsRun;
+
+	idList<idParallelJobListLocal *> jobLists;
+
+	bool						GetWork( jobThread_t *thread, jobQueueEntry_t &entry );
+	static unsigned int			JobThread( void *parm );
+	static void					ListJobs_f( const idCmdArgs &args );
+};
+
+idParallelJobManagerLocal		parallelJobManagerLocal;
+idParallelJobManager *			parallelJobManager = &parallelJobManagerLocal;
+
+/*
+========================
+idParallelJobListLocal::idParallelJobListLocal
+========================
+*/
+idParallelJobListLocal::idParallelJobListLocal( const char *name ) {
+	this->name = name;
+	jobs.SetGranularity( 64 );
+	numJobs = 0;
+	submitted = false;
+	completed = true;
+	waitingForList = false;
+	doneSignal = Sys_SignalCreate( true );
+	numSubmits = 0;
+	totalJobs = 0;
+	lastWaitMsec = 0.0;
+	totalWaitMsec = 0.0;
+}
+
+/*
+========================
+idParallelJobListLocal::~idParallelJobListLocal
+========================
+*/
+idParallelJobListLocal::~idParallelJobListLocal( void ) {
+	Wait();
+	Sys_SignalDestroy( doneSignal );
+}
+
+/*
+========================
+idParallelJobListLocal::AddJob
+========================
+*/
+void idParallelJobListLocal::AddJob( jobRun_t function, void *data ) {
+	assert( !submitted );
+	job_t &job = jobs.Alloc();
+	job.function = function;
+	job.data = data;
+}
+
+/*
+========================
+idParallelJobListLocal::Submit
+========================
+*/
+void idParallelJobListLocal::Submit( idParallelJobList *waitForList ) {
+	assert( !submitted );
+
+	numJobs = jobs.Num();
+	nextJob.SetValue( 0 );
+	doneJobs.SetValue( 0 );
+	completed = false;
+	waitingForList = false;
+	Sys_SignalClear( doneSignal );
+	submitted = true;
+
+	numSubmits++;
+	totalJobs += numJobs;
+
+	int runGeneration = generation.Increment();
+
+	if ( numJobs == 0 ) {
+		Complete();
+		return;
+	}
+
+	if ( waitForList != NULL ) {
+		waitingForList = true;
+		if ( static_cast<idParallelJobListLocal *>( waitForList )->AddDependent( this ) ) {
+			return;
+		}
+		waitingForList = false;
+	}
+
+	parallelJobManagerLocal.QueueJobList( this, runGeneration, JOB_THREAD_EXTERNAL );
+}
+
+/*
+========================
+idParallelJobListLocal::Wait
+========================
+*/
+void idParallelJobListLocal::Wait( void ) {
+	idTimer waitTimer;
+
+	if ( !submitted ) {
+		return;
+	}
+
+	// help running the jobs instead of just blocking
+	if ( !waitingForList ) {
+		Run( JOB_THREAD_EXTERNAL, generation.GetValue(), false );
+	}
+
+	waitTimer.Start();
+	Sys_SignalWait( doneSignal );
+	waitTimer.Stop();
+
+	// make sure no other thread is still looking at the jobs before they are changed
+	generation.Increment();
+	while ( activeThreads.GetValue() > 0 ) {
+		Sys_Yield();
+	}
+
+	lastWaitMsec = waitTimer.Milliseconds();
+	totalWaitMsec += lastWaitMsec;
+
+	jobs.SetNum( 0, false );
+	submitted = false;
+}
+
+/*
+========================
+idParallelJobListLocal::TryWait
+========================
+*/
+bool idParallelJobListLocal::TryWait( void ) {
+	if ( !submitted ) {
+		return true;
+	}
+	if ( !completed ) {
+		return false;
+	}
+	Wait();
+	return true;
+}
+
+/*
+========================
+idParallelJobListLocal::Run
+========================
+*/
+void idParallelJobListLocal::Run( int threadNum, int runGeneration, bool requeue ) {
+	int count = 0;
+
+	activeThreads.Increment();
+
+	if ( generation.GetValue() == runGeneration ) {
+		PROFILE_SCOPE( "idParallelJobList::Run" );
+
+		while( 1 ) {
+			int i = nextJob.Increment() - 1;
+			if ( i >= numJobs ) {
+				break;
+			}
+			if ( requeue && i + 1 < numJobs ) {
+				// let idle threads steal the remaining jobs
+				parallelJobManagerLocal.QueueJobList( this, runGeneration, threadNum );
+				requeue = false;
+			}
+
+			jobs[i].function( jobs[i].data );
+			count++;
+
+			if ( doneJobs.Increment() == numJobs ) {
+				Complete();
+			}
+		}
+	}
+
+	activeThreads.Decrement();
+
+	parallelJobManagerLocal.CountJobs( threadNum, count );
+}
+
+/*
+========================
+idParallelJobListLocal::AddDependent
+
+Returns false if the list has already completed and the dependent can start right away.
+========================
+*/
+bool idParallelJobListLocal::AddDependent( idParallelJobListLocal *jobList ) {
+	dependentLock.Lock();
+	if ( !submitted || completed ) {
+		dependentLock.Unlock();
+		return false;
+	}
+	if ( dependents.Num() >= dependents.Max() ) {
+		dependentLock.Unlock();
+		// wait for the jobs to complete instead
+		while ( !completed ) {
+			Sys_Yield();
+		}
+		return false;
+	}
+	dependents.Append( jobList );
+	dependentLock.Unlock();
+	return true;
+}
+
+/*
+========================
+idParallelJobListLocal::Complete
+
+Called by the thread that finished the last job.
+========================
+*/
+void idParallelJobListLocal::Complete( void ) {
+	idParallelJobListLocal *	start[MAX_JOB_LIST_DEPENDENTS];
+	int							numStart;
+
+	dependentLock.Lock();
+	completed = true;
+	numStart = dependents.Num();
+	for ( int i = 0; i < numStart; i++ ) {
+		start[i] = dependents[i];
+	}
+	dependents.Clear();
+	dependentLock.Unlock();
+
+	Sys_SignalRaise( doneSignal );
+
+	for ( int i = 0; i < numStart; i++ ) {
+		start[i]->waitingForList = false;
+		parallelJobManagerLocal.QueueJobList( start[i], start[i]->generation.GetValue(), JOB_THREAD_EXTERNAL );
+	}
+}
+
+/*
+========================
+idParallelJobListLocal::PrintStats
+========================
+*/
+void idParallelJobListLocal::PrintStats( void ) const {
+	common->Printf( "%-24s %7d %9d %9.2f %9.3f\n", name.c_str(), numSubmits, totalJobs, lastWaitMsec,
+		numSubmits ? totalWaitMsec / numSubmits : 0.0 );
+}
+
+/*
+========================
+idParallelJobManagerLocal::idParallelJobManagerLocal
+========================
+*/
+idParallelJobManagerLocal::idParallelJobManagerLocal( void ) {
+	threadInfoCount = 0;
+	numThreads = 0;
+	shuttingDown = false;
+}
+
+/*
+========================
+idParallelJobManagerLocal::Init
+========================
+*/
+void idParallelJobManagerLocal::Init( void ) {
+	int count = com_jobThreads.GetInteger();
+	if ( count < 0 ) {
+		count = Sys_GetProcessorCount() - 1;
+	}
+	count = idMath::ClampInt( 0, MAX_JOB_THREADS, count );
+
+	shuttingDown = false;
+	threadInfoCount = 0;
+
+	for ( int i = 0; i < count; i++ ) {
+		jobThread_t *thread = &threads[i];
+		thread->threadNum = i;
+		thread->wakeSignal = Sys_SignalCreate( false );
+		thread->idleMsec = 0.0;
+		thread->runningList = NULL;
+		sprintf( thread->name, "Jobs%d", i );
+		Sys_CreateThread( JobThread, thread, THREAD_NORMAL, thread->threadInfo, thread->name, threadInfos, &threadInfoCount );
+	}
+	numThreads = count;
+
+	cmdSystem->AddCommand( "listJobs", ListJobs_f, CMD_FL_SYSTEM, "lists job lists and job thread statistics" );
+
+	common->Printf( "%d job threads started\n", numThreads );
+}
+
+/*
+========================
+idParallelJobManagerLocal::Shutdown
+========================
+*/
+void idParallelJobManagerLocal::Shutdown( void ) {
+	shuttingDown = true;
+	for ( int i = 0; i < numThreads; i++ ) {
+		Sys_SignalRaise( threads[i].wakeSignal );
+	}
+	for ( int i = 0; i < numThreads; i++ ) {
+		Sys_DestroyThread( threads[i].threadInfo );
+		Sys_SignalDestroy( threads[i].wakeSignal );
+		threads[i].wakeSignal = NULL;
+	}
+	numThreads = 0;
+
+	cmdSystem->RemoveCommand( "listJobs" );
+}
+
+/*
+========================
+idParallelJobManagerLocal::AllocJobList
+========================
+*/
+idParallelJobList *idParallelJobManagerLocal::AllocJobList( const char *name ) {
+	if ( jobLists.Num() >= MAX_JOB_LISTS ) {
+		common->FatalError( "idParallelJobManager::AllocJobList: more than %d job lists", MAX_JOB_LISTS );
+	}
+	idParallelJobListLocal *jobList = new idParallelJobListLocal( name );
+	jobLists.Append( jobList );
+	return jobList;
+}
+
+/*
+========================
+idParallelJobManagerLocal::FreeJobList
+========================
+*/
+void idParallelJobManagerLocal::FreeJobList( idParallelJobList *jobList ) {
+	if ( jobList == NULL ) {
+		return;
+	}
+	idParallelJobListLocal *jobListLocal = static_cast<idParallelJobListLocal *>( jobList );
+
+	jobListLocal->Wait();
+
+	// job threads can still have stale entries of the list queued, or be about to run one
+	for ( int i = 0; i < numThreads; i++ ) {
+		threads[i].queue.Remove( jobListLocal );
+	}
+	for ( int i = 0; i < numThreads; i++ ) {
+		while ( threads[i].runningList == jobListLocal ) {
+			Sys_Yield();
+		}
+	}
+
+	jobLists.Remove( jobListLocal );
+	delete jobListLocal;
+}
+
+/*
+========================
+idParallelJobManagerLocal::QueueJobList
+
+Puts the list on the queue of the given job thread, or the next one round robin for an external thread.
+========================
+*/
+void idParallelJobManagerLocal::QueueJobList( idParallelJobListLocal *jobList, int generation, int threadNum ) {
+	jobQueueEntry_t	entry;
+	int				i, queueNum;
+
+	// without job threads everything runs on the submitting thread
+	if ( numThreads == 0 ) {
+		jobList->Run( threadNum, generation, false );
+		return;
+	}
+
+	entry.jobList = jobList;
+	entry.generation = generation;
+
+	if ( threadNum == JOB_THREAD_EXTERNAL ) {
+		queueNum = ( nextQueue.Increment() & 0x7fffffff ) % numThreads;
+	} else {
+		queueNum = threadNum;
+	}
+
+	for ( i = 0; i < numThreads; i++ ) {
+		if ( threads[( queueNum + i ) % numThreads].queue.Push( entry ) ) {
+			break;
+		}
+	}
+	if ( i == numThreads ) {
+		// all queues are full
+		jobList->Run( threadNum, generation, false );
+		return;
+	}
+
+	// the interlocked add orders the push before the idle check
+	if ( numIdleThreads.Add( 0 ) > 0 ) {
+		for ( i = 0; i < numThreads; i++ ) {
+			Sys_SignalRaise( threads[i].wakeSignal );
+		}
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::CountJobs
+========================
+*/
+void idParallelJobManagerLocal::CountJobs( int threadNum, int count ) {
+	if ( count == 0 ) {
+		return;
+	}
+	if ( threadNum == JOB_THREAD_EXTERNAL ) {
+		externalJobsRun.Add( count );
+	} else {
+		threads[threadNum].jobsRun.Add( count );
+	}
+}
+
+/*
+========================
+idParallelJobManagerLocal::GetWork
+========================
+*/
+bool idParallelJobManagerLocal::GetWork( jobThread_t *thread, jobQueueEntry_t &entry ) {
+	if ( thread->queue.Pop( entry, thread->runningList ) ) {
+		return true;
+	}
+	for ( int i = 1; i < numThreads; i++ ) {
+		if ( threads[( thread->threadNum + i ) % numThreads].queue.Steal( entry, thread->runningList ) ) {
+			thread->steals.Increment();
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+========================
+idParallelJobManagerLocal::JobThread
+========================
+*/
+unsigned int idParallelJobManagerLocal::JobThread( void *parm ) {
+	jobThread_t *		thread = (jobThread_t *)parm;
+	jobQueueEntry_t		entry;
+	idTimer				idleTimer;
+
+	profiler->SetThreadName( thread->name );
+
+	while( !parallelJobManagerLocal.shuttingDown ) {
+		if ( !parallelJobManagerLocal.GetWork( thread, entry ) ) {
+			// check again after announcing we are about to sleep, so a list queued in between isn't missed
+			parallelJobManagerLocal.numIdleThreads.Increment();
+			if ( !parallelJobManagerLocal.GetWork( thread, entry ) ) {
+				idleTimer.Clear();
+				idleTimer.Start();
+				Sys_SignalWait( thread->wakeSignal );
+				idleTimer.Stop();
+				thread->idleMsec += idleTimer.Milliseconds();
+				parallelJobManagerLocal.numIdleThreads.Decrement();
+				continue;
+			}
+			parallelJobManagerLocal.numIdleThreads.Decrement();
+		}
+		entry.jobList->Run( thread->threadNum, entry.generation, true );
+		thread->runningList = NULL;
+	}
+	Mem_ShutdownThread();
+	return 0;
+}
+
+/*
+========================
+idParallelJobManagerLocal::ListJobs_f
+========================
+*/
+void idParallelJobManagerLocal::ListJobs_f( const idCmdArgs &args ) {
+	idParallelJobManagerLocal &manager = parallelJobManagerLocal;
+
+	common->Printf( "%-24s %7s %9s %9s %9s\n", "job list", "submits", "jobs", "wait ms", "avg wait" );
+	for ( int i = 0; i < manager.jobLists.Num(); i++ ) {
+		manager.jobLists[i]->PrintStats();
+	}
+	common->Printf( "\n%-8s %9s %9s %10s\n", "thread", "jobs", "steals", "idle ms" );
+	for ( int i = 0; i < manager.numThreads; i++ ) {
+		const jobThread_t &thread = manager.threads[i];
+		common->Printf( "%-8s %9d %9d %10.0f\n", thread.name, thread.jobsRun.GetValue(), thread.steals.GetValue(), thread.idleMsec );
+	}
+	common->Printf( "%-8s %9d\n", "waiting", manager.externalJobsRun.GetValue() );
+}
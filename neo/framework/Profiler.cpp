@@ -0,0 +1,370 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+/*
+===============================================================================
+
+	Profile zones.
+
+	Every thread that records a zone gets its own ring buffer the first time,
+	so recording needs no locks.  The writing thread only advances its event
+	count after an event is complete, a trace copies the events behind that
+	count while the other threads keep recording.  The oldest part of a ring
+	buffer can be overwritten during the copy, so it is left out.
+
+===============================================================================
+*/
+
+const int MAX_PROFILE_THREADS		= 16;
+const int PROFILE_BUFFER_EVENTS		= 1 << 17;		// per thread, must be a power of two
+const int PROFILE_BUFFER_MARGIN		= 4096;			// events a thread can record while its buffer is copied
+const int PROFILE_SPIKE_FRAMES		= 300;			// frames between automatic traces
+
+idCVar com_profile( "com_profile", "0", CVAR_SYSTEM | CVAR_BOOL, "record profile zones, write them out with profileTrace" );
+idCVar com_profileSpikeMsec( "com_profileSpikeMsec", "0", CVAR_SYSTEM | CVAR_INTEGER, "write a trace when a frame takes longer than this many milliseconds while recording, 0 = disabled" );
+
+typedef enum {
+	PROFILE_EVENT_BEGIN,
+	PROFILE_EVENT_END,
+	PROFILE_EVENT_FRAME
+} profileEventType_t;
+
+typedef struct {
+	const char *				name;
+	double						ticks;
+	int							type;
+	int							frameNumber;
+} profileEvent_t;
+
+typedef struct {
+	char						name[32];
+	profileEvent_t *			events;
+	volatile unsigned int		numEvents;		// events ever recorded, wraps around, the next one goes to numEvents & ( PROFILE_BUFFER_EVENTS - 1 )
+} profileThread_t;
+
+/*
+================================================
+idProfilerLocal
+================================================
+*/
+class idProfilerLocal : public idProfiler {
+public:
+								idProfilerLocal( void );
+
+	virtual void				Init( void );
+	virtual void				Shutdown( void );
+	virtual void				BeginZone( const char *name );
+	virtual void				EndZone( void );
+	virtual void				BeginFrame( int frameNumber );
+	virtual void				SetThreadName( const char *name );
+	virtual void				Clear( void );
+	virtual bool				WriteTrace( const char *fileName );
+
+private:
+	profileThread_t				threads[MAX_PROFILE_THREADS];
+	idSysInterlockedInteger		numThreads;
+	profileThread_t				discardThread;		// for threads that start after all buffers are taken
+
+	int							frameNumber;
+	double						frameStartTicks;
+	double						startTicks;
+	int							lastSpikeFrame;
+
+	profileThread_t *			GetThread( void );
+	void						AddEvent( const char *name, profileEventType_t type );
+	int							GetNumThreads( void ) { return Min( numThreads.GetValue(), MAX_PROFILE_THREADS ); }
+
+	static void					ProfileTrace_f( const idCmdArgs &args );
+};
+
+idProfilerLocal					profilerLocal;
+idProfiler *					profiler = &profilerLocal;
+
+#ifdef ID_THREAD_LOCAL
+static ID_THREAD_LOCAL profileThread_t *currentThread;
+#endif
+
+/*
+========================
+idProfilerLocal::idProfilerLocal
+========================
+*/
+idProfilerLocal::idProfilerLocal( void ) {
+	enabled = false;
+	memset( threads, 0, sizeof( threads ) );
+	memset( &discardThread, 0, sizeof( discardThread ) );
+	frameNumber = 0;
+	frameStartTicks = 0.0;
+	startTicks = 0.0;
+	lastSpikeFrame = 0;
+}
+
+/*
+========================
+idProfilerLocal::Init
+========================
+*/
+void idProfilerLocal::Init( void ) {
+	startTicks = Sys_GetClockTicks();
+	lastSpikeFrame = -PROFILE_SPIKE_FRAMES;
+
+	cmdSystem->AddCommand( "profileTrace", ProfileTrace_f, CMD_FL_SYSTEM, "writes the recorded profile zones as a Chrome trace" );
+}
+
+/*
+========================
+idProfilerLocal::Shutdown
+========================
+*/
+void idProfilerLocal::Shutdown( void ) {
+	enabled = false;
+
+	for ( int i = 0; i < GetNumThreads(); i++ ) {
+		Mem_Free( threads[i].events );
+		threads[i].events = NULL;
+		threads[i].numEvents = 0;
+	}
+
+	cmdSystem->RemoveCommand( "profileTrace" );
+}
+
+/*
+========================
+idProfilerLocal::GetThread
+========================
+*/
+profileThread_t *idProfilerLocal::GetThread( void ) {
+#ifdef ID_THREAD_LOCAL
+	if ( currentThread != NULL ) {
+		return currentThread;
+	}
+
+	int index = numThreads.Increment() - 1;
+	if ( index >= MAX_PROFILE_THREADS ) {
+		currentThread = &discardThread;
+		return currentThread;
+	}
+
+	profileThread_t *thread = &threads[index];
+	if ( thread->name[0] == '\0' ) {
+		idStr::Copynz( thread->name, Sys_GetThreadName(), sizeof( thread->name ) );
+	}
+	thread->numEvents = 0;
+	thread->events = (profileEvent_t *)Mem_Alloc( PROFILE_BUFFER_EVENTS * sizeof( profileEvent_t ) );
+	currentThread = thread;
+	return thread;
+#else
+	return &discardThread;
+#endif
+}
+
+/*
+========================
+idProfilerLocal::AddEvent
+========================
+*/
+void idProfilerLocal::AddEvent( const char *name, profileEventType_t type ) {
+	profileThread_t *thread = GetThread();
+	if ( thread->events == NULL ) {
+		return;
+	}
+
+	profileEvent_t &event = thread->events[thread->numEvents & ( PROFILE_BUFFER_EVENTS - 1 )];
+	event.name = name;
+	event.ticks = Sys_GetClockTicks();
+	event.type = type;
+	event.frameNumber = frameNumber;
+
+	// only now the event can be copied by a trace
+	thread->numEvents++;
+}
+
+/*
+========================
+idProfilerLocal::BeginZone
+========================
+*/
+void idProfilerLocal::BeginZone( const char *name ) {
+	AddEvent( name, PROFILE_EVENT_BEGIN );
+}
+
+/*
+========================
+idProfilerLocal::EndZone
+========================
+*/
+void idProfilerLocal::EndZone( void ) {
+	AddEvent( NULL, PROFILE_EVENT_END );
+}
+
+/*
+========================
+idProfilerLocal::BeginFrame
+========================
+*/
+void idProfilerLocal::BeginFrame( int frameNumber ) {
+#ifdef ID_THREAD_LOCAL
+	enabled = com_profile.GetBool();
+#endif
+
+	if ( !enabled ) {
+		frameStartTicks = 0.0;
+		return;
+	}
+
+	double now = Sys_GetClockTicks();
+
+	if ( com_profileSpikeMsec.GetInteger() > 0 && frameStartTicks > 0.0 && frameNumber - lastSpikeFrame >= PROFILE_SPIKE_FRAMES ) {
+		double msec = ( now - frameStartTicks ) * 1000.0 / Sys_ClockTicksPerSecond();
+		if ( msec > com_profileSpikeMsec.GetInteger() ) {
+			idStr fileName = va( "profile/spike_%d.json", this->frameNumber );
+			common->Printf( "frame %d took %.1f msec, writing %s\n", this->frameNumber, msec, fileName.c_str() );
+			WriteTrace( fileName );
+			lastSpikeFrame = frameNumber;
+			// don't count writing the trace against the next frame
+			now = Sys_GetClockTicks();
+		}
+	}
+
+	frameStartTicks = now;
+	this->frameNumber = frameNumber;
+
+	AddEvent( "Frame", PROFILE_EVENT_FRAME );
+}
+
+/*
+========================
+idProfilerLocal::SetThreadName
+========================
+*/
+void idProfilerLocal::SetThreadName( const char *name ) {
+	profileThread_t *thread = GetThread();
+	idStr::Copynz( thread->name, name, sizeof( thread->name ) );
+}
+
+/*
+========================
+idProfilerLocal::Clear
+========================
+*/
+void idProfilerLocal::Clear( void ) {
+	for ( int i = 0; i < GetNumThreads(); i++ ) {
+		threads[i].numEvents = 0;
+	}
+}
+
+/*
+========================
+idProfilerLocal::WriteTrace
+
+Uses the Chrome trace event format with begin and end events, the time stamps are in microseconds.
+========================
+*/
+bool idProfilerLocal::WriteTrace( const char *fileName ) {
+	idFile *f = fileSystem->OpenFileWrite( fileName );
+	if ( f == NULL ) {
+		common->Warning( "idProfiler::WriteTrace: couldn't open %s", fileName );
+		return false;
+	}
+
+	const double usecPerTick = 1000000.0 / Sys_ClockTicksPerSecond();
+	profileEvent_t *events = (profileEvent_t *)Mem_Alloc( PROFILE_BUFFER_EVENTS * sizeof( profileEvent_t ) );
+	const char *separator = "";
+	int totalEvents = 0;
+
+	f->Printf( "{\"traceEvents\":[\n" );
+
+	for ( int i = 0; i < GetNumThreads(); i++ ) {
+		profileThread_t &thread = threads[i];
+		if ( thread.events == NULL ) {
+			continue;
+		}
+
+		f->Printf( "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}", separator, i, thread.name );
+		separator = ",\n";
+
+		// copy the events behind the count, leaving out the part that can be overwritten meanwhile
+		unsigned int last = thread.numEvents;
+		int count = Min( last, (unsigned int)( PROFILE_BUFFER_EVENTS - PROFILE_BUFFER_MARGIN ) );
+		for ( int j = 0; j < count; j++ ) {
+			events[j] = thread.events[( last - count + j ) & ( PROFILE_BUFFER_EVENTS - 1 )];
+		}
+
+		// zones are written as they are nested on the thread, ends without a begin are dropped
+		int depth = 0;
+		for ( int j = 0; j < count; j++ ) {
+			const profileEvent_t &event = events[j];
+			double ts = ( event.ticks - startTicks ) * usecPerTick;
+
+			switch( event.type ) {
+				case PROFILE_EVENT_BEGIN:
+					f->Printf( ",\n{\"name\":\"%s\",\"ph\":\"B\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", event.name, i, ts );
+					depth++;
+					break;
+				case PROFILE_EVENT_END:
+					if ( depth == 0 ) {
+						continue;
+					}
+					f->Printf( ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%d,\"ts\":%.3f}", i, ts );
+					depth--;
+					break;
+				case PROFILE_EVENT_FRAME:
+					f->Printf( ",\n{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"args\":{\"frame\":%d}}", event.name, i, ts, event.frameNumber );
+					break;
+			}
+			totalEvents++;
+		}
+	}
+
+	f->Printf( "\n],\"displayTimeUnit\":\"ms\"}\n" );
+
+	Mem_Free( events );
+	fileSystem->CloseFile( f );
+
+	common->Printf( "wrote %d profile events to %s\n", totalEvents, fileName );
+	return true;
+}
+
+/*
+========================
+idProfilerLocal::ProfileTrace_f
+========================
+*/
+void idProfilerLocal::ProfileTrace_f( const idCmdArgs &args ) {
+	const char *fileName = ( args.Argc() > 1 ) ? args.Argv( 1 ) : "profile/trace.json";
+
+	if ( profilerLocal.GetNumThreads() == 0 ) {
+		common->Printf( "nothing recorded, set com_profile 1 first\n" );
+		return;
+	}
+	profilerLocal.WriteTrace( fileName );
+}
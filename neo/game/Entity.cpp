@@ -2527,6 +2527,8 @@ bool idEntity::RunPhysics( void ) {
 	trace_t		results;
 	bool		moved;
 
+	PROFILE_SCOPE( "idEntity::RunPhysics" );
+
 	// don't run physics if not enabled
 	if ( !( thinkFlags & TH_PHYSICS ) ) {
 		// however do update any animation controllers
@@ -318,7 +318,7 @@ extern idGameEdit *				gameEdit;
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 8;
+const int GAME_API_VERSION		= 10;
 
 typedef struct {
 
@@ -336,6 +336,8 @@ typedef struct {
 	idDeclManager *				declManager;			// declaration manager
 	idAASFileManager *			AASFileManager;			// AAS file manager
 	idCollisionModelManager *	collisionModelManager;	// collision model manager
+	idParallelJobManager *		parallelJobManager;		// shared job threads
+	idProfiler *				profiler;				// profile zones
 
 } gameImport_t;
 
@@ -1469,6 +1469,9 @@ gameReturn_t idGameLocal::ClientPrediction( int clientNum, const usercmd_t *clie
 
 	ret.sessionCommand[ 0 ] = '\0';
 
+	// release the temporary allocations of the previous frame
+	Mem_ResetFrameArena();
+
 	player = static_cast<idPlayer *>( entities[clientNum] );
 	if ( !player ) {
 		return ret;
@@ -1499,6 +1502,9 @@ gameReturn_t idGameLocal::ClientPrediction( int clientNum, const usercmd_t *clie
 	// set the user commands for this frame
 	memcpy( usercmds, clientCmds, numClients * sizeof( usercmds[ 0 ] ) );
 
+	// forget the anim poses decoded during the last frame
+	animPoseCache.BeginFrame();
+
 	// run prediction on all entities from the last snapshot
 	for( ent = snapshotEntities.Next(); ent != NULL; ent = ent->snapshotNode.Next() ) {
 		ent->thinkFlags |= TH_PHYSICS;
@@ -59,6 +59,17 @@ typedef struct aasGoal_s {
 } aasGoal_t;
 
 
+typedef struct aasRoute_s {
+	int							areaNum;		// area to start from
+	idVec3						origin;			// start origin inside the area
+	int							goalAreaNum;	// area to route to
+	int							travelFlags;	// allowed travel flags
+	bool						result;			// true if there is a path
+	int							travelTime;		// travel time towards the goal area
+	idReachability *			reach;			// first reachability towards the goal area
+} aasRoute_t;
+
+
 typedef struct aasObstacle_s {
 	idBounds					absBounds;		// absolute bounds of obstacle
 	idBounds					expAbsBounds;	// expanded absolute bounds of obstacle
@@ -122,6 +133,10 @@ public:
 	virtual int					TravelTimeToGoalArea( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags ) const = 0;
 								// Get the travel time and first reachability to be used towards the goal, returns true if there is a path.
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const = 0;
+								// Same as RouteToGoalArea for many routes at once, the routes are spread over the job threads.
+	virtual void				RouteToGoalAreas( aasRoute_t *routes, int numRoutes ) const = 0;
+								// Returns the number of areas.
+	virtual int					GetNumAreas( void ) const = 0;
 								// Creates a walk path towards the goal.
 	virtual bool				WalkPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags ) const = 0;
 								// Returns true if one can walk along a straight line from the origin to the goal origin.
@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "AAS.h"
 #include "../Pvs.h"
 
+#define MAX_ROUTING_THREADS			16			// number of threads that can update the routing cache without allocating memory
+
 
 class idRoutingCache {
 	friend class idAASLocal;
@@ -50,8 +52,9 @@ private:
 	int							travelFlags;			// combinations of the travel flags
 	idRoutingCache *			next;					// next in list
 	idRoutingCache *			prev;					// previous in list
-	idRoutingCache *			time_next;				// next in time based list
-	idRoutingCache *			time_prev;				// previous in time based list
+	idRoutingCache *			list_next;				// next in list with all cache
+	idRoutingCache *			list_prev;				// previous in list with all cache
+	int							lastUsed;				// game frame the cache was last used
 	unsigned short				startTravelTime;		// travel time to start with
 	unsigned char *				reachabilities;			// reachabilities used for routing
 	unsigned short *			travelTimes;			// travel time for every area
@@ -73,6 +76,19 @@ private:
 };
 
 
+class idRoutingScratch {
+	friend class idAASLocal;
+								idRoutingScratch( void ) { inUse = 0; temporary = false; areaUpdate = portalUpdate = NULL; goalAreaTravelTimes = NULL; }
+
+private:
+	volatile int				inUse;					// set while a thread routes with this memory
+	bool						temporary;				// allocated because all the memory was in use
+	idRoutingUpdate *			areaUpdate;				// memory used to update the area routing cache
+	idRoutingUpdate *			portalUpdate;			// memory used to update the portal routing cache
+	unsigned short *			goalAreaTravelTimes;	// travel times to goal areas
+};
+
+
 class idRoutingObstacle {
 	friend class idAASLocal;
 								idRoutingObstacle( void ) { }
@@ -111,6 +127,8 @@ public:
 	virtual void				RemoveAllObstacles( void );
 	virtual int					TravelTimeToGoalArea( int areaNum, const idVec3 &origin, int goalAreaNum, int travelFlags ) const;
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int &travelTime, idReachability **reach ) const;
+	virtual void				RouteToGoalAreas( aasRoute_t *routes, int numRoutes ) const;
+	virtual int					GetNumAreas( void ) const;
 	virtual bool				WalkPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags ) const;
 	virtual bool				WalkPathValid( int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags, idVec3 &endPos, int &endAreaNum ) const;
 	virtual bool				FlyPathToGoal( aasPath_t &path, int areaNum, const idVec3 &origin, int goalAreaNum, const idVec3 &goalOrigin, int travelFlags ) const;
@@ -128,15 +146,26 @@ private:	// routing data
 	int							areaCacheIndexSize;		// number of area cache entries
 	idRoutingCache **			portalCacheIndex;		// for each area in the world the travel times from each portal
 	int							portalCacheIndexSize;	// number of portal cache entries
-	idRoutingUpdate *			areaUpdate;				// memory used to update the area routing cache
-	idRoutingUpdate *			portalUpdate;			// memory used to update the portal routing cache
-	unsigned short *			goalAreaTravelTimes;	// travel times to goal areas
+	mutable idRoutingScratch	routingScratch[MAX_ROUTING_THREADS];	// memory used to update the routing cache
 	unsigned short *			areaTravelTimes;		// travel times through the areas
 	int							numAreaTravelTimes;		// number of area travel times
-	mutable idRoutingCache *	cacheListStart;			// start of list with cache sorted from oldest to newest
-	mutable idRoutingCache *	cacheListEnd;			// end of list with cache sorted from oldest to newest
-	mutable int					totalCacheMemory;		// total cache memory used
+	mutable idRoutingCache *	cacheList;				// list with all cache
+	mutable idSysInterlockedInteger totalCacheMemory;	// total cache memory used
+	mutable bool				routingInParallel;		// set while routing on the job threads, cache can only be added then
+	idParallelJobList *			routingJobList;			// routes on the job threads
 	idList<idRoutingObstacle *>	obstacleList;			// list with obstacles
+	int *						clusterTableBlocks;		// for each cluster the number of changes that invalidate the precalculated routing tables
+	int							numTableBlocks;			// total number of changes that invalidate the precalculated routing tables
+
+private:	// routing statistics
+	mutable idSysInterlockedInteger	numAreaCacheHits;
+	mutable idSysInterlockedInteger	numAreaCacheMisses;
+	mutable idSysInterlockedInteger	numPortalCacheHits;
+	mutable idSysInterlockedInteger	numPortalCacheMisses;
+	mutable idSysInterlockedInteger	numDeletedCache;
+	mutable idSysInterlockedInteger	numAreaTableCopies;
+	mutable idSysInterlockedInteger	numPortalTableCopies;
+	mutable int					maxCacheMemory;			// highest cache memory used
 
 private:	// routing
 	bool						SetupRouting( void );
@@ -149,15 +178,23 @@ private:	// routing
 	void						DeletePortalCache( void );
 	void						ShutdownRoutingCache( void );
 	void						RoutingStats( void ) const;
-	void						LinkCache( idRoutingCache *cache ) const;
+	idRoutingScratch *			AllocRoutingScratch( void ) const;
+	void						FreeRoutingScratch( idRoutingScratch *scratch ) const;
+	idRoutingCache *			LinkCache( idRoutingCache **cacheIndex, idRoutingCache *cache ) const;
 	void						UnlinkCache( idRoutingCache *cache ) const;
 	void						DeleteOldestCache( void ) const;
+	static int					CompareCacheUse( idRoutingCache * const *a, idRoutingCache * const *b );
 	idReachability *			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache *areaCache ) const;
-	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
-	void						UpdatePortalRoutingCache( idRoutingCache *portalCache ) const;
+	void						UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingScratch *scratch ) const;
+	idRoutingCache *			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags, idRoutingScratch *scratch = NULL ) const;
+	void						UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingScratch *scratch ) const;
 	idRoutingCache *			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	bool						CopyAreaRouteTable( idRoutingCache *areaCache ) const;
+	bool						CopyPortalRouteTable( idRoutingCache *portalCache ) const;
+	void						VerifyRouteTable( const idRoutingCache *cache ) const;
+	void						BlockRouteTables( int areaNum );
+	void						UnblockRouteTables( int areaNum );
 	void						RemoveRoutingCacheUsingArea( int areaNum );
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
@@ -36,6 +36,9 @@ If you have questions concerning this license or the applicable additional terms
 #define CACHETYPE_PORTAL			2
 
 #define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
+#define MIN_ROUTING_CACHE_MEMORY	(MAX_ROUTING_CACHE_MEMORY*3/4)	// memory used after deleting the oldest cache
+
+#define ROUTES_PER_JOB				8
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
@@ -48,7 +51,8 @@ idRoutingCache::idRoutingCache( int size ) {
 	areaNum = 0;
 	cluster = 0;
 	next = prev = NULL;
-	time_next = time_prev = NULL;
+	list_next = list_prev = NULL;
+	lastUsed = 0;
 	travelFlags = 0;
 	startTravelTime = 0;
 	type = 0;
@@ -205,13 +209,22 @@ void idAASLocal::SetupRoutingCache( void ) {
 	portalCacheIndexSize = file->GetNumAreas();
 	portalCacheIndex = (idRoutingCache **) Mem_ClearedAlloc( portalCacheIndexSize * sizeof( idRoutingCache * ) );
 
-	areaUpdate = (idRoutingUpdate *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ) );
-	portalUpdate = (idRoutingUpdate *) Mem_ClearedAlloc( (file->GetNumPortals()+1) * sizeof( idRoutingUpdate ) );
-
-	goalAreaTravelTimes = (unsigned short *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ) );
-
-	cacheListStart = cacheListEnd = NULL;
-	totalCacheMemory = 0;
+	cacheList = NULL;
+	totalCacheMemory.SetValue( 0 );
+	routingInParallel = false;
+	routingJobList = parallelJobManager->AllocJobList( "aasRouting" );
+
+	clusterTableBlocks = (int *) Mem_ClearedAlloc( file->GetNumClusters() * sizeof( int ) );
+	numTableBlocks = 0;
+
+	numAreaCacheHits.SetValue( 0 );
+	numAreaCacheMisses.SetValue( 0 );
+	numPortalCacheHits.SetValue( 0 );
+	numPortalCacheMisses.SetValue( 0 );
+	numDeletedCache.SetValue( 0 );
+	numAreaTableCopies.SetValue( 0 );
+	numPortalTableCopies.SetValue( 0 );
+	maxCacheMemory = 0;
 }
 
 /*
@@ -223,9 +236,10 @@ void idAASLocal::DeleteClusterCache( int clusterNum ) {
 	int i;
 	idRoutingCache *cache;
 
+	assert( !routingInParallel );
+
 	for ( i = 0; i < file->GetCluster( clusterNum ).numReachableAreas; i++ ) {
 		for ( cache = areaCacheIndex[clusterNum][i]; cache; cache = areaCacheIndex[clusterNum][i] ) {
-			areaCacheIndex[clusterNum][i] = cache->next;
 			UnlinkCache( cache );
 			delete cache;
 		}
@@ -241,9 +255,10 @@ void idAASLocal::DeletePortalCache( void ) {
 	int i;
 	idRoutingCache *cache;
 
+	assert( !routingInParallel );
+
 	for ( i = 0; i < file->GetNumAreas(); i++ ) {
 		for ( cache = portalCacheIndex[i]; cache; cache = portalCacheIndex[i] ) {
-			portalCacheIndex[i] = cache->next;
 			UnlinkCache( cache );
 			delete cache;
 		}
@@ -270,15 +285,26 @@ void idAASLocal::ShutdownRoutingCache( void ) {
 	Mem_Free( portalCacheIndex );
 	portalCacheIndex = NULL;
 	portalCacheIndexSize = 0;
-	Mem_Free( areaUpdate );
-	areaUpdate = NULL;
-	Mem_Free( portalUpdate );
-	portalUpdate = NULL;
-	Mem_Free( goalAreaTravelTimes );
-	goalAreaTravelTimes = NULL;
-
-	cacheListStart = cacheListEnd = NULL;
-	totalCacheMemory = 0;
+
+	for ( i = 0; i < MAX_ROUTING_THREADS; i++ ) {
+		assert( !routingScratch[i].inUse );
+		Mem_Free( routingScratch[i].areaUpdate );
+		routingScratch[i].areaUpdate = NULL;
+		Mem_Free( routingScratch[i].portalUpdate );
+		routingScratch[i].portalUpdate = NULL;
+		Mem_Free( routingScratch[i].goalAreaTravelTimes );
+		routingScratch[i].goalAreaTravelTimes = NULL;
+	}
+
+	parallelJobManager->FreeJobList( routingJobList );
+	routingJobList = NULL;
+
+	Mem_Free( clusterTableBlocks );
+	clusterTableBlocks = NULL;
+	numTableBlocks = 0;
+
+	cacheList = NULL;
+	totalCacheMemory.SetValue( 0 );
 }
 
 /*
@@ -312,9 +338,11 @@ void idAASLocal::RoutingStats( void ) const {
 	int numAreaCache, numPortalCache;
 	int totalAreaCacheMemory, totalPortalCacheMemory;
 
+	int numHits, numMisses;
+
 	numAreaCache = numPortalCache = 0;
 	totalAreaCacheMemory = totalPortalCacheMemory = 0;
-	for ( cache = cacheListStart; cache; cache = cache->time_next ) {
+	for ( cache = cacheList; cache; cache = cache->list_next ) {
 		if ( cache->type == CACHETYPE_AREA ) {
 			numAreaCache++;
 			totalAreaCacheMemory += sizeof( idRoutingCache ) + cache->size * (sizeof( unsigned short ) + sizeof( byte ));
@@ -326,10 +354,20 @@ void idAASLocal::RoutingStats( void ) const {
 
 	gameLocal.Printf( "%6d area cache (%d KB)\n", numAreaCache, totalAreaCacheMemory >> 10 );
 	gameLocal.Printf( "%6d portal cache (%d KB)\n", numPortalCache, totalPortalCacheMemory >> 10 );
-	gameLocal.Printf( "%6d total cache (%d KB)\n", numAreaCache + numPortalCache, totalCacheMemory >> 10 );
+	gameLocal.Printf( "%6d total cache (%d KB, max %d KB)\n", numAreaCache + numPortalCache, totalCacheMemory.GetValue() >> 10, Max( maxCacheMemory, totalCacheMemory.GetValue() ) >> 10 );
 	gameLocal.Printf( "%6d area travel times (%d KB)\n", numAreaTravelTimes, ( numAreaTravelTimes * sizeof( unsigned short ) ) >> 10 );
 	gameLocal.Printf( "%6d area cache entries (%d KB)\n", areaCacheIndexSize, ( areaCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
 	gameLocal.Printf( "%6d portal cache entries (%d KB)\n", portalCacheIndexSize, ( portalCacheIndexSize * sizeof( idRoutingCache * ) ) >> 10 );
+
+	numHits = numAreaCacheHits.GetValue();
+	numMisses = numAreaCacheMisses.GetValue();
+	gameLocal.Printf( "%6d area cache hits, %d misses (%.1f%% hit)\n", numHits, numMisses, numHits + numMisses ? 100.0f * numHits / ( numHits + numMisses ) : 0.0f );
+	numHits = numPortalCacheHits.GetValue();
+	numMisses = numPortalCacheMisses.GetValue();
+	gameLocal.Printf( "%6d portal cache hits, %d misses (%.1f%% hit)\n", numHits, numMisses, numHits + numMisses ? 100.0f * numHits / ( numHits + numMisses ) : 0.0f );
+	gameLocal.Printf( "%6d cache deleted to stay below %d KB\n", numDeletedCache.GetValue(), MAX_ROUTING_CACHE_MEMORY >> 10 );
+	gameLocal.Printf( "%6d routing tables, %d changes block the tables\n", file->GetNumRouteTables(), numTableBlocks );
+	gameLocal.Printf( "%6d area cache and %d portal cache copied from the routing tables\n", numAreaTableCopies.GetValue(), numPortalTableCopies.GetValue() );
 }
 
 /*
@@ -368,6 +406,7 @@ void idAASLocal::DisableArea( int areaNum ) {
 	file->SetAreaTravelFlag( areaNum, TFL_INVALID );
 
 	RemoveRoutingCacheUsingArea( areaNum );
+	BlockRouteTables( areaNum );
 }
 
 /*
@@ -385,6 +424,7 @@ void idAASLocal::EnableArea( int areaNum ) {
 	file->RemoveAreaTravelFlag( areaNum, TFL_INVALID );
 
 	RemoveRoutingCacheUsingArea( areaNum );
+	UnblockRouteTables( areaNum );
 }
 
 /*
@@ -490,6 +530,10 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle *obstacle, bool enabl
 
 		RemoveRoutingCacheUsingArea( obstacle->areas[i] );
 
+		// reachabilities may stay disabled after the obstacle is removed
+		// so the routing tables are never used again for these areas
+		BlockRouteTables( obstacle->areas[i] );
+
 		area = &file->GetArea( obstacle->areas[i] );
 
 		for ( rev_reach = area->rev_reach; rev_reach; rev_reach = rev_reach->rev_next ) {
@@ -589,70 +633,112 @@ void idAASLocal::RemoveAllObstacles( void ) {
 
 /*
 ============
-idAASLocal::LinkCache
+idAASLocal::AllocRoutingScratch
 
-  link the cache in the cache list sorted from oldest to newest cache
+  Returns memory to update the routing cache with.  Every thread routing at the
+  same time uses its own memory.  If all the memory is in use temporary memory
+  is allocated, so a thread never waits for another.
 ============
 */
-void idAASLocal::LinkCache( idRoutingCache *cache ) const {
+idRoutingScratch *idAASLocal::AllocRoutingScratch( void ) const {
+	int i;
+	idRoutingScratch *scratch;
 
-	// if the cache is already linked
-	if ( cache->time_next || cache->time_prev || cacheListStart == cache ) {
-		UnlinkCache( cache );
+	scratch = NULL;
+	for ( i = 0; i < MAX_ROUTING_THREADS; i++ ) {
+		if ( Sys_InterlockedCompareExchange( routingScratch[i].inUse, 0, 1 ) == 0 ) {
+			scratch = &routingScratch[i];
+			break;
+		}
 	}
-
-	totalCacheMemory += cache->Size();
-
-	// add cache to the end of the list
-	cache->time_next = NULL;
-	cache->time_prev = cacheListEnd;
-	if ( cacheListEnd ) {
-		cacheListEnd->time_next = cache;
+	if ( !scratch ) {
+		scratch = new idRoutingScratch;
+		scratch->temporary = true;
 	}
-	cacheListEnd = cache;
-	if ( !cacheListStart ) {
-		cacheListStart = cache;
+	if ( !scratch->areaUpdate ) {
+		scratch->areaUpdate = (idRoutingUpdate *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ) );
+		scratch->portalUpdate = (idRoutingUpdate *) Mem_ClearedAlloc( (file->GetNumPortals()+1) * sizeof( idRoutingUpdate ) );
+		scratch->goalAreaTravelTimes = (unsigned short *) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ) );
 	}
+	return scratch;
 }
 
 /*
 ============
-idAASLocal::UnlinkCache
+idAASLocal::FreeRoutingScratch
 ============
 */
-void idAASLocal::UnlinkCache( idRoutingCache *cache ) const {
+void idAASLocal::FreeRoutingScratch( idRoutingScratch *scratch ) const {
+	if ( scratch->temporary ) {
+		Mem_Free( scratch->areaUpdate );
+		Mem_Free( scratch->portalUpdate );
+		Mem_Free( scratch->goalAreaTravelTimes );
+		delete scratch;
+		return;
+	}
+	Sys_InterlockedExchange( scratch->inUse, 0 );
+}
 
-	totalCacheMemory -= cache->Size();
+/*
+============
+idAASLocal::LinkCache
 
-	// unlink the cache
-	if ( cache->time_next ) {
-		cache->time_next->time_prev = cache->time_prev;
-	} else {
-		cacheListEnd = cache->time_prev;
+  Adds new cache to the area or portal cache index and the list with all cache.
+  Other threads may be adding cache at the same time.  If another thread already
+  added the same cache the new cache is deleted and the existing cache is returned.
+============
+*/
+idRoutingCache *idAASLocal::LinkCache( idRoutingCache **cacheIndex, idRoutingCache *cache ) const {
+	idRoutingCache *head, *existing;
+
+	// add the cache to the front of the area or portal cache index
+	do {
+		head = *(idRoutingCache * volatile *)cacheIndex;
+		for ( existing = head; existing; existing = existing->next ) {
+			if ( existing->travelFlags == cache->travelFlags ) {
+				delete cache;
+				return existing;
+			}
+		}
+		cache->prev = NULL;
+		cache->next = head;
+	} while( Sys_InterlockedCompareExchangePointer( *(void * volatile *)cacheIndex, head, cache ) != head );
+
+	// only the thread that added the cache in front of head updates the head
+	if ( head ) {
+		head->prev = cache;
 	}
-	if ( cache->time_prev ) {
-		cache->time_prev->time_next = cache->time_next;
-	} else {
-		cacheListStart = cache->time_next;
+
+	// add the cache to the front of the list with all cache
+	do {
+		head = *(idRoutingCache * volatile *)&cacheList;
+		cache->list_prev = NULL;
+		cache->list_next = head;
+	} while( Sys_InterlockedCompareExchangePointer( *(void * volatile *)&cacheList, head, cache ) != head );
+
+	if ( head ) {
+		head->list_prev = cache;
 	}
-	cache->time_next = cache->time_prev = NULL;
+
+	totalCacheMemory.Add( cache->Size() );
+
+	return cache;
 }
 
 /*
 ============
-idAASLocal::DeleteOldestCache
+idAASLocal::UnlinkCache
+
+  The cache can only be unlinked while no other thread is routing.
 ============
 */
-void idAASLocal::DeleteOldestCache( void ) const {
-	idRoutingCache *cache;
+void idAASLocal::UnlinkCache( idRoutingCache *cache ) const {
 
-	assert( cacheListStart );
+	assert( !routingInParallel );
 
-	// unlink the oldest cache
-	cache = cacheListStart;
-	UnlinkCache( cache );
+	totalCacheMemory.Add( -cache->Size() );
 
-	// unlink the oldest cache from the area or portal cache index
+	// unlink the cache from the area or portal cache index
 	if ( cache->next ) {
 		cache->next->prev = cache->prev;
 	}
@@ -666,7 +752,58 @@ void idAASLocal::DeleteOldestCache( void ) const {
 		portalCacheIndex[cache->areaNum] = cache->next;
 	}
 
-	delete cache;
+	// unlink the cache from the list with all cache
+	if ( cache->list_next ) {
+		cache->list_next->list_prev = cache->list_prev;
+	}
+	if ( cache->list_prev ) {
+		cache->list_prev->list_next = cache->list_next;
+	} else {
+		cacheList = cache->list_next;
+	}
+
+	cache->next = cache->prev = NULL;
+	cache->list_next = cache->list_prev = NULL;
+}
+
+/*
+============
+idAASLocal::CompareCacheUse
+============
+*/
+int idAASLocal::CompareCacheUse( idRoutingCache * const *a, idRoutingCache * const *b ) {
+	return (*a)->lastUsed - (*b)->lastUsed;
+}
+
+/*
+============
+idAASLocal::DeleteOldestCache
+
+  Deletes the least recently used cache until the cache memory drops below
+  MIN_ROUTING_CACHE_MEMORY, so the cache only needs to be sorted once in a while.
+============
+*/
+void idAASLocal::DeleteOldestCache( void ) const {
+	int i;
+	idRoutingCache *cache;
+	idList<idRoutingCache *> sorted;
+
+	assert( cacheList );
+
+	if ( totalCacheMemory.GetValue() > maxCacheMemory ) {
+		maxCacheMemory = totalCacheMemory.GetValue();
+	}
+
+	for ( cache = cacheList; cache; cache = cache->list_next ) {
+		sorted.Append( cache );
+	}
+	sorted.Sort( CompareCacheUse );
+
+	for ( i = 0; i < sorted.Num() && totalCacheMemory.GetValue() > MIN_ROUTING_CACHE_MEMORY; i++ ) {
+		UnlinkCache( sorted[i] );
+		delete sorted[i];
+		numDeletedCache.Increment();
+	}
 }
 
 /*
@@ -708,7 +845,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const {
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
+void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache, idRoutingScratch *scratch ) const {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
@@ -729,7 +866,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &scratch->areaUpdate[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -791,7 +928,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &scratch->areaUpdate[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -821,42 +958,161 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache *areaCache ) const {
 	}
 }
 
+/*
+============
+idAASLocal::BlockRouteTables
+
+  The precalculated routing tables are only valid while all areas are enabled.
+  Disabling an area blocks the tables for the clusters the area is part of,
+  and the portal tables for all areas.
+============
+*/
+void idAASLocal::BlockRouteTables( int areaNum ) {
+	int clusterNum;
+
+	clusterNum = file->GetArea( areaNum ).cluster;
+	if ( clusterNum > 0 ) {
+		clusterTableBlocks[clusterNum]++;
+	}
+	else {
+		clusterTableBlocks[file->GetPortal( -clusterNum ).clusters[0]]++;
+		clusterTableBlocks[file->GetPortal( -clusterNum ).clusters[1]]++;
+	}
+	numTableBlocks++;
+}
+
+/*
+============
+idAASLocal::UnblockRouteTables
+============
+*/
+void idAASLocal::UnblockRouteTables( int areaNum ) {
+	int clusterNum;
+
+	clusterNum = file->GetArea( areaNum ).cluster;
+	if ( clusterNum > 0 ) {
+		clusterTableBlocks[clusterNum]--;
+	}
+	else {
+		clusterTableBlocks[file->GetPortal( -clusterNum ).clusters[0]]--;
+		clusterTableBlocks[file->GetPortal( -clusterNum ).clusters[1]]--;
+	}
+	numTableBlocks--;
+}
+
+/*
+============
+idAASLocal::VerifyRouteTable
+
+  Compares cache copied from the routing tables with the cache the
+  routing code calculates.
+============
+*/
+void idAASLocal::VerifyRouteTable( const idRoutingCache *cache ) const {
+	idRoutingCache *check;
+	idRoutingScratch *scratch;
+
+	check = new idRoutingCache( cache->size );
+	check->type = cache->type;
+	check->cluster = cache->cluster;
+	check->areaNum = cache->areaNum;
+	check->startTravelTime = cache->startTravelTime;
+	check->travelFlags = cache->travelFlags;
+
+	scratch = AllocRoutingScratch();
+	if ( cache->type == CACHETYPE_AREA ) {
+		UpdateAreaRoutingCache( check, scratch );
+	} else {
+		UpdatePortalRoutingCache( check, scratch );
+	}
+	FreeRoutingScratch( scratch );
+
+	if ( memcmp( check->travelTimes, cache->travelTimes, cache->size * sizeof( cache->travelTimes[0] ) ) != 0 ||
+			memcmp( check->reachabilities, cache->reachabilities, cache->size * sizeof( cache->reachabilities[0] ) ) != 0 ) {
+		gameLocal.Warning( "%s routing table for area %d in cluster %d doesn't match the routing cache",
+							cache->type == CACHETYPE_AREA ? "area" : "portal", cache->areaNum, cache->cluster );
+	}
+
+	delete check;
+}
+
+/*
+============
+idAASLocal::CopyAreaRouteTable
+============
+*/
+bool idAASLocal::CopyAreaRouteTable( idRoutingCache *areaCache ) const {
+	int clusterAreaNum, numReachableAreas, offset;
+	const aasRouteTable_t *table;
+
+	if ( !aas_routeTables.GetBool() || clusterTableBlocks[areaCache->cluster] ) {
+		return false;
+	}
+
+	table = file->GetRouteTable( areaCache->travelFlags );
+	if ( !table || table->clusterOffset[areaCache->cluster] < 0 || areaCache->startTravelTime != 1 ) {
+		return false;
+	}
+
+	numReachableAreas = file->GetCluster( areaCache->cluster ).numReachableAreas;
+	clusterAreaNum = ClusterAreaNum( areaCache->cluster, areaCache->areaNum );
+	if ( clusterAreaNum >= numReachableAreas ) {
+		return false;
+	}
+
+	offset = table->clusterOffset[areaCache->cluster] + clusterAreaNum * numReachableAreas;
+	memcpy( areaCache->travelTimes, table->areaTravelTimes.Ptr() + offset, numReachableAreas * sizeof( areaCache->travelTimes[0] ) );
+	memcpy( areaCache->reachabilities, table->areaReach.Ptr() + offset, numReachableAreas * sizeof( areaCache->reachabilities[0] ) );
+	numAreaTableCopies.Increment();
+
+	if ( aas_verifyRouteTables.GetBool() ) {
+		VerifyRouteTable( areaCache );
+	}
+	return true;
+}
+
 /*
 ============
 idAASLocal::GetAreaRoutingCache
 ============
 */
-idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
+idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags, idRoutingScratch *scratch ) const {
 	int clusterAreaNum;
-	idRoutingCache *cache, *clusterCache;
+	idRoutingCache *cache;
 
 	// number of the area in the cluster
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
-	// pointer to the cache for the area in the cluster
-	clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
 	// check if cache without undesired travel flags already exists
-	for ( cache = clusterCache; cache; cache = cache->next ) {
+	for ( cache = areaCacheIndex[clusterNum][clusterAreaNum]; cache; cache = cache->next ) {
 		if ( cache->travelFlags == travelFlags ) {
 			break;
 		}
 	}
 	// if no cache found
 	if ( !cache ) {
+		numAreaCacheMisses.Increment();
 		cache = new idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
 		cache->type = CACHETYPE_AREA;
 		cache->cluster = clusterNum;
 		cache->areaNum = areaNum;
 		cache->startTravelTime = 1;
 		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = clusterCache;
-		if ( clusterCache ) {
-			clusterCache->prev = cache;
+		// copy the precalculated routing table or flood the cluster
+		if ( !CopyAreaRouteTable( cache ) ) {
+			if ( scratch ) {
+				UpdateAreaRoutingCache( cache, scratch );
+			} else {
+				scratch = AllocRoutingScratch();
+				UpdateAreaRoutingCache( cache, scratch );
+				FreeRoutingScratch( scratch );
+			}
 		}
-		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
+		// the cache is only shared with other threads once it's complete
+		cache = LinkCache( &areaCacheIndex[clusterNum][clusterAreaNum], cache );
+	} else {
+		numAreaCacheHits.Increment();
 	}
-	LinkCache( cache );
+	cache->lastUsed = gameLocal.framenum;
 	return cache;
 }
 
@@ -865,7 +1121,7 @@ idRoutingCache *idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 idAASLocal::UpdatePortalRoutingCache
 ============
 */
-void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
+void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache, idRoutingScratch *scratch ) const {
 	int i, portalNum, clusterAreaNum;
 	unsigned short t;
 	const aasPortal_t *portal;
@@ -873,7 +1129,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 	idRoutingCache *cache;
 	idRoutingUpdate *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 
-	curUpdate = &portalUpdate[ file->GetNumPortals() ];
+	curUpdate = &scratch->portalUpdate[ file->GetNumPortals() ];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -900,7 +1156,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 		curUpdate->isInList = false;
 
 		cluster = &file->GetCluster( curUpdate->cluster );
-		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags, scratch );
 
 		// take all portals of the cluster
 		for ( i = 0; i < cluster->numPortals; i++ ) {
@@ -923,7 +1179,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 
 				portalCache->travelTimes[portalNum] = t;
 				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				nextUpdate = &scratch->portalUpdate[portalNum];
 				if ( portal->clusters[0] == curUpdate->cluster ) {
 					nextUpdate->cluster = portal->clusters[1];
 				}
@@ -952,6 +1208,45 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache *portalCache ) const {
 	}
 }
 
+/*
+============
+idAASLocal::CopyPortalRouteTable
+============
+*/
+bool idAASLocal::CopyPortalRouteTable( idRoutingCache *portalCache ) const {
+	int clusterNum, offset;
+	const aasRouteTable_t *table;
+
+	// the portal tables depend on the area tables of all clusters
+	if ( !aas_routeTables.GetBool() || numTableBlocks ) {
+		return false;
+	}
+
+	table = file->GetRouteTable( portalCache->travelFlags );
+	if ( !table || table->portalOffset[portalCache->areaNum] < 0 || portalCache->startTravelTime != 1 ) {
+		return false;
+	}
+
+	// the tables assume a goal portal area is part of the front cluster
+	clusterNum = file->GetArea( portalCache->areaNum ).cluster;
+	if ( clusterNum < 0 ) {
+		clusterNum = file->GetPortal( -clusterNum ).clusters[0];
+	}
+	if ( clusterNum != portalCache->cluster ) {
+		return false;
+	}
+
+	offset = table->portalOffset[portalCache->areaNum];
+	memcpy( portalCache->travelTimes, table->portalTravelTimes.Ptr() + offset, portalCache->size * sizeof( portalCache->travelTimes[0] ) );
+	memcpy( portalCache->reachabilities, table->portalReach.Ptr() + offset, portalCache->size * sizeof( portalCache->reachabilities[0] ) );
+	numPortalTableCopies.Increment();
+
+	if ( aas_verifyRouteTables.GetBool() ) {
+		VerifyRouteTable( portalCache );
+	}
+	return true;
+}
+
 /*
 ============
 idAASLocal::GetPortalRoutingCache
@@ -959,6 +1254,7 @@ idAASLocal::GetPortalRoutingCache
 */
 idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const {
 	idRoutingCache *cache;
+	idRoutingScratch *scratch;
 
 	// check if cache without undesired travel flags already exists
 	for ( cache = portalCacheIndex[areaNum]; cache; cache = cache->next ) {
@@ -968,21 +1264,24 @@ idRoutingCache *idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 	}
 	// if no cache found
 	if ( !cache ) {
+		numPortalCacheMisses.Increment();
 		cache = new idRoutingCache( file->GetNumPortals() );
 		cache->type = CACHETYPE_PORTAL;
 		cache->cluster = clusterNum;
 		cache->areaNum = areaNum;
 		cache->startTravelTime = 1;
 		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = portalCacheIndex[areaNum];
-		if ( portalCacheIndex[areaNum] ) {
-			portalCacheIndex[areaNum]->prev = cache;
+		if ( !CopyPortalRouteTable( cache ) ) {
+			scratch = AllocRoutingScratch();
+			UpdatePortalRoutingCache( cache, scratch );
+			FreeRoutingScratch( scratch );
 		}
-		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+		// the cache is only shared with other threads once it's complete
+		cache = LinkCache( &portalCacheIndex[areaNum], cache );
+	} else {
+		numPortalCacheHits.Increment();
 	}
-	LinkCache( cache );
+	cache->lastUsed = gameLocal.framenum;
 	return cache;
 }
 
@@ -1019,7 +1318,8 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY ) {
+	// cache can't be deleted while other threads may be using it
+	if ( totalCacheMemory.GetValue() > MAX_ROUTING_CACHE_MEMORY && !routingInParallel ) {
 		DeleteOldestCache();
 	}
 
@@ -1161,6 +1461,70 @@ int idAASLocal::TravelTimeToGoalArea( int areaNum, const idVec3 &origin, int goa
 	return travelTime;
 }
 
+typedef struct aasRouteJob_s {
+	const idAAS *				aas;
+	aasRoute_t *				routes;
+	int							numRoutes;
+} aasRouteJob_t;
+
+/*
+============
+RouteToGoalAreasJob
+============
+*/
+static void RouteToGoalAreasJob( void *data ) {
+	aasRouteJob_t *job = (aasRouteJob_t *) data;
+
+	for ( int i = 0; i < job->numRoutes; i++ ) {
+		aasRoute_t &route = job->routes[i];
+		route.result = job->aas->RouteToGoalArea( route.areaNum, route.origin, route.goalAreaNum, route.travelFlags, route.travelTime, &route.reach );
+	}
+}
+
+/*
+============
+idAASLocal::RouteToGoalAreas
+
+  While the routes are calculated on the job threads the routing cache is only
+  added to, the cache memory is brought back within bounds afterwards.
+============
+*/
+void idAASLocal::RouteToGoalAreas( aasRoute_t *routes, int numRoutes ) const {
+	int i, numJobs;
+	idList<aasRouteJob_t> jobs;
+
+	if ( !file || numRoutes <= 0 ) {
+		for ( i = 0; i < numRoutes; i++ ) {
+			routes[i].result = false;
+			routes[i].travelTime = 0;
+			routes[i].reach = NULL;
+		}
+		return;
+	}
+
+	if ( totalCacheMemory.GetValue() > MAX_ROUTING_CACHE_MEMORY ) {
+		DeleteOldestCache();
+	}
+
+	numJobs = ( numRoutes + ROUTES_PER_JOB - 1 ) / ROUTES_PER_JOB;
+	jobs.SetNum( numJobs );
+	for ( i = 0; i < numJobs; i++ ) {
+		jobs[i].aas = this;
+		jobs[i].routes = routes + i * ROUTES_PER_JOB;
+		jobs[i].numRoutes = Min( ROUTES_PER_JOB, numRoutes - i * ROUTES_PER_JOB );
+		routingJobList->AddJob( RouteToGoalAreasJob, &jobs[i] );
+	}
+
+	routingInParallel = true;
+	routingJobList->Submit();
+	routingJobList->Wait();
+	routingInParallel = false;
+
+	if ( totalCacheMemory.GetValue() > MAX_ROUTING_CACHE_MEMORY ) {
+		DeleteOldestCache();
+	}
+}
+
 /*
 ============
 idAASLocal::FindNearestGoal
@@ -1174,6 +1538,9 @@ bool idAASLocal::FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 ori
 	const aasArea_t *nextArea;
 	idVec3 v1, v2, p;
 	float targetDist, dist;
+	idRoutingScratch *scratch;
+	idRoutingUpdate *areaUpdate;
+	unsigned short *goalAreaTravelTimes;
 
 	if ( file == NULL || areaNum <= 0 ) {
 		goal.areaNum = areaNum;
@@ -1194,6 +1561,10 @@ bool idAASLocal::FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 ori
 		obstacles[k].expAbsBounds[1] = obstacles[k].absBounds[1] - file->GetSettings().boundingBoxes[0][0];
 	}
 	
+	scratch = AllocRoutingScratch();
+	areaUpdate = scratch->areaUpdate;
+	goalAreaTravelTimes = scratch->goalAreaTravelTimes;
+
 	badTravelFlags = ~travelFlags;
 	SIMDProcessor->Memset( goalAreaTravelTimes, 0, file->GetNumAreas() * sizeof( unsigned short ) );
 
@@ -1339,6 +1710,8 @@ bool idAASLocal::FindNearestGoal( aasGoal_t &goal, int areaNum, const idVec3 ori
 		}
 	}
 
+	FreeRoutingScratch( scratch );
+
 	if ( bestAreaNum ) {
 		goal.areaNum = bestAreaNum;
 		goal.origin = AreaCenter( bestAreaNum );
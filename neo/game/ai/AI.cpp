@@ -1045,6 +1045,8 @@ idAI::Think
 =====================
 */
 void idAI::Think( void ) {
+	PROFILE_SCOPE( "idAI::Think" );
+
 	// if we are completely closed off from the player, don't do anything at all
 	if ( CheckDormant() ) {
 		return;
@@ -1384,6 +1386,47 @@ int idAI::PointReachableAreaNum( const idVec3 &pos, const float boundsScale ) co
 	return areaNum;
 }
 
+/*
+=====================
+idAI::GetMoveRoute
+
+  Returns the route from the current area towards the goal area that
+  GetMovePos will look for when the monster moves this frame, so the
+  route can be calculated ahead of the think.
+=====================
+*/
+bool idAI::GetMoveRoute( aasRoute_t &route ) const {
+	idVec3 org;
+
+	if ( !aas || !move.toAreaNum || gameLocal.time <= move.blockTime ) {
+		return false;
+	}
+
+	switch( move.moveCommand ) {
+	case MOVE_NONE :
+	case MOVE_FACE_ENEMY :
+	case MOVE_FACE_ENTITY :
+	case MOVE_TO_POSITION_DIRECT :
+	case MOVE_SLIDE_TO_POSITION :
+	case MOVE_WANDER :
+		return false;
+	default :
+		break;
+	}
+
+	org = physicsObj.GetOrigin();
+	route.areaNum = PointReachableAreaNum( org );
+	aas->PushPointIntoAreaNum( route.areaNum, org );
+	if ( !route.areaNum ) {
+		return false;
+	}
+
+	route.origin = org;
+	route.goalAreaNum = move.toAreaNum;
+	route.travelFlags = travelFlags;
+	return true;
+}
+
 /*
 =====================
 idAI::PathToGoal
@@ -259,6 +259,10 @@ public:
 							// Outputs a list of all monsters to the console.
 	static void				List_f( const idCmdArgs &args );
 
+							// Returns the route GetMovePos will look for this frame.
+	bool					GetMoveRoute( aasRoute_t &route ) const;
+	idAAS *					GetAAS( void ) const { return aas; }
+
 							// Finds a path around dynamic obstacles.
 	static bool				FindPathAroundObstacles( const idPhysics *physics, const idAAS *aas, const idEntity *ignore, const idVec3 &startPos, const idVec3 &seekPos, obstaclePath_t &path );
 							// Frees any nodes used for the dynamic obstacle avoidance.
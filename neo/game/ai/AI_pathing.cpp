@@ -1350,7 +1350,8 @@ bool idAI::TestTrajectory( const idVec3 &start, const idVec3 &end, float zVel, f
 	int i, numSegments;
 	float maxHeight, t, t2;
 	idVec3 points[5];
-	trace_t trace;
+	clipTrace_t traces[4];
+	trace_t results[4], trace;
 	bool result;
 
 	t = zVel / gravity;
@@ -1401,10 +1402,22 @@ bool idAI::TestTrajectory( const idVec3 &start, const idVec3 &end, float zVel, f
 		}
 	}
 
+	// the segments are next to each other so they are traced as one batch
+	for ( i = 0; i < numSegments; i++ ) {
+		traces[i].start = points[i];
+		traces[i].end = points[i+1];
+		traces[i].mdl = clip;
+		traces[i].trmAxis = mat3_identity;
+		traces[i].contentMask = clipmask;
+		traces[i].passEntity = ignore;
+	}
+	gameLocal.clip.TranslationBatch( results, traces, numSegments );
+
 	result = true;
+	trace = results[numSegments - 1];
 	for ( i = 0; i < numSegments; i++ ) {
-		gameLocal.clip.Translation( trace, points[i], points[i+1], clip, mat3_identity, clipmask, ignore );
-		if ( trace.fraction < 1.0f ) {
+		if ( results[i].fraction < 1.0f ) {
+			trace = results[i];
 			if ( gameLocal.GetTraceEntity( trace ) == targetEntity ) {
 				result = true;
 			} else {
@@ -516,6 +516,7 @@ public:
 	void						ClearForceUpdate( void );
 	bool						CreateFrame( int animtime, bool force );
 	bool						FrameHasChanged( int animtime ) const;
+	int							GetFrameNumber( void ) const;
 	void						GetDelta( int fromtime, int totime, idVec3 &delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3 &delta ) const;
 	void						GetOrigin( int currentTime, idVec3 &pos ) const;
@@ -573,6 +574,7 @@ private:
 	idJointMat *				joints;
 
 	mutable int					lastTransformTime;		// mutable because the value is updated in CreateFrame
+	int							frameNumber;			// incremented each time CreateFrame creates the joints
 	mutable bool				stoppedAnimatingUpdate;
 	bool						removeOriginOffset;
 	bool						forceUpdate;
@@ -618,4 +620,67 @@ private:
 	idHashIndex					jointnamesHash;
 };
 
+/*
+==============================================================================================
+
+	idAnimPoseCache
+
+	Keeps the joints decoded from md5 anims during the current game frame so
+	entities playing the same anim at the same frame only decode it once.
+
+	Animation frames are created on the job threads, so the cache is lock-free:
+	poses are stored in fixed buffers reserved with interlocked adds and are
+	published by linking them into a hash chain with a compare-and-swap. A
+	published pose is never changed until the cache is reset, which only
+	happens on the main thread while no frames are being created.
+
+==============================================================================================
+*/
+
+class idAnimPoseCache {
+public:
+								idAnimPoseCache();
+
+	void						BeginFrame( void );
+	void						Clear( void );
+	void						Shutdown( void );
+	void						GetInterpolatedFrame( const idMD5Anim *anim, frameBlend_t &frame, idJointQuat *joints, const int *index, int numIndexes );
+	void						GetSingleFrame( const idMD5Anim *anim, int framenum, idJointQuat *joints, const int *index, int numIndexes );
+
+	int							NumLookups( void ) const { return numLookups.GetValue(); }
+	int							NumHits( void ) const { return numHits.GetValue(); }
+	void						ClearStatistics( void );
+
+private:
+	typedef struct animPose_s {
+		const idMD5Anim *		anim;
+		const int *				index;			// joint subset that was decoded
+		int						numIndexes;
+		int						cycleCount;
+		int						frame1;
+		int						frame2;			// -1 for a single frame
+		float					backlerp;
+		int						firstJoint;		// offset in poseJoints
+		int						next;			// next pose in the hash chain
+	} animPose_t;
+
+	static const int			MAX_POSES = 1024;
+	static const int			MAX_JOINTS = 32 * 1024;
+	static const int			HASH_SIZE = 1024;
+
+	animPose_t *				poses;
+	idJointQuat *				poseJoints;
+	volatile int				hashHeads[ HASH_SIZE ];
+	idSysInterlockedInteger		numPoses;
+	idSysInterlockedInteger		numPoseJoints;
+	idSysInterlockedInteger		frameLookups;
+	idSysInterlockedInteger		frameHits;
+	idSysInterlockedInteger		numLookups;
+	idSysInterlockedInteger		numHits;
+
+	int							HashKey( const animPose_t &pose ) const;
+	const idJointQuat *			FindPose( const animPose_t &pose, int key );
+	void						StorePose( animPose_t &pose, int key, const idJointQuat *joints );
+};
+
 #endif /* !__ANIM_H__ */
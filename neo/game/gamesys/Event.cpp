@@ -213,10 +213,328 @@ const idEventDef *idEventDef::FindEvent( const char *name ) {
 
 ***********************************************************************/
 
+/***********************************************************************
+
+  idEventTimeQueue
+
+  Pending events are kept in one bucket per distinct time. The buckets
+  are ordered by a binary heap and found through a hash on the time,
+  so scheduling and servicing an event never walks the other pending
+  events. Within a bucket the events are kept in the order they were
+  scheduled, which preserves the ordering of the old sorted list.
+
+***********************************************************************/
+
+class idEventTimeQueue {
+public:
+							idEventTimeQueue( void );
+
+	void					Clear( void );
+	void					Shutdown( void );
+	void					Add( idEvent *event );
+	void					Remove( idEvent *event );
+	bool					IsEmpty( void ) const;
+	idEvent *				First( void ) const;
+	int						Num( void ) const;
+	int						NumBuckets( void ) const;
+	void					GetEvents( idList<idEvent *> &events ) const;
+
+private:
+	typedef struct eventBucket_s {
+		int					time;
+		int					heapIndex;
+		idLinkList<idEvent>	events;
+	} eventBucket_t;
+
+	eventBucket_t			buckets[ MAX_EVENTS ];
+	int						freeBuckets[ MAX_EVENTS ];
+	int						numFreeBuckets;
+	int						heap[ MAX_EVENTS ];		// bucket numbers ordered on time
+	int						numBuckets;
+	int						numEvents;
+	idHashIndex				timeHash;
+
+	int						FindBucket( int time ) const;
+	void					RemoveBucket( int bucketNum );
+	void					HeapUp( int index );
+	void					HeapDown( int index );
+	void					HeapSet( int index, int bucketNum );
+};
+
+/*
+================
+idEventTimeQueue::idEventTimeQueue
+================
+*/
+idEventTimeQueue::idEventTimeQueue( void ) : timeHash( 1024, MAX_EVENTS ) {
+	Clear();
+}
+
+/*
+================
+idEventTimeQueue::Clear
+================
+*/
+void idEventTimeQueue::Clear( void ) {
+	int i;
+
+	for ( i = 0; i < MAX_EVENTS; i++ ) {
+		buckets[ i ].events.Clear();
+		freeBuckets[ i ] = MAX_EVENTS - 1 - i;
+	}
+	numFreeBuckets = MAX_EVENTS;
+	numBuckets = 0;
+	numEvents = 0;
+	timeHash.Clear();
+}
+
+/*
+================
+idEventTimeQueue::Shutdown
+================
+*/
+void idEventTimeQueue::Shutdown( void ) {
+	Clear();
+	timeHash.Free();
+}
+
+/*
+================
+idEventTimeQueue::Add
+
+  Appends the event to the bucket for its time.
+================
+*/
+void idEventTimeQueue::Add( idEvent *event ) {
+	int bucketNum;
+
+	assert( event->queue == NULL );
+
+	bucketNum = FindBucket( event->time );
+	if ( bucketNum == -1 ) {
+		// there can never be more buckets than events
+		assert( numFreeBuckets > 0 );
+		bucketNum = freeBuckets[ --numFreeBuckets ];
+		buckets[ bucketNum ].time = event->time;
+		timeHash.Add( event->time, bucketNum );
+		HeapSet( numBuckets, bucketNum );
+		numBuckets++;
+		HeapUp( numBuckets - 1 );
+	}
+
+	event->eventNode.AddToEnd( buckets[ bucketNum ].events );
+	event->queue = this;
+	event->bucket = bucketNum;
+	numEvents++;
+}
+
+/*
+================
+idEventTimeQueue::Remove
+================
+*/
+void idEventTimeQueue::Remove( idEvent *event ) {
+	int bucketNum;
+
+	assert( event->queue == this );
+
+	bucketNum = event->bucket;
+	event->eventNode.Remove();
+	event->queue = NULL;
+	event->bucket = -1;
+	numEvents--;
+
+	if ( buckets[ bucketNum ].events.IsListEmpty() ) {
+		RemoveBucket( bucketNum );
+	}
+}
+
+/*
+================
+idEventTimeQueue::IsEmpty
+================
+*/
+bool idEventTimeQueue::IsEmpty( void ) const {
+	return ( numBuckets == 0 );
+}
+
+/*
+================
+idEventTimeQueue::First
+
+  Returns the first event to be serviced.
+================
+*/
+idEvent *idEventTimeQueue::First( void ) const {
+	if ( !numBuckets ) {
+		return NULL;
+	}
+	return buckets[ heap[ 0 ] ].events.Next();
+}
+
+/*
+================
+idEventTimeQueue::Num
+================
+*/
+int idEventTimeQueue::Num( void ) const {
+	return numEvents;
+}
+
+/*
+================
+idEventTimeQueue::NumBuckets
+================
+*/
+int idEventTimeQueue::NumBuckets( void ) const {
+	return numBuckets;
+}
+
+/*
+================
+idEventTimeQueue::GetEvents
+
+  Lists all pending events in the order they will be serviced.
+================
+*/
+void idEventTimeQueue::GetEvents( idList<idEvent *> &events ) const {
+	int i;
+	idList<int> times;
+	idEvent *event;
+
+	times.SetNum( numBuckets );
+	for ( i = 0; i < numBuckets; i++ ) {
+		times[ i ] = buckets[ heap[ i ] ].time;
+	}
+	times.Sort();
+
+	events.Clear();
+	events.SetGranularity( 256 );
+	for ( i = 0; i < times.Num(); i++ ) {
+		for ( event = buckets[ FindBucket( times[ i ] ) ].events.Next(); event != NULL; event = event->eventNode.Next() ) {
+			events.Append( event );
+		}
+	}
+}
+
+/*
+================
+idEventTimeQueue::FindBucket
+================
+*/
+int idEventTimeQueue::FindBucket( int time ) const {
+	int i;
+
+	for ( i = timeHash.First( time ); i != -1; i = timeHash.Next( i ) ) {
+		if ( buckets[ i ].time == time ) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+================
+idEventTimeQueue::RemoveBucket
+================
+*/
+void idEventTimeQueue::RemoveBucket( int bucketNum ) {
+	int index;
+
+	timeHash.Remove( buckets[ bucketNum ].time, bucketNum );
+
+	// move the last heap entry into the hole and restore the heap order
+	index = buckets[ bucketNum ].heapIndex;
+	numBuckets--;
+	if ( index < numBuckets ) {
+		HeapSet( index, heap[ numBuckets ] );
+		HeapDown( index );
+		HeapUp( index );
+	}
+
+	freeBuckets[ numFreeBuckets++ ] = bucketNum;
+}
+
+/*
+================
+idEventTimeQueue::HeapUp
+================
+*/
+void idEventTimeQueue::HeapUp( int index ) {
+	int parent, bucketNum;
+
+	bucketNum = heap[ index ];
+	while( index > 0 ) {
+		parent = ( index - 1 ) >> 1;
+		if ( buckets[ heap[ parent ] ].time <= buckets[ bucketNum ].time ) {
+			break;
+		}
+		HeapSet( index, heap[ parent ] );
+		index = parent;
+	}
+	HeapSet( index, bucketNum );
+}
+
+/*
+================
+idEventTimeQueue::HeapDown
+================
+*/
+void idEventTimeQueue::HeapDown( int index ) {
+	int child, bucketNum;
+
+	bucketNum = heap[ index ];
+	while( 1 ) {
+		child = ( index << 1 ) + 1;
+		if ( child >= numBuckets ) {
+			break;
+		}
+		if ( child + 1 < numBuckets && buckets[ heap[ child + 1 ] ].time < buckets[ heap[ child ] ].time ) {
+			child++;
+		}
+		if ( buckets[ bucketNum ].time <= buckets[ heap[ child ] ].time ) {
+			break;
+		}
+		HeapSet( index, heap[ child ] );
+		index = child;
+	}
+	HeapSet( index, bucketNum );
+}
+
+/*
+================
+idEventTimeQueue::HeapSet
+================
+*/
+ID_INLINE void idEventTimeQueue::HeapSet( int index, int bucketNum ) {
+	heap[ index ] = bucketNum;
+	buckets[ bucketNum ].heapIndex = index;
+}
+
+/***********************************************************************
+
+  idEvent
+
+***********************************************************************/
+
 static idLinkList<idEvent> FreeEvents;
-static idLinkList<idEvent> EventQueue;
+static idEventTimeQueue EventQueue;
+static idHashIndex EventObjectHash( 1024, MAX_EVENTS );	// pool indices of scheduled events hashed on their object
 static idEvent EventPool[ MAX_EVENTS ];
 
+static int numEventsScheduled;
+static int numEventsServiced;
+static int numEventsCancelled;
+
+/*
+================
+EventObjectKey
+================
+*/
+static ID_INLINE int EventObjectKey( const idClass *obj ) {
+	return static_cast<int>( reinterpret_cast<size_t>( obj ) >> 4 );
+}
+
 bool idEvent::initialized = false;
 
 idDynamicBlockAlloc<byte, 16 * 1024, 256>	idEvent::eventDataAllocator;
@@ -354,12 +672,28 @@ void idEvent::CopyArgs( const idEventDef *evdef, int numargs, va_list args, int
 	}
 }
 
+/*
+================
+idEvent::Unschedule
+
+  Removes the event from the queue it is scheduled in.
+================
+*/
+void idEvent::Unschedule( void ) {
+	if ( queue != NULL ) {
+		EventObjectHash.Remove( EventObjectKey( object ), this - EventPool );
+		queue->Remove( this );
+	}
+}
+
 /*
 ================
 idEvent::Free
 ================
 */
 void idEvent::Free( void ) {
+	Unschedule();
+
 	if ( data ) {
 		eventDataAllocator.Free( data );
 		data = NULL;
@@ -380,13 +714,13 @@ idEvent::Schedule
 ================
 */
 void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
-	idEvent *event;
-
 	assert( initialized );
 	if ( !initialized ) {
 		return;
 	}
 
+	Unschedule();
+
 	object = obj;
 	typeinfo = type;
 
@@ -395,16 +729,9 @@ void idEvent::Schedule( idClass *obj, const idTypeInfo *type, int time ) {
 
 	eventNode.Remove();
 
-	event = EventQueue.Next();
-	while( ( event != NULL ) && ( this->time >= event->time ) ) {
-		event = event->eventNode.Next();
-	}
-
-	if ( event ) {
-		eventNode.InsertBefore( event->eventNode );
-	} else {
-		eventNode.AddToEnd( EventQueue );
-	}
+	EventQueue.Add( this );
+	EventObjectHash.Add( EventObjectKey( object ), this - EventPool );
+	numEventsScheduled++;
 }
 
 /*
@@ -414,17 +741,19 @@ idEvent::CancelEvents
 */
 void idEvent::CancelEvents( const idClass *obj, const idEventDef *evdef ) {
 	idEvent *event;
-	idEvent *next;
+	int i, next;
 
 	if ( !initialized ) {
 		return;
 	}
 
-	for( event = EventQueue.Next(); event != NULL; event = next ) {
-		next = event->eventNode.Next();
+	for( i = EventObjectHash.First( EventObjectKey( obj ) ); i != -1; i = next ) {
+		next = EventObjectHash.Next( i );
+		event = &EventPool[ i ];
 		if ( event->object == obj ) {
 			if ( !evdef || ( evdef == event->eventdef ) ) {
 				event->Free();
+				numEventsCancelled++;
 			}
 		}
 	}
@@ -443,11 +772,14 @@ void idEvent::ClearEventList( void ) {
 	//
 	FreeEvents.Clear();
 	EventQueue.Clear();
+	EventObjectHash.Clear();
    
 	// 
 	// add the events to the free list
 	//
 	for( i = 0; i < MAX_EVENTS; i++ ) {
+		EventPool[ i ].queue = NULL;
+		EventPool[ i ].bucket = -1;
 		EventPool[ i ].Free();
 	}
 }
@@ -470,9 +802,11 @@ void idEvent::ServiceEvents( void ) {
 	byte		*data;
 	const char  *materialName;
 
+	PROFILE_SCOPE( "idEvent::ServiceEvents" );
+
 	num = 0;
-	while( !EventQueue.IsListEmpty() ) {
-		event = EventQueue.Next();
+	while( !EventQueue.IsEmpty() ) {
+		event = EventQueue.First();
 		assert( event );
 
 		if ( event->time > gameLocal.time ) {
@@ -527,7 +861,7 @@ void idEvent::ServiceEvents( void ) {
 
 		// the event is removed from its list so that if then object
 		// is deleted, the event won't be freed twice
-		event->eventNode.Remove();
+		event->Unschedule();
 		assert( event->object );
 		event->object->ProcessEventArgPtr( ev, args );
 
@@ -541,6 +875,7 @@ void idEvent::ServiceEvents( void ) {
 
 		// return the event to the free list
 		event->Free();
+		numEventsServiced++;
 
 		// Don't allow ourselves to stay in here too long.  An abnormally high number
 		// of events being processed is evidence of an infinite loop of events.
@@ -549,6 +884,14 @@ void idEvent::ServiceEvents( void ) {
 			gameLocal.Error( "Event overflow.  Possible infinite loop in script." );
 		}
 	}
+
+	if ( g_showEvents.GetBool() ) {
+		gameLocal.Printf( "%d: %d events scheduled, %d serviced, %d cancelled, %d pending at %d times\n", gameLocal.time,
+			numEventsScheduled, numEventsServiced, numEventsCancelled, EventQueue.Num(), EventQueue.NumBuckets() );
+	}
+	numEventsScheduled = 0;
+	numEventsServiced = 0;
+	numEventsCancelled = 0;
 }
 
 /*
@@ -599,7 +942,10 @@ void idEvent::Shutdown( void ) {
 	}
 
 	ClearEventList();
-	
+
+	EventQueue.Shutdown();
+	EventObjectHash.Free();
+
 	eventDataAllocator.Shutdown();
 
 	// say it is now shutdown
@@ -613,16 +959,18 @@ idEvent::Save
 */
 void idEvent::Save( idSaveGame *savefile ) {
 	char *str;
-	int i, size;
+	int i, j, size;
 	idEvent	*event;
 	byte *dataPtr;
 	bool validTrace;
 	const char	*format;
+	idList<idEvent *> events;
 
-	savefile->WriteInt( EventQueue.Num() );
+	EventQueue.GetEvents( events );
+	savefile->WriteInt( events.Num() );
 
-	event = EventQueue.Next();
-	while( event != NULL ) {
+	for ( j = 0; j < events.Num(); j++ ) {
+		event = events[ j ];
 		savefile->WriteInt( event->time );
 		savefile->WriteString( event->eventdef->GetName() );
 		savefile->WriteString( event->typeinfo->classname );
@@ -666,7 +1014,6 @@ void idEvent::Save( idSaveGame *savefile ) {
 			}
 		}
 		assert( size == event->eventdef->GetArgSize() );
-		event = event->eventNode.Next();
 	}
 }
 
@@ -692,7 +1039,6 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 
 		event = FreeEvents.Next();
 		event->eventNode.Remove();
-		event->eventNode.AddToEnd( EventQueue );
 
 		savefile->ReadInt( event->time );
 
@@ -760,6 +1106,9 @@ void idEvent::Restore( idRestoreGame *savefile ) {
 		} else {
 			event->data = NULL;
 		}
+
+		EventQueue.Add( event );
+		EventObjectHash.Add( EventObjectKey( event->object ), event - EventPool );
 	}
 }
 
@@ -808,6 +808,187 @@ void Cmd_Spawn_f( const idCmdArgs &args ) {
 	gameLocal.SpawnEntityDef( dict );
 }
 
+/*
+==================
+BenchmarkAF_Evaluate
+
+Evaluates the physics of a figure the same way idEntity::RunPhysics does.
+==================
+*/
+static void BenchmarkAF_Evaluate( idEntity *ent, int endTime ) {
+	idEntity *part;
+
+	for ( part = ent; part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( !part->fl.solidForTeam ) {
+			part->GetPhysics()->DisableClip();
+		}
+	}
+	ent->GetPhysics()->Evaluate( USERCMD_MSEC, endTime );
+	for ( part = ent; part != NULL; part = part->GetNextTeamEntity() ) {
+		if ( !part->fl.solidForTeam ) {
+			part->GetPhysics()->EnableClip();
+		}
+	}
+}
+
+/*
+==================
+Cmd_BenchmarkAF_f
+
+Spawns a grid of articulated figures in front of the player and runs their
+physics for a number of frames without rendering.  The frames are run once
+with the figures evaluated serially and once with the figures solved on
+the job threads, the figures are put back where they started afterwards.
+The figures need a map to collide with but no player, without a local player
+the grid is spawned at the first spawn point, so the benchmark also runs on
+a dedicated server: +map <map> +benchmarkAF <entityDef> <count>
+==================
+*/
+void Cmd_BenchmarkAF_f( const idCmdArgs &args ) {
+	int			i, frame, count, numFrames, gridSize, endTime, numDiffer;
+	float		yaw, serialTime, parallelTime;
+	idVec3		start, org, forward, right;
+	idPlayer	*player;
+	idEntity	*ent, *spot;
+	idDict		dict;
+	idTimer		timer;
+	idList<idEntity *> figures;
+	idList<idVec3> serialOrigins;
+
+	if ( gameLocal.GameState() != GAMESTATE_ACTIVE ) {
+		gameLocal.Printf( "benchmarkAF needs a map\n" );
+		return;
+	}
+	if ( !gameLocal.CheatsOk( false ) ) {
+		return;
+	}
+
+	if ( args.Argc() < 3 ) {
+		gameLocal.Printf( "usage: benchmarkAF <entityDef> <count> [frames]\n" );
+		return;
+	}
+
+	player = gameLocal.GetLocalPlayer();
+	if ( player ) {
+		start = player->GetPhysics()->GetOrigin();
+		yaw = player->viewAngles.yaw;
+	} else {
+		spot = gameLocal.FindEntityUsingDef( NULL, "info_player_start" );
+		if ( !spot ) {
+			spot = gameLocal.FindEntityUsingDef( NULL, "info_player_deathmatch" );
+		}
+		if ( !spot ) {
+			gameLocal.Printf( "benchmarkAF: no local player and no spawn point on the map\n" );
+			return;
+		}
+		start = spot->GetPhysics()->GetOrigin();
+		yaw = spot->GetPhysics()->GetAxis().ToAngles().yaw;
+	}
+
+	count = idMath::ClampInt( 1, 256, atoi( args.Argv( 2 ) ) );
+	numFrames = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 3 ) ) ) : 100;
+	gridSize = idMath::FtoiFast( idMath::Ceil( idMath::Sqrt( (float) count ) ) );
+
+	forward = idAngles( 0, yaw, 0 ).ToForward();
+	right = idAngles( 0, yaw - 90, 0 ).ToForward();
+
+	for ( i = 0; i < count; i++ ) {
+		org = start + forward * ( 128.0f + ( i / gridSize ) * 96.0f ) +
+				right * ( ( i % gridSize ) - gridSize / 2 ) * 96.0f + idVec3( 0, 0, 64 );
+
+		dict.Clear();
+		dict.Set( "classname", args.Argv( 1 ) );
+		dict.Set( "angle", va( "%f", yaw + 180 ) );
+		dict.Set( "origin", org.ToString() );
+		dict.Set( "nodrop", "0" );
+
+		ent = NULL;
+		if ( !gameLocal.SpawnEntityDef( dict, &ent ) || ent == NULL ) {
+			gameLocal.Printf( "couldn't spawn '%s'\n", args.Argv( 1 ) );
+			break;
+		}
+		if ( !gameLocal.IsParallelArticulatedFigure( ent ) ) {
+			gameLocal.Printf( "'%s' is not an articulated figure that can be solved in parallel\n", args.Argv( 1 ) );
+			ent->PostEventMS( &EV_Remove, 0 );
+			break;
+		}
+		figures.Append( ent );
+	}
+
+	if ( figures.Num() == 0 ) {
+		return;
+	}
+
+	for ( i = 0; i < figures.Num(); i++ ) {
+		figures[i]->GetPhysics()->SaveState();
+	}
+
+	// evaluate serially
+	timer.Clear();
+	timer.Start();
+	for ( frame = 1; frame <= numFrames; frame++ ) {
+		endTime = gameLocal.time + frame * USERCMD_MSEC;
+		for ( i = 0; i < figures.Num(); i++ ) {
+			BenchmarkAF_Evaluate( figures[i], endTime );
+		}
+	}
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	for ( i = 0; i < figures.Num(); i++ ) {
+		serialOrigins.Append( figures[i]->GetPhysics()->GetOrigin() );
+		figures[i]->GetPhysics()->RestoreState();
+	}
+
+	// solve the figures on the job threads
+	timer.Clear();
+	timer.Start();
+	for ( frame = 1; frame <= numFrames; frame++ ) {
+		endTime = gameLocal.time + frame * USERCMD_MSEC;
+		gameLocal.EvaluateArticulatedFigures( figures.Ptr(), figures.Num(), USERCMD_MSEC, endTime );
+		for ( i = 0; i < figures.Num(); i++ ) {
+			BenchmarkAF_Evaluate( figures[i], endTime );
+		}
+	}
+	timer.Stop();
+	parallelTime = timer.Milliseconds();
+
+	numDiffer = 0;
+	for ( i = 0; i < figures.Num(); i++ ) {
+		if ( !figures[i]->GetPhysics()->GetOrigin().Compare( serialOrigins[i] ) ) {
+			numDiffer++;
+		}
+		figures[i]->GetPhysics()->RestoreState();
+		figures[i]->BecomeActive( TH_PHYSICS );
+	}
+
+	gameLocal.Printf( "%d figures, %d frames, %d job threads\n", figures.Num(), numFrames, parallelJobManager->GetNumProcessingThreads() );
+	gameLocal.Printf( "serial:   %6.1f ms, %6.3f ms per frame\n", serialTime, serialTime / numFrames );
+	gameLocal.Printf( "parallel: %6.1f ms, %6.3f ms per frame\n", parallelTime, parallelTime / numFrames );
+	gameLocal.Printf( "%d figures ended up in a different position\n", numDiffer );
+}
+
+/*
+==================
+Cmd_PrintAFSolverStats_f
+==================
+*/
+void Cmd_PrintAFSolverStats_f( const idCmdArgs &args ) {
+	if ( !af_compareSolvers.GetBool() ) {
+		gameLocal.Printf( "set af_compareSolvers 1 to gather solver statistics\n" );
+	}
+	idPhysics_AF::PrintSolverStats();
+}
+
+/*
+==================
+Cmd_RigidBodyStats_f
+==================
+*/
+void Cmd_RigidBodyStats_f( const idCmdArgs &args ) {
+	idPhysics_RigidBody::PrintStats();
+}
+
 /*
 ==================
 Cmd_Damage_f
@@ -1324,6 +1505,37 @@ static void Cmd_CollisionModelInfo_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_RecordClipTraces_f
+==================
+*/
+static void Cmd_RecordClipTraces_f( const idCmdArgs &args ) {
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	if ( args.Argc() < 2 ) {
+		gameLocal.Printf( "usage: recordClipTraces <numTraces> [file]\n" );
+		return;
+	}
+
+	gameLocal.clip.RecordTraces( args.Argc() > 2 ? args.Argv( 2 ) : "cliptraces.bin", atoi( args.Argv( 1 ) ) );
+}
+
+/*
+==================
+Cmd_BenchmarkClipTraces_f
+==================
+*/
+static void Cmd_BenchmarkClipTraces_f( const idCmdArgs &args ) {
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	gameLocal.clip.BenchmarkTraces( args.Argc() > 1 ? args.Argv( 1 ) : "cliptraces.bin", args.Argc() > 2 ? atoi( args.Argv( 2 ) ) : 16 );
+}
+
 /*
 ==================
 Cmd_ExportModels_f
@@ -1463,6 +1675,312 @@ static void Cmd_AASStats_f( const idCmdArgs &args ) {
 	}
 }
 
+/*
+==================
+Cmd_BenchmarkAASRouting_f
+
+Routes between random reachable areas of the aas_test AAS, once with the routes
+spread over the job threads and once serially, and compares the results.
+==================
+*/
+static void Cmd_BenchmarkAASRouting_f( const idCmdArgs &args ) {
+	int i, aasNum, numRoutes, numDiffer;
+	float parallelTime, serialTime;
+	idAAS *aas;
+	idRandom random;
+	idTimer timer;
+	idList<int> areas;
+	idList<aasRoute_t> routes, serialRoutes;
+
+	if ( !gameLocal.CheatsOk() ) {
+		return;
+	}
+
+	aasNum = aas_test.GetInteger();
+	aas = gameLocal.GetAAS( aasNum );
+	if ( !aas ) {
+		gameLocal.Printf( "No aas #%d loaded\n", aasNum );
+		return;
+	}
+
+	numRoutes = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 1024;
+	numRoutes = idMath::ClampInt( 1, 65536, numRoutes );
+
+	for ( i = 1; i < aas->GetNumAreas(); i++ ) {
+		if ( aas->AreaFlags( i ) & AREA_REACHABLE_WALK ) {
+			areas.Append( i );
+		}
+	}
+	if ( areas.Num() < 2 ) {
+		gameLocal.Printf( "aas #%d has no reachable areas\n", aasNum );
+		return;
+	}
+
+	routes.SetNum( numRoutes );
+	for ( i = 0; i < numRoutes; i++ ) {
+		routes[i].areaNum = areas[random.RandomInt( areas.Num() )];
+		routes[i].origin = aas->AreaCenter( routes[i].areaNum );
+		routes[i].goalAreaNum = areas[random.RandomInt( areas.Num() )];
+		routes[i].travelFlags = TFL_WALK|TFL_AIR;
+	}
+	serialRoutes = routes;
+
+	timer.Start();
+	aas->RouteToGoalAreas( routes.Ptr(), routes.Num() );
+	timer.Stop();
+	parallelTime = timer.Milliseconds();
+
+	timer.Clear();
+	timer.Start();
+	for ( i = 0; i < numRoutes; i++ ) {
+		aasRoute_t &route = serialRoutes[i];
+		route.result = aas->RouteToGoalArea( route.areaNum, route.origin, route.goalAreaNum, route.travelFlags, route.travelTime, &route.reach );
+	}
+	timer.Stop();
+	serialTime = timer.Milliseconds();
+
+	numDiffer = 0;
+	for ( i = 0; i < numRoutes; i++ ) {
+		if ( routes[i].result != serialRoutes[i].result || routes[i].travelTime != serialRoutes[i].travelTime || routes[i].reach != serialRoutes[i].reach ) {
+			numDiffer++;
+		}
+	}
+
+	gameLocal.Printf( "%d routes between %d areas\n", numRoutes, areas.Num() );
+	gameLocal.Printf( "parallel: %.2f ms\n", parallelTime );
+	gameLocal.Printf( "serial:   %.2f ms, with the cache filled by the parallel routes\n", serialTime );
+	gameLocal.Printf( "%d routes differ\n", numDiffer );
+	aas->Stats();
+}
+
+// fixed workload for benchmarkScript, it only uses local variables so every run does the same work
+static const char *scriptBenchmarkFunction = "benchmarkScript_workload";
+static const char *scriptBenchmarkText =
+	"void benchmarkScript_workload() {\n"
+	"	float i, j, a, b, c;\n"
+	"	boolean odd;\n"
+	"	a = 0; b = 1; c = 0; odd = false;\n"
+	"	for ( i = 0; i < 100; i++ ) {\n"
+	"		odd = !odd;\n"
+	"		for ( j = 0; j < 10; j++ ) {\n"
+	"			if ( !odd ) {\n"
+	"				a = a + j;\n"
+	"			} else {\n"
+	"				b = b * 1.01;\n"
+	"			}\n"
+	"			if ( a > 1000 ) {\n"
+	"				a = a - 1000;\n"
+	"			}\n"
+	"			if ( j == 5 ) {\n"
+	"				c++;\n"
+	"			}\n"
+	"			if ( b >= 2 ) {\n"
+	"				b = 1;\n"
+	"			}\n"
+	"		}\n"
+	"	}\n"
+	"}\n";
+
+/*
+==================
+RunScriptBenchmark
+
+Runs the function the given number of times in threads of its own and returns
+the number of statements executed.
+==================
+*/
+static int RunScriptBenchmark( const function_t *func, int count, bool superInstructions, float &ms, int &numDispatched ) {
+	int i, numExecuted;
+	bool oldSuperInstructions;
+	idThread *thread;
+	idTimer timer;
+
+	oldSuperInstructions = g_scriptSuperInstructions.GetBool();
+	g_scriptSuperInstructions.SetBool( superInstructions );
+
+	numExecuted = 0;
+	numDispatched = 0;
+	timer.Start();
+	for ( i = 0; i < count; i++ ) {
+		thread = new idThread( func );
+		thread->ManualDelete();
+		thread->ManualControl();
+		thread->Execute();
+		numExecuted += thread->GetNumStatementsExecuted();
+		numDispatched += thread->GetNumStatementsDispatched();
+		delete thread;
+	}
+	timer.Stop();
+	ms = timer.Milliseconds();
+
+	g_scriptSuperInstructions.SetBool( oldSuperInstructions );
+
+	return numExecuted;
+}
+
+/*
+==================
+Cmd_BenchmarkScript_f
+
+Runs a fixed script workload with and without superinstructions and reports
+the number of script statements executed per second.  The workload only
+uses local variables, so it doesn't need a map or a player and both modes
+do the same work.
+==================
+*/
+static void Cmd_BenchmarkScript_f( const idCmdArgs &args ) {
+	int count, stockStatements, stockDispatched, superStatements, superDispatched;
+	float stockTime, superTime;
+	const function_t *func;
+
+	if ( !gameLocal.CheatsOk( false ) ) {
+		return;
+	}
+
+	func = gameLocal.program.FindFunction( scriptBenchmarkFunction );
+	if ( !func ) {
+		if ( !gameLocal.program.CompileText( "benchmarkScript", scriptBenchmarkText, true ) ) {
+			return;
+		}
+		func = gameLocal.program.FindFunction( scriptBenchmarkFunction );
+		if ( !func ) {
+			return;
+		}
+	}
+
+	count = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 100;
+	count = idMath::ClampInt( 1, 100000, count );
+
+	stockStatements = RunScriptBenchmark( func, count, false, stockTime, stockDispatched );
+	superStatements = RunScriptBenchmark( func, count, true, superTime, superDispatched );
+
+	if ( stockStatements != superStatements ) {
+		gameLocal.Warning( "benchmarkScript: %d statements executed with superinstructions instead of %d", superStatements, stockStatements );
+	}
+
+	gameLocal.Printf( "%d runs of the script workload\n", count );
+	gameLocal.Printf( "stock:             %.2f ms, %d statements, %d dispatches, %.0f statements/sec\n", stockTime, stockStatements, stockDispatched, stockStatements * 1000.0f / Max( stockTime, 0.001f ) );
+	gameLocal.Printf( "superinstructions: %.2f ms, %d statements, %d dispatches, %.0f statements/sec\n", superTime, superStatements, superDispatched, superStatements * 1000.0f / Max( superTime, 0.001f ) );
+	gameLocal.Printf( "speedup: %.2fx\n", stockTime / Max( superTime, 0.001f ) );
+}
+
+/*
+==================
+BenchmarkAnimCache_CreateFrames
+
+Recreates the joints of all animated entities the given number of times,
+every pass is treated as a new game frame by the anim pose cache.
+==================
+*/
+static float BenchmarkAnimCache_CreateFrames( const idList<idAnimator *> &animators, int numFrames, bool useCache ) {
+	int i, frame;
+	bool oldUseCache;
+	idTimer timer;
+
+	oldUseCache = g_animPoseCache.GetBool();
+	g_animPoseCache.SetBool( useCache );
+
+	timer.Start();
+	for ( frame = 1; frame <= numFrames; frame++ ) {
+		animPoseCache.BeginFrame();
+		for ( i = 0; i < animators.Num(); i++ ) {
+			animators[i]->CreateFrame( gameLocal.time + frame * USERCMD_MSEC, true );
+		}
+	}
+	timer.Stop();
+
+	animPoseCache.Clear();
+	g_animPoseCache.SetBool( oldUseCache );
+
+	return timer.Milliseconds();
+}
+
+/*
+==================
+Cmd_BenchmarkAnimCache_f
+
+Spawns a grid of identical monsters in front of the player that all play the
+same anim and recreates their joints for a number of frames with and without
+the anim pose cache.
+==================
+*/
+static void Cmd_BenchmarkAnimCache_f( const idCmdArgs &args ) {
+	int			i, count, numFrames, gridSize, animNum;
+	float		yaw, stockTime, cacheTime;
+	const char	*animName;
+	idVec3		org, forward, right;
+	idPlayer	*player;
+	idEntity	*ent;
+	idAnimator	*animator;
+	idDict		dict;
+	idList<idAnimator *> animators;
+
+	player = gameLocal.GetLocalPlayer();
+	if ( !player || !gameLocal.CheatsOk( false ) ) {
+		return;
+	}
+
+	if ( args.Argc() < 3 ) {
+		gameLocal.Printf( "usage: benchmarkAnimCache <entityDef> <count> [frames] [anim]\n" );
+		return;
+	}
+
+	count = idMath::ClampInt( 1, 256, atoi( args.Argv( 2 ) ) );
+	numFrames = ( args.Argc() > 3 ) ? idMath::ClampInt( 1, 10000, atoi( args.Argv( 3 ) ) ) : 100;
+	animName = ( args.Argc() > 4 ) ? args.Argv( 4 ) : "idle";
+	gridSize = idMath::FtoiFast( idMath::Ceil( idMath::Sqrt( (float) count ) ) );
+
+	yaw = player->viewAngles.yaw;
+	forward = idAngles( 0, yaw, 0 ).ToForward();
+	right = idAngles( 0, yaw - 90, 0 ).ToForward();
+
+	for ( i = 0; i < count; i++ ) {
+		org = player->GetPhysics()->GetOrigin() + forward * ( 128.0f + ( i / gridSize ) * 96.0f ) +
+				right * ( ( i % gridSize ) - gridSize / 2 ) * 96.0f + idVec3( 0, 0, 1 );
+
+		dict.Clear();
+		dict.Set( "classname", args.Argv( 1 ) );
+		dict.Set( "angle", va( "%f", yaw + 180 ) );
+		dict.Set( "origin", org.ToString() );
+
+		ent = NULL;
+		if ( !gameLocal.SpawnEntityDef( dict, &ent ) || ent == NULL ) {
+			gameLocal.Printf( "couldn't spawn '%s'\n", args.Argv( 1 ) );
+			break;
+		}
+		animator = ent->GetAnimator();
+		if ( !animator || !animator->ModelDef() ) {
+			gameLocal.Printf( "'%s' has no animated model\n", args.Argv( 1 ) );
+			ent->PostEventMS( &EV_Remove, 0 );
+			break;
+		}
+
+		// start the same anim at the same time on all of them
+		animNum = animator->GetAnim( animName );
+		if ( !animNum && animator->NumAnims() > 1 ) {
+			animNum = 1;
+		}
+		if ( animNum ) {
+			animator->CycleAnim( ANIMCHANNEL_ALL, animNum, gameLocal.time, 0 );
+		}
+		animators.Append( animator );
+	}
+
+	if ( animators.Num() == 0 ) {
+		return;
+	}
+
+	stockTime = BenchmarkAnimCache_CreateFrames( animators, numFrames, false );
+	animPoseCache.ClearStatistics();
+	cacheTime = BenchmarkAnimCache_CreateFrames( animators, numFrames, true );
+
+	gameLocal.Printf( "%d animated entities, %d frames\n", animators.Num(), numFrames );
+	gameLocal.Printf( "stock: %6.1f ms, %6.3f ms per frame\n", stockTime, stockTime / numFrames );
+	gameLocal.Printf( "cache: %6.1f ms, %6.3f ms per frame\n", cacheTime, cacheTime / numFrames );
+	gameLocal.Printf( "%d lookups, %d hits (%.1f%%)\n", animPoseCache.NumLookups(), animPoseCache.NumHits(),
+						animPoseCache.NumHits() * 100.0f / Max( animPoseCache.NumLookups(), 1 ) );
+}
+
 /*
 ==================
 Cmd_TestDamage_f
@@ -2298,6 +2816,10 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "game_memory",			idClass::DisplayInfo_f,		CMD_FL_GAME,				"displays game class info" );
 	cmdSystem->AddCommand( "listClasses",			idClass::ListClasses_f,		CMD_FL_GAME,				"lists game classes" );
 	cmdSystem->AddCommand( "listThreads",			idThread::ListThreads_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"lists script threads" );
+	cmdSystem->AddCommand( "scriptProfile",			idInterpreter::ScriptProfile_f,	CMD_FL_GAME,			"lists the script functions and events with the most time, 'scriptProfile clear' resets the counters" );
+#ifdef GAME_DLL
+	cmdSystem->AddCommand( "gameMemoryProfile",		Mem_Profile_f,				CMD_FL_GAME,				"samples game allocations and lists the top allocating call sites" );
+#endif
 	cmdSystem->AddCommand( "listEntities",			Cmd_EntityList_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"lists game entities" );
 	cmdSystem->AddCommand( "listActiveEntities",	Cmd_ActiveEntityList_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"lists active game entities" );
 	cmdSystem->AddCommand( "listMonsters",			idAI::List_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"lists monsters" );
@@ -2318,6 +2840,9 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "teleport",				Cmd_Teleport_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"teleports the player to an entity location", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "trigger",				Cmd_Trigger_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"triggers an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "spawn",					Cmd_Spawn_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"spawns a game entity", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "benchmarkAF",			Cmd_BenchmarkAF_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"benchmarks serial and parallel articulated figure physics", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
+	cmdSystem->AddCommand( "printAFSolverStats",	Cmd_PrintAFSolverStats_f,	CMD_FL_GAME,				"prints and clears the statistics gathered with af_compareSolvers" );
+	cmdSystem->AddCommand( "rigidBodyStats",		Cmd_RigidBodyStats_f,		CMD_FL_GAME,				"prints active and resting rigid bodies and clears the contact cache and island sleep statistics" );
 	cmdSystem->AddCommand( "damage",				Cmd_Damage_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"apply damage to an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "remove",				Cmd_Remove_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"removes an entity", idGameLocal::ArgCompletion_EntityName );
 	cmdSystem->AddCommand( "killMonsters",			Cmd_KillMonsters_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"removes all monsters" );
@@ -2351,10 +2876,15 @@ void idGameLocal::InitConsoleCommands( void ) {
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME|CMD_FL_CHEAT,	"executes a line of script" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
+	cmdSystem->AddCommand( "recordClipTraces",		Cmd_RecordClipTraces_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"records the next clip translations to a file" );
+	cmdSystem->AddCommand( "benchmarkClipTraces",	Cmd_BenchmarkClipTraces_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"replays recorded clip translations one by one and batched" );
 	cmdSystem->AddCommand( "reexportmodels",		Cmd_ReexportModels_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"reexports models", ArgCompletion_DefFile );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
+	cmdSystem->AddCommand( "benchmarkAASRouting",	Cmd_BenchmarkAASRouting_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"routes between random areas of the aas_test AAS on the job threads and serially" );
+	cmdSystem->AddCommand( "benchmarkScript",		Cmd_BenchmarkScript_f,		CMD_FL_GAME|CMD_FL_CHEAT,	"runs a fixed script workload with and without superinstructions" );
+	cmdSystem->AddCommand( "benchmarkAnimCache",	Cmd_BenchmarkAnimCache_f,	CMD_FL_GAME|CMD_FL_CHEAT,	"spawns a crowd of identical monsters and times their anims with and without the pose cache", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
 	cmdSystem->AddCommand( "saveSelected",			Cmd_SaveSelected_f,			CMD_FL_GAME|CMD_FL_CHEAT,	"saves the selected entity to the .map file" );
@@ -108,6 +108,10 @@ idCVar g_skipFX(					"g_skipFX",					"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_skipParticles(				"g_skipParticles",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 
 idCVar g_disasm(					"g_disasm",					"0",			CVAR_GAME | CVAR_BOOL, "disassemble script into base/script/disasm.txt on the local drive when script is compiled" );
+idCVar g_scriptCache(				"g_scriptCache",			"1",			CVAR_GAME | CVAR_BOOL, "load the program compiled from the default script from a binary cache when the script files didn't change, and write the cache after compiling" );
+idCVar g_showEvents(				"g_showEvents",				"0",			CVAR_GAME | CVAR_BOOL, "print the number of events scheduled, serviced and cancelled each frame" );
+idCVar g_scriptProfile(				"g_scriptProfile",			"0",			CVAR_GAME | CVAR_BOOL, "accumulate statement counts and time per script function and event, see scriptProfile" );
+idCVar g_scriptSuperInstructions(	"g_scriptSuperInstructions", "1",			CVAR_GAME | CVAR_BOOL, "execute combined statement sequences with a single dispatch in the script interpreter" );
 idCVar g_debugBounds(				"g_debugBounds",			"0",			CVAR_GAME | CVAR_BOOL, "checks for models with bounds > 2048" );
 idCVar g_debugAnim(					"g_debugAnim",				"-1",			CVAR_GAME | CVAR_INTEGER, "displays information on which animations are playing on the specified entity number.  set to -1 to disable." );
 idCVar g_debugMove(					"g_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "" );
@@ -134,16 +138,23 @@ idCVar g_showTriggers(				"g_showTriggers",			"0",			CVAR_GAME | CVAR_BOOL, "dra
 idCVar g_showCollisionWorld(		"g_showCollisionWorld",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionModels(		"g_showCollisionModels",	"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showCollisionTraces(		"g_showCollisionTraces",	"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar g_clipTree(					"g_clipTree",				"0",			CVAR_GAME | CVAR_BOOL, "link clip models in a dynamic bounding volume tree instead of the clip sectors, takes effect on map load" );
 idCVar g_maxShowDistance(			"g_maxShowDistance",		"128",			CVAR_GAME | CVAR_FLOAT, "" );
 idCVar g_showEntityInfo(			"g_showEntityInfo",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showviewpos(				"g_showviewpos",			"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar g_showcamerainfo(			"g_showcamerainfo",			"0",			CVAR_GAME | CVAR_ARCHIVE, "displays the current frame # for the camera when playing cinematics" );
+idCVar g_animPoseCache(			"g_animPoseCache",			"1",			CVAR_GAME | CVAR_BOOL, "reuse anim frames decoded earlier in the same game frame" );
+idCVar g_showAnimPoseCache(		"g_showAnimPoseCache",		"0",			CVAR_GAME | CVAR_BOOL, "print anim pose cache hits each frame" );
 idCVar g_showTestModelFrame(		"g_showTestModelFrame",		"0",			CVAR_GAME | CVAR_BOOL, "displays the current animation and frame # for testmodels" );
 idCVar g_showActiveEntities(		"g_showActiveEntities",		"0",			CVAR_GAME | CVAR_BOOL, "draws boxes around thinking entities.  dormant entities (outside of pvs) are drawn yellow.  non-dormant are green." );
 idCVar g_showEnemies(				"g_showEnemies",			"0",			CVAR_GAME | CVAR_BOOL, "draws boxes around monsters that have targeted the the player" );
 
 idCVar g_frametime(					"g_frametime",				"0",			CVAR_GAME | CVAR_BOOL, "displays timing information for each game frame" );
 idCVar g_timeentities(				"g_timeEntities",			"0",			CVAR_GAME | CVAR_FLOAT, "when non-zero, shows entities whose think functions exceeded the # of milliseconds specified" );
+idCVar g_frameArenaSize(			"g_frameArenaSize",			"1024",			CVAR_GAME | CVAR_INTEGER | CVAR_INIT, "initial size in kB of the memory arena for temporary per frame data, grows to the high water mark when exceeded", 0, 65536 );
+idCVar g_parallelThink(				"g_parallelThink",			"0",			CVAR_GAME | CVAR_BOOL, "create the animation frames and solve the articulated figures of independent entity teams and route the moving monsters on the job threads" );
+idCVar g_parallelThinkCheck(		"g_parallelThinkCheck",		"0",			CVAR_GAME | CVAR_INTEGER, "compare the animation frames created with g_parallelThink with a serial update, 2 = also print a summary each frame", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar g_showFrameArena(			"g_showFrameArena",			"0",			CVAR_GAME | CVAR_BOOL, "displays per frame memory arena usage for each game frame" );
 	
 idCVar ai_debugScript(				"ai_debugScript",			"-1",			CVAR_GAME | CVAR_INTEGER, "displays script calls for the specified monster entity number" );
 idCVar ai_debugMove(				"ai_debugMove",				"0",			CVAR_GAME | CVAR_BOOL, "draws movement information for monsters" );
@@ -217,6 +228,8 @@ idCVar af_showTotalMass(			"af_showTotalMass",			"0",			CVAR_GAME | CVAR_BOOL, "
 idCVar af_showInertia(				"af_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "show the inertia tensor of each body" );
 idCVar af_showVelocity(				"af_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each body" );
 idCVar af_showActive(				"af_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show tree-like structures of articulated figures not at rest" );
+idCVar af_compareSolvers(			"af_compareSolvers",		"0",			CVAR_GAME | CVAR_BOOL, "solve the auxiliary constraints with all lcp solvers and gather statistics for printAFSolverStats" );
+idCVar af_parallel(					"af_parallel",				"0",			CVAR_GAME | CVAR_BOOL, "solve independent articulated figures on the job threads" );
 idCVar af_testSolid(				"af_testSolid",				"1",			CVAR_GAME | CVAR_BOOL, "test for bodies initially stuck in solid" );
 
 idCVar rb_showTimings(				"rb_showTimings",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid body cpu usage" );
@@ -225,6 +238,9 @@ idCVar rb_showMass(					"rb_showMass",				"0",			CVAR_GAME | CVAR_BOOL, "show th
 idCVar rb_showInertia(				"rb_showInertia",			"0",			CVAR_GAME | CVAR_BOOL, "show the inertia tensor of each rigid body" );
 idCVar rb_showVelocity(				"rb_showVelocity",			"0",			CVAR_GAME | CVAR_BOOL, "show the velocity of each rigid body" );
 idCVar rb_showActive(				"rb_showActive",			"0",			CVAR_GAME | CVAR_BOOL, "show rigid bodies that are not at rest" );
+idCVar rb_cacheContacts(			"rb_cacheContacts",			"1",			CVAR_GAME | CVAR_BOOL, "reuse the contacts of rigid bodies that barely moved" );
+idCVar rb_islandSleep(				"rb_islandSleep",			"1",			CVAR_GAME | CVAR_BOOL, "put slowly moving rigid bodies in contact with each other to rest together" );
+idCVar rb_sleepTime(				"rb_sleepTime",				"1",			CVAR_GAME | CVAR_FLOAT, "seconds a rigid body must move slowly before its island is put to rest", 0.0f, 10.0f );
 
 // The default values for player movement cvars are set in def/player.def
 idCVar pm_jumpheight(				"pm_jumpheight",			"48",			CVAR_GAME | CVAR_NETWORKSYNC | CVAR_FLOAT, "approximate hieght the player can jump" );
@@ -304,6 +320,8 @@ idCVar aas_pullPlayer(				"aas_pullPlayer",			"0",			CVAR_GAME | CVAR_INTEGER, "
 idCVar aas_randomPullPlayer(		"aas_randomPullPlayer",		"0",			CVAR_GAME | CVAR_BOOL, "" );
 idCVar aas_goalArea(				"aas_goalArea",				"0",			CVAR_GAME | CVAR_INTEGER, "" );
 idCVar aas_showPushIntoArea(		"aas_showPushIntoArea",		"0",			CVAR_GAME | CVAR_BOOL, "" );
+idCVar aas_routeTables(				"aas_routeTables",			"1",			CVAR_GAME | CVAR_BOOL, "use the routing tables precalculated with runAAS -routeTables" );
+idCVar aas_verifyRouteTables(		"aas_verifyRouteTables",	"0",			CVAR_GAME | CVAR_BOOL, "compare the precalculated routing tables with the routing cache" );
 
 idCVar g_password(					"g_password",				"",				CVAR_GAME | CVAR_ARCHIVE, "game password" );
 idCVar password(					"password",					"",				CVAR_GAME | CVAR_NOCHEAT, "client password used when connecting" );
@@ -49,6 +49,10 @@ extern idCVar	g_doubleVision;
 extern idCVar	g_muzzleFlash;
 
 extern idCVar	g_disasm;
+extern idCVar	g_scriptCache;
+extern idCVar	g_showEvents;
+extern idCVar	g_scriptProfile;
+extern idCVar	g_scriptSuperInstructions;
 extern idCVar	g_debugBounds;
 extern idCVar	g_debugAnim;
 extern idCVar	g_debugMove;
@@ -73,16 +77,23 @@ extern idCVar	g_showTriggers;
 extern idCVar	g_showCollisionWorld;
 extern idCVar	g_showCollisionModels;
 extern idCVar	g_showCollisionTraces;
+extern idCVar	g_clipTree;
 extern idCVar	g_maxShowDistance;
 extern idCVar	g_showEntityInfo;
 extern idCVar	g_showviewpos;
 extern idCVar	g_showcamerainfo;
+extern idCVar	g_animPoseCache;
+extern idCVar	g_showAnimPoseCache;
 extern idCVar	g_showTestModelFrame;
 extern idCVar	g_showActiveEntities;
 extern idCVar	g_showEnemies;
 
 extern idCVar	g_frametime;
 extern idCVar	g_timeentities;
+extern idCVar	g_frameArenaSize;
+extern idCVar	g_showFrameArena;
+extern idCVar	g_parallelThink;
+extern idCVar	g_parallelThinkCheck;
 
 extern idCVar	ai_debugScript;
 extern idCVar	ai_debugMove;
@@ -149,6 +160,8 @@ extern idCVar	af_showTotalMass;
 extern idCVar	af_showInertia;
 extern idCVar	af_showVelocity;
 extern idCVar	af_showActive;
+extern idCVar	af_compareSolvers;
+extern idCVar	af_parallel;
 extern idCVar	af_testSolid;
 
 extern idCVar	rb_showTimings;
@@ -157,6 +170,9 @@ extern idCVar	rb_showMass;
 extern idCVar	rb_showInertia;
 extern idCVar	rb_showVelocity;
 extern idCVar	rb_showActive;
+extern idCVar	rb_cacheContacts;
+extern idCVar	rb_islandSleep;
+extern idCVar	rb_sleepTime;
 
 extern idCVar	pm_jumpheight;
 extern idCVar	pm_stepsize;
@@ -232,6 +248,8 @@ extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
 extern idCVar	aas_showPushIntoArea;
+extern idCVar	aas_routeTables;
+extern idCVar	aas_verifyRouteTables;
 
 extern idCVar	net_clientPredictGUI;
 
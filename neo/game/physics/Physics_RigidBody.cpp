@@ -35,6 +35,12 @@ CLASS_DECLARATION( idPhysics_Base, idPhysics_RigidBody )
 END_CLASS
 
 const float STOP_SPEED		= 10.0f;
+const float SLEEP_SPEED		= 2.0f * STOP_SPEED;	// maximum speed of a supported body that may fall asleep with its island
+
+const float CONTACT_CACHE_MOVE_EPSILON	= 0.1f;		// maximum translation before cached contacts are recalculated
+const float CONTACT_CACHE_AXIS_EPSILON	= 0.001f;	// maximum change in orientation before cached contacts are recalculated
+const int	CONTACT_CACHE_MAX_AGE		= 500;		// maximum age of cached contacts in milliseconds
+const int	MAX_SLEEP_ISLAND_BODIES		= 64;		// maximum number of bodies put to rest together
 
 
 #undef RB_TIMINGS
@@ -45,6 +51,15 @@ static int numRigidBodies = 0;
 static idTimer timer_total, timer_collision;
 #endif
 
+typedef struct rigidBodyStats_s {
+	int						numContactQueries;		// contact queries on the collision model manager
+	int						numCachedContacts;		// contact queries answered from the contact cache
+	int						numIslands;				// number of islands put to rest together
+	int						numIslandBodies;		// number of bodies put to rest as part of an island
+} rigidBodyStats_t;
+
+static rigidBodyStats_t rigidBodyStats;
+
 
 /*
 ================
@@ -272,16 +287,26 @@ idPhysics_RigidBody::TestIfAtRest
 ================
 */
 bool idPhysics_RigidBody::TestIfAtRest( void ) const {
+	if ( current.atRest >= 0 ) {
+		return true;
+	}
+	return TestIfSupported( STOP_SPEED );
+}
+
+/*
+================
+idPhysics_RigidBody::TestIfSupported
+
+  Returns true if the body is supported by its contacts and moves slower than the given speed.
+================
+*/
+bool idPhysics_RigidBody::TestIfSupported( const float stopSpeed ) const {
 	int i;
 	float gv;
 	idVec3 v, av, normal, point;
 	idMat3 inverseWorldInertiaTensor;
 	idFixedWinding contactWinding;
 
-	if ( current.atRest >= 0 ) {
-		return true;
-	}
-
 	// need at least 3 contact points to come to rest
 	if ( contacts.Num() < 3 ) {
 		return false;
@@ -330,11 +355,11 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	v -= gv * gravityNormal;
 
 	// if too much velocity orthogonal to gravity direction
-	if ( v.Length() > STOP_SPEED ) {
+	if ( v.Length() > stopSpeed ) {
 		return false;
 	}
 	// if too much velocity in gravity direction
-	if ( gv > 2.0f * STOP_SPEED || gv < -2.0f * STOP_SPEED ) {
+	if ( gv > 2.0f * stopSpeed || gv < -2.0f * stopSpeed ) {
 		return false;
 	}
 
@@ -343,7 +368,7 @@ bool idPhysics_RigidBody::TestIfAtRest( void ) const {
 	av = inverseWorldInertiaTensor * current.i.angularMomentum;
 
 	// if too much rotational velocity
-	if ( av.LengthSqr() > STOP_SPEED ) {
+	if ( av.LengthSqr() > stopSpeed ) {
 		return false;
 	}
 
@@ -469,6 +494,12 @@ idPhysics_RigidBody::idPhysics_RigidBody( void ) {
 	hasMaster = false;
 	isOrientated = false;
 
+	contactCacheTime = -1;
+	contactCacheNumEntities = 0;
+	contactCacheOrigin.Zero();
+	contactCacheAxis.Identity();
+	sleepStartTime = -1;
+
 #ifdef RB_TIMINGS
 	lastTimerReset = 0;
 #endif
@@ -587,6 +618,11 @@ void idPhysics_RigidBody::Restore( idRestoreGame *savefile ) {
 
 	savefile->ReadBool( hasMaster );
 	savefile->ReadBool( isOrientated );
+
+	// the contact cache and sleep timer are rebuilt after loading
+	cachedContacts.Clear();
+	contactCacheTime = -1;
+	sleepStartTime = -1;
 }
 
 /*
@@ -611,6 +647,8 @@ void idPhysics_RigidBody::SetClipModel( idClipModel *model, const float density,
 	clipModel = model;
 	clipModel->Link( gameLocal.clip, self, 0, current.i.position, current.i.orientation );
 
+	contactCacheTime = -1;
+
 	// get mass properties from the trace model
 	clipModel->GetMassProperties( density, mass, centerOfMass, inertiaTensor );
 
@@ -723,6 +761,7 @@ void idPhysics_RigidBody::Rest( void ) {
 	current.atRest = gameLocal.time;
 	current.i.linearMomentum.Zero();
 	current.i.angularMomentum.Zero();
+	sleepStartTime = -1;
 	self->BecomeInactive( TH_PHYSICS );
 }
 
@@ -752,6 +791,8 @@ idPhysics_RigidBody::Activate
 */
 void idPhysics_RigidBody::Activate( void ) {
 	current.atRest = -1;
+	// impulses and velocity changes activate the body, which restarts the sleep timer
+	sleepStartTime = -1;
 	self->BecomeActive( TH_PHYSICS );
 }
 
@@ -935,7 +976,10 @@ bool idPhysics_RigidBody::Evaluate( int timeStepMSec, int endTimeMSec ) {
 			// put to rest
 			Rest();
 			cameToRest = true;
-		}  else {
+		} else if ( TestIfSleeping() && SleepIsland() ) {
+			// put to rest together with the bodies it is resting on
+			cameToRest = true;
+		} else {
 			// apply contact friction
 			ContactFriction( timeStep );
 		}
@@ -1357,6 +1401,22 @@ bool idPhysics_RigidBody::EvaluateContacts( void ) {
 
 	ClearContacts();
 
+	// reuse the contacts from the previous evaluation if nothing relevant changed
+	if ( UseCachedContacts() ) {
+		idVec3 delta = clipModel->GetOrigin() - contactCacheOrigin;
+
+		contacts.SetNum( cachedContacts.Num(), false );
+		for ( num = 0; num < cachedContacts.Num(); num++ ) {
+			contacts[num] = cachedContacts[num];
+			contacts[num].point += delta;
+		}
+		rigidBodyStats.numCachedContacts++;
+
+		AddContactEntitiesForContacts();
+
+		return ( contacts.Num() != 0 );
+	}
+
 	contacts.SetNum( 10, false );
 
 	dir.SubVec3(0) = current.i.linearMomentum + current.lastTimeStep * gravityVector * mass;
@@ -1366,12 +1426,205 @@ bool idPhysics_RigidBody::EvaluateContacts( void ) {
 	num = gameLocal.clip.Contacts( &contacts[0], 10, clipModel->GetOrigin(),
 					dir, CONTACT_EPSILON, clipModel, clipModel->GetAxis(), clipMask, self );
 	contacts.SetNum( num, false );
+	rigidBodyStats.numContactQueries++;
+
+	// store the contacts for the next evaluation
+	if ( rb_cacheContacts.GetBool() ) {
+		cachedContacts = contacts;
+		contactCacheOrigin = clipModel->GetOrigin();
+		contactCacheAxis = clipModel->GetAxis();
+		contactCacheTime = gameLocal.time;
+		contactCacheNumEntities = contactEntities.Num();
+	}
 
 	AddContactEntitiesForContacts();
 
 	return ( contacts.Num() != 0 );
 }
 
+/*
+================
+idPhysics_RigidBody::UseCachedContacts
+
+  The cached contacts can be reused if the body barely moved since they were
+  determined, no other entity started touching the body and all the other
+  entities in contact are at rest.
+================
+*/
+bool idPhysics_RigidBody::UseCachedContacts( void ) const {
+	int i;
+	idEntity *ent;
+
+	if ( !rb_cacheContacts.GetBool() || contactCacheTime < 0 ) {
+		return false;
+	}
+	if ( gameLocal.time - contactCacheTime > CONTACT_CACHE_MAX_AGE || gameLocal.time < contactCacheTime ) {
+		return false;
+	}
+	if ( ( clipModel->GetOrigin() - contactCacheOrigin ).LengthSqr() > Square( CONTACT_CACHE_MOVE_EPSILON ) ) {
+		return false;
+	}
+	if ( !clipModel->GetAxis().Compare( contactCacheAxis, CONTACT_CACHE_AXIS_EPSILON ) ) {
+		return false;
+	}
+	// if another entity started touching this body
+	if ( contactEntities.Num() > contactCacheNumEntities ) {
+		return false;
+	}
+	for ( i = 0; i < contactEntities.Num(); i++ ) {
+		ent = contactEntities[i].GetEntity();
+		if ( !ent || !ent->IsAtRest() ) {
+			return false;
+		}
+	}
+	for ( i = 0; i < cachedContacts.Num(); i++ ) {
+		if ( cachedContacts[i].entityNum == ENTITYNUM_WORLD || cachedContacts[i].entityNum == self->entityNumber ) {
+			continue;
+		}
+		ent = gameLocal.entities[cachedContacts[i].entityNum];
+		if ( !ent || !ent->IsAtRest() ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idPhysics_RigidBody::TestIfSleeping
+
+  Returns true if the body has been supported and moving slowly for longer than rb_sleepTime.
+  Uses the same support and velocity tests as TestIfAtRest with a slightly higher speed limit.
+================
+*/
+bool idPhysics_RigidBody::TestIfSleeping( void ) {
+	if ( !rb_islandSleep.GetBool() ) {
+		sleepStartTime = -1;
+		return false;
+	}
+
+	if ( !TestIfSupported( SLEEP_SPEED ) ) {
+		sleepStartTime = -1;
+		return false;
+	}
+
+	if ( sleepStartTime < 0 ) {
+		sleepStartTime = gameLocal.time;
+	}
+
+	return IsSleepy();
+}
+
+/*
+================
+idPhysics_RigidBody::IsSleepy
+================
+*/
+bool idPhysics_RigidBody::IsSleepy( void ) const {
+	return ( sleepStartTime >= 0 && gameLocal.time - sleepStartTime >= SEC2MS( rb_sleepTime.GetFloat() ) );
+}
+
+/*
+================
+idPhysics_RigidBody::SleepIsland
+
+  Puts the body to rest together with all the slowly moving rigid bodies it is in contact with.
+  The island is only put to rest if every body in it has been moving slowly for long enough and
+  it does not touch any other moving physics. The island wakes up through the regular activation
+  of contact entities.
+================
+*/
+bool idPhysics_RigidBody::SleepIsland( void ) {
+	int i, j;
+	idEntity *ent;
+	idPhysics *phys;
+	idPhysics_RigidBody *body, *other;
+	idStaticList<idPhysics_RigidBody *, MAX_SLEEP_ISLAND_BODIES> island;
+
+	island.Append( this );
+
+	for ( i = 0; i < island.Num(); i++ ) {
+		body = island[i];
+
+		for ( j = 0; j < body->contacts.Num() + body->contactEntities.Num(); j++ ) {
+			if ( j < body->contacts.Num() ) {
+				if ( body->contacts[j].entityNum == ENTITYNUM_WORLD ) {
+					continue;
+				}
+				ent = gameLocal.entities[body->contacts[j].entityNum];
+			} else {
+				ent = body->contactEntities[j - body->contacts.Num()].GetEntity();
+			}
+			if ( !ent || ent == body->self ) {
+				continue;
+			}
+
+			phys = ent->GetPhysics();
+			if ( phys->IsAtRest() ) {
+				continue;
+			}
+			if ( !phys->IsType( idPhysics_RigidBody::Type ) ) {
+				// touching some other kind of moving physics
+				return false;
+			}
+
+			other = static_cast<idPhysics_RigidBody *>( phys );
+			if ( other->hasMaster || !other->IsSleepy() ) {
+				return false;
+			}
+			// the sleep timer of the other body is from its last evaluation, so test its current momentum
+			if ( !other->TestIfSupported( SLEEP_SPEED ) ) {
+				return false;
+			}
+			if ( island.FindIndex( other ) == -1 ) {
+				if ( island.Num() >= island.Max() ) {
+					return false;
+				}
+				island.Append( other );
+			}
+		}
+	}
+
+	for ( i = 0; i < island.Num(); i++ ) {
+		island[i]->Rest();
+	}
+
+	rigidBodyStats.numIslands++;
+	rigidBodyStats.numIslandBodies += island.Num();
+
+	return true;
+}
+
+/*
+================
+idPhysics_RigidBody::PrintStats
+================
+*/
+void idPhysics_RigidBody::PrintStats( void ) {
+	int numActive, numResting;
+	idEntity *ent;
+
+	numActive = numResting = 0;
+	for ( ent = gameLocal.spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() ) {
+		if ( !ent->GetPhysics()->IsType( idPhysics_RigidBody::Type ) ) {
+			continue;
+		}
+		if ( ent->GetPhysics()->IsAtRest() ) {
+			numResting++;
+		} else {
+			numActive++;
+		}
+	}
+
+	gameLocal.Printf( "%5d rigid bodies active\n", numActive );
+	gameLocal.Printf( "%5d rigid bodies at rest\n", numResting );
+	gameLocal.Printf( "%5d contact queries\n", rigidBodyStats.numContactQueries );
+	gameLocal.Printf( "%5d contact queries answered from the cache\n", rigidBodyStats.numCachedContacts );
+	gameLocal.Printf( "%5d islands put to rest with %d bodies\n", rigidBodyStats.numIslands, rigidBodyStats.numIslandBodies );
+
+	memset( &rigidBodyStats, 0, sizeof( rigidBodyStats ) );
+}
+
 /*
 ================
 idPhysics_RigidBody::SetPushed
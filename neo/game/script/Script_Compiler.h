@@ -194,6 +194,28 @@ enum {
 	NUM_OPCODES
 };
 
+// Superinstructions combine an opcode with the statements that follow it so the
+// interpreter dispatches once for the whole sequence.  They are only set in
+// statement_t::execOp by idProgram::CreateSuperInstructions, the compiler never emits them.
+enum {
+	OP_EQ_F_IFNOT = NUM_OPCODES,	// compare followed by an OP_IFNOT on the result
+	OP_NE_F_IFNOT,
+	OP_EQ_E_IFNOT,
+	OP_NE_E_IFNOT,
+	OP_LE_IFNOT,
+	OP_GE_IFNOT,
+	OP_LT_IFNOT,
+	OP_GT_IFNOT,
+	OP_NOT_F_IFNOT,
+	OP_NOT_BOOL_IFNOT,
+	OP_NOT_ENT_IFNOT,
+	OP_INDIRECT_F_IFNOT,			// object field load followed by an OP_IFNOT on the field
+	OP_INDIRECT_BOOL_IFNOT,
+	OP_INDIRECT_F_COMPARE_IFNOT,	// object field load, float compare with the field and an OP_IFNOT on the result
+
+	NUM_EXEC_OPCODES
+};
+
 class idCompiler {
 private:
 	static bool		punctuationValid[ 256 ];
@@ -38,6 +38,12 @@ idInterpreter::idInterpreter()
 */
 idInterpreter::idInterpreter() {
 	localstackUsed = 0;
+	numStatementsDispatched = 0;
+	numStatementsExecuted = 0;
+	profiling = false;
+	profileStatements = 0;
+	profileTicks = 0.0;
+	profileParent = NULL;
 	terminateOnExit = true;
 	debug = 0;
 	memset( localstack, 0, sizeof( localstack ) );
@@ -156,6 +162,8 @@ idInterpreter::Reset
 ================
 */
 void idInterpreter::Reset( void ) {
+	StopProfile();
+
 	callStackDepth = 0;
 	localstackUsed = 0;
 	localstackBase = 0;
@@ -435,6 +443,9 @@ void idInterpreter::Error( char *fmt, ... ) const {
 
 	StackTrace();
 
+	// the error unwinds every Execute without ending its profile
+	AbortProfiles();
+
 	if ( ( instructionPointer >= 0 ) && ( instructionPointer < gameLocal.program.NumStatements() ) ) {
 		statement_t &line = gameLocal.program.GetStatement( instructionPointer );
 		common->Error( "%s(%d): Thread '%s': %s\n", gameLocal.program.GetFilename( line.file ), line.linenumber, thread->GetThreadName(), text );
@@ -591,6 +602,13 @@ void idInterpreter::EnterFunction( const function_t *func, bool clearStack ) {
 		}
 	}
 
+	if ( profiling ) {
+		ProfileFunctionTime();
+	}
+	if ( g_scriptProfile.GetBool() ) {
+		GetProfile( functionProfile, gameLocal.program.GetFunctionIndex( func ) ).numCalls++;
+	}
+
 	currentFunction = func;
 	assert( !func->eventdef );
 	NextInstruction( func->firstStatement );
@@ -660,6 +678,10 @@ void idInterpreter::LeaveFunction( idVarDef *returnDef ) {
 		}
 	}
 
+	if ( profiling ) {
+		ProfileFunctionTime();
+	}
+
 	// up stack
 	callStackDepth--;
 	stack = &callStack[ callStackDepth ]; 
@@ -689,6 +711,7 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 	int					data[ D_EVENT_MAXARGS ];
 	const idEventDef	*evdef;
 	const char			*format;
+	double				startTicks;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -791,7 +814,11 @@ void idInterpreter::CallEvent( const function_t *func, int argsize ) {
 	}
 
 	popParms = argsize;
+	startTicks = profiling ? idLib::sys->GetClockTicks() : 0.0;
 	eventEntity->ProcessEventArgPtr( evdef, data );
+	if ( profiling ) {
+		ProfileEventCall( evdef, startTicks );
+	}
 
 	if ( !multiFrameEvent ) {
 		if ( popParms ) {
@@ -860,6 +887,7 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	int					data[ D_EVENT_MAXARGS ];
 	const idEventDef	*evdef;
 	const char			*format;
+	double				startTicks;
 
 	if ( !func ) {
 		Error( "NULL function" );
@@ -921,7 +949,11 @@ void idInterpreter::CallSysEvent( const function_t *func, int argsize ) {
 	}
 
 	popParms = argsize;
+	startTicks = profiling ? idLib::sys->GetClockTicks() : 0.0;
 	thread->ProcessEventArgPtr( evdef, data );
+	if ( profiling ) {
+		ProfileEventCall( evdef, startTicks );
+	}
 	if ( popParms ) {
 		PopParms( popParms );
 	}
@@ -944,6 +976,7 @@ bool idInterpreter::Execute( void ) {
 	float		floatVal;
 	idScriptObject *obj;
 	const function_t *func;
+	bool		superInstructions;
 
 	if ( threadDying || !currentFunction ) {
 		return true;
@@ -955,6 +988,11 @@ bool idInterpreter::Execute( void ) {
 	}
 
 	runaway = 5000000;
+	superInstructions = g_scriptSuperInstructions.GetBool();
+
+	if ( g_scriptProfile.GetBool() ) {
+		BeginProfile();
+	}
 
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying ) {
@@ -964,10 +1002,14 @@ bool idInterpreter::Execute( void ) {
 			Error( "runaway loop error" );
 		}
 
+		if ( profiling ) {
+			profileStatements++;
+		}
+
 		// next statement
 		st = &gameLocal.program.GetStatement( instructionPointer );
 
-		switch( st->op ) {
+		switch( superInstructions ? st->execOp : st->op ) {
 		case OP_RETURN:
 			LeaveFunction( st->a );
 			break;
@@ -1039,6 +1081,145 @@ bool idInterpreter::Execute( void ) {
 			}
 			break;
 
+		case OP_EQ_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_NE_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_EQ_E_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_NE_E_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_LE_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_GE_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_LT_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_GT_IFNOT:
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_NOT_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_NOT_BOOL_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( *var_a.intPtr == 0 );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_NOT_ENT_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_INDIRECT_F_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.floatPtr = *var.floatPtr;
+			} else {
+				*var_c.floatPtr = 0.0f;
+			}
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_INDIRECT_BOOL_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.intPtr = *var.intPtr;
+			} else {
+				*var_c.intPtr = 0;
+			}
+			SuperInstructionIfNot( *var_c.intPtr, 2 );
+			break;
+
+		case OP_INDIRECT_F_COMPARE_IFNOT:
+			var_a = GetVariable( st->a );
+			var_c = GetVariable( st->c );
+			obj = GetScriptObject( *var_a.entityNumberPtr );
+			if ( obj ) {
+				var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
+				*var_c.floatPtr = *var.floatPtr;
+			} else {
+				*var_c.floatPtr = 0.0f;
+			}
+
+			// the compare that uses the field
+			st++;
+			var_a = GetVariable( st->a );
+			var_b = GetVariable( st->b );
+			var_c = GetVariable( st->c );
+			switch( st->op ) {
+			case OP_EQ_F:	*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr ); break;
+			case OP_NE_F:	*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr ); break;
+			case OP_LE:		*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr ); break;
+			case OP_GE:		*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr ); break;
+			case OP_LT:		*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr ); break;
+			case OP_GT:		*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr ); break;
+			default:		Error( "Bad superinstruction opcode %i", st->op ); break;
+			}
+			SuperInstructionIfNot( *var_c.intPtr, 3 );
+			break;
+
 		case OP_GOTO:
 			NextInstruction( instructionPointer + st->a->value.jumpOffset );
 			break;
@@ -1831,5 +2012,274 @@ bool idInterpreter::Execute( void ) {
 		}
 	}
 
+	numStatementsDispatched += 5000000 - runaway;
+	numStatementsExecuted += 5000000 - runaway;
+
+	if ( profiling ) {
+		EndProfile();
+	}
+
 	return threadDying;
 }
+
+/*
+===============================================================================
+
+	Script profiling
+
+	While g_scriptProfile is set every Execute accumulates the statements it
+	executes, including the ones run by superinstructions, and the time
+	between function calls and returns in the current function.  A script thread that runs from within an event of another one
+	pauses the time of the other thread, so function times don't overlap.
+	Event times include everything the event does.
+
+===============================================================================
+*/
+
+idList<scriptProfile_t>	idInterpreter::functionProfile;
+idList<scriptProfile_t>	idInterpreter::eventProfile;
+idInterpreter *			idInterpreter::profileInterpreter = NULL;
+
+/*
+================
+idInterpreter::GetProfile
+================
+*/
+scriptProfile_t &idInterpreter::GetProfile( idList<scriptProfile_t> &list, int index ) {
+	if ( index >= list.Num() ) {
+		scriptProfile_t empty;
+
+		memset( &empty, 0, sizeof( empty ) );
+		list.AssureSize( index + 1, empty );
+	}
+	return list[ index ];
+}
+
+/*
+================
+idInterpreter::BeginProfile
+================
+*/
+void idInterpreter::BeginProfile( void ) {
+	profileParent = profileInterpreter;
+	if ( profileParent ) {
+		profileParent->ProfileFunctionTime();
+	}
+	profileInterpreter = this;
+
+	profiling = true;
+	profileStatements = 0;
+	profileTicks = idLib::sys->GetClockTicks();
+}
+
+/*
+================
+idInterpreter::EndProfile
+================
+*/
+void idInterpreter::EndProfile( void ) {
+	ProfileFunctionTime();
+	profiling = false;
+
+	profileInterpreter = profileParent;
+	if ( profileParent ) {
+		// the parent continues from here
+		profileParent->profileTicks = profileTicks;
+		profileParent = NULL;
+	}
+}
+
+/*
+================
+idInterpreter::StopProfile
+
+Removes the interpreter from the profiling chain when it is reset or destroyed
+without returning from Execute.  The time since the last function call is dropped.
+================
+*/
+void idInterpreter::StopProfile( void ) {
+	idInterpreter *interpreter;
+
+	if ( !profiling ) {
+		return;
+	}
+	profiling = false;
+
+	if ( profileInterpreter == this ) {
+		profileInterpreter = profileParent;
+		if ( profileParent ) {
+			profileParent->profileTicks = idLib::sys->GetClockTicks();
+		}
+	} else {
+		for ( interpreter = profileInterpreter; interpreter; interpreter = interpreter->profileParent ) {
+			if ( interpreter->profileParent == this ) {
+				interpreter->profileParent = profileParent;
+				break;
+			}
+		}
+	}
+	profileParent = NULL;
+}
+
+/*
+================
+idInterpreter::AbortProfiles
+================
+*/
+void idInterpreter::AbortProfiles( void ) {
+	idInterpreter *interpreter;
+
+	while( profileInterpreter ) {
+		interpreter = profileInterpreter;
+		profileInterpreter = interpreter->profileParent;
+		interpreter->profiling = false;
+		interpreter->profileParent = NULL;
+	}
+}
+
+/*
+================
+idInterpreter::ProfileFunctionTime
+
+Adds the time and statements since the last call to the current function.
+================
+*/
+void idInterpreter::ProfileFunctionTime( void ) {
+	double ticks;
+
+	ticks = idLib::sys->GetClockTicks();
+	if ( currentFunction ) {
+		scriptProfile_t &profile = GetProfile( functionProfile, gameLocal.program.GetFunctionIndex( currentFunction ) );
+		profile.numStatements += profileStatements;
+		profile.clockTicks += ticks - profileTicks;
+	}
+	profileStatements = 0;
+	profileTicks = ticks;
+}
+
+/*
+================
+idInterpreter::ProfileEventCall
+================
+*/
+void idInterpreter::ProfileEventCall( const idEventDef *evdef, double startTicks ) {
+	scriptProfile_t &profile = GetProfile( eventProfile, evdef->GetEventNum() );
+	profile.numCalls++;
+	profile.clockTicks += idLib::sys->GetClockTicks() - startTicks;
+}
+
+/*
+================
+idInterpreter::ClearProfile
+
+The function indices change when the program is restarted.
+================
+*/
+void idInterpreter::ClearProfile( void ) {
+	functionProfile.Clear();
+	eventProfile.Clear();
+	AbortProfiles();
+}
+
+typedef struct {
+	const char *		name;
+	scriptProfile_t		profile;
+} profileEntry_t;
+
+/*
+================
+SortProfileEntryByTime
+================
+*/
+static int SortProfileEntryByTime( const profileEntry_t *a, const profileEntry_t *b ) {
+	if ( a->profile.clockTicks > b->profile.clockTicks ) {
+		return -1;
+	}
+	if ( a->profile.clockTicks < b->profile.clockTicks ) {
+		return 1;
+	}
+	return 0;
+}
+
+/*
+================
+PrintProfileEntries
+================
+*/
+static void PrintProfileEntries( idList<profileEntry_t> &entries, int maxEntries, bool statements ) {
+	int i;
+	double total, ticksPerMsec;
+
+	ticksPerMsec = idLib::sys->ClockTicksPerSecond() * 0.001;
+
+	total = 0.0;
+	for ( i = 0; i < entries.Num(); i++ ) {
+		total += entries[i].profile.clockTicks;
+	}
+	entries.Sort( SortProfileEntryByTime );
+
+	if ( statements ) {
+		gameLocal.Printf( "      ms     %%    calls  statements  function\n" );
+	} else {
+		gameLocal.Printf( "      ms     %%    calls  usec/call  event\n" );
+	}
+	for ( i = 0; i < entries.Num() && i < maxEntries; i++ ) {
+		const scriptProfile_t &profile = entries[i].profile;
+		if ( statements ) {
+			gameLocal.Printf( "%8.2f %5.1f %8d %11d  %s\n", profile.clockTicks / ticksPerMsec, total > 0.0 ? profile.clockTicks * 100.0 / total : 0.0,
+				profile.numCalls, profile.numStatements, entries[i].name );
+		} else {
+			gameLocal.Printf( "%8.2f %5.1f %8d %10.2f  %s\n", profile.clockTicks / ticksPerMsec, total > 0.0 ? profile.clockTicks * 100.0 / total : 0.0,
+				profile.numCalls, profile.numCalls ? profile.clockTicks * 1000.0 / ( ticksPerMsec * profile.numCalls ) : 0.0, entries[i].name );
+		}
+	}
+	gameLocal.Printf( "%.2f ms total in %d\n\n", total / ticksPerMsec, entries.Num() );
+}
+
+/*
+================
+idInterpreter::ScriptProfile_f
+================
+*/
+void idInterpreter::ScriptProfile_f( const idCmdArgs &args ) {
+	int i, maxEntries;
+	profileEntry_t entry;
+	idList<profileEntry_t> entries;
+
+	if ( args.Argc() > 1 && !idStr::Icmp( args.Argv( 1 ), "clear" ) ) {
+		ClearProfile();
+		gameLocal.Printf( "script profile cleared\n" );
+		return;
+	}
+
+	if ( !g_scriptProfile.GetBool() && !functionProfile.Num() ) {
+		gameLocal.Printf( "set g_scriptProfile 1 to profile the script functions and events\n" );
+		return;
+	}
+
+	maxEntries = ( args.Argc() > 1 ) ? atoi( args.Argv( 1 ) ) : 30;
+	if ( maxEntries <= 0 ) {
+		maxEntries = 30;
+	}
+
+	for ( i = 0; i < functionProfile.Num() && i < gameLocal.program.NumFunctions(); i++ ) {
+		if ( functionProfile[i].numCalls || functionProfile[i].numStatements ) {
+			entry.name = gameLocal.program.GetFunction( i )->Name();
+			entry.profile = functionProfile[i];
+			entries.Append( entry );
+		}
+	}
+	gameLocal.Printf( "script functions:\n" );
+	PrintProfileEntries( entries, maxEntries, true );
+
+	entries.Clear();
+	for ( i = 0; i < eventProfile.Num() && i < idEventDef::NumEventCommands(); i++ ) {
+		if ( eventProfile[i].numCalls ) {
+			entry.name = idEventDef::GetEventCommand( i )->GetName();
+			entry.profile = eventProfile[i];
+			entries.Append( entry );
+		}
+	}
+	gameLocal.Printf( "events called from script:\n" );
+	PrintProfileEntries( entries, maxEntries, false );
+}
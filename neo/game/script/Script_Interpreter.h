@@ -38,6 +38,13 @@ typedef struct prstack_s {
 	int 				stackbase;
 } prstack_t;
 
+// accumulated by the interpreter when g_scriptProfile is set
+typedef struct scriptProfile_s {
+	int					numCalls;
+	int					numStatements;		// statements executed while the function was the current one
+	double				clockTicks;			// time spent in the function, or in the event call
+} scriptProfile_t;
+
 class idInterpreter {
 private:
 	prstack_t			callStack[ MAX_STACK_DEPTH ];
@@ -51,6 +58,8 @@ private:
 
 	const function_t	*currentFunction;
 	int 				instructionPointer;
+	int					numStatementsDispatched;
+	int					numStatementsExecuted;		// dispatched statements plus the statements executed by superinstructions
 
 	int					popParms;
 	const idEventDef	*multiFrameEvent;
@@ -58,6 +67,15 @@ private:
 
 	idThread			*thread;
 
+	bool				profiling;
+	int					profileStatements;
+	double				profileTicks;
+	idInterpreter		*profileParent;
+
+	static idList<scriptProfile_t> functionProfile;
+	static idList<scriptProfile_t> eventProfile;
+	static idInterpreter *profileInterpreter;	// the interpreter currently accumulating time
+
 	void				PopParms( int numParms );
 	void				PushString( const char *string );
 	void				Push( int value );
@@ -69,11 +87,19 @@ private:
 	idEntity			*GetEntity( int entnum ) const;
 	idScriptObject		*GetScriptObject( int entnum ) const;
 	void				NextInstruction( int position );
+	void				SuperInstructionIfNot( int value, int numStatements );
 
 	void				LeaveFunction( idVarDef *returnDef );
 	void				CallEvent( const function_t *func, int argsize );
 	void				CallSysEvent( const function_t *func, int argsize );
 
+	void				BeginProfile( void );
+	void				EndProfile( void );
+	static void			AbortProfiles( void );
+	void				ProfileFunctionTime( void );
+	void				ProfileEventCall( const idEventDef *evdef, double startTicks );
+	static scriptProfile_t &GetProfile( idList<scriptProfile_t> &list, int index );
+
 public:
 	bool				doneProcessing;
 	bool				threadDying;
@@ -113,6 +139,12 @@ public:
 	const prstack_t		*GetCallstack( void ) const;
 	const function_t	*GetCurrentFunction( void ) const;
 	idThread			*GetThread( void ) const;
+	int					GetNumStatementsDispatched( void ) const;
+	int					GetNumStatementsExecuted( void ) const;
+
+	static void			ClearProfile( void );
+	void				StopProfile( void );
+	static void			ScriptProfile_f( const idCmdArgs &args );
 
 };
 
@@ -268,4 +300,39 @@ ID_INLINE void idInterpreter::NextInstruction( int position ) {
 	instructionPointer = position - 1;
 }
 
+/*
+====================
+idInterpreter::SuperInstructionIfNot
+
+Finishes a superinstruction that ends in an OP_IFNOT on value.
+====================
+*/
+ID_INLINE void idInterpreter::SuperInstructionIfNot( int value, int numStatements ) {
+	instructionPointer += numStatements - 1;
+	numStatementsExecuted += numStatements - 1;
+	// the profiler counts statements, not dispatches, it resets the count when it starts
+	profileStatements += numStatements - 1;
+	if ( value == 0 ) {
+		NextInstruction( instructionPointer + gameLocal.program.GetStatement( instructionPointer ).b->value.jumpOffset );
+	}
+}
+
+/*
+====================
+idInterpreter::GetNumStatementsDispatched
+====================
+*/
+ID_INLINE int idInterpreter::GetNumStatementsDispatched( void ) const {
+	return numStatementsDispatched;
+}
+
+/*
+====================
+idInterpreter::GetNumStatementsExecuted
+====================
+*/
+ID_INLINE int idInterpreter::GetNumStatementsExecuted( void ) const {
+	return numStatementsExecuted;
+}
+
 #endif /* !__SCRIPT_INTERPRETER_H__ */
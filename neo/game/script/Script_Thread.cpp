@@ -342,6 +342,8 @@ idThread::~idThread() {
 	if ( currentThread == this ) {
 		currentThread = NULL;
 	}
+
+	interpreter.StopProfile();
 }
 
 /*
@@ -647,6 +649,8 @@ bool idThread::Execute( void ) {
 	idThread	*oldThread;
 	bool		done;
 
+	PROFILE_SCOPE( "idThread::Execute" );
+
 	if ( manualControl && ( waitingUntil > gameLocal.time ) ) {
 		return false;
 	}
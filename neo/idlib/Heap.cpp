@@ -29,10 +29,27 @@ If you have questions concerning this license or the applicable additional terms
 #include "../idlib/precompiled.h"
 #pragma hdrstop
 
+#ifndef _WIN32
+#include <sched.h>
+#endif
+
+#if defined( __linux__ ) || defined( MACOS_X )
+#include <execinfo.h>
+#endif
+
 #ifndef USE_LIBC_MALLOC
 	#define USE_LIBC_MALLOC		0
 #endif
 
+// per-thread caches for the small block lists, so the common small allocs and frees don't take the heap lock
+#ifndef USE_THREAD_CACHE
+	#ifdef ID_THREAD_LOCAL
+		#define USE_THREAD_CACHE	1
+	#else
+		#define USE_THREAD_CACHE	0
+	#endif
+#endif
+
 #ifndef CRASH_ON_STATIC_ALLOCATION
 //	#define CRASH_ON_STATIC_ALLOCATION
 #endif
@@ -51,6 +68,10 @@ If you have questions concerning this license or the applicable additional terms
 #define SMALL_ALIGN( bytes )	( ALIGN_SIZE( (bytes) + SMALL_HEADER_SIZE ) - SMALL_HEADER_SIZE )
 #define MEDIUM_SMALLEST_SIZE	( ALIGN_SIZE( 256 ) + ALIGN_SIZE( MEDIUM_HEADER_SIZE ) )
 
+#define HEAP_LOCK_SPINS			64		// lock attempts before yielding the time slice
+#define THREAD_CACHE_BATCH		32		// small blocks moved between a thread cache and the heap at once
+#define THREAD_CACHE_MAX_FREE	64		// free small blocks a thread keeps per size before returning a batch
+
 
 class idHeap {
 
@@ -67,6 +88,15 @@ public:
 
 	void 			AllocDefragBlock( void );		// hack for huge renderbumps
 
+	void			Lock( void );					// lock the heap for exclusive access
+	void			Unlock( void );
+	void			FlushThreadCache( void );		// return the small blocks cached by the calling thread
+
+	void			UpdateAllocStats( int size );	// accounting is kept per thread and summed on request
+	void			UpdateFreeStats( int size );
+	void			GetStats( memoryStats_t &total, memoryStats_t &frameAllocs, memoryStats_t &frameFrees );
+	void			ClearFrameStats( void );
+
 private:
 
 	enum {
@@ -99,6 +129,16 @@ private:
 		dword				freeBlock;				// non-zero if free block
 	};
 
+	struct threadCache_s {							// small block lists and stats owned by a single thread
+		void *				firstFree[256/ALIGN+1];	// same layout as smallFirstFree
+		int					numFree[256/ALIGN+1];	// number of blocks on each list
+		memoryStats_t		totalAllocs;			// allocs minus frees made by this thread
+		memoryStats_t		frameAllocs;
+		memoryStats_t		frameFrees;
+		bool				inUse;					// false once the owning thread flushed the cache
+		threadCache_s *		next;					// next cache in the heap's list
+	};
+
 	// variables
 	void *			smallFirstFree[256/ALIGN+1];	// small heap allocator lists (for allocs of 1-255 bytes)
 	page_s *		smallCurPage;					// current page for small allocations
@@ -119,7 +159,13 @@ private:
 	dword			pageRequests;					// page requests
 	dword			OSAllocs;						// number of allocs made to the OS
 
-	int				c_heapAllocRunningCount;
+	volatile int	lockValue;						// non-zero while a thread owns the heap
+	threadCache_s *	threadCaches;					// caches of all threads that used the heap
+	threadCache_s	sharedCache;					// stats of allocations made without a thread cache
+
+#if USE_THREAD_CACHE
+	static ID_THREAD_LOCAL threadCache_s *threadCache;	// cache of the calling thread
+#endif
 
 	void			*defragBlock;					// a single huge block that can be allocated
 													// at startup, then freed when needed
@@ -140,8 +186,49 @@ private:
 
 	void			ReleaseSwappedPages( void );
 	void			FreePageReal( idHeap::page_s *p );
+
+	threadCache_s *	GetThreadCache( void );			// get or create the cache of the calling thread
+	void *			CachedSmallAllocate( dword bytes );	// allocate from the thread cache without locking
+	void			CachedSmallFree( void *ptr );	// free to the thread cache without locking
+	void			ClearCacheStats( threadCache_s *cache, bool total );
 };
 
+#if USE_THREAD_CACHE
+ID_THREAD_LOCAL idHeap::threadCache_s *idHeap::threadCache = NULL;
+#endif
+
+
+/*
+==================
+Mem_UpdateStats
+==================
+*/
+static void Mem_UpdateStats( memoryStats_t &stats, int size ) {
+	stats.num++;
+	if ( size < stats.minSize ) {
+		stats.minSize = size;
+	}
+	if ( size > stats.maxSize ) {
+		stats.maxSize = size;
+	}
+	stats.totalSize += size;
+}
+
+/*
+==================
+Mem_AddStats
+==================
+*/
+static void Mem_AddStats( memoryStats_t &stats, const memoryStats_t &add ) {
+	stats.num += add.num;
+	if ( add.minSize < stats.minSize ) {
+		stats.minSize = add.minSize;
+	}
+	if ( add.maxSize > stats.maxSize ) {
+		stats.maxSize = add.maxSize;
+	}
+	stats.totalSize += add.totalSize;
+}
 
 /*
 ================
@@ -169,7 +256,11 @@ void idHeap::Init () {
 	mediumLastFreePage	= NULL;
 	mediumFirstUsedPage	= NULL;
 
-	c_heapAllocRunningCount = 0;
+	lockValue			= 0;
+	threadCaches		= NULL;
+	ClearCacheStats( &sharedCache, true );
+	sharedCache.inUse	= true;
+	sharedCache.next	= NULL;
 }
 
 /*
@@ -230,6 +321,16 @@ idHeap::~idHeap( void ) {
 	}
 
 	assert( pagesAllocated == 0 );
+
+	// the cached blocks lived in the pages freed above
+	while( threadCaches ) {
+		threadCache_s *next = threadCaches->next;
+		::free( threadCaches );
+		threadCaches = next;
+	}
+#if USE_THREAD_CACHE
+	threadCache = NULL;
+#endif
 }
 
 /*
@@ -253,6 +354,35 @@ void idHeap::AllocDefragBlock( void ) {
 	idLib::common->Printf( "Allocated a %i mb defrag block\n", size / (1024*1024) );
 }
 
+/*
+================
+idHeap::Lock
+
+  simple spin lock, the game DLL has its own heap and can't use the engine critical sections
+================
+*/
+void idHeap::Lock( void ) {
+	for ( int spins = 0; Sys_InterlockedCompareExchange( lockValue, 0, 1 ) != 0; spins++ ) {
+		if ( spins >= HEAP_LOCK_SPINS ) {
+#ifdef _WIN32
+			SwitchToThread();
+#else
+			sched_yield();
+#endif
+			spins = 0;
+		}
+	}
+}
+
+/*
+================
+idHeap::Unlock
+================
+*/
+void idHeap::Unlock( void ) {
+	Sys_InterlockedExchange( lockValue, 0 );
+}
+
 /*
 ================
 idHeap::Allocate
@@ -262,18 +392,30 @@ void *idHeap::Allocate( const dword bytes ) {
 	if ( !bytes ) {
 		return NULL;
 	}
-	c_heapAllocRunningCount++;
 
 #if USE_LIBC_MALLOC
 	return malloc( bytes );
 #else
+	void *p;
+
 	if ( !(bytes & ~255) ) {
-		return SmallAllocate( bytes );
+#if USE_THREAD_CACHE
+		return CachedSmallAllocate( bytes );
+#else
+		Lock();
+		p = SmallAllocate( bytes );
+		Unlock();
+		return p;
+#endif
 	}
+	Lock();
 	if ( !(bytes & ~32767) ) {
-		return MediumAllocate( bytes );
+		p = MediumAllocate( bytes );
+	} else {
+		p = LargeAllocate( bytes );
 	}
-	return LargeAllocate( bytes );
+	Unlock();
+	return p;
 #endif
 }
 
@@ -286,22 +428,31 @@ void idHeap::Free( void *p ) {
 	if ( !p ) {
 		return;
 	}
-	c_heapAllocRunningCount--;
 
 #if USE_LIBC_MALLOC
 	free( p );
 #else
 	switch( ((byte *)(p))[-1] ) {
 		case SMALL_ALLOC: {
+#if USE_THREAD_CACHE
+			CachedSmallFree( p );
+#else
+			Lock();
 			SmallFree( p );
+			Unlock();
+#endif
 			break;
 		}
 		case MEDIUM_ALLOC: {
+			Lock();
 			MediumFree( p );
+			Unlock();
 			break;
 		}
 		case LARGE_ALLOC: {
+			Lock();
 			LargeFree( p );
+			Unlock();
 			break;
 		}
 		default: {
@@ -603,6 +754,270 @@ void idHeap::SmallFree( void *ptr ) {
 	smallFirstFree[ix] = (void *)d;		// link
 }
 
+//===============================================================
+//
+//	thread cache code
+//
+//	Each thread keeps its own lists of free small blocks. Allocations and
+//	frees only take the heap lock when a list runs empty or grows too long,
+//	and then move a whole batch of blocks at once.
+//
+//===============================================================
+
+/*
+================
+idHeap::ClearCacheStats
+================
+*/
+void idHeap::ClearCacheStats( threadCache_s *cache, bool total ) {
+	if ( total ) {
+		cache->totalAllocs.num = 0;
+		cache->totalAllocs.minSize = 0x0fffffff;
+		cache->totalAllocs.maxSize = -1;
+		cache->totalAllocs.totalSize = 0;
+	}
+	cache->frameAllocs.num = cache->frameFrees.num = 0;
+	cache->frameAllocs.minSize = cache->frameFrees.minSize = 0x0fffffff;
+	cache->frameAllocs.maxSize = cache->frameFrees.maxSize = -1;
+	cache->frameAllocs.totalSize = cache->frameFrees.totalSize = 0;
+}
+
+/*
+================
+idHeap::GetThreadCache
+
+  returns the cache of the calling thread, a cache given up by an exited thread is reused
+================
+*/
+idHeap::threadCache_s *idHeap::GetThreadCache( void ) {
+#if USE_THREAD_CACHE
+	threadCache_s *cache = threadCache;
+
+	if ( cache ) {
+		return cache;
+	}
+
+	Lock();
+	for ( cache = threadCaches; cache; cache = cache->next ) {
+		if ( !cache->inUse ) {
+			break;
+		}
+	}
+	if ( !cache ) {
+		cache = (threadCache_s *) ::malloc( sizeof( threadCache_s ) );
+		if ( !cache ) {
+			Unlock();
+			idLib::common->FatalError( "malloc failure for thread cache" );
+		}
+		memset( cache->firstFree, 0, sizeof( cache->firstFree ) );
+		memset( cache->numFree, 0, sizeof( cache->numFree ) );
+		ClearCacheStats( cache, true );
+		cache->next = threadCaches;
+		threadCaches = cache;
+	}
+	cache->inUse = true;
+	Unlock();
+
+	threadCache = cache;
+	return cache;
+#else
+	return &sharedCache;
+#endif
+}
+
+/*
+================
+idHeap::FlushThreadCache
+
+  returns all small blocks cached by the calling thread to the heap
+  the stats are kept so the totals stay correct after the thread exits
+================
+*/
+void idHeap::FlushThreadCache( void ) {
+#if USE_THREAD_CACHE
+	threadCache_s *cache = threadCache;
+
+	if ( !cache ) {
+		return;
+	}
+
+	Lock();
+	for ( int ix = 0; ix <= 256 / ALIGN; ix++ ) {
+		byte *d = (byte *)cache->firstFree[ix];
+		while( d ) {
+			dword *dt = (dword *)( d + SMALL_HEADER_SIZE );
+			byte *next = (byte *)(*dt);
+			*dt = (dword)smallFirstFree[ix];
+			smallFirstFree[ix] = (void *)d;
+			d = next;
+		}
+		cache->firstFree[ix] = NULL;
+		cache->numFree[ix] = 0;
+	}
+	cache->inUse = false;
+	Unlock();
+
+	threadCache = NULL;
+#endif
+}
+
+/*
+================
+idHeap::CachedSmallAllocate
+
+  allocate memory (1-255 bytes) from the cache of the calling thread
+================
+*/
+void *idHeap::CachedSmallAllocate( dword bytes ) {
+	threadCache_s *cache = GetThreadCache();
+
+	// we need the at least sizeof( dword ) bytes for the free list
+	if ( bytes < sizeof( dword ) ) {
+		bytes = sizeof( dword );
+	}
+
+	// increase the number of bytes if necessary to make sure the next small allocation is aligned
+	bytes = SMALL_ALIGN( bytes );
+
+	dword ix = bytes / ALIGN;
+	byte *smallBlock = (byte *)(cache->firstFree[ix]);
+
+	if ( !smallBlock ) {
+		// refill the list with a batch of blocks from the small heap manager
+		Lock();
+		for ( int i = 0; i < THREAD_CACHE_BATCH; i++ ) {
+			byte *p = (byte *)SmallAllocate( bytes );
+			if ( !p ) {
+				break;
+			}
+			p[-1] = INVALID_ALLOC;
+			*((dword *)p) = (dword)cache->firstFree[ix];
+			cache->firstFree[ix] = (void *)( p - SMALL_HEADER_SIZE );
+			cache->numFree[ix]++;
+		}
+		Unlock();
+
+		smallBlock = (byte *)(cache->firstFree[ix]);
+		if ( !smallBlock ) {
+			return NULL;
+		}
+	}
+
+	dword *link = (dword *)(smallBlock + SMALL_HEADER_SIZE);
+	smallBlock[1] = SMALL_ALLOC;					// allocation identifier
+	cache->firstFree[ix] = (void *)(*link);
+	cache->numFree[ix]--;
+	return (void *)(link);
+}
+
+/*
+================
+idHeap::CachedSmallFree
+
+  frees a small block to the cache of the calling thread
+================
+*/
+void idHeap::CachedSmallFree( void *ptr ) {
+	threadCache_s *cache = GetThreadCache();
+
+	((byte *)(ptr))[-1] = INVALID_ALLOC;
+
+	byte *d = ( (byte *)ptr ) - SMALL_HEADER_SIZE;
+	dword *dt = (dword *)ptr;
+	// index into the table with free small memory blocks
+	dword ix = *d;
+
+	// check if the index is correct
+	if ( ix > (256 / ALIGN) ) {
+		idLib::common->FatalError( "SmallFree: invalid memory block" );
+	}
+
+	*dt = (dword)cache->firstFree[ix];	// write next index
+	cache->firstFree[ix] = (void *)d;	// link
+
+	if ( ++cache->numFree[ix] < THREAD_CACHE_MAX_FREE ) {
+		return;
+	}
+
+	// unlink a batch of blocks and splice it onto the heap list in one go
+	byte *first = d;
+	byte *last = d;
+	for ( int i = 1; i < THREAD_CACHE_BATCH; i++ ) {
+		last = (byte *)(*(dword *)( last + SMALL_HEADER_SIZE ));
+	}
+	dword *lastLink = (dword *)( last + SMALL_HEADER_SIZE );
+	cache->firstFree[ix] = (void *)(*lastLink);
+	cache->numFree[ix] -= THREAD_CACHE_BATCH;
+
+	Lock();
+	*lastLink = (dword)smallFirstFree[ix];
+	smallFirstFree[ix] = (void *)first;
+	Unlock();
+}
+
+/*
+================
+idHeap::UpdateAllocStats
+================
+*/
+void idHeap::UpdateAllocStats( int size ) {
+	threadCache_s *cache = GetThreadCache();
+	Mem_UpdateStats( cache->frameAllocs, size );
+	Mem_UpdateStats( cache->totalAllocs, size );
+}
+
+/*
+================
+idHeap::UpdateFreeStats
+================
+*/
+void idHeap::UpdateFreeStats( int size ) {
+	threadCache_s *cache = GetThreadCache();
+	Mem_UpdateStats( cache->frameFrees, size );
+	cache->totalAllocs.num--;
+	cache->totalAllocs.totalSize -= size;
+}
+
+/*
+================
+idHeap::GetStats
+
+  sums the stats of all threads
+================
+*/
+void idHeap::GetStats( memoryStats_t &total, memoryStats_t &frameAllocs, memoryStats_t &frameFrees ) {
+	threadCache_s *cache;
+
+	Lock();
+	total = sharedCache.totalAllocs;
+	frameAllocs = sharedCache.frameAllocs;
+	frameFrees = sharedCache.frameFrees;
+	for ( cache = threadCaches; cache; cache = cache->next ) {
+		Mem_AddStats( total, cache->totalAllocs );
+		Mem_AddStats( frameAllocs, cache->frameAllocs );
+		Mem_AddStats( frameFrees, cache->frameFrees );
+	}
+	Unlock();
+}
+
+/*
+================
+idHeap::ClearFrameStats
+
+  the stats of other threads are not synchronized, they may lose a few counts
+================
+*/
+void idHeap::ClearFrameStats( void ) {
+	threadCache_s *cache;
+
+	Lock();
+	ClearCacheStats( &sharedCache, false );
+	for ( cache = threadCaches; cache; cache = cache->next ) {
+		ClearCacheStats( cache, false );
+	}
+	Unlock();
+}
+
 //===============================================================
 //
 //	medium heap code
@@ -984,9 +1399,6 @@ void idHeap::LargeFree( void *ptr) {
 #undef new
 
 static idHeap *			mem_heap = NULL;
-static memoryStats_t	mem_total_allocs = { 0, 0x0fffffff, -1, 0 };
-static memoryStats_t	mem_frame_allocs;
-static memoryStats_t	mem_frame_frees;
 
 /*
 ==================
@@ -994,10 +1406,9 @@ Mem_ClearFrameStats
 ==================
 */
 void Mem_ClearFrameStats( void ) {
-	mem_frame_allocs.num = mem_frame_frees.num = 0;
-	mem_frame_allocs.minSize = mem_frame_frees.minSize = 0x0fffffff;
-	mem_frame_allocs.maxSize = mem_frame_frees.maxSize = -1;
-	mem_frame_allocs.totalSize = mem_frame_frees.totalSize = 0;
+	if ( mem_heap ) {
+		mem_heap->ClearFrameStats();
+	}
 }
 
 /*
@@ -1006,8 +1417,14 @@ Mem_GetFrameStats
 ==================
 */
 void Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees ) {
-	allocs = mem_frame_allocs;
-	frees = mem_frame_frees;
+	memoryStats_t total;
+
+	if ( !mem_heap ) {
+		memset( &allocs, 0, sizeof( allocs ) );
+		memset( &frees, 0, sizeof( frees ) );
+		return;
+	}
+	mem_heap->GetStats( total, allocs, frees );
 }
 
 /*
@@ -1016,44 +1433,712 @@ Mem_GetStats
 ==================
 */
 void Mem_GetStats( memoryStats_t &stats ) {
-	stats = mem_total_allocs;
+	memoryStats_t allocs, frees;
+
+	if ( !mem_heap ) {
+		memset( &stats, 0, sizeof( stats ) );
+		return;
+	}
+	mem_heap->GetStats( stats, allocs, frees );
 }
 
 /*
 ==================
-Mem_UpdateStats
+Mem_UpdateAllocStats
 ==================
 */
-void Mem_UpdateStats( memoryStats_t &stats, int size ) {
-	stats.num++;
-	if ( size < stats.minSize ) {
-		stats.minSize = size;
+void Mem_UpdateAllocStats( int size ) {
+	mem_heap->UpdateAllocStats( size );
+}
+
+/*
+==================
+Mem_UpdateFreeStats
+==================
+*/
+void Mem_UpdateFreeStats( int size ) {
+	mem_heap->UpdateFreeStats( size );
+}
+
+/*
+==================
+Mem_ShutdownThread
+==================
+*/
+void Mem_ShutdownThread( void ) {
+	if ( mem_heap ) {
+		mem_heap->FlushThreadCache();
 	}
-	if ( size > stats.maxSize ) {
-		stats.maxSize = size;
+}
+
+
+//===============================================================
+//
+//	frame arena
+//
+//===============================================================
+
+typedef struct {
+	byte *			base;					// arena memory
+	int				size;					// bytes reserved for the arena
+	volatile int	used;					// bump offset, can go past size by the allocations that overflowed
+	volatile int	overflow;				// bytes allocated from the heap this frame
+	volatile int	numAllocs;
+	int				highWater;
+} frameArena_t;
+
+static frameArena_t		mem_frameArena;
+
+/*
+==================
+Mem_InitFrameArena
+==================
+*/
+void Mem_InitFrameArena( const int size ) {
+	Mem_ShutdownFrameArena();
+	mem_frameArena.size = ( size + 15 ) & ~15;
+	mem_frameArena.base = (byte *) Mem_Alloc16( mem_frameArena.size );
+}
+
+/*
+==================
+Mem_ShutdownFrameArena
+==================
+*/
+void Mem_ShutdownFrameArena( void ) {
+	if ( mem_frameArena.base ) {
+		Mem_Free16( mem_frameArena.base );
 	}
-	stats.totalSize += size;
+	memset( &mem_frameArena, 0, sizeof( mem_frameArena ) );
 }
 
 /*
 ==================
-Mem_UpdateAllocStats
+Mem_ResetFrameArena
+
+  releases all frame allocations, must not be called while other threads allocate from the arena
 ==================
 */
-void Mem_UpdateAllocStats( int size ) {
-	Mem_UpdateStats( mem_frame_allocs, size );
-	Mem_UpdateStats( mem_total_allocs, size );
+void Mem_ResetFrameArena( void ) {
+	int demand = Min( mem_frameArena.used, mem_frameArena.size ) + mem_frameArena.overflow;
+	if ( demand > mem_frameArena.highWater ) {
+		mem_frameArena.highWater = demand;
+	}
+
+	if ( mem_frameArena.overflow > 0 ) {
+		// nothing in the arena is alive anymore so grow it to the high water mark with some room to spare
+		int size = mem_frameArena.highWater + ( mem_frameArena.highWater >> 2 );
+		size = ( size + 0xffff ) & ~0xffff;
+		if ( mem_frameArena.base ) {
+			Mem_Free16( mem_frameArena.base );
+		}
+		mem_frameArena.base = (byte *) Mem_Alloc16( size );
+		mem_frameArena.size = size;
+	}
+#ifdef _DEBUG
+	else if ( mem_frameArena.base ) {
+		// make use of stale frame memory easier to spot
+		memset( mem_frameArena.base, 0xcd, Min( mem_frameArena.used, mem_frameArena.size ) );
+	}
+#endif
+
+	mem_frameArena.used = 0;
+	mem_frameArena.overflow = 0;
+	mem_frameArena.numAllocs = 0;
 }
 
 /*
 ==================
-Mem_UpdateFreeStats
+Mem_FrameAlloc
 ==================
 */
-void Mem_UpdateFreeStats( int size ) {
-	Mem_UpdateStats( mem_frame_frees, size );
-	mem_total_allocs.num--;
-	mem_total_allocs.totalSize -= size;
+void *Mem_FrameAlloc( const int size ) {
+	if ( size <= 0 ) {
+		return NULL;
+	}
+
+	int bytes = ( size + 15 ) & ~15;
+	Sys_InterlockedIncrement( mem_frameArena.numAllocs );
+
+	// stop bumping once the arena is full so used can't wrap around
+	if ( bytes <= mem_frameArena.size && mem_frameArena.used < mem_frameArena.size ) {
+		int end = Sys_InterlockedAdd( mem_frameArena.used, bytes );
+		if ( end <= mem_frameArena.size ) {
+			return mem_frameArena.base + end - bytes;
+		}
+	}
+
+	Sys_InterlockedAdd( mem_frameArena.overflow, bytes );
+	return Mem_Alloc16( size );
+}
+
+/*
+==================
+Mem_FrameFree
+==================
+*/
+void Mem_FrameFree( void *ptr ) {
+	if ( !ptr ) {
+		return;
+	}
+	if ( (byte *)ptr >= mem_frameArena.base && (byte *)ptr < mem_frameArena.base + mem_frameArena.size ) {
+		return;
+	}
+	Mem_Free16( ptr );
+}
+
+/*
+==================
+Mem_GetFrameArenaStats
+==================
+*/
+void Mem_GetFrameArenaStats( frameArenaStats_t &stats ) {
+	stats.size = mem_frameArena.size;
+	stats.used = Min( mem_frameArena.used, mem_frameArena.size );
+	stats.overflow = mem_frameArena.overflow;
+	stats.highWater = Max( mem_frameArena.highWater, stats.used + stats.overflow );
+	stats.numAllocs = mem_frameArena.numAllocs;
+}
+
+
+//===============================================================
+//
+//	allocation profiler
+//
+//	Samples one in every 'sampleRate' allocations and groups the samples
+//	by call stack and size class. Cheap enough to run in release builds,
+//	when disabled an allocation only tests the sample rate.
+//
+//===============================================================
+
+#define MEM_PROFILE_DEPTH			8			// call stack depth recorded for a sample
+#define MEM_PROFILE_SKIP			2			// skip Mem_ProfileCallStack and Mem_ProfileAlloc
+#define MEM_PROFILE_MAX_SITES		4096		// must be a power of two
+#define MEM_PROFILE_TRACE_ID		( ( 'T' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | 'I' )
+#define MEM_PROFILE_TRACE_VERSION	1
+#define MEM_PROFILE_TRACE_BUFFER	( 1 << 20 )	// samples buffered per frame for the trace file
+
+typedef enum {
+	MEM_CLASS_SMALL,						// 1-255 bytes
+	MEM_CLASS_MEDIUM,						// 256-32767 bytes
+	MEM_CLASS_LARGE,						// 32768 bytes or more
+	MEM_CLASS_ALIGNED,						// Mem_Alloc16
+	MEM_NUM_CLASSES
+} memSizeClass_t;
+
+static const char *mem_sizeClassNames[MEM_NUM_CLASSES] = { "small", "medium", "large", "align16" };
+
+typedef struct {
+	address_t		callStack[MEM_PROFILE_DEPTH];
+	int				sizeClass;				// -1 for an unused slot
+	int				frameSamples;			// samples in the current frame
+	int				frameBytes;
+	int				lastFrameSamples;		// samples in the last frame
+	int				lastFrameBytes;
+	int				peakFrameSamples;
+	int				totalSamples;
+	unsigned int	totalBytes;
+} memProfileSite_t;
+
+typedef struct {
+	int				id;
+	int				version;
+	int				sampleRate;
+	int				callStackDepth;
+	int				addressSize;			// sizeof( address_t )
+} memProfileTraceHeader_t;
+
+typedef struct {
+	int				frameNumber;
+	int				size;
+	int				sizeClass;
+	// followed by callStackDepth addresses
+} memProfileTraceSample_t;
+
+typedef struct {
+	volatile int		sampleRate;			// 0 when not profiling
+	volatile int		counter;
+	volatile int		lockValue;
+	int					frameNumber;		// frame the per frame counts belong to
+	int					numSites;
+	int					numFrames;
+	int					droppedSamples;		// samples that didn't fit in the site table
+	memProfileSite_t *	sites;
+	FILE *				traceFile;
+	byte *				traceBuffer;		// samples of the current frame, written to the trace file outside the lock
+	byte *				traceWriteBuffer;	// samples of the last frame being written
+	int					traceBufferUsed;
+	int					droppedTraceSamples;
+} memProfile_t;
+
+static memProfile_t		mem_profile;
+
+/*
+==================
+Mem_ProfileLock
+
+  separate from the heap lock so the sites can be read while allocating
+==================
+*/
+static void Mem_ProfileLock( void ) {
+	while ( Sys_InterlockedCompareExchange( mem_profile.lockValue, 0, 1 ) != 0 ) {
+#ifdef _WIN32
+		SwitchToThread();
+#else
+		sched_yield();
+#endif
+	}
+}
+
+/*
+==================
+Mem_ProfileUnlock
+==================
+*/
+static void Mem_ProfileUnlock( void ) {
+	Sys_InterlockedExchange( mem_profile.lockValue, 0 );
+}
+
+/*
+==================
+Mem_ProfileAdvanceFrame
+
+  moves the per frame counts of all sites to the last frame
+==================
+*/
+static void Mem_ProfileAdvanceFrame( void ) {
+	for ( int i = 0; i < MEM_PROFILE_MAX_SITES; i++ ) {
+		memProfileSite_t *site = &mem_profile.sites[i];
+		if ( site->sizeClass < 0 ) {
+			continue;
+		}
+		site->lastFrameSamples = site->frameSamples;
+		site->lastFrameBytes = site->frameBytes;
+		if ( site->frameSamples > site->peakFrameSamples ) {
+			site->peakFrameSamples = site->frameSamples;
+		}
+		site->frameSamples = 0;
+		site->frameBytes = 0;
+	}
+	mem_profile.frameNumber = idLib::frameNumber;
+	mem_profile.numFrames++;
+}
+
+/*
+==================
+Mem_ProfileClear
+==================
+*/
+static void Mem_ProfileClear( void ) {
+	for ( int i = 0; i < MEM_PROFILE_MAX_SITES; i++ ) {
+		memset( &mem_profile.sites[i], 0, sizeof( memProfileSite_t ) );
+		mem_profile.sites[i].sizeClass = -1;
+	}
+	mem_profile.numSites = 0;
+	mem_profile.numFrames = 0;
+	mem_profile.droppedSamples = 0;
+	mem_profile.frameNumber = idLib::frameNumber;
+}
+
+/*
+==================
+Mem_ProfileCallStack
+
+  Sys_GetCallStack is a stub on Linux and walks the frame pointers on Windows,
+  which the release builds omit, so the call stacks are captured here.
+==================
+*/
+static void Mem_ProfileCallStack( address_t callStack[MEM_PROFILE_DEPTH] ) {
+	void *frames[MEM_PROFILE_SKIP + MEM_PROFILE_DEPTH];
+	int i, num;
+
+#if defined( _WIN32 )
+	num = CaptureStackBackTrace( MEM_PROFILE_SKIP, MEM_PROFILE_DEPTH, frames, NULL );
+#elif defined( __linux__ ) || defined( MACOS_X )
+	num = backtrace( frames, MEM_PROFILE_SKIP + MEM_PROFILE_DEPTH ) - MEM_PROFILE_SKIP;
+	if ( num > 0 ) {
+		memmove( frames, frames + MEM_PROFILE_SKIP, num * sizeof( frames[0] ) );
+	}
+#else
+	frames[0] = __builtin_return_address( 0 );
+	num = 1;
+#endif
+
+	for ( i = 0; i < num; i++ ) {
+		callStack[i] = (address_t) frames[i];
+	}
+	for ( ; i < MEM_PROFILE_DEPTH; i++ ) {
+		callStack[i] = 0;
+	}
+}
+
+/*
+==================
+Mem_ProfileCallStackStr
+==================
+*/
+static const char *Mem_ProfileCallStackStr( const address_t callStack[MEM_PROFILE_DEPTH] ) {
+#if defined( _WIN32 )
+	return idLib::sys->GetCallStackStr( callStack, MEM_PROFILE_DEPTH );
+#else
+	static char string[MAX_STRING_CHARS*2];
+	void *frames[MEM_PROFILE_DEPTH];
+	int i, num, length;
+
+	for ( num = 0; num < MEM_PROFILE_DEPTH && callStack[num] != 0; num++ ) {
+		frames[num] = (void *) callStack[num];
+	}
+
+	string[0] = '\0';
+	length = 0;
+#if defined( __linux__ ) || defined( MACOS_X )
+	char **strings = backtrace_symbols( frames, num );
+	if ( strings ) {
+		for ( i = 0; i < num && length < (int)sizeof( string ) - 1; i++ ) {
+			length += idStr::snPrintf( string + length, sizeof( string ) - length, "  %s\n", strings[i] );
+		}
+		::free( strings );
+		return string;
+	}
+#endif
+	for ( i = 0; i < num && length < (int)sizeof( string ) - 1; i++ ) {
+		length += idStr::snPrintf( string + length, sizeof( string ) - length, "  %p\n", frames[i] );
+	}
+	return string;
+#endif
+}
+
+/*
+==================
+Mem_ProfileAlloc
+==================
+*/
+static void Mem_ProfileAlloc( const int size, const bool align16 ) {
+	address_t callStack[MEM_PROFILE_DEPTH];
+	int i, sizeClass, hash;
+	memProfileSite_t *site;
+
+	int rate = mem_profile.sampleRate;
+	if ( rate <= 0 || ( Sys_InterlockedIncrement( mem_profile.counter ) % rate ) != 0 ) {
+		return;
+	}
+
+	if ( align16 ) {
+		sizeClass = MEM_CLASS_ALIGNED;
+	} else if ( !( size & ~255 ) ) {
+		sizeClass = MEM_CLASS_SMALL;
+	} else if ( !( size & ~32767 ) ) {
+		sizeClass = MEM_CLASS_MEDIUM;
+	} else {
+		sizeClass = MEM_CLASS_LARGE;
+	}
+
+	Mem_ProfileCallStack( callStack );
+
+	hash = sizeClass;
+	for ( i = 0; i < MEM_PROFILE_DEPTH; i++ ) {
+		hash = hash * 31 + (int)callStack[i];
+	}
+	hash = ( hash ^ ( hash >> 16 ) ) & ( MEM_PROFILE_MAX_SITES - 1 );
+
+	Mem_ProfileLock();
+
+	if ( !mem_profile.sites ) {
+		// profiling was stopped while this sample was taken
+		Mem_ProfileUnlock();
+		return;
+	}
+
+	if ( mem_profile.traceFile ) {
+		if ( mem_profile.traceBufferUsed + (int)( sizeof( memProfileTraceSample_t ) + sizeof( callStack ) ) <= MEM_PROFILE_TRACE_BUFFER ) {
+			memProfileTraceSample_t *sample = (memProfileTraceSample_t *)( mem_profile.traceBuffer + mem_profile.traceBufferUsed );
+			sample->frameNumber = idLib::frameNumber;
+			sample->size = size;
+			sample->sizeClass = sizeClass;
+			memcpy( sample + 1, callStack, sizeof( callStack ) );
+			mem_profile.traceBufferUsed += sizeof( memProfileTraceSample_t ) + sizeof( callStack );
+		} else {
+			mem_profile.droppedTraceSamples++;
+		}
+	}
+
+	// find the site with linear probing
+	for ( i = 0; i < MEM_PROFILE_MAX_SITES; i++ ) {
+		site = &mem_profile.sites[( hash + i ) & ( MEM_PROFILE_MAX_SITES - 1 )];
+		if ( site->sizeClass < 0 ) {
+			memcpy( site->callStack, callStack, sizeof( callStack ) );
+			site->sizeClass = sizeClass;
+			mem_profile.numSites++;
+			break;
+		}
+		if ( site->sizeClass == sizeClass && memcmp( site->callStack, callStack, sizeof( callStack ) ) == 0 ) {
+			break;
+		}
+	}
+
+	if ( i < MEM_PROFILE_MAX_SITES ) {
+		site->frameSamples++;
+		site->frameBytes += size;
+		site->totalSamples++;
+		site->totalBytes += size;
+	} else {
+		mem_profile.droppedSamples++;
+	}
+
+	Mem_ProfileUnlock();
+}
+
+/*
+==================
+Mem_ProfileFlushTrace
+
+  Swaps the trace buffers under the lock and writes the samples after releasing it.
+  Only called from the main thread.
+==================
+*/
+static void Mem_ProfileFlushTrace( void ) {
+	byte *buffer;
+	int used, dropped;
+	FILE *f;
+
+	Mem_ProfileLock();
+	f = mem_profile.traceFile;
+	buffer = mem_profile.traceBuffer;
+	used = mem_profile.traceBufferUsed;
+	dropped = mem_profile.droppedTraceSamples;
+	mem_profile.traceBuffer = mem_profile.traceWriteBuffer;
+	mem_profile.traceWriteBuffer = buffer;
+	mem_profile.traceBufferUsed = 0;
+	mem_profile.droppedTraceSamples = 0;
+	Mem_ProfileUnlock();
+
+	if ( f && used ) {
+		fwrite( buffer, used, 1, f );
+	}
+	if ( dropped ) {
+		idLib::common->Warning( "allocation trace buffer full, %d samples dropped", dropped );
+	}
+}
+
+/*
+==================
+Mem_ProfileStopTrace
+==================
+*/
+static void Mem_ProfileStopTrace( void ) {
+	FILE *f;
+
+	if ( !mem_profile.traceFile ) {
+		return;
+	}
+
+	Mem_ProfileFlushTrace();
+
+	Mem_ProfileLock();
+	f = mem_profile.traceFile;
+	mem_profile.traceFile = NULL;
+	Mem_ProfileUnlock();
+
+	fclose( f );
+	::free( mem_profile.traceBuffer );
+	::free( mem_profile.traceWriteBuffer );
+	mem_profile.traceBuffer = NULL;
+	mem_profile.traceWriteBuffer = NULL;
+}
+
+/*
+==================
+Mem_ProfileNextFrame
+==================
+*/
+void Mem_ProfileNextFrame( void ) {
+	if ( !mem_profile.sampleRate ) {
+		return;
+	}
+
+	Mem_ProfileLock();
+	if ( mem_profile.sites ) {
+		Mem_ProfileAdvanceFrame();
+	}
+	Mem_ProfileUnlock();
+
+	if ( mem_profile.traceFile ) {
+		Mem_ProfileFlushTrace();
+	}
+}
+
+/*
+==================
+Mem_ProfileStop
+==================
+*/
+static void Mem_ProfileStop( void ) {
+	Mem_ProfileStopTrace();
+
+	Mem_ProfileLock();
+	mem_profile.sampleRate = 0;
+	if ( mem_profile.sites ) {
+		::free( mem_profile.sites );
+		mem_profile.sites = NULL;
+	}
+	Mem_ProfileUnlock();
+}
+
+/*
+==================
+Mem_ProfileSortByFrame
+==================
+*/
+static int Mem_ProfileSortByFrame( const void *a, const void *b ) {
+	const memProfileSite_t *sa = (const memProfileSite_t *)a;
+	const memProfileSite_t *sb = (const memProfileSite_t *)b;
+	if ( sb->lastFrameSamples != sa->lastFrameSamples ) {
+		return sb->lastFrameSamples - sa->lastFrameSamples;
+	}
+	return sb->totalSamples - sa->totalSamples;
+}
+
+/*
+==================
+Mem_ProfileSortByTotal
+==================
+*/
+static int Mem_ProfileSortByTotal( const void *a, const void *b ) {
+	const memProfileSite_t *sa = (const memProfileSite_t *)a;
+	const memProfileSite_t *sb = (const memProfileSite_t *)b;
+	return sb->totalSamples - sa->totalSamples;
+}
+
+/*
+==================
+Mem_ProfilePrintTop
+==================
+*/
+static void Mem_ProfilePrintTop( int count, bool total ) {
+	memProfileSite_t *sites;
+	int i, numSites, numFrames, droppedSamples, rate;
+
+	if ( !mem_profile.sampleRate ) {
+		idLib::common->Printf( "allocation profiler is not running\n" );
+		return;
+	}
+
+	// copy the sites so nothing is printed while holding the lock
+	sites = (memProfileSite_t *) ::malloc( MEM_PROFILE_MAX_SITES * sizeof( memProfileSite_t ) );
+	Mem_ProfileLock();
+	if ( !mem_profile.sites ) {
+		Mem_ProfileUnlock();
+		::free( sites );
+		return;
+	}
+	numSites = 0;
+	for ( i = 0; i < MEM_PROFILE_MAX_SITES; i++ ) {
+		if ( mem_profile.sites[i].sizeClass >= 0 ) {
+			sites[numSites++] = mem_profile.sites[i];
+		}
+	}
+	numFrames = mem_profile.numFrames;
+	droppedSamples = mem_profile.droppedSamples;
+	rate = mem_profile.sampleRate;
+	Mem_ProfileUnlock();
+
+	idLib::common->Printf( "%d call sites, %d frames, sampling 1 in %d allocations, %d samples dropped\n",
+							numSites, numFrames, rate, droppedSamples );
+	numFrames = Max( numFrames, 1 );
+
+	qsort( sites, numSites, sizeof( sites[0] ), total ? Mem_ProfileSortByTotal : Mem_ProfileSortByFrame );
+
+	// counts are estimated from the samples
+	if ( total ) {
+		idLib::common->Printf( "  allocs/frame    kB/frame  peak/frame class\n" );
+	} else {
+		idLib::common->Printf( " allocs lastfrm  kB lastfrm  peak/frame class\n" );
+	}
+	for ( i = 0; i < numSites && i < count; i++ ) {
+		const memProfileSite_t *site = &sites[i];
+		if ( total ) {
+			idLib::common->Printf( "%14.1f %11.1f %11d %-7s\n", (float)site->totalSamples * rate / numFrames,
+									(float)site->totalBytes * rate / numFrames / 1024.0f, site->peakFrameSamples * rate, mem_sizeClassNames[site->sizeClass] );
+		} else {
+			idLib::common->Printf( "%15d %11.1f %11d %-7s\n", site->lastFrameSamples * rate,
+									(float)site->lastFrameBytes * rate / 1024.0f, site->peakFrameSamples * rate, mem_sizeClassNames[site->sizeClass] );
+		}
+		idLib::common->Printf( "%s\n", Mem_ProfileCallStackStr( site->callStack ) );
+	}
+
+	::free( sites );
+}
+
+/*
+==================
+Mem_Profile_f
+==================
+*/
+void Mem_Profile_f( const idCmdArgs &args ) {
+	const char *cmd = args.Argv( 1 );
+
+	if ( idStr::Icmp( cmd, "start" ) == 0 ) {
+		int rate = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 64;
+		if ( rate < 1 ) {
+			rate = 1;
+		}
+		Mem_ProfileLock();
+		if ( !mem_profile.sites ) {
+			mem_profile.sites = (memProfileSite_t *) ::malloc( MEM_PROFILE_MAX_SITES * sizeof( memProfileSite_t ) );
+			Mem_ProfileClear();
+		}
+		mem_profile.sampleRate = rate;
+		Mem_ProfileUnlock();
+		idLib::common->Printf( "allocation profiler sampling 1 in %d allocations\n", rate );
+	} else if ( idStr::Icmp( cmd, "stop" ) == 0 ) {
+		Mem_ProfileStop();
+	} else if ( idStr::Icmp( cmd, "clear" ) == 0 ) {
+		Mem_ProfileLock();
+		if ( mem_profile.sites ) {
+			Mem_ProfileClear();
+		}
+		Mem_ProfileUnlock();
+	} else if ( idStr::Icmp( cmd, "top" ) == 0 || idStr::Icmp( cmd, "total" ) == 0 ) {
+		int count = ( args.Argc() > 2 ) ? atoi( args.Argv( 2 ) ) : 20;
+		Mem_ProfilePrintTop( count, idStr::Icmp( cmd, "total" ) == 0 );
+	} else if ( idStr::Icmp( cmd, "trace" ) == 0 ) {
+		Mem_ProfileStopTrace();
+		if ( args.Argc() < 3 ) {
+			return;
+		}
+		if ( !mem_profile.sampleRate ) {
+			idLib::common->Printf( "allocation profiler is not running\n" );
+			return;
+		}
+		FILE *f = fopen( args.Argv( 2 ), "wb" );
+		if ( !f ) {
+			idLib::common->Warning( "couldn't open %s", args.Argv( 2 ) );
+			return;
+		}
+		memProfileTraceHeader_t header;
+		header.id = MEM_PROFILE_TRACE_ID;
+		header.version = MEM_PROFILE_TRACE_VERSION;
+		header.sampleRate = mem_profile.sampleRate;
+		header.callStackDepth = MEM_PROFILE_DEPTH;
+		header.addressSize = sizeof( address_t );
+		fwrite( &header, sizeof( header ), 1, f );
+		mem_profile.traceBuffer = (byte *) ::malloc( MEM_PROFILE_TRACE_BUFFER );
+		mem_profile.traceWriteBuffer = (byte *) ::malloc( MEM_PROFILE_TRACE_BUFFER );
+		Mem_ProfileLock();
+		mem_profile.traceBufferUsed = 0;
+		mem_profile.droppedTraceSamples = 0;
+		mem_profile.traceFile = f;
+		Mem_ProfileUnlock();
+		idLib::common->Printf( "writing allocation trace to %s\n", args.Argv( 2 ) );
+	} else {
+		idLib::common->Printf( "usage: %s <command>\n"
+								"  start [rate]   sample one in every 'rate' allocations, default 64\n"
+								"  stop           stop profiling\n"
+								"  clear          clear all samples\n"
+								"  top [count]    call sites with the most allocations in the last frame\n"
+								"  total [count]  call sites with the most allocations per frame over all frames\n"
+								"  trace [file]   write all samples to a binary file, no file stops the trace\n", args.Argv( 0 ) );
+	}
 }
 
 
@@ -1076,6 +2161,9 @@ void *Mem_Alloc( const int size ) {
 	}
 	void *mem = mem_heap->Allocate( size );
 	Mem_UpdateAllocStats( mem_heap->Msize( mem ) );
+	if ( mem_profile.sampleRate ) {
+		Mem_ProfileAlloc( size, false );
+	}
 	return mem;
 }
 
@@ -1117,6 +2205,9 @@ void *Mem_Alloc16( const int size ) {
 	void *mem = mem_heap->Allocate16( size );
 	// make sure the memory is 16 byte aligned
 	assert( ( ((int)mem) & 15) == 0 );
+	if ( mem_profile.sampleRate ) {
+		Mem_ProfileAlloc( size, true );
+	}
 	return mem;
 }
 
@@ -1197,7 +2288,6 @@ Mem_Init
 */
 void Mem_Init( void ) {
 	mem_heap = new idHeap;
-	Mem_ClearFrameStats();
 }
 
 /*
@@ -1206,6 +2296,8 @@ Mem_Shutdown
 ==================
 */
 void Mem_Shutdown( void ) {
+	Mem_ProfileStop();
+
 	idHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
@@ -1584,18 +2676,23 @@ void *Mem_AllocDebugMemory( const int size, const char *fileName, const int line
 	}
 
 	Mem_UpdateAllocStats( size );
+	if ( mem_profile.sampleRate ) {
+		Mem_ProfileAlloc( size, align16 );
+	}
 
 	m = (debugMemory_t *) p;
 	m->fileName = fileName;
 	m->lineNumber = lineNumber;
 	m->frameNumber = idLib::frameNumber;
 	m->size = size;
+	mem_heap->Lock();
 	m->next = mem_debugMemory;
 	m->prev = NULL;
 	if ( mem_debugMemory ) {
 		mem_debugMemory->prev = m;
 	}
 	mem_debugMemory = m;
+	mem_heap->Unlock();
 	idLib::sys->GetCallStack( m->callStack, MAX_CALLSTACK_DEPTH );
 
 	return ( ( (byte *) p ) + sizeof( debugMemory_t ) );
@@ -1630,6 +2727,7 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 
 	Mem_UpdateFreeStats( m->size );
 
+	mem_heap->Lock();
 	if ( m->next ) {
 		m->next->prev = m->prev;
 	}
@@ -1639,6 +2737,7 @@ void Mem_FreeDebugMemory( void *p, const char *fileName, const int lineNumber, c
 	else {
 		mem_debugMemory = m->next;
 	}
+	mem_heap->Unlock();
 
 	m->fileName = fileName;
 	m->lineNumber = lineNumber;
@@ -1753,6 +2852,8 @@ void Mem_Shutdown( void ) {
 		Mem_DumpCompressed( va( "%s_leak_cs1.txt", mem_leakName ), MEMSORT_CALLSTACK, 2, 0 );
 	}
 
+	Mem_ProfileStop();
+
 	idHeap *m = mem_heap;
 	mem_heap = NULL;
 	delete m;
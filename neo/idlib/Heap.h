@@ -58,7 +58,10 @@ void		Mem_GetFrameStats( memoryStats_t &allocs, memoryStats_t &frees );
 void		Mem_GetStats( memoryStats_t &stats );
 void		Mem_Dump_f( const class idCmdArgs &args );
 void		Mem_DumpCompressed_f( const class idCmdArgs &args );
+void		Mem_Profile_f( const class idCmdArgs &args );
+void		Mem_ProfileNextFrame( void );	// advances the allocation profiler to the next frame and writes the trace samples
 void		Mem_AllocDefragBlock( void );
+void		Mem_ShutdownThread( void );		// return the blocks cached by the calling thread before it exits
 
 
 #ifndef ID_DEBUG_MEMORY
@@ -139,6 +142,38 @@ __inline void operator delete[]( void *p ) {
 #endif /* ID_DEBUG_MEMORY */
 
 
+/*
+===============================================================================
+
+	Frame arena.
+
+	Linear allocator for temporary data that never lives past the current
+	frame. An allocation is a lock-free pointer bump and everything is
+	released at once by Mem_ResetFrameArena. When the arena runs full the
+	allocations come from the heap, and the next reset grows the arena to
+	the high water mark.
+
+	Each module that links idlib has its own arena.
+
+===============================================================================
+*/
+
+typedef struct {
+	int		size;					// bytes reserved for the arena
+	int		used;					// bytes allocated this frame, including overflow
+	int		overflow;				// bytes that didn't fit this frame and came from the heap
+	int		highWater;				// most bytes used by a single frame
+	int		numAllocs;				// allocations this frame
+} frameArenaStats_t;
+
+void		Mem_InitFrameArena( const int size );
+void		Mem_ShutdownFrameArena( void );
+void		Mem_ResetFrameArena( void );
+void *		Mem_FrameAlloc( const int size );	// 16 byte aligned, valid until the next Mem_ResetFrameArena
+void		Mem_FrameFree( void *ptr );			// only releases the memory if it came from the heap
+void		Mem_GetFrameArenaStats( frameArenaStats_t &stats );
+
+
 /*
 ===============================================================================
 
@@ -0,0 +1,91 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __PARALLELJOBLIST_H__
+#define __PARALLELJOBLIST_H__
+
+/*
+===============================================================================
+
+	Parallel job lists.
+
+	A job list is a batch of function + data pairs that is handed to the
+	shared pool of job threads with Submit() and synchronized with Wait().
+	The jobs in a list can run in any order and on any thread, including the
+	thread that waits on the list.  Job lists are allocated once and reused,
+	after Wait() returns new jobs can be added for the next submission.
+
+	The pool is owned by the engine and shared with the game through
+	gameImport_t, so the renderer, game and tools don't each start their own
+	threads.  With zero job threads, jobs run on the submitting thread.
+
+	Jobs may allocate from the heap, but must not use any other system that
+	isn't thread safe.
+
+===============================================================================
+*/
+
+typedef void ( * jobRun_t )( void * );
+
+class idParallelJobList {
+public:
+	virtual						~idParallelJobList( void ) {}
+
+	// adds a job, the list can't be submitted
+	virtual void				AddJob( jobRun_t function, void *data ) = 0;
+	// starts running the jobs, if waitForList is set the jobs won't start before all jobs in that list have completed
+	virtual void				Submit( idParallelJobList *waitForList = NULL ) = 0;
+	// blocks until all jobs have completed, the calling thread helps running the jobs
+	virtual void				Wait( void ) = 0;
+	// returns true if the list isn't submitted or all jobs have completed, doesn't block
+	virtual bool				TryWait( void ) = 0;
+	virtual bool				IsSubmitted( void ) const = 0;
+	virtual int					NumJobs( void ) const = 0;
+	virtual const char *		GetName( void ) const = 0;
+	// milliseconds the last Wait() was blocked
+	virtual double				GetWaitTime( void ) const = 0;
+};
+
+class idParallelJobManager {
+public:
+	virtual						~idParallelJobManager( void ) {}
+
+	virtual void				Init( void ) = 0;
+	virtual void				Shutdown( void ) = 0;
+
+	virtual idParallelJobList *	AllocJobList( const char *name ) = 0;
+	virtual void				FreeJobList( idParallelJobList *jobList ) = 0;
+
+	// number of job threads, not counting the threads waiting on job lists
+	virtual int					GetNumProcessingThreads( void ) const = 0;
+};
+
+extern idParallelJobManager *	parallelJobManager;
+
+#endif /* !__PARALLELJOBLIST_H__ */
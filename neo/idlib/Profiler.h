@@ -0,0 +1,110 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+/*
+===============================================================================
+
+	Hierarchical CPU profiler.
+
+	Code is instrumented with named zones that are recorded with a time stamp
+	into a ring buffer owned by the thread that runs them, so the last few
+	seconds of every thread can be written out at any time as a Chrome trace
+	("chrome://tracing" or Perfetto).  Zones nest, a zone ends when the scope
+	it was opened in is left.
+
+	Zone names must be string literals, only the pointer is recorded.
+
+	When recording is disabled a zone costs a test of a single flag, defining
+	ID_PROFILE_ZONES to 0 removes the zones from the build completely.
+
+===============================================================================
+*/
+
+class idProfiler {
+public:
+	virtual						~idProfiler( void ) {}
+
+	virtual void				Init( void ) = 0;
+	virtual void				Shutdown( void ) = 0;
+
+	// records the start of a zone on the calling thread
+	virtual void				BeginZone( const char *name ) = 0;
+	// records the end of the innermost zone on the calling thread
+	virtual void				EndZone( void ) = 0;
+	// marks the start of a new frame, applies cvar changes and checks the previous frame for a spike
+	virtual void				BeginFrame( int frameNumber ) = 0;
+	// sets the name the calling thread is shown with in traces
+	virtual void				SetThreadName( const char *name ) = 0;
+	// throws away everything recorded, zone names from an unloaded module must not be written
+	virtual void				Clear( void ) = 0;
+	// writes the recorded events of all threads as Chrome trace JSON
+	virtual bool				WriteTrace( const char *fileName ) = 0;
+
+	bool						IsEnabled( void ) const { return enabled; }
+
+protected:
+	volatile bool				enabled;
+};
+
+extern idProfiler *				profiler;
+
+class idProfileScope {
+public:
+								idProfileScope( const char *name ) {
+									active = profiler->IsEnabled();
+									if ( active ) {
+										profiler->BeginZone( name );
+									}
+								}
+								~idProfileScope( void ) {
+									if ( active ) {
+										profiler->EndZone();
+									}
+								}
+
+private:
+	bool						active;		// a zone that started while disabled must not be ended
+};
+
+#ifndef ID_PROFILE_ZONES
+#define ID_PROFILE_ZONES		1
+#endif
+
+#if ID_PROFILE_ZONES
+#define PROFILE_SCOPE_NAME2( line )		profileScope_##line
+#define PROFILE_SCOPE_NAME( line )		PROFILE_SCOPE_NAME2( line )
+#define PROFILE_SCOPE( name )			idProfileScope PROFILE_SCOPE_NAME( __LINE__ )( name )
+#else
+#define PROFILE_SCOPE( name )
+#endif
+
+#endif /* !__PROFILER_H__ */
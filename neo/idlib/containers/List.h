@@ -68,6 +68,36 @@ ID_INLINE type *idListNewElement( void ) {
 	return new type;
 }
 
+/*
+================
+idListHeapAllocator<type>
+
+Default idList storage, allocated with new[] from the heap.
+================
+*/
+template< class type >
+class idListHeapAllocator {
+public:
+	static type *	Alloc( int num ) { return new type[ num ]; }
+	static void		Free( type *ptr, int num ) { delete[] ptr; }
+};
+
+/*
+================
+idListFrameAllocator<type>
+
+idList storage allocated from the frame arena, so the list must not live past
+the next Mem_ResetFrameArena. No constructor or destructor is called for the
+elements, only use it for plain data types.
+================
+*/
+template< class type >
+class idListFrameAllocator {
+public:
+	static type *	Alloc( int num ) { return (type *)Mem_FrameAlloc( num * sizeof( type ) ); }
+	static void		Free( type *ptr, int num ) { Mem_FrameFree( ptr ); }
+};
+
 /*
 ================
 idSwap<type>
@@ -80,7 +110,8 @@ ID_INLINE void idSwap( type &a, type &b ) {
 	b = c;
 }
 
-template< class type >
+// the default allocator is given by the forward declaration in sys_public.h
+template< class type, class allocator_t >
 class idList {
 public:
 
@@ -88,8 +119,8 @@ public:
 	typedef type	new_t( void );
 
 					idList( int newgranularity = 16 );
-					idList( const idList<type> &other );
-					~idList<type>( void );
+					idList( const idList<type,allocator_t> &other );
+					~idList( void );
 
 	void			Clear( void );										// clear the list
 	int				Num( void ) const;									// returns number of elements in list
@@ -101,7 +132,7 @@ public:
 	size_t			Size( void ) const;									// returns total size of allocated memory including size of list type
 	size_t			MemoryUsed( void ) const;							// returns size of the used elements in the list
 
-	idList<type> &	operator=( const idList<type> &other );
+	idList<type,allocator_t> &	operator=( const idList<type,allocator_t> &other );
 	const type &	operator[]( int index ) const;
 	type &			operator[]( int index );
 
@@ -117,7 +148,7 @@ public:
 	const type *	Ptr( void ) const;									// returns a pointer to the list
 	type &			Alloc( void );										// returns reference to a new data element at the end of the list
 	int				Append( const type & obj );							// append element
-	int				Append( const idList<type> &other );				// append list
+	int				Append( const idList<type,allocator_t> &other );				// append list
 	int				AddUnique( const type & obj );						// add unique element
 	int				Insert( const type & obj, int index = 0 );			// insert the element at the given index
 	int				FindIndex( const type & obj ) const;				// find the index for the given element
@@ -128,7 +159,7 @@ public:
 	bool			Remove( const type & obj );							// remove the element
 	void			Sort( cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
 	void			SortSubSection( int startIndex, int endIndex, cmp_t *compare = ( cmp_t * )&idListSortCompare<type> );
-	void			Swap( idList<type> &other );						// swap the contents of the lists
+	void			Swap( idList<type,allocator_t> &other );						// swap the contents of the lists
 	void			DeleteContents( bool clear );						// delete the contents of the list
 
 private:
@@ -143,8 +174,8 @@ private:
 idList<type>::idList( int )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( int newgranularity ) {
+template< class type, class allocator_t >
+ID_INLINE idList<type,allocator_t>::idList( int newgranularity ) {
 	assert( newgranularity > 0 );
 
 	list		= NULL;
@@ -157,8 +188,8 @@ ID_INLINE idList<type>::idList( int newgranularity ) {
 idList<type>::idList( const idList<type> &other )
 ================
 */
-template< class type >
-ID_INLINE idList<type>::idList( const idList<type> &other ) {
+template< class type, class allocator_t >
+ID_INLINE idList<type,allocator_t>::idList( const idList<type,allocator_t> &other ) {
 	list = NULL;
 	*this = other;
 }
@@ -168,8 +199,8 @@ ID_INLINE idList<type>::idList( const idList<type> &other ) {
 idList<type>::~idList<type>
 ================
 */
-template< class type >
-ID_INLINE idList<type>::~idList( void ) {
+template< class type, class allocator_t >
+ID_INLINE idList<type,allocator_t>::~idList( void ) {
 	Clear();
 }
 
@@ -180,10 +211,10 @@ idList<type>::Clear
 Frees up the memory allocated by the list.  Assumes that type automatically handles freeing up memory.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Clear( void ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Clear( void ) {
 	if ( list ) {
-		delete[] list;
+		allocator_t::Free( list, size );
 	}
 
 	list	= NULL;
@@ -203,8 +234,8 @@ the pointers are still valid when this function is called.  Function will set al
 list to NULL.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::DeleteContents( bool clear ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::DeleteContents( bool clear ) {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -226,8 +257,8 @@ idList<type>::Allocated
 return total memory allocated for the list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Allocated( void ) const {
+template< class type, class allocator_t >
+ID_INLINE size_t idList<type,allocator_t>::Allocated( void ) const {
 	return size * sizeof( type );
 }
 
@@ -238,9 +269,9 @@ idList<type>::Size
 return total size of list in bytes, but doesn't take into account additional memory allocated by type
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::Size( void ) const {
-	return sizeof( idList<type> ) + Allocated();
+template< class type, class allocator_t >
+ID_INLINE size_t idList<type,allocator_t>::Size( void ) const {
+	return sizeof( idList<type,allocator_t> ) + Allocated();
 }
 
 /*
@@ -248,8 +279,8 @@ ID_INLINE size_t idList<type>::Size( void ) const {
 idList<type>::MemoryUsed
 ================
 */
-template< class type >
-ID_INLINE size_t idList<type>::MemoryUsed( void ) const {
+template< class type, class allocator_t >
+ID_INLINE size_t idList<type,allocator_t>::MemoryUsed( void ) const {
 	return num * sizeof( *list );
 }
 
@@ -261,8 +292,8 @@ Returns the number of elements currently contained in the list.
 Note that this is NOT an indication of the memory allocated.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Num( void ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::Num( void ) const {
 	return num;
 }
 
@@ -273,8 +304,8 @@ idList<type>::NumAllocated
 Returns the number of elements currently allocated for.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::NumAllocated( void ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::NumAllocated( void ) const {
 	return size;
 }
 
@@ -285,8 +316,8 @@ idList<type>::SetNum
 Resize to the exact size specified irregardless of granularity
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetNum( int newnum, bool resize ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::SetNum( int newnum, bool resize ) {
 	assert( newnum >= 0 );
 	if ( resize || newnum > size ) {
 		Resize( newnum );
@@ -301,8 +332,8 @@ idList<type>::SetGranularity
 Sets the base size of the array and resizes the array to match.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SetGranularity( int newgranularity ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::SetGranularity( int newgranularity ) {
 	int newsize;
 
 	assert( newgranularity > 0 );
@@ -325,8 +356,8 @@ idList<type>::GetGranularity
 Get the current granularity.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::GetGranularity( void ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::GetGranularity( void ) const {
 	return granularity;
 }
 
@@ -337,8 +368,8 @@ idList<type>::Condense
 Resizes the array to exactly the number of elements it contains or frees up memory if empty.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Condense( void ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Condense( void ) {
 	if ( list ) {
 		if ( num ) {
 			Resize( num );
@@ -356,9 +387,10 @@ Allocates memory for the amount of elements requested while keeping the contents
 Contents are copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Resize( int newsize ) {
 	type	*temp;
+	int		oldsize;
 	int		i;
 
 	assert( newsize >= 0 );
@@ -375,20 +407,21 @@ ID_INLINE void idList<type>::Resize( int newsize ) {
 	}
 
 	temp	= list;
+	oldsize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = allocator_t::Alloc( size );
 	for( i = 0; i < num; i++ ) {
 		list[ i ] = temp[ i ];
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		allocator_t::Free( temp, oldsize );
 	}
 }
 
@@ -400,9 +433,10 @@ Allocates memory for the amount of elements requested while keeping the contents
 Contents are copied using their = operator so that data is correnctly instantiated.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Resize( int newsize, int newgranularity ) {
 	type	*temp;
+	int		oldsize;
 	int		i;
 
 	assert( newsize >= 0 );
@@ -417,20 +451,21 @@ ID_INLINE void idList<type>::Resize( int newsize, int newgranularity ) {
 	}
 
 	temp	= list;
+	oldsize	= size;
 	size	= newsize;
 	if ( size < num ) {
 		num = size;
 	}
 
 	// copy the old list into our new one
-	list = new type[ size ];
+	list = allocator_t::Alloc( size );
 	for( i = 0; i < num; i++ ) {
 		list[ i ] = temp[ i ];
 	}
 
 	// delete the old list if it exists
 	if ( temp ) {
-		delete[] temp;
+		allocator_t::Free( temp, oldsize );
 	}
 }
 
@@ -441,8 +476,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::AssureSize( int newSize ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -466,8 +501,8 @@ idList<type>::AssureSize
 Makes sure the list has at least the given number of elements and initialize any elements not yet initialized.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSize( int newSize, const type &initValue ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::AssureSize( int newSize, const type &initValue ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -499,8 +534,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::AssureSizeAlloc( int newSize, new_t *allocator ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::AssureSizeAlloc( int newSize, new_t *allocator ) {
 	int newNum = newSize;
 
 	if ( newSize > size ) {
@@ -529,8 +564,8 @@ idList<type>::operator=
 Copies the contents and size attributes of another list.
 ================
 */
-template< class type >
-ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
+template< class type, class allocator_t >
+ID_INLINE idList<type,allocator_t> &idList<type,allocator_t>::operator=( const idList<type,allocator_t> &other ) {
 	int	i;
 
 	Clear();
@@ -540,7 +575,7 @@ ID_INLINE idList<type> &idList<type>::operator=( const idList<type> &other ) {
 	granularity	= other.granularity;
 
 	if ( size ) {
-		list = new type[ size ];
+		list = allocator_t::Alloc( size );
 		for( i = 0; i < num; i++ ) {
 			list[ i ] = other.list[ i ];
 		}
@@ -557,8 +592,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE const type &idList<type>::operator[]( int index ) const {
+template< class type, class allocator_t >
+ID_INLINE const type &idList<type,allocator_t>::operator[]( int index ) const {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -573,8 +608,8 @@ Access operator.  Index must be within range or an assert will be issued in debu
 Release builds do no range checking.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::operator[]( int index ) {
+template< class type, class allocator_t >
+ID_INLINE type &idList<type,allocator_t>::operator[]( int index ) {
 	assert( index >= 0 );
 	assert( index < num );
 
@@ -592,8 +627,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Ptr( void ) {
+template< class type, class allocator_t >
+ID_INLINE type *idList<type,allocator_t>::Ptr( void ) {
 	return list;
 }
 
@@ -608,8 +643,8 @@ Note: may return NULL if the list is empty.
 FIXME: Create an iterator template for this kind of thing.
 ================
 */
-template< class type >
-const ID_INLINE type *idList<type>::Ptr( void ) const {
+template< class type, class allocator_t >
+const ID_INLINE type *idList<type,allocator_t>::Ptr( void ) const {
 	return list;
 }
 
@@ -620,8 +655,8 @@ idList<type>::Alloc
 Returns a reference to a new data element at the end of the list.
 ================
 */
-template< class type >
-ID_INLINE type &idList<type>::Alloc( void ) {
+template< class type, class allocator_t >
+ID_INLINE type &idList<type,allocator_t>::Alloc( void ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -642,8 +677,8 @@ Increases the size of the list by one element and copies the supplied data into
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( type const & obj ) {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::Append( type const & obj ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -675,8 +710,8 @@ and inserts the supplied data into it.
 Returns the index of the new element.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Insert( type const & obj, int index ) {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::Insert( type const & obj, int index ) {
 	if ( !list ) {
 		Resize( granularity );
 	}
@@ -714,8 +749,8 @@ adds the other list to this one
 Returns the size of the new combined list
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::Append( const idList<type> &other ) {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::Append( const idList<type,allocator_t> &other ) {
 	if ( !list ) {
 		if ( granularity == 0 ) {	// this is a hack to fix our memset classes
 			granularity = 16;
@@ -738,8 +773,8 @@ idList<type>::AddUnique
 Adds the data to the list if it doesn't already exist.  Returns the index of the data in the list.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::AddUnique( type const & obj ) {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::AddUnique( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -757,8 +792,8 @@ idList<type>::FindIndex
 Searches for the specified data in the list and returns it's index.  Returns -1 if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindIndex( type const & obj ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::FindIndex( type const & obj ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -778,8 +813,8 @@ idList<type>::Find
 Searches for the specified data in the list and returns it's address. Returns NULL if the data is not found.
 ================
 */
-template< class type >
-ID_INLINE type *idList<type>::Find( type const & obj ) const {
+template< class type, class allocator_t >
+ID_INLINE type *idList<type,allocator_t>::Find( type const & obj ) const {
 	int i;
 
 	i = FindIndex( obj );
@@ -800,8 +835,8 @@ NOTE: This function can only be called on lists containing pointers. Calling it
 on non-pointer lists will cause a compiler error.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::FindNull( void ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::FindNull( void ) const {
 	int i;
 
 	for( i = 0; i < num; i++ ) {
@@ -824,8 +859,8 @@ Function will assert in debug builds if pointer is outside the bounds of the lis
 but remains silent in release builds.
 ================
 */
-template< class type >
-ID_INLINE int idList<type>::IndexOf( type const *objptr ) const {
+template< class type, class allocator_t >
+ID_INLINE int idList<type,allocator_t>::IndexOf( type const *objptr ) const {
 	int index;
 
 	index = objptr - list;
@@ -845,8 +880,8 @@ The number of elements in the list is reduced by one.  Returns false if the inde
 Note that the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::RemoveIndex( int index ) {
+template< class type, class allocator_t >
+ID_INLINE bool idList<type,allocator_t>::RemoveIndex( int index ) {
 	int i;
 
 	assert( list != NULL );
@@ -874,8 +909,8 @@ The number of elements in the list is reduced by one.  Returns false if the data
 the element is not destroyed, so any memory used by it may not be freed until the destruction of the list.
 ================
 */
-template< class type >
-ID_INLINE bool idList<type>::Remove( type const & obj ) {
+template< class type, class allocator_t >
+ID_INLINE bool idList<type,allocator_t>::Remove( type const & obj ) {
 	int index;
 
 	index = FindIndex( obj );
@@ -894,8 +929,8 @@ Performs a qsort on the list using the supplied comparison function.  Note that
 list, so any pointers to data within the list may no longer be valid.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Sort( cmp_t *compare ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Sort( cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -912,8 +947,8 @@ idList<type>::SortSubSection
 Sorts a subsection of the list.
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::SortSubSection( int startIndex, int endIndex, cmp_t *compare ) {
 	if ( !list ) {
 		return;
 	}
@@ -939,8 +974,8 @@ idList<type>::Swap
 Swaps the contents of two lists
 ================
 */
-template< class type >
-ID_INLINE void idList<type>::Swap( idList<type> &other ) {
+template< class type, class allocator_t >
+ID_INLINE void idList<type,allocator_t>::Swap( idList<type,allocator_t> &other ) {
 	idSwap( num, other.num );
 	idSwap( size, other.size );
 	idSwap( granularity, other.granularity );
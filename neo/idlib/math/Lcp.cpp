@@ -35,6 +35,8 @@ const float LCP_BOUND_EPSILON			= 1e-5f;
 const float LCP_ACCEL_EPSILON			= 1e-5f;
 const float LCP_DELTA_ACCEL_EPSILON		= 1e-9f;
 const float LCP_DELTA_FORCE_EPSILON		= 1e-9f;
+const float LCP_GS_DIAGONAL_EPSILON		= 1e-9f;
+const float LCP_GS_CONVERGED_EPSILON	= 1e-5f;
 
 #define IGNORE_UNSATISFIABLE_VARIABLES
 
@@ -1589,6 +1591,139 @@ bool idLCP_Symmetric::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b,
 }
 
 
+//===============================================================
+//
+//	idLCP_GaussSeidel
+//
+//===============================================================
+
+class idLCP_GaussSeidel : public idLCP {
+public:
+	virtual bool	Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex );
+
+private:
+	idVecX			invDiagonal;		// reciprocal of the diagonal, zero if the variable is not constrained
+
+private:
+	float			Sweep( const idMatX &m, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex, bool boxed );
+};
+
+/*
+============
+idLCP_GaussSeidel::Sweep
+
+  Does a projected Gauss-Seidel step for either the boxed or the other
+  variables and returns the largest change of a variable.
+============
+*/
+float idLCP_GaussSeidel::Sweep( const idMatX &m, idVecX &x, const idVecX &b, const idVecX &lo, const idVecX &hi, const int *boxIndex, bool boxed ) {
+	int i, n;
+	float dot, f, l, h, maxChange;
+
+	n = m.GetNumRows();
+	maxChange = 0.0f;
+
+	for ( i = 0; i < n; i++ ) {
+
+		if ( ( boxIndex != NULL && boxIndex[i] != -1 ) != boxed ) {
+			continue;
+		}
+
+		if ( invDiagonal[i] == 0.0f ) {
+			continue;
+		}
+
+		SIMDProcessor->Dot( dot, m[i], x.ToFloatPtr(), n );
+		f = x[i] + ( b[i] - dot ) * invDiagonal[i];
+
+		if ( boxed ) {
+			l = - idMath::Fabs( lo[i] * x[boxIndex[i]] );
+			h = idMath::Fabs( hi[i] * x[boxIndex[i]] );
+		} else {
+			l = lo[i];
+			h = hi[i];
+		}
+
+		if ( f < l ) {
+			f = l;
+		} else if ( f > h ) {
+			f = h;
+		}
+
+		maxChange = Max( maxChange, idMath::Fabs( f - x[i] ) );
+		x[i] = f;
+	}
+
+	return maxChange;
+}
+
+/*
+============
+idLCP_GaussSeidel::Solve
+============
+*/
+bool idLCP_GaussSeidel::Solve( const idMatX &o_m, idVecX &o_x, const idVecX &o_b, const idVecX &o_lo, const idVecX &o_hi, const int *o_boxIndex ) {
+	int i, n, iteration;
+	float d, l, h, maxChange, maxForce;
+
+	n = o_m.GetNumRows();
+
+	assert( n == o_m.GetNumColumns() );
+	assert( o_x.GetSize() == n );
+	assert( o_b.GetSize() == n );
+	assert( o_lo.GetSize() == n );
+	assert( o_hi.GetSize() == n );
+
+	if ( n == 0 ) {
+		return true;
+	}
+
+	invDiagonal.SetSize( n );
+
+	// clamp the initial guess to the bounds, variables that are not constrained exert no force
+	for ( i = 0; i < n; i++ ) {
+		d = o_m[i][i];
+		if ( d > LCP_GS_DIAGONAL_EPSILON ) {
+			invDiagonal[i] = 1.0f / d;
+		} else {
+			invDiagonal[i] = 0.0f;
+			o_x[i] = 0.0f;
+			continue;
+		}
+		if ( o_boxIndex != NULL && o_boxIndex[i] != -1 ) {
+			continue;
+		}
+		l = o_lo[i];
+		h = o_hi[i];
+		if ( o_x[i] < l ) {
+			o_x[i] = l;
+		} else if ( o_x[i] > h ) {
+			o_x[i] = h;
+		}
+	}
+
+	for ( iteration = 0; iteration < maxIterations; iteration++ ) {
+
+		// the boxed variables depend on the others so they are updated last
+		maxChange = Sweep( o_m, o_x, o_b, o_lo, o_hi, o_boxIndex, false );
+		if ( o_boxIndex != NULL ) {
+			maxChange = Max( maxChange, Sweep( o_m, o_x, o_b, o_lo, o_hi, o_boxIndex, true ) );
+		}
+
+		// stop when the variables hardly change anymore relative to the largest force
+		maxForce = 1.0f;
+		for ( i = 0; i < n; i++ ) {
+			maxForce = Max( maxForce, idMath::Fabs( o_x[i] ) );
+		}
+		if ( maxChange < LCP_GS_CONVERGED_EPSILON * maxForce ) {
+			break;
+		}
+	}
+
+	return true;
+}
+
+
 //===============================================================
 //
 //	idLCP
@@ -1617,6 +1752,17 @@ idLCP *idLCP::AllocSymmetric( void ) {
 	return lcp;
 }
 
+/*
+============
+idLCP::AllocGaussSeidel
+============
+*/
+idLCP *idLCP::AllocGaussSeidel( void ) {
+	idLCP *lcp = new idLCP_GaussSeidel;
+	lcp->SetMaxIterations( 32 );
+	return lcp;
+}
+
 /*
 ============
 idLCP::~idLCP
@@ -56,6 +56,14 @@ If you have questions concerning this license or the applicable additional terms
   Before calculating any of the bounded x[i] with boxIndex[i] != -1 the
   solver calculates all unbounded x[i] and all x[i] with boxIndex[i] == -1.
 
+  The square and symmetric solvers use Dantzig's pivoting method and find
+  an exact solution, their cost grows with the cube of the dimension.
+  The Gauss-Seidel solver iterates towards the solution with projected
+  Gauss-Seidel steps, it never fails but the accuracy depends on the
+  number of iterations.  The iterations start from the contents of x,
+  which should hold a good guess like the solution of the previous frame.
+  The Dantzig solvers ignore the contents of x.
+
 ===============================================================================
 */
 
@@ -63,6 +71,7 @@ class idLCP {
 public:
 	static idLCP *	AllocSquare( void );		// A must be a square matrix
 	static idLCP *	AllocSymmetric( void );		// A must be a symmetric matrix
+	static idLCP *	AllocGaussSeidel( void );	// A must have a positive diagonal
 
 	virtual			~idLCP( void );
 
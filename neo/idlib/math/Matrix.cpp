@@ -2935,9 +2935,9 @@ const char *idMat6::ToString( int precision ) const {
 //
 //===============================================================
 
-float	idMatX::temp[MATX_MAX_TEMP+4];
-float *	idMatX::tempPtr = (float *) ( ( (int) idMatX::temp + 15 ) & ~15 );
-int		idMatX::tempIndex = 0;
+ID_THREAD_LOCAL_IF_AVAILABLE float	idMatX::temp[MATX_MAX_TEMP+4];
+ID_THREAD_LOCAL_IF_AVAILABLE float *	idMatX::tempPtr = NULL;
+ID_THREAD_LOCAL_IF_AVAILABLE int		idMatX::tempIndex = 0;
 
 
 /*
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "Simd_SSE.h"
 #include "Simd_SSE2.h"
 #include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
 #include "Simd_AltiVec.h"
 
 
@@ -75,6 +76,8 @@ void idSIMD::InitProcessor( const char *module, bool forceGeneric ) {
 		if ( !processor ) {
 			if ( ( cpuid & CPUID_ALTIVEC ) ) {
 				processor = new idSIMD_AltiVec;
+			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) && ( cpuid & CPUID_AVX2 ) && ( cpuid & CPUID_FMA3 ) ) {
+				processor = new idSIMD_AVX2;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) && ( cpuid & CPUID_SSE3 ) ) {
 				processor = new idSIMD_SSE3;
 			} else if ( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) && ( cpuid & CPUID_SSE2 ) ) {
@@ -2833,6 +2836,125 @@ void TestOverlayPointCull( void ) {
 	PrintClocks( va( "   simd->OverlayPointCull() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestCullBoxes
+============
+*/
+void TestCullBoxes( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	ALIGN16( idPlane planes[5] );
+	ALIGN16( idBounds bounds[COUNT] );
+	ALIGN16( float modelMatrices[COUNT][16] );
+	const idBounds *boundsPtrs[COUNT];
+	const float *modelMatrixPtrs[COUNT];
+	ALIGN16( byte culled1[COUNT] );
+	ALIGN16( byte culled2[COUNT] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	for ( i = 0; i < 5; i++ ) {
+		idVec3 normal( srnd.CRandomFloat(), srnd.CRandomFloat(), srnd.CRandomFloat() );
+		normal.Normalize();
+		planes[i].SetNormal( normal );
+		planes[i][3] = -5.0f - srnd.RandomFloat() * 10.0f;
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		idMat3 axis = idAngles( srnd.RandomFloat() * 360.0f, srnd.RandomFloat() * 360.0f, srnd.RandomFloat() * 360.0f ).ToMat3();
+		for ( j = 0; j < 3; j++ ) {
+			bounds[i][0][j] = -srnd.RandomFloat() * 4.0f;
+			bounds[i][1][j] = srnd.RandomFloat() * 4.0f;
+			modelMatrices[i][j*4+0] = axis[j][0];
+			modelMatrices[i][j*4+1] = axis[j][1];
+			modelMatrices[i][j*4+2] = axis[j][2];
+			modelMatrices[i][j*4+3] = 0.0f;
+			modelMatrices[i][3*4+j] = srnd.CRandomFloat() * 20.0f;
+		}
+		modelMatrices[i][15] = 1.0f;
+		boundsPtrs[i] = &bounds[i];
+		modelMatrixPtrs[i] = modelMatrices[i];
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->CullBoxes( culled1, planes, 5, boundsPtrs, modelMatrixPtrs, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->CullBoxes()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->CullBoxes( culled2, planes, 5, boundsPtrs, modelMatrixPtrs, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( culled1[i] != culled2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->CullBoxes() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
+/*
+============
+TestOverlapBounds
+============
+*/
+void TestOverlapBounds( void ) {
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idBounds bounds;
+	ALIGN16( idBounds boundsList[COUNT] );
+	ALIGN16( byte overlap1[COUNT] );
+	ALIGN16( byte overlap2[COUNT] );
+	const char *result;
+
+	idRandom srnd( RANDOM_SEED );
+
+	bounds[0].Set( -8.0f, -8.0f, -8.0f );
+	bounds[1].Set( 8.0f, 8.0f, 8.0f );
+	for ( i = 0; i < COUNT; i++ ) {
+		for ( j = 0; j < 3; j++ ) {
+			boundsList[i][0][j] = srnd.CRandomFloat() * 20.0f;
+			boundsList[i][1][j] = boundsList[i][0][j] + srnd.RandomFloat() * 8.0f;
+		}
+	}
+
+	bestClocksGeneric = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_generic->OverlapBounds( overlap1, bounds, boundsList, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksGeneric );
+	}
+	PrintClocks( "generic->OverlapBounds()", COUNT, bestClocksGeneric );
+
+	bestClocksSIMD = 0;
+	for ( i = 0; i < NUMTESTS; i++ ) {
+		StartRecordTime( start );
+		p_simd->OverlapBounds( overlap2, bounds, boundsList, COUNT );
+		StopRecordTime( end );
+		GetBest( start, end, bestClocksSIMD );
+	}
+
+	for ( i = 0; i < COUNT; i++ ) {
+		if ( overlap1[i] != overlap2[i] ) {
+			break;
+		}
+	}
+	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	PrintClocks( va( "   simd->OverlapBounds() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+}
+
 /*
 ============
 TestDeriveTriPlanes
@@ -4144,6 +4266,12 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 				return;
 			}
 			p_simd = new idSIMD_SSE3();
+		} else if ( idStr::Icmp( argString, "AVX2" ) == 0 ) {
+			if ( !( cpuid & CPUID_MMX ) || !( cpuid & CPUID_SSE ) || !( cpuid & CPUID_SSE2 ) || !( cpuid & CPUID_SSE3 ) || !( cpuid & CPUID_AVX2 ) || !( cpuid & CPUID_FMA3 ) ) {
+				common->Printf( "CPU does not support MMX & SSE & SSE2 & SSE3 & AVX2 & FMA3\n" );
+				return;
+			}
+			p_simd = new idSIMD_AVX2();
 		} else if ( idStr::Icmp( argString, "AltiVec" ) == 0 ) {
 			if ( !( cpuid & CPUID_ALTIVEC ) ) {
 				common->Printf( "CPU does not support AltiVec\n" );
@@ -4151,7 +4279,7 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 			}
 			p_simd = new idSIMD_AltiVec();
 		} else {
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AVX2, AltiVec\n" );
 			return;
 		}
 	}
@@ -4198,6 +4326,8 @@ void idSIMD::Test_f( const idCmdArgs &args ) {
 	TestTracePointCull();
 	TestDecalPointCull();
 	TestOverlayPointCull();
+	TestCullBoxes();
+	TestOverlapBounds();
 	TestDeriveTriPlanes();
 	TestDeriveTangents();
 	TestDeriveUnsmoothedTangents();
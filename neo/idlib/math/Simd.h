@@ -76,6 +76,7 @@ class idMat5;
 class idMat6;
 class idMatX;
 class idPlane;
+class idBounds;
 class idDrawVert;
 class idJointQuat;
 class idJointMat;
@@ -179,6 +180,10 @@ public:
 	virtual void VPCALL TracePointCull( byte *cullBits, byte &totalOr, const float radius, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
 	virtual void VPCALL DecalPointCull( byte *cullBits, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
 	virtual void VPCALL OverlayPointCull( byte *cullBits, idVec2 *texCoords, const idPlane *planes, const idDrawVert *verts, const int numVerts ) = 0;
+	// culled[i] is set if the i'th bounds transformed by the i'th 16 float model matrix is completely in front of one of the planes
+	virtual void VPCALL CullBoxes( byte *culled, const idPlane *planes, const int numPlanes, const idBounds * const *bounds, const float * const *modelMatrices, const int numBoxes ) = 0;
+	// overlap[i] is set if boundsList[i] intersects or touches the bounds
+	virtual void VPCALL OverlapBounds( byte *overlap, const idBounds &bounds, const idBounds *boundsList, const int count ) = 0;
 	virtual void VPCALL DeriveTriPlanes( idPlane *planes, const idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) = 0;
 	virtual void VPCALL DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) = 0;
 	virtual void VPCALL DeriveUnsmoothedTangents( idDrawVert *verts, const dominantTri_s *dominantTris, const int numVerts ) = 0;
@@ -0,0 +1,702 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../precompiled.h"
+#pragma hdrstop
+
+#include "Simd_Generic.h"
+#include "Simd_MMX.h"
+#include "Simd_SSE.h"
+#include "Simd_SSE2.h"
+#include "Simd_SSE3.h"
+#include "Simd_AVX2.h"
+
+
+//===============================================================
+//
+//	AVX2 & FMA implementation of idSIMDProcessor
+//
+//===============================================================
+
+#if defined(_WIN32) || defined(__i386__) || defined(__x86_64__)
+
+#include <immintrin.h>
+
+/*
+	GCC only allows the AVX2 and FMA intrinsics in functions compiled for those
+	instruction sets. The functions are tagged individually instead of building
+	the whole file with -mavx2 so inline functions from the headers that end up
+	emitted in this file can never contain instructions older CPUs can't run.
+*/
+#if defined(__GNUC__)
+#define AVX2_FUNC					__attribute__ ((target ("avx2,fma")))
+#else
+#define AVX2_FUNC
+#endif
+
+#define AVX2_INLINE					static inline AVX2_FUNC
+
+#define DRAWVERT_FLOATS				( sizeof( idDrawVert ) / sizeof( float ) )
+#define JOINTQUAT_FLOATS			( sizeof( idJointQuat ) / sizeof( float ) )
+
+/*
+============
+HorizontalSum
+============
+*/
+AVX2_INLINE float HorizontalSum( const __m256 v ) {
+	__m128 s = _mm_add_ps( _mm256_castps256_ps128( v ), _mm256_extractf128_ps( v, 1 ) );
+	s = _mm_hadd_ps( s, s );
+	s = _mm_hadd_ps( s, s );
+	return _mm_cvtss_f32( s );
+}
+
+/*
+============
+ReciprocalSqrt
+
+  same precision as idMath::RSqrt, one Newton-Raphson step on the estimate
+  the input is clamped so a zero length vector is scaled to zero instead of NaN
+============
+*/
+AVX2_INLINE __m256 ReciprocalSqrt( const __m256 x ) {
+	const __m256 c = _mm256_max_ps( x, _mm256_set1_ps( 1e-30f ) );
+	const __m256 r = _mm256_rsqrt_ps( c );
+	const __m256 y = _mm256_mul_ps( c, _mm256_set1_ps( 0.5f ) );
+	return _mm256_mul_ps( r, _mm256_fnmadd_ps( _mm256_mul_ps( r, r ), y, _mm256_set1_ps( 1.5f ) ) );
+}
+
+/*
+============
+DotFloats
+============
+*/
+AVX2_INLINE float DotFloats( const float *a, const float *b, const int count ) {
+	__m256 sum = _mm256_setzero_ps();
+	int k;
+
+	for ( k = 0; k + 8 <= count; k += 8 ) {
+		sum = _mm256_fmadd_ps( _mm256_loadu_ps( a + k ), _mm256_loadu_ps( b + k ), sum );
+	}
+	float s = HorizontalSum( sum );
+	for ( ; k < count; k++ ) {
+		s += a[k] * b[k];
+	}
+	return s;
+}
+
+/*
+============
+idSIMD_AVX2::GetName
+============
+*/
+const char * idSIMD_AVX2::GetName( void ) const {
+	return "MMX & SSE & SSE2 & SSE3 & AVX2 & FMA3";
+}
+
+/*
+============
+idSIMD_AVX2::MatX_LDLTFactor
+
+  in-place factorization LDL' of the n * n sub-matrix of mat
+  the reciprocal of the diagonal elements are stored in invDiag
+============
+*/
+AVX2_FUNC bool VPCALL idSIMD_AVX2::MatX_LDLTFactor( idMatX &mat, idVecX &invDiag, const int n ) {
+	int i, j, k, nc;
+	float *v, *diag, *mptr;
+	float s, sum, d;
+
+	v = (float *) _alloca16( n * sizeof( float ) );
+	diag = (float *) _alloca16( n * sizeof( float ) );
+
+	nc = mat.GetNumColumns();
+
+	for ( i = 0; i < n; i++ ) {
+
+		mptr = mat[i];
+
+		// v = diag * row, and the dot product of v with the row
+		__m256 acc = _mm256_setzero_ps();
+		for ( k = 0; k + 8 <= i; k += 8 ) {
+			__m256 r = _mm256_loadu_ps( mptr + k );
+			__m256 t = _mm256_mul_ps( _mm256_loadu_ps( diag + k ), r );
+			_mm256_storeu_ps( v + k, t );
+			acc = _mm256_fmadd_ps( t, r, acc );
+		}
+		s = HorizontalSum( acc );
+		for ( ; k < i; k++ ) {
+			v[k] = diag[k] * mptr[k];
+			s += v[k] * mptr[k];
+		}
+
+		sum = mptr[i] - s;
+
+		if ( sum == 0.0f ) {
+			return false;
+		}
+
+		mptr[i] = sum;
+		diag[i] = sum;
+		invDiag[i] = d = 1.0f / sum;
+
+		if ( i + 1 >= n ) {
+			return true;
+		}
+
+		mptr = mat[i+1];
+		for ( j = i + 1; j < n; j++ ) {
+			mptr[i] = ( mptr[i] - DotFloats( mptr, v, i ) ) * d;
+			mptr += nc;
+		}
+	}
+
+	return true;
+}
+
+/*
+============
+Transpose4x4
+
+  transposes the 4x4 matrices in the lower and upper half of the registers
+============
+*/
+AVX2_INLINE void Transpose4x4( __m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3 ) {
+	__m256 t0 = _mm256_unpacklo_ps( r0, r1 );
+	__m256 t1 = _mm256_unpacklo_ps( r2, r3 );
+	__m256 t2 = _mm256_unpackhi_ps( r0, r1 );
+	__m256 t3 = _mm256_unpackhi_ps( r2, r3 );
+	r0 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	r1 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+	r2 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+	r3 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+}
+
+/*
+============
+Load2x128
+============
+*/
+AVX2_INLINE __m256 Load2x128( const float *lo, const float *hi ) {
+	return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( lo ) ), _mm_loadu_ps( hi ), 1 );
+}
+
+/*
+============
+Store2x128
+============
+*/
+AVX2_INLINE void Store2x128( float *lo, float *hi, const __m256 v ) {
+	_mm_storeu_ps( lo, _mm256_castps256_ps128( v ) );
+	_mm_storeu_ps( hi, _mm256_extractf128_ps( v, 1 ) );
+}
+
+/*
+============
+idSIMD_AVX2::BlendJoints
+
+  Eight quaternions are transposed into registers and slerped at once using
+  the same approximations for the arc tangent and sine as idQuat::Slerp.
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::BlendJoints( idJointQuat *joints, const idJointQuat *blendJoints, const float lerp, const int *index, const int numJoints ) {
+	int i, k;
+
+	if ( lerp <= 0.0f ) {
+		return;
+	}
+
+	if ( lerp >= 1.0f ) {
+		for ( i = 0; i < numJoints; i++ ) {
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	const __m256 two = _mm256_set1_ps( 2.0f );
+	const __m256 halfPi = _mm256_set1_ps( idMath::HALF_PI );
+	const __m256 signBit = _mm256_set1_ps( -0.0f );
+	const __m256 t = _mm256_set1_ps( lerp );
+	const __m256 oneMinusT = _mm256_set1_ps( 1.0f - lerp );
+
+	for ( i = 0; i + 8 <= numJoints; i += 8 ) {
+		const int *j = index + i;
+
+		__m256 fromX = Load2x128( joints[j[0]].q.ToFloatPtr(), joints[j[4]].q.ToFloatPtr() );
+		__m256 fromY = Load2x128( joints[j[1]].q.ToFloatPtr(), joints[j[5]].q.ToFloatPtr() );
+		__m256 fromZ = Load2x128( joints[j[2]].q.ToFloatPtr(), joints[j[6]].q.ToFloatPtr() );
+		__m256 fromW = Load2x128( joints[j[3]].q.ToFloatPtr(), joints[j[7]].q.ToFloatPtr() );
+		Transpose4x4( fromX, fromY, fromZ, fromW );
+
+		__m256 toX = Load2x128( blendJoints[j[0]].q.ToFloatPtr(), blendJoints[j[4]].q.ToFloatPtr() );
+		__m256 toY = Load2x128( blendJoints[j[1]].q.ToFloatPtr(), blendJoints[j[5]].q.ToFloatPtr() );
+		__m256 toZ = Load2x128( blendJoints[j[2]].q.ToFloatPtr(), blendJoints[j[6]].q.ToFloatPtr() );
+		__m256 toW = Load2x128( blendJoints[j[3]].q.ToFloatPtr(), blendJoints[j[7]].q.ToFloatPtr() );
+		Transpose4x4( toX, toY, toZ, toW );
+
+		// identical quaternions are copied as is
+		__m256 same = _mm256_and_ps( _mm256_and_ps( _mm256_cmp_ps( fromX, toX, _CMP_EQ_OQ ), _mm256_cmp_ps( fromY, toY, _CMP_EQ_OQ ) ),
+									_mm256_and_ps( _mm256_cmp_ps( fromZ, toZ, _CMP_EQ_OQ ), _mm256_cmp_ps( fromW, toW, _CMP_EQ_OQ ) ) );
+
+		__m256 cosom = _mm256_mul_ps( fromX, toX );
+		cosom = _mm256_fmadd_ps( fromY, toY, cosom );
+		cosom = _mm256_fmadd_ps( fromZ, toZ, cosom );
+		cosom = _mm256_fmadd_ps( fromW, toW, cosom );
+
+		// take the shortest path
+		__m256 flip = _mm256_and_ps( _mm256_cmp_ps( cosom, zero, _CMP_LT_OQ ), signBit );
+		cosom = _mm256_xor_ps( cosom, flip );
+		__m256 tempX = _mm256_xor_ps( toX, flip );
+		__m256 tempY = _mm256_xor_ps( toY, flip );
+		__m256 tempZ = _mm256_xor_ps( toZ, flip );
+		__m256 tempW = _mm256_xor_ps( toW, flip );
+
+		// omega = atan2( sin( omega ), cos( omega ) ), both are positive so the
+		// smaller over the larger one is in the range [0, 1]
+		__m256 sinSqr = _mm256_fnmadd_ps( cosom, cosom, one );
+		__m256 sinom = ReciprocalSqrt( sinSqr );
+		__m256 sinOmega = _mm256_mul_ps( sinSqr, sinom );
+		__m256 maxSinCos = _mm256_max_ps( sinOmega, cosom );
+		__m256 rcp = _mm256_rcp_ps( maxSinCos );
+		rcp = _mm256_mul_ps( rcp, _mm256_fnmadd_ps( maxSinCos, rcp, two ) );
+		__m256 a = _mm256_mul_ps( _mm256_min_ps( sinOmega, cosom ), rcp );
+		__m256 s = _mm256_mul_ps( a, a );
+		__m256 p = _mm256_set1_ps( 0.0028662257f );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.0161657367f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.0429096138f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.0752896400f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.1065626393f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.1420889944f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( 0.1999355085f ) );
+		p = _mm256_fmadd_ps( p, s, _mm256_set1_ps( -0.3333314528f ) );
+		p = _mm256_fmadd_ps( p, s, one );
+		p = _mm256_mul_ps( p, a );
+		__m256 omega = _mm256_blendv_ps( p, _mm256_sub_ps( halfPi, p ), _mm256_cmp_ps( sinOmega, cosom, _CMP_GT_OQ ) );
+
+		// sine of ( 1 - t ) * omega and t * omega, both in the range [0, PI/2]
+		__m256 a0 = _mm256_mul_ps( oneMinusT, omega );
+		__m256 a1 = _mm256_mul_ps( t, omega );
+		__m256 s0 = _mm256_mul_ps( a0, a0 );
+		__m256 s1 = _mm256_mul_ps( a1, a1 );
+		__m256 p0 = _mm256_set1_ps( -2.39e-08f );
+		__m256 p1 = _mm256_set1_ps( -2.39e-08f );
+		p0 = _mm256_fmadd_ps( p0, s0, _mm256_set1_ps( 2.7526e-06f ) );
+		p1 = _mm256_fmadd_ps( p1, s1, _mm256_set1_ps( 2.7526e-06f ) );
+		p0 = _mm256_fmadd_ps( p0, s0, _mm256_set1_ps( -1.98409e-04f ) );
+		p1 = _mm256_fmadd_ps( p1, s1, _mm256_set1_ps( -1.98409e-04f ) );
+		p0 = _mm256_fmadd_ps( p0, s0, _mm256_set1_ps( 8.3333315e-03f ) );
+		p1 = _mm256_fmadd_ps( p1, s1, _mm256_set1_ps( 8.3333315e-03f ) );
+		p0 = _mm256_fmadd_ps( p0, s0, _mm256_set1_ps( -1.666666664e-01f ) );
+		p1 = _mm256_fmadd_ps( p1, s1, _mm256_set1_ps( -1.666666664e-01f ) );
+		p0 = _mm256_fmadd_ps( p0, s0, one );
+		p1 = _mm256_fmadd_ps( p1, s1, one );
+		__m256 scale0 = _mm256_mul_ps( _mm256_mul_ps( p0, a0 ), sinom );
+		__m256 scale1 = _mm256_mul_ps( _mm256_mul_ps( p1, a1 ), sinom );
+
+		// linear interpolation when the quaternions are very close
+		__m256 linear = _mm256_cmp_ps( _mm256_sub_ps( one, cosom ), _mm256_set1_ps( 1e-6f ), _CMP_LE_OQ );
+		scale0 = _mm256_blendv_ps( scale0, oneMinusT, linear );
+		scale1 = _mm256_blendv_ps( scale1, t, linear );
+
+		__m256 qX = _mm256_blendv_ps( _mm256_fmadd_ps( scale0, fromX, _mm256_mul_ps( scale1, tempX ) ), toX, same );
+		__m256 qY = _mm256_blendv_ps( _mm256_fmadd_ps( scale0, fromY, _mm256_mul_ps( scale1, tempY ) ), toY, same );
+		__m256 qZ = _mm256_blendv_ps( _mm256_fmadd_ps( scale0, fromZ, _mm256_mul_ps( scale1, tempZ ) ), toZ, same );
+		__m256 qW = _mm256_blendv_ps( _mm256_fmadd_ps( scale0, fromW, _mm256_mul_ps( scale1, tempW ) ), toW, same );
+
+		Transpose4x4( qX, qY, qZ, qW );
+		Store2x128( joints[j[0]].q.ToFloatPtr(), joints[j[4]].q.ToFloatPtr(), qX );
+		Store2x128( joints[j[1]].q.ToFloatPtr(), joints[j[5]].q.ToFloatPtr(), qY );
+		Store2x128( joints[j[2]].q.ToFloatPtr(), joints[j[6]].q.ToFloatPtr(), qZ );
+		Store2x128( joints[j[3]].q.ToFloatPtr(), joints[j[7]].q.ToFloatPtr(), qW );
+
+		for ( k = 0; k < 8; k++ ) {
+			joints[j[k]].t.Lerp( joints[j[k]].t, blendJoints[j[k]].t, lerp );
+		}
+	}
+
+	if ( i < numJoints ) {
+		idSIMD_Generic::BlendJoints( joints, blendJoints, lerp, index + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::ConvertJointQuatsToJointMats
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::ConvertJointQuatsToJointMats( idJointMat *jointMats, const idJointQuat *jointQuats, const int numJoints ) {
+	int i, k;
+
+	const __m256 one = _mm256_set1_ps( 1.0f );
+	const __m256i offset = _mm256_mullo_epi32( _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ), _mm256_set1_epi32( JOINTQUAT_FLOATS ) );
+
+	for ( i = 0; i + 8 <= numJoints; i += 8 ) {
+		const float *q = jointQuats[i].q.ToFloatPtr();
+
+		__m256 x = _mm256_i32gather_ps( q + 0, offset, 4 );
+		__m256 y = _mm256_i32gather_ps( q + 1, offset, 4 );
+		__m256 z = _mm256_i32gather_ps( q + 2, offset, 4 );
+		__m256 w = _mm256_i32gather_ps( q + 3, offset, 4 );
+
+		__m256 x2 = _mm256_add_ps( x, x );
+		__m256 y2 = _mm256_add_ps( y, y );
+		__m256 z2 = _mm256_add_ps( z, z );
+
+		__m256 xx = _mm256_mul_ps( x, x2 );
+		__m256 xy = _mm256_mul_ps( x, y2 );
+		__m256 xz = _mm256_mul_ps( x, z2 );
+		__m256 yy = _mm256_mul_ps( y, y2 );
+		__m256 yz = _mm256_mul_ps( y, z2 );
+		__m256 zz = _mm256_mul_ps( z, z2 );
+		__m256 wx = _mm256_mul_ps( w, x2 );
+		__m256 wy = _mm256_mul_ps( w, y2 );
+		__m256 wz = _mm256_mul_ps( w, z2 );
+
+		// the rows of the joint matrix, see idQuat::ToMat3 and idJointMat::SetRotation
+		__m256 m[12];
+		m[ 0] = _mm256_sub_ps( one, _mm256_add_ps( yy, zz ) );
+		m[ 1] = _mm256_add_ps( xy, wz );
+		m[ 2] = _mm256_sub_ps( xz, wy );
+		m[ 3] = _mm256_i32gather_ps( q + 4, offset, 4 );
+		m[ 4] = _mm256_sub_ps( xy, wz );
+		m[ 5] = _mm256_sub_ps( one, _mm256_add_ps( xx, zz ) );
+		m[ 6] = _mm256_add_ps( yz, wx );
+		m[ 7] = _mm256_i32gather_ps( q + 5, offset, 4 );
+		m[ 8] = _mm256_add_ps( xz, wy );
+		m[ 9] = _mm256_sub_ps( yz, wx );
+		m[10] = _mm256_sub_ps( one, _mm256_add_ps( xx, yy ) );
+		m[11] = _mm256_i32gather_ps( q + 6, offset, 4 );
+
+		// transpose back to one matrix row per register and store
+		for ( k = 0; k < 3; k++ ) {
+			Transpose4x4( m[k*4+0], m[k*4+1], m[k*4+2], m[k*4+3] );
+			Store2x128( jointMats[i+0].ToFloatPtr() + k * 4, jointMats[i+4].ToFloatPtr() + k * 4, m[k*4+0] );
+			Store2x128( jointMats[i+1].ToFloatPtr() + k * 4, jointMats[i+5].ToFloatPtr() + k * 4, m[k*4+1] );
+			Store2x128( jointMats[i+2].ToFloatPtr() + k * 4, jointMats[i+6].ToFloatPtr() + k * 4, m[k*4+2] );
+			Store2x128( jointMats[i+3].ToFloatPtr() + k * 4, jointMats[i+7].ToFloatPtr() + k * 4, m[k*4+3] );
+		}
+	}
+
+	if ( i < numJoints ) {
+		idSIMD_Generic::ConvertJointQuatsToJointMats( jointMats + i, jointQuats + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::TransformVerts
+
+  The first two rows of a joint matrix fill a single register so each weight
+  is accumulated with one 8 wide and one 4 wide multiply-add.
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::TransformVerts( idDrawVert *verts, const int numVerts, const idJointMat *joints, const idVec4 *weights, const int *index, const int numWeights ) {
+	int i, j;
+	const byte *jointsPtr = (byte *)joints;
+
+	for( j = i = 0; i < numVerts; i++ ) {
+		const float *m = (const float *) ( jointsPtr + index[j*2+0] );
+		__m256 w = _mm256_broadcast_ps( (const __m128 *) weights[j].ToFloatPtr() );
+		__m256 row01 = _mm256_mul_ps( _mm256_loadu_ps( m + 0 ), w );
+		__m128 row2 = _mm_mul_ps( _mm_loadu_ps( m + 8 ), _mm256_castps256_ps128( w ) );
+
+		while( index[j*2+1] == 0 ) {
+			j++;
+			m = (const float *) ( jointsPtr + index[j*2+0] );
+			w = _mm256_broadcast_ps( (const __m128 *) weights[j].ToFloatPtr() );
+			row01 = _mm256_fmadd_ps( _mm256_loadu_ps( m + 0 ), w, row01 );
+			row2 = _mm_fmadd_ps( _mm_loadu_ps( m + 8 ), _mm256_castps256_ps128( w ), row2 );
+		}
+		j++;
+
+		__m128 xy = _mm_hadd_ps( _mm256_castps256_ps128( row01 ), _mm256_extractf128_ps( row01, 1 ) );
+		__m128 zz = _mm_hadd_ps( row2, row2 );
+		__m128 xyz = _mm_hadd_ps( xy, zz );
+
+		float *v = verts[i].xyz.ToFloatPtr();
+		_mm_storel_pi( (__m64 *) v, xyz );
+		_mm_store_ss( v + 2, _mm_movehl_ps( xyz, xyz ) );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::DeriveTangents
+
+	Derives the normal and orthogonal tangent vectors for the triangle vertices.
+	For each vertex the normal and tangent vectors are derived from all triangles
+	using the vertex which results in smooth tangents across the mesh.
+	In the process the triangle planes are calculated as well.
+
+	The planes and tangents of eight triangles are calculated at once, the sums
+	are accumulated serially in triangle order to get the same results as the
+	generic code when triangles in the same batch share vertices.
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::DeriveTangents( idPlane *planes, idDrawVert *verts, const int numVerts, const int *indexes, const int numIndexes ) {
+	ALIGN16( float result[10][8] );
+	ALIGN16( int remainder[3*8] );
+	int i, k;
+
+	bool *used = (bool *)_alloca16( numVerts * sizeof( used[0] ) );
+	memset( used, 0, numVerts * sizeof( used[0] ) );
+
+	const float *vertsPtr = verts[0].xyz.ToFloatPtr();
+	const int numTris = numIndexes / 3;
+
+	const __m256 signBit = _mm256_set1_ps( -0.0f );
+	const __m256i triOffset = _mm256_setr_epi32( 0, 3, 6, 9, 12, 15, 18, 21 );
+	const __m256i stride = _mm256_set1_epi32( DRAWVERT_FLOATS );
+
+	for ( i = 0; i < numTris; i += 8 ) {
+		const int *indexPtr = indexes + i * 3;
+		const int count = Min( numTris - i, 8 );
+
+		// the last batch is padded with triangles using the first vertex
+		if ( count < 8 ) {
+			memset( remainder, 0, sizeof( remainder ) );
+			memcpy( remainder, indexPtr, count * 3 * sizeof( int ) );
+			indexPtr = remainder;
+		}
+
+		__m256i v0 = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexPtr + 0, triOffset, 4 ), stride );
+		__m256i v1 = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexPtr + 1, triOffset, 4 ), stride );
+		__m256i v2 = _mm256_mullo_epi32( _mm256_i32gather_epi32( indexPtr + 2, triOffset, 4 ), stride );
+
+		__m256 aX = _mm256_i32gather_ps( vertsPtr + 0, v0, 4 );
+		__m256 aY = _mm256_i32gather_ps( vertsPtr + 1, v0, 4 );
+		__m256 aZ = _mm256_i32gather_ps( vertsPtr + 2, v0, 4 );
+		__m256 aS = _mm256_i32gather_ps( vertsPtr + 3, v0, 4 );
+		__m256 aT = _mm256_i32gather_ps( vertsPtr + 4, v0, 4 );
+
+		__m256 d00 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 0, v1, 4 ), aX );
+		__m256 d01 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 1, v1, 4 ), aY );
+		__m256 d02 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 2, v1, 4 ), aZ );
+		__m256 d03 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 3, v1, 4 ), aS );
+		__m256 d04 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 4, v1, 4 ), aT );
+
+		__m256 d10 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 0, v2, 4 ), aX );
+		__m256 d11 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 1, v2, 4 ), aY );
+		__m256 d12 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 2, v2, 4 ), aZ );
+		__m256 d13 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 3, v2, 4 ), aS );
+		__m256 d14 = _mm256_sub_ps( _mm256_i32gather_ps( vertsPtr + 4, v2, 4 ), aT );
+
+		// normal
+		__m256 nX = _mm256_fmsub_ps( d11, d02, _mm256_mul_ps( d12, d01 ) );
+		__m256 nY = _mm256_fmsub_ps( d12, d00, _mm256_mul_ps( d10, d02 ) );
+		__m256 nZ = _mm256_fmsub_ps( d10, d01, _mm256_mul_ps( d11, d00 ) );
+
+		__m256 f = ReciprocalSqrt( _mm256_fmadd_ps( nX, nX, _mm256_fmadd_ps( nY, nY, _mm256_mul_ps( nZ, nZ ) ) ) );
+		nX = _mm256_mul_ps( nX, f );
+		nY = _mm256_mul_ps( nY, f );
+		nZ = _mm256_mul_ps( nZ, f );
+
+		_mm256_storeu_ps( result[0], nX );
+		_mm256_storeu_ps( result[1], nY );
+		_mm256_storeu_ps( result[2], nZ );
+		_mm256_storeu_ps( result[3], _mm256_fmadd_ps( nX, aX, _mm256_fmadd_ps( nY, aY, _mm256_mul_ps( nZ, aZ ) ) ) );
+
+		// area sign bit
+		__m256 area = _mm256_fmsub_ps( d03, d14, _mm256_mul_ps( d04, d13 ) );
+		__m256 areaSign = _mm256_and_ps( area, signBit );
+
+		// first tangent
+		__m256 t0X = _mm256_fmsub_ps( d00, d14, _mm256_mul_ps( d04, d10 ) );
+		__m256 t0Y = _mm256_fmsub_ps( d01, d14, _mm256_mul_ps( d04, d11 ) );
+		__m256 t0Z = _mm256_fmsub_ps( d02, d14, _mm256_mul_ps( d04, d12 ) );
+
+		f = ReciprocalSqrt( _mm256_fmadd_ps( t0X, t0X, _mm256_fmadd_ps( t0Y, t0Y, _mm256_mul_ps( t0Z, t0Z ) ) ) );
+		f = _mm256_xor_ps( f, areaSign );
+
+		_mm256_storeu_ps( result[4], _mm256_mul_ps( t0X, f ) );
+		_mm256_storeu_ps( result[5], _mm256_mul_ps( t0Y, f ) );
+		_mm256_storeu_ps( result[6], _mm256_mul_ps( t0Z, f ) );
+
+		// second tangent
+		__m256 t1X = _mm256_fmsub_ps( d03, d10, _mm256_mul_ps( d00, d13 ) );
+		__m256 t1Y = _mm256_fmsub_ps( d03, d11, _mm256_mul_ps( d01, d13 ) );
+		__m256 t1Z = _mm256_fmsub_ps( d03, d12, _mm256_mul_ps( d02, d13 ) );
+
+		f = ReciprocalSqrt( _mm256_fmadd_ps( t1X, t1X, _mm256_fmadd_ps( t1Y, t1Y, _mm256_mul_ps( t1Z, t1Z ) ) ) );
+		f = _mm256_xor_ps( f, areaSign );
+
+		_mm256_storeu_ps( result[7], _mm256_mul_ps( t1X, f ) );
+		_mm256_storeu_ps( result[8], _mm256_mul_ps( t1Y, f ) );
+		_mm256_storeu_ps( result[9], _mm256_mul_ps( t1Z, f ) );
+
+		for ( k = 0; k < count; k++ ) {
+			idVec3 n( result[0][k], result[1][k], result[2][k] );
+			idVec3 t0( result[4][k], result[5][k], result[6][k] );
+			idVec3 t1( result[7][k], result[8][k], result[9][k] );
+
+			planes->SetNormal( n );
+			planes->SetDist( result[3][k] );
+			planes++;
+
+			for ( int l = 0; l < 3; l++ ) {
+				int vi = indexPtr[k*3+l];
+				idDrawVert *a = verts + vi;
+
+				if ( used[vi] ) {
+					a->normal += n;
+					a->tangents[0] += t0;
+					a->tangents[1] += t1;
+				} else {
+					a->normal = n;
+					a->tangents[0] = t0;
+					a->tangents[1] = t1;
+					used[vi] = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::CreateShadowCache
+
+  The remap table is tested eight vertices at a time so runs of vertices that
+  are already in the cache are skipped without branching per vertex.
+============
+*/
+AVX2_FUNC int VPCALL idSIMD_AVX2::CreateShadowCache( idVec4 *vertexCache, int *vertRemap, const idVec3 &lightOrigin, const idDrawVert *verts, const int numVerts ) {
+	int i, k, outVerts = 0;
+
+	const __m128 oneW = _mm_setr_ps( 0.0f, 0.0f, 0.0f, 1.0f );
+	const __m128 light = _mm_setr_ps( lightOrigin.x, lightOrigin.y, lightOrigin.z, 1.0f );
+
+	for ( i = 0; i < numVerts; i += 8 ) {
+		int mask;
+
+		if ( i + 8 <= numVerts ) {
+			__m256i remap = _mm256_loadu_si256( (const __m256i *)( vertRemap + i ) );
+			mask = _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( remap, _mm256_setzero_si256() ) ) );
+		} else {
+			mask = 0;
+			for ( k = 0; i + k < numVerts; k++ ) {
+				mask |= ( vertRemap[i+k] == 0 ) << k;
+			}
+		}
+
+		for ( k = 0; mask != 0; k++, mask >>= 1 ) {
+			if ( !( mask & 1 ) ) {
+				continue;
+			}
+
+			// the fourth float is the first texture coordinate and is replaced with 1
+			__m128 v = _mm_loadu_ps( verts[i+k].xyz.ToFloatPtr() );
+			v = _mm_blend_ps( v, oneW, 8 );
+
+			// R_SetupProjection() builds the projection matrix with a slight crunch
+			// for depth, which keeps this w=0 division from rasterizing right at the
+			// wrap around point and causing depth fighting with the rear caps
+			__m128 p = _mm_sub_ps( v, light );
+
+			_mm256_storeu_ps( vertexCache[outVerts].ToFloatPtr(), _mm256_insertf128_ps( _mm256_castps128_ps256( v ), p, 1 ) );
+			vertRemap[i+k] = outVerts;
+			outVerts += 2;
+		}
+	}
+	return outVerts;
+}
+
+/*
+============
+MixSoundSixSpeaker
+
+  Four samples of six speakers fill three registers. The speaker volumes are
+  laid out the same way and advanced four samples per iteration.
+============
+*/
+AVX2_INLINE void MixSoundSixSpeaker( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6], const bool stereo ) {
+	ALIGN16( float volume[24] );
+	ALIGN16( float increment[24] );
+	int i;
+
+	assert( numSamples == MIXBUFFER_SAMPLES );
+
+	for ( i = 0; i < 24; i++ ) {
+		float inc = ( currentV[i%6] - lastV[i%6] ) / MIXBUFFER_SAMPLES;
+		volume[i] = lastV[i%6] + ( i / 6 ) * inc;
+		increment[i] = 4.0f * inc;
+	}
+
+	__m256 vol0 = _mm256_loadu_ps( volume + 0 );
+	__m256 vol1 = _mm256_loadu_ps( volume + 8 );
+	__m256 vol2 = _mm256_loadu_ps( volume + 16 );
+	const __m256 inc0 = _mm256_loadu_ps( increment + 0 );
+	const __m256 inc1 = _mm256_loadu_ps( increment + 8 );
+	const __m256 inc2 = _mm256_loadu_ps( increment + 16 );
+
+	// the speakers read the left, right, left, left, left and right channel of a stereo sample
+	const __m256i index0 = stereo ? _mm256_setr_epi32( 0, 1, 0, 0, 0, 1, 2, 3 ) : _mm256_setr_epi32( 0, 0, 0, 0, 0, 0, 1, 1 );
+	const __m256i index1 = stereo ? _mm256_setr_epi32( 2, 2, 2, 3, 4, 5, 4, 4 ) : _mm256_setr_epi32( 1, 1, 1, 1, 2, 2, 2, 2 );
+	const __m256i index2 = stereo ? _mm256_setr_epi32( 4, 5, 6, 7, 6, 6, 6, 7 ) : _mm256_setr_epi32( 2, 2, 3, 3, 3, 3, 3, 3 );
+
+	for ( i = 0; i < MIXBUFFER_SAMPLES; i += 4 ) {
+		__m256 s;
+		if ( stereo ) {
+			s = _mm256_loadu_ps( samples + i * 2 );
+		} else {
+			s = _mm256_castps128_ps256( _mm_loadu_ps( samples + i ) );
+		}
+
+		float *mix = mixBuffer + i * 6;
+		_mm256_storeu_ps( mix + 0, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, index0 ), vol0, _mm256_loadu_ps( mix + 0 ) ) );
+		_mm256_storeu_ps( mix + 8, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, index1 ), vol1, _mm256_loadu_ps( mix + 8 ) ) );
+		_mm256_storeu_ps( mix + 16, _mm256_fmadd_ps( _mm256_permutevar8x32_ps( s, index2 ), vol2, _mm256_loadu_ps( mix + 16 ) ) );
+
+		vol0 = _mm256_add_ps( vol0, inc0 );
+		vol1 = _mm256_add_ps( vol1, inc1 );
+		vol2 = _mm256_add_ps( vol2, inc2 );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundSixSpeakerMono
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::MixSoundSixSpeakerMono( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	MixSoundSixSpeaker( mixBuffer, samples, numSamples, lastV, currentV, false );
+}
+
+/*
+============
+idSIMD_AVX2::MixSoundSixSpeakerStereo
+============
+*/
+AVX2_FUNC void VPCALL idSIMD_AVX2::MixSoundSixSpeakerStereo( float *mixBuffer, const float *samples, const int numSamples, const float lastV[6], const float currentV[6] ) {
+	MixSoundSixSpeaker( mixBuffer, samples, numSamples, lastV, currentV, true );
+}
+
+#endif /* _WIN32 || __i386__ || __x86_64__ */
@@ -2437,6 +2437,70 @@ void VPCALL idSIMD_Generic::OverlayPointCull( byte *cullBits, idVec2 *texCoords,
 	}
 }
 
+/*
+============
+idSIMD_Generic::CullBoxes
+
+The box is culled by a plane if the center distance is larger than the
+projection of the transformed half axes on the plane normal, which is
+the same as all eight transformed corners being in front of the plane.
+============
+*/
+void VPCALL idSIMD_Generic::CullBoxes( byte *culled, const idPlane *planes, const int numPlanes, const idBounds * const *bounds, const float * const *modelMatrices, const int numBoxes ) {
+	int i, j;
+
+	for ( i = 0; i < numBoxes; i++ ) {
+		const idBounds &b = *bounds[i];
+		const float *m = modelMatrices[i];
+		idVec3 localCenter, center, axis[3];
+		float extents[3];
+
+		for ( j = 0; j < 3; j++ ) {
+			localCenter[j] = ( b[0][j] + b[1][j] ) * 0.5f;
+			extents[j] = ( b[1][j] - b[0][j] ) * 0.5f;
+		}
+
+		// transform into world space
+		for ( j = 0; j < 3; j++ ) {
+			center[j] = localCenter[0] * m[0*4+j] + localCenter[1] * m[1*4+j] + localCenter[2] * m[2*4+j] + m[3*4+j];
+			axis[j][0] = m[j*4+0] * extents[j];
+			axis[j][1] = m[j*4+1] * extents[j];
+			axis[j][2] = m[j*4+2] * extents[j];
+		}
+
+		culled[i] = 0;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const idPlane &p = planes[j];
+			float d, r;
+
+			d = p[0] * center[0] + p[1] * center[1] + p[2] * center[2] + p[3];
+			r = idMath::Fabs( p[0] * axis[0][0] + p[1] * axis[0][1] + p[2] * axis[0][2] );
+			r += idMath::Fabs( p[0] * axis[1][0] + p[1] * axis[1][1] + p[2] * axis[1][2] );
+			r += idMath::Fabs( p[0] * axis[2][0] + p[1] * axis[2][1] + p[2] * axis[2][2] );
+			if ( d - r >= 0.0f ) {
+				culled[i] = 1;
+				break;
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_Generic::OverlapBounds
+============
+*/
+void VPCALL idSIMD_Generic::OverlapBounds( byte *overlap, const idBounds &bounds, const idBounds *boundsList, const int count ) {
+	int i;
+
+	for ( i = 0; i < count; i++ ) {
+		const idBounds &b = boundsList[i];
+		overlap[i] = !(	b[0][0] > bounds[1][0] || b[1][0] < bounds[0][0] ||
+						b[0][1] > bounds[1][1] || b[1][1] < bounds[0][1] ||
+						b[0][2] > bounds[1][2] || b[1][2] < bounds[0][2] );
+	}
+}
+
 /*
 ============
 idSIMD_Generic::DeriveTriPlanes
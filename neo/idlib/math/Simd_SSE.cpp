@@ -18085,3 +18085,157 @@ void VPCALL idSIMD_SSE::MixedSoundToSamples( short *samples, const float *mixBuf
 }
 
 #endif /* _WIN32 */
+
+
+#if defined(_WIN32) || defined(__i386__) || defined(__x86_64__)
+
+#include <xmmintrin.h>
+
+/*
+	GCC only allows the SSE intrinsics in functions compiled for SSE, and the
+	32 bit build does not enable it for the whole file.  The functions are
+	tagged individually like the AVX2 functions in Simd_AVX2.cpp.
+*/
+#if defined(__GNUC__)
+#define SSE_FUNC					__attribute__ ((target ("sse")))
+#else
+#define SSE_FUNC
+#endif
+
+/*
+============
+idSIMD_SSE::CullBoxes
+
+Four boxes are gathered in structure of arrays form and transformed
+together, then each plane is tested against all four at once.
+============
+*/
+SSE_FUNC void VPCALL idSIMD_SSE::CullBoxes( byte *culled, const idPlane *planes, const int numPlanes, const idBounds * const *bounds, const float * const *modelMatrices, const int numBoxes ) {
+	ALIGN16( float soa[18][4] );
+	int i, j, k;
+
+	const __m128 half = _mm_set1_ps( 0.5f );
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signBit = _mm_set1_ps( -0.0f );
+
+	for ( i = 0; i + 4 <= numBoxes; i += 4 ) {
+
+		// gather the bounds and matrices, rows 6-17 hold the matrix without the fourth column
+		for ( k = 0; k < 4; k++ ) {
+			const idBounds &b = *bounds[i+k];
+			const float *m = modelMatrices[i+k];
+
+			soa[ 0][k] = b[0][0];
+			soa[ 1][k] = b[0][1];
+			soa[ 2][k] = b[0][2];
+			soa[ 3][k] = b[1][0];
+			soa[ 4][k] = b[1][1];
+			soa[ 5][k] = b[1][2];
+			for ( j = 0; j < 4; j++ ) {
+				soa[ 6+j*3+0][k] = m[j*4+0];
+				soa[ 6+j*3+1][k] = m[j*4+1];
+				soa[ 6+j*3+2][k] = m[j*4+2];
+			}
+		}
+
+		__m128 minX = _mm_load_ps( soa[0] );
+		__m128 minY = _mm_load_ps( soa[1] );
+		__m128 minZ = _mm_load_ps( soa[2] );
+		__m128 maxX = _mm_load_ps( soa[3] );
+		__m128 maxY = _mm_load_ps( soa[4] );
+		__m128 maxZ = _mm_load_ps( soa[5] );
+
+		__m128 localX = _mm_mul_ps( _mm_add_ps( minX, maxX ), half );
+		__m128 localY = _mm_mul_ps( _mm_add_ps( minY, maxY ), half );
+		__m128 localZ = _mm_mul_ps( _mm_add_ps( minZ, maxZ ), half );
+		__m128 extentX = _mm_mul_ps( _mm_sub_ps( maxX, minX ), half );
+		__m128 extentY = _mm_mul_ps( _mm_sub_ps( maxY, minY ), half );
+		__m128 extentZ = _mm_mul_ps( _mm_sub_ps( maxZ, minZ ), half );
+
+		// transform the center into world space
+		__m128 centerX = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( localX, _mm_load_ps( soa[ 6] ) ), _mm_mul_ps( localY, _mm_load_ps( soa[ 9] ) ) ), _mm_mul_ps( localZ, _mm_load_ps( soa[12] ) ) ), _mm_load_ps( soa[15] ) );
+		__m128 centerY = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( localX, _mm_load_ps( soa[ 7] ) ), _mm_mul_ps( localY, _mm_load_ps( soa[10] ) ) ), _mm_mul_ps( localZ, _mm_load_ps( soa[13] ) ) ), _mm_load_ps( soa[16] ) );
+		__m128 centerZ = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( localX, _mm_load_ps( soa[ 8] ) ), _mm_mul_ps( localY, _mm_load_ps( soa[11] ) ) ), _mm_mul_ps( localZ, _mm_load_ps( soa[14] ) ) ), _mm_load_ps( soa[17] ) );
+
+		// the world space half axes
+		__m128 axis0X = _mm_mul_ps( _mm_load_ps( soa[ 6] ), extentX );
+		__m128 axis0Y = _mm_mul_ps( _mm_load_ps( soa[ 7] ), extentX );
+		__m128 axis0Z = _mm_mul_ps( _mm_load_ps( soa[ 8] ), extentX );
+		__m128 axis1X = _mm_mul_ps( _mm_load_ps( soa[ 9] ), extentY );
+		__m128 axis1Y = _mm_mul_ps( _mm_load_ps( soa[10] ), extentY );
+		__m128 axis1Z = _mm_mul_ps( _mm_load_ps( soa[11] ), extentY );
+		__m128 axis2X = _mm_mul_ps( _mm_load_ps( soa[12] ), extentZ );
+		__m128 axis2Y = _mm_mul_ps( _mm_load_ps( soa[13] ), extentZ );
+		__m128 axis2Z = _mm_mul_ps( _mm_load_ps( soa[14] ), extentZ );
+
+		__m128 cull = zero;
+		for ( j = 0; j < numPlanes; j++ ) {
+			const __m128 nx = _mm_set1_ps( planes[j][0] );
+			const __m128 ny = _mm_set1_ps( planes[j][1] );
+			const __m128 nz = _mm_set1_ps( planes[j][2] );
+			const __m128 nd = _mm_set1_ps( planes[j][3] );
+
+			__m128 d = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, centerX ), _mm_mul_ps( ny, centerY ) ), _mm_mul_ps( nz, centerZ ) ), nd );
+			__m128 r0 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, axis0X ), _mm_mul_ps( ny, axis0Y ) ), _mm_mul_ps( nz, axis0Z ) );
+			__m128 r1 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, axis1X ), _mm_mul_ps( ny, axis1Y ) ), _mm_mul_ps( nz, axis1Z ) );
+			__m128 r2 = _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, axis2X ), _mm_mul_ps( ny, axis2Y ) ), _mm_mul_ps( nz, axis2Z ) );
+			__m128 r = _mm_add_ps( _mm_add_ps( _mm_andnot_ps( signBit, r0 ), _mm_andnot_ps( signBit, r1 ) ), _mm_andnot_ps( signBit, r2 ) );
+
+			cull = _mm_or_ps( cull, _mm_cmpge_ps( _mm_sub_ps( d, r ), zero ) );
+			if ( _mm_movemask_ps( cull ) == 15 ) {
+				break;
+			}
+		}
+
+		int mask = _mm_movemask_ps( cull );
+		culled[i+0] = ( mask >> 0 ) & 1;
+		culled[i+1] = ( mask >> 1 ) & 1;
+		culled[i+2] = ( mask >> 2 ) & 1;
+		culled[i+3] = ( mask >> 3 ) & 1;
+	}
+
+	if ( i < numBoxes ) {
+		idSIMD_Generic::CullBoxes( culled + i, planes, numPlanes, bounds + i, modelMatrices + i, numBoxes - i );
+	}
+}
+
+/*
+============
+idSIMD_SSE::OverlapBounds
+
+The six floats of a bounds are read with two overlapping loads, the first
+holds the minimum and the second the maximum in its upper three lanes.
+The unused lane of each compare is set up to never reject.
+============
+*/
+SSE_FUNC void VPCALL idSIMD_SSE::OverlapBounds( byte *overlap, const idBounds &bounds, const idBounds *boundsList, const int count ) {
+	int i;
+
+	const __m128 boundsMax = _mm_setr_ps( bounds[1][0], bounds[1][1], bounds[1][2], idMath::INFINITY );
+	const __m128 boundsMin = _mm_setr_ps( -idMath::INFINITY, bounds[0][0], bounds[0][1], bounds[0][2] );
+
+	for ( i = 0; i + 4 <= count; i += 4 ) {
+		const float *b0 = boundsList[i+0][0].ToFloatPtr();
+		const float *b1 = boundsList[i+1][0].ToFloatPtr();
+		const float *b2 = boundsList[i+2][0].ToFloatPtr();
+		const float *b3 = boundsList[i+3][0].ToFloatPtr();
+
+		__m128 r0 = _mm_or_ps( _mm_cmpgt_ps( _mm_loadu_ps( b0 ), boundsMax ), _mm_cmplt_ps( _mm_loadu_ps( b0 + 2 ), boundsMin ) );
+		__m128 r1 = _mm_or_ps( _mm_cmpgt_ps( _mm_loadu_ps( b1 ), boundsMax ), _mm_cmplt_ps( _mm_loadu_ps( b1 + 2 ), boundsMin ) );
+		__m128 r2 = _mm_or_ps( _mm_cmpgt_ps( _mm_loadu_ps( b2 ), boundsMax ), _mm_cmplt_ps( _mm_loadu_ps( b2 + 2 ), boundsMin ) );
+		__m128 r3 = _mm_or_ps( _mm_cmpgt_ps( _mm_loadu_ps( b3 ), boundsMax ), _mm_cmplt_ps( _mm_loadu_ps( b3 + 2 ), boundsMin ) );
+
+		overlap[i+0] = ( _mm_movemask_ps( r0 ) == 0 );
+		overlap[i+1] = ( _mm_movemask_ps( r1 ) == 0 );
+		overlap[i+2] = ( _mm_movemask_ps( r2 ) == 0 );
+		overlap[i+3] = ( _mm_movemask_ps( r3 ) == 0 );
+	}
+
+	for ( ; i < count; i++ ) {
+		const float *b = boundsList[i][0].ToFloatPtr();
+		__m128 r = _mm_or_ps( _mm_cmpgt_ps( _mm_loadu_ps( b ), boundsMax ), _mm_cmplt_ps( _mm_loadu_ps( b + 2 ), boundsMin ) );
+		overlap[i] = ( _mm_movemask_ps( r ) == 0 );
+	}
+}
+
+#endif /* _WIN32 || __i386__ || __x86_64__ */
@@ -138,6 +138,12 @@ public:
 	virtual void VPCALL MixedSoundToSamples( short *samples, const float *mixBuffer, const int numSamples );
 
 #endif
+
+#if defined(_WIN32) || defined(__i386__) || defined(__x86_64__)
+	// written with intrinsics so it is shared by all x86 compilers
+	virtual void VPCALL CullBoxes( byte *culled, const idPlane *planes, const int numPlanes, const idBounds * const *bounds, const float * const *modelMatrices, const int numBoxes );
+	virtual void VPCALL OverlapBounds( byte *overlap, const idBounds &bounds, const idBounds *boundsList, const int count );
+#endif
 };
 
 #endif /* !__MATH_SIMD_SSE_H__ */
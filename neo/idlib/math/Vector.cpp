@@ -383,9 +383,9 @@ const char *idVec6::ToString( int precision ) const {
 //
 //===============================================================
 
-float	idVecX::temp[VECX_MAX_TEMP+4];
-float *	idVecX::tempPtr = (float *) ( ( (int) idVecX::temp + 15 ) & ~15 );
-int		idVecX::tempIndex = 0;
+ID_THREAD_LOCAL_IF_AVAILABLE float	idVecX::temp[VECX_MAX_TEMP+4];
+ID_THREAD_LOCAL_IF_AVAILABLE float *	idVecX::tempPtr = NULL;
+ID_THREAD_LOCAL_IF_AVAILABLE int		idVecX::tempIndex = 0;
 
 /*
 =============
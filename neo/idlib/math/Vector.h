@@ -1494,9 +1494,10 @@ private:
 	int				alloced;				// if -1 p points to data set with SetData
 	float *			p;						// memory the vector is stored
 
-	static float	temp[VECX_MAX_TEMP+4];	// used to store intermediate results
-	static float *	tempPtr;				// pointer to 16 byte aligned temporary memory
-	static int		tempIndex;				// index into memory pool, wraps around
+	// the memory pool is per thread where available so vectors can be used in parallel jobs
+	static ID_THREAD_LOCAL_IF_AVAILABLE float	temp[VECX_MAX_TEMP+4];	// used to store intermediate results
+	static ID_THREAD_LOCAL_IF_AVAILABLE float *	tempPtr;				// pointer to 16 byte aligned temporary memory, set on first use
+	static ID_THREAD_LOCAL_IF_AVAILABLE int		tempIndex;				// index into memory pool, wraps around
 
 private:
 	void			SetTempSize( int size );
@@ -1745,6 +1746,9 @@ ID_INLINE void idVecX::SetTempSize( int newSize ) {
 	size = newSize;
 	alloced = ( newSize + 3 ) & ~3;
 	assert( alloced < VECX_MAX_TEMP );
+	if ( idVecX::tempPtr == NULL ) {
+		idVecX::tempPtr = (float *) ( ( (int) idVecX::temp + 15 ) & ~15 );
+	}
 	if ( idVecX::tempIndex + alloced > VECX_MAX_TEMP ) {
 		idVecX::tempIndex = 0;
 	}
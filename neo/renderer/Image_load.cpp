@@ -1456,6 +1456,9 @@ void idImage::UploadPrecompressedImage( byte *data, int len ) {
 	header->ddspf.dwBBitMask = LittleLong( header->ddspf.dwBBitMask );
 	header->ddspf.dwABitMask = LittleLong( header->ddspf.dwABitMask );
 
+	// the main thread needs the context back from the back end thread
+	R_SyncBackEnd();
+
 	// generate the texture number
 	qglGenTextures( 1, &texnum );
 
@@ -1671,6 +1674,9 @@ PurgeImage
 ===============
 */
 void idImage::PurgeImage() {
+	// the main thread needs the context back from the back end thread
+	R_SyncBackEnd();
+
 	if ( texnum != TEXTURE_NOT_LOADED ) {
 		// sometimes is NULL when exiting with an error
 		if ( qglDeleteTextures ) {
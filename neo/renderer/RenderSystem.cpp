@@ -112,6 +112,12 @@ static void R_PerformanceCounters( void ) {
 	if ( r_showLightScale.GetBool() ) {
 		common->Printf( "lightScale: %f\n", backEnd.pc.maxLightValue );
 	}
+	if ( r_showFrontEndJobs.GetBool() ) {
+		R_ReportFrontEndJobs();
+	}
+	if ( r_showSmp.GetBool() ) {
+		R_ReportSmp();
+	}
 
 	memset( &tr.pc, 0, sizeof( tr.pc ) );
 	memset( &backEnd.pc, 0, sizeof( backEnd.pc ) );
@@ -142,7 +148,7 @@ static void R_IssueRenderCommands( void ) {
 	// r_skipRender is usually more usefull, because it will still
 	// draw 2D graphics
 	if ( !r_skipBackEnd.GetBool() ) {
-		RB_ExecuteBackEndCommands( frameData->cmdHead );
+		R_IssueBackEndCommands( frameData->cmdHead );
 	}
 
 	R_ClearCommandChain();
@@ -716,6 +722,10 @@ void idRenderSystemLocal::EndFrame( int *frontEndMsec, int *backEndMsec ) {
 	guiModel->EmitFullScreen();
 	guiModel->Clear();
 
+	// wait for the back end thread to finish the previous frame, so its
+	// counters are complete and its frameData can be reused
+	R_SyncBackEnd();
+
 	// save out timing information
 	if ( frontEndMsec ) {
 		*frontEndMsec = pc.frontEndMsec;
@@ -959,6 +969,7 @@ void idRenderSystemLocal::CaptureRenderToFile( const char *fileName, bool fixAlp
 	guiModel->EmitFullScreen();
 	guiModel->Clear();
 	R_IssueRenderCommands();
+	R_SyncBackEnd();
 
 	qglReadBuffer( GL_BACK );
 
@@ -116,6 +116,7 @@ idCVar r_ignore( "r_ignore", "0", CVAR_RENDERER, "used for random debugging with
 idCVar r_ignore2( "r_ignore2", "0", CVAR_RENDERER, "used for random debugging without defining new vars" );
 idCVar r_usePreciseTriangleInteractions( "r_usePreciseTriangleInteractions", "0", CVAR_RENDERER | CVAR_BOOL, "1 = do winding clipping to determine if each ambiguous tri should be lit" );
 idCVar r_useCulling( "r_useCulling", "2", CVAR_RENDERER | CVAR_INTEGER, "0 = none, 1 = sphere, 2 = sphere + box", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
+idCVar r_useBatchCulling( "r_useBatchCulling", "1", CVAR_RENDERER | CVAR_BOOL, "cull reference bounds in batches with the SIMD processor" );
 idCVar r_useLightCulling( "r_useLightCulling", "3", CVAR_RENDERER | CVAR_INTEGER, "0 = none, 1 = box, 2 = exact clip of polyhedron faces, 3 = also areas", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar r_useLightScissors( "r_useLightScissors", "1", CVAR_RENDERER | CVAR_BOOL, "1 = use custom scissor rectangle for each light" );
 idCVar r_useClippedLightScissors( "r_useClippedLightScissors", "1", CVAR_RENDERER | CVAR_INTEGER, "0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
@@ -150,6 +151,8 @@ idCVar r_useOptimizedShadows( "r_useOptimizedShadows", "1", CVAR_RENDERER | CVAR
 idCVar r_useScissor( "r_useScissor", "1", CVAR_RENDERER | CVAR_BOOL, "scissor clip as portals and lights are processed" );
 idCVar r_useCombinerDisplayLists( "r_useCombinerDisplayLists", "1", CVAR_RENDERER | CVAR_BOOL | CVAR_NOCHEAT, "put all nvidia register combiner programming in display lists" );
 idCVar r_useDepthBoundsTest( "r_useDepthBoundsTest", "1", CVAR_RENDERER | CVAR_BOOL, "use depth bounds test to reduce shadow fill" );
+idCVar r_smp( "r_smp", "0", CVAR_RENDERER | CVAR_BOOL | CVAR_ARCHIVE, "run the back end in its own thread, overlapped with the next frame's front end, takes effect on vid_restart" );
+idCVar r_frontEndJobs( "r_frontEndJobs", "0", CVAR_RENDERER | CVAR_INTEGER, "number of jobs besides the main thread for the light and model setup, 0 = serial", 0, MAX_FRONTEND_THREADS - 1, idCmdSystem::ArgCompletion_Integer<0,MAX_FRONTEND_THREADS-1> );
 
 idCVar r_screenFraction( "r_screenFraction", "100", CVAR_RENDERER | CVAR_INTEGER, "for testing fill rate, the resolution of the entire screen can be changed" );
 idCVar r_demonstrateBug( "r_demonstrateBug", "0", CVAR_RENDERER | CVAR_BOOL, "used during development to show IHV's their problems" );
@@ -175,7 +178,7 @@ idCVar r_showDefs( "r_showDefs", "0", CVAR_RENDERER | CVAR_BOOL, "report the num
 idCVar r_showTrace( "r_showTrace", "0", CVAR_RENDERER | CVAR_INTEGER, "show the intersection of an eye trace with the world", idCmdSystem::ArgCompletion_Integer<0,2> );
 idCVar r_showIntensity( "r_showIntensity", "0", CVAR_RENDERER | CVAR_BOOL, "draw the screen colors based on intensity, red = 0, green = 128, blue = 255" );
 idCVar r_showImages( "r_showImages", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = show all images instead of rendering, 2 = show in proportional size", 0, 2, idCmdSystem::ArgCompletion_Integer<0,2> );
-idCVar r_showSmp( "r_showSmp", "0", CVAR_RENDERER | CVAR_BOOL, "show which end (front or back) is blocking" );
+idCVar r_showSmp( "r_showSmp", "0", CVAR_RENDERER | CVAR_BOOL, "report back end, stall and overlap times for the back end thread" );
 idCVar r_showLights( "r_showLights", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = just print volumes numbers, highlighting ones covering the view, 2 = also draw planes of each volume, 3 = also draw edges of each volume", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar r_showShadows( "r_showShadows", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = visualize the stencil shadow volumes, 2 = draw filled in", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar r_showShadowCount( "r_showShadowCount", "0", CVAR_RENDERER | CVAR_INTEGER, "colors screen based on shadow volume depth complexity, >= 2 = print overdraw count based on stencil index values, 3 = only show turboshadows, 4 = only show static shadows", 0, 4, idCmdSystem::ArgCompletion_Integer<0,4> );
@@ -199,6 +202,7 @@ idCVar r_showTexturePolarity( "r_showTexturePolarity", "0", CVAR_RENDERER | CVAR
 idCVar r_showTangentSpace( "r_showTangentSpace", "0", CVAR_RENDERER | CVAR_INTEGER, "shade triangles by tangent space, 1 = use 1st tangent vector, 2 = use 2nd tangent vector, 3 = use normal vector", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 idCVar r_showDominantTri( "r_showDominantTri", "0", CVAR_RENDERER | CVAR_BOOL, "draw lines from vertexes to center of dominant triangles" );
 idCVar r_showAlloc( "r_showAlloc", "0", CVAR_RENDERER | CVAR_BOOL, "report alloc/free counts" );
+idCVar r_showFrontEndJobs( "r_showFrontEndJobs", "0", CVAR_RENDERER | CVAR_BOOL, "report light and model setup time for serial and job modes" );
 idCVar r_showTextureVectors( "r_showTextureVectors", "0", CVAR_RENDERER | CVAR_FLOAT, " if > 0 draw each triangles texture (tangent) vectors" );
 idCVar r_showOverDraw( "r_showOverDraw", "0", CVAR_RENDERER | CVAR_INTEGER, "1 = geometry overdraw, 2 = light interaction overdraw, 3 = geometry and light interaction overdraw", 0, 3, idCmdSystem::ArgCompletion_Integer<0,3> );
 
@@ -695,6 +699,10 @@ void R_InitOpenGL( void ) {
 	cmdSystem->AddCommand( "reloadARBprograms", R_ReloadARBPrograms_f, CMD_FL_RENDERER, "reloads ARB programs" );
 	R_ReloadARBPrograms_f( idCmdArgs() );
 
+	// start the back end thread before the vertex cache, which can't
+	// use vertex buffer objects with it
+	R_InitBackEndThread();
+
 	// allocate the vertex array range or vertex objects
 	vertexCache.Init();
 
@@ -1068,6 +1076,7 @@ R_RenderingFPS
 ================
 */
 static float R_RenderingFPS( const renderView_t *renderView ) {
+	R_SyncBackEnd();
 	qglFinish();
 
 	int		start = Sys_Milliseconds();
@@ -1080,6 +1089,7 @@ static float R_RenderingFPS( const renderView_t *renderView ) {
 		renderSystem->BeginFrame( glConfig.vidWidth, glConfig.vidHeight );
 		tr.primaryWorld->RenderScene( renderView );
 		renderSystem->EndFrame( NULL, NULL );
+		R_SyncBackEnd();
 		qglFinish();
 		count++;
 		end = Sys_Milliseconds();
@@ -1177,6 +1187,9 @@ void R_ReadTiledPixels( int width, int height, byte *buffer, renderView_t *ref =
 				session->UpdateScreen();
 			}
 
+			// the tile has to be finished before it can be read back
+			R_SyncBackEnd();
+
 			int w = oldWidth;
 			if ( xo + w > width ) {
 				w = width - xo;
@@ -1422,6 +1435,7 @@ void R_StencilShot( void ) {
 
 	byte *byteBuffer = (byte *)Mem_Alloc(pix);
 
+	R_SyncBackEnd();
 	qglReadPixels( 0, 0, width, height, GL_STENCIL_INDEX , GL_UNSIGNED_BYTE, byteBuffer ); 
 
 	for ( i = 0 ; i < pix ; i++ ) {
@@ -1880,6 +1894,9 @@ void R_VidRestart_f( const idCmdArgs &args ) {
 		return;
 	}
 
+	// the back end thread must be idle while everything is freed
+	R_SyncBackEnd();
+
 	bool full = true;
 	bool forceWindow = false;
 	for ( int i = 1 ; i < args.Argc() ; i++ ) {
@@ -1917,6 +1934,7 @@ void R_VidRestart_f( const idCmdArgs &args ) {
 		Sys_ShutdownInput();
 		globalImages->PurgeAllImages();
 		// free the context and close the window
+		R_ShutdownBackEndThread();
 		GLimp_Shutdown();
 		glConfig.isInitialized = false;
 
@@ -2148,6 +2166,9 @@ void idRenderSystemLocal::Init( void ) {
 
 	R_InitTriSurfData();
 
+	// allocate the job list for the front end view setup
+	R_InitFrontEndJobs();
+
 	globalImages->Init();
 
 	idCinematic::InitCinematic( );
@@ -2199,6 +2220,9 @@ void idRenderSystemLocal::Shutdown( void ) {
 		logFile = 0;
 	}
 
+	// free the front end job list before the frame arenas go away
+	R_ShutdownFrontEndJobs();
+
 	// free frame memory
 	R_ShutdownFrameData();
 
@@ -2268,6 +2292,7 @@ idRenderSystemLocal::ShutdownOpenGL
 */
 void idRenderSystemLocal::ShutdownOpenGL( void ) {
 	// free the context and close the window
+	R_ShutdownBackEndThread();
 	R_ShutdownFrameData();
 	GLimp_Shutdown();
 	glConfig.isInitialized = false;
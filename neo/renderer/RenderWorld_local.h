@@ -33,6 +33,15 @@ If you have questions concerning this license or the applicable additional terms
 const int LUDICROUS_INDEX	= 10000;
 
 
+// an entity in one of the areas touched by a light, as found by idRenderWorldLocal::FindLightDefInteractions
+typedef struct {
+	idRenderEntityLocal *	entityDef;
+	idInteraction *			interaction;	// NULL if the interaction did not exist yet
+	bool					skipUnviewed;	// skip the entity if it isn't in view by the time it is linked
+	bool					culled;			// reference bounds are outside the light frustum
+} lightEntityRef_t;
+
+
 typedef struct portal_s {
 	int						intoArea;		// area this portal leads to
 	idWinding *				w;				// winding points have counter clockwise ordering seen this area
@@ -257,6 +266,12 @@ public:
 	//-------------------------------
 	// tr_light.c
 	void					CreateLightDefInteractions( idRenderLightLocal *ldef );
+
+	// the same work split for the front end jobs, the find pass only reads the world
+	// and can run on any thread, the link pass must run on the main thread
+	int						FindLightDefInteractions( const idRenderLightLocal *ldef, lightEntityRef_t *refs ) const;
+	void					CullLightDefEntityRefs( const idRenderLightLocal *ldef, lightEntityRef_t *refs, int numRefs ) const;
+	void					LinkLightDefInteractions( idRenderLightLocal *ldef, const lightEntityRef_t *refs, int numRefs );
 };
 
 #endif /* !__RENDERWORLDLOCAL_H__ */
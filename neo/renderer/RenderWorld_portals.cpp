@@ -586,6 +586,9 @@ AddAreaEntityRefs
 
 Any models that are visible through the current portalStack will
 have their scissor 
+
+The reference bounds are culled in batches of CULL_BATCH_SIZE
+entities with R_CullLocalBoxes.
 ===================
 */
 void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps ) {
@@ -593,44 +596,66 @@ void idRenderWorldLocal::AddAreaEntityRefs( int areaNum, const portalStack_t *ps
 	idRenderEntityLocal	*entity;
 	portalArea_t		*area;
 	viewEntity_t		*vEnt;
-	idBounds			b;
+	idRenderEntityLocal	*batch[CULL_BATCH_SIZE];
+	const idBounds		*batchBounds[CULL_BATCH_SIZE];
+	const float			*batchMatrices[CULL_BATCH_SIZE];
+	byte				culled[CULL_BATCH_SIZE];
+	int					numBatch;
 
 	area = &portalAreas[ areaNum ];
 
-	for ( ref = area->entityRefs.areaNext ; ref != &area->entityRefs ; ref = ref->areaNext ) {
-		entity = ref->entity;
+	ref = area->entityRefs.areaNext;
+	while ( ref != &area->entityRefs ) {
 
-		// debug tool to allow viewing of only one entity at a time
-		if ( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != entity->index ) {
-			continue;
-		}
+		// collect the next batch of entities that pass the cheap tests
+		for ( numBatch = 0 ; numBatch < CULL_BATCH_SIZE && ref != &area->entityRefs ; ref = ref->areaNext ) {
+			entity = ref->entity;
 
-		// remove decals that are completely faded away
-		R_FreeEntityDefFadedDecals( entity, tr.viewDef->renderView.time );
-
-		// check for completely suppressing the model
-		if ( !r_skipSuppress.GetBool() ) {
-			if ( entity->parms.suppressSurfaceInViewID
-					&& entity->parms.suppressSurfaceInViewID == tr.viewDef->renderView.viewID ) {
+			// debug tool to allow viewing of only one entity at a time
+			if ( r_singleEntity.GetInteger() >= 0 && r_singleEntity.GetInteger() != entity->index ) {
 				continue;
 			}
-			if ( entity->parms.allowSurfaceInViewID 
-					&& entity->parms.allowSurfaceInViewID != tr.viewDef->renderView.viewID ) {
-				continue;
+
+			// remove decals that are completely faded away
+			R_FreeEntityDefFadedDecals( entity, tr.viewDef->renderView.time );
+
+			// check for completely suppressing the model
+			if ( !r_skipSuppress.GetBool() ) {
+				if ( entity->parms.suppressSurfaceInViewID
+						&& entity->parms.suppressSurfaceInViewID == tr.viewDef->renderView.viewID ) {
+					continue;
+				}
+				if ( entity->parms.allowSurfaceInViewID 
+						&& entity->parms.allowSurfaceInViewID != tr.viewDef->renderView.viewID ) {
+					continue;
+				}
 			}
+
+			batch[numBatch] = entity;
+			batchBounds[numBatch] = &entity->referenceBounds;
+			batchMatrices[numBatch] = entity->modelMatrix;
+			numBatch++;
 		}
 
-		// cull reference bounds
-		if ( CullEntityByPortals( entity, ps ) ) {
-			// we are culled out through this portal chain, but it might
-			// still be visible through others
-			continue;
+		// cull reference bounds, see CullEntityByPortals
+		if ( r_useEntityCulling.GetBool() ) {
+			R_CullLocalBoxes( culled, batchBounds, batchMatrices, numBatch, ps->numPortalPlanes, ps->portalPlanes );
+		} else {
+			memset( culled, 0, numBatch );
 		}
 
-		vEnt = R_SetEntityDefViewEntity( entity );
+		for ( int i = 0 ; i < numBatch ; i++ ) {
+			if ( culled[i] ) {
+				// we are culled out through this portal chain, but it might
+				// still be visible through others
+				continue;
+			}
 
-		// possibly expand the scissor rect
-		vEnt->scissorRect.Union( ps->rect );
+			vEnt = R_SetEntityDefViewEntity( batch[i] );
+
+			// possibly expand the scissor rect
+			vEnt->scissorRect.Union( ps->rect );
+		}
 	}
 }
 
@@ -119,7 +119,7 @@ private:
 	int				dynamicCountThisFrame;
 
 	int				currentFrame;			// for purgable block tracking
-	int				listNum;				// currentFrame % NUM_VERTEX_FRAMES, determines which tempBuffers to use
+	int				listNum;				// advanced every EndFrame, determines which tempBuffers and frame lists to use
 
 	bool			virtualMemory;			// not fast stuff
 
@@ -132,8 +132,8 @@ private:
 
 	vertCache_t		freeStaticHeaders;		// head of doubly linked list
 	vertCache_t		freeDynamicHeaders;		// head of doubly linked list
-	vertCache_t		dynamicHeaders;			// head of doubly linked list
-	vertCache_t		deferredFreeList;		// head of doubly linked list
+	vertCache_t		dynamicHeaders[NUM_VERTEX_FRAMES];		// head of doubly linked list
+	vertCache_t		deferredFreeList[NUM_VERTEX_FRAMES];	// head of doubly linked list
 	vertCache_t		staticHeaders;			// head of doubly linked list in MRU order,
 											// staticHeaders.next is most recently used
 
@@ -710,19 +710,11 @@ static const int CULL_OCCLUDER_AND_RECEIVER = 2;	// the surface doesn't effect t
 ==================
 RB_EXP_CullInteractions
 
-Sets surfaceInteraction_t->cullBits
+Sets viewOccluderSurf_t->expCulled
 ==================
 */
 void RB_EXP_CullInteractions( viewLight_t *vLight, idPlane frustumPlanes[6] ) {
-	for ( idInteraction *inter = vLight->lightDef->firstInteraction ; inter ; inter = inter->lightNext ) {
-		const idRenderEntityLocal *entityDef = inter->entityDef;
-		if ( !entityDef ) {
-			continue;
-		}
-		if ( inter->numSurfaces < 1 ) {
-			continue;
-		}
-
+	for ( viewOccluder_t *occluder = vLight->occluders ; occluder ; occluder = occluder->next ) {
 		int	culled = 0;
 
 		if ( r_sb_useCulling.GetBool() ) {
@@ -730,16 +722,16 @@ void RB_EXP_CullInteractions( viewLight_t *vLight, idPlane frustumPlanes[6] ) {
 			idPlane	localPlanes[6];
 			int		plane;
 			for ( plane = 0 ; plane < 6 ; plane++ ) {
-				R_GlobalPlaneToLocal( entityDef->modelMatrix, frustumPlanes[plane], localPlanes[plane] );
+				R_GlobalPlaneToLocal( occluder->modelMatrix, frustumPlanes[plane], localPlanes[plane] );
 			}
 
 			// cull the entire entity bounding box
 			// has referenceBounds been tightened to the actual model bounds?
 			idVec3	corners[8];
 			for ( int i = 0 ; i < 8 ; i++ ) {
-				corners[i][0] = entityDef->referenceBounds[i&1][0];
-				corners[i][1] = entityDef->referenceBounds[(i>>1)&1][1];
-				corners[i][2] = entityDef->referenceBounds[(i>>2)&1][2];
+				corners[i][0] = occluder->referenceBounds[i&1][0];
+				corners[i][1] = occluder->referenceBounds[(i>>1)&1][1];
+				corners[i][2] = occluder->referenceBounds[(i>>2)&1][2];
 			}
 
 			for ( plane = 0 ; plane < 6 ; plane++ ) {
@@ -760,13 +752,8 @@ void RB_EXP_CullInteractions( viewLight_t *vLight, idPlane frustumPlanes[6] ) {
 			}
 		}
 
-		for ( int i = 0 ; i < inter->numSurfaces ; i++ ) {
-			surfaceInteraction_t	*surfInt = &inter->surfaces[i];
-
-			if ( !surfInt->ambientTris ) {
-				continue;
-			}
-			surfInt->expCulled = culled;
+		for ( int i = 0 ; i < occluder->numSurfaces ; i++ ) {
+			occluder->surfaces[i].expCulled = culled;
 		}
 
 	}
@@ -778,28 +765,17 @@ RB_EXP_RenderOccluders
 ==================
 */
 void RB_EXP_RenderOccluders( viewLight_t *vLight ) {
-	for ( idInteraction *inter = vLight->lightDef->firstInteraction ; inter ; inter = inter->lightNext ) {
-		const idRenderEntityLocal *entityDef = inter->entityDef;
-		if ( !entityDef ) {
-			continue;
-		}
-		if ( inter->numSurfaces < 1 ) {
-			continue;
-		}
-
+	for ( viewOccluder_t *occluder = vLight->occluders ; occluder ; occluder = occluder->next ) {
 		// no need to check for current on this, because each interaction is always
 		// a different space
 		float	matrix[16];
-		myGlMultMatrix( inter->entityDef->modelMatrix, lightMatrix, matrix );
+		myGlMultMatrix( occluder->modelMatrix, lightMatrix, matrix );
 		qglLoadMatrixf( matrix );
 
 		// draw each surface
-		for ( int i = 0 ; i < inter->numSurfaces ; i++ ) {
-			surfaceInteraction_t	*surfInt = &inter->surfaces[i];
+		for ( int i = 0 ; i < occluder->numSurfaces ; i++ ) {
+			viewOccluderSurf_t	*surfInt = &occluder->surfaces[i];
 
-			if ( !surfInt->ambientTris ) {
-				continue;
-			}
 			if ( surfInt->shader && !surfInt->shader->SurfaceCastsShadow() ) {
 				continue;
 			}
@@ -811,9 +787,6 @@ void RB_EXP_RenderOccluders( viewLight_t *vLight ) {
 
 			// render it
 			const srfTriangles_t *tri = surfInt->ambientTris;
-			if ( !tri->ambientCache ) {
-				R_CreateAmbientCache( const_cast<srfTriangles_t *>(tri), false ); 
-			}
 			idDrawVert *ac = (idDrawVert *)vertexCache.Position( tri->ambientCache );
 			qglVertexPointer( 3, GL_FLOAT, sizeof( idDrawVert ), ac->xyz.ToFloatPtr() );
 	qglTexCoordPointer( 2, GL_FLOAT, sizeof( idDrawVert ), ac->st.ToFloatPtr() );
@@ -911,23 +884,23 @@ qglEnableClientState( GL_TEXTURE_COORD_ARRAY );
 	float	viewMatrix[16];
 
 	idVec3	vec;
-	idVec3	origin = vLight->lightDef->globalLightOrigin;
+	idVec3	origin = vLight->globalLightOrigin;
 
 	if ( side == -1 ) {
 		// projected light
-		vec = vLight->lightDef->parms.target;
+		vec = vLight->parms.target;
 		vec.Normalize();
 		viewMatrix[0] = vec[0];
 		viewMatrix[4] = vec[1];
 		viewMatrix[8] = vec[2];
 
-		vec = vLight->lightDef->parms.right;
+		vec = vLight->parms.right;
 		vec.Normalize();
 		viewMatrix[1] = -vec[0];
 		viewMatrix[5] = -vec[1];
 		viewMatrix[9] = -vec[2];
 
-		vec = vLight->lightDef->parms.up;
+		vec = vLight->parms.up;
 		vec.Normalize();
 		viewMatrix[2] = vec[0];
 		viewMatrix[6] = vec[1];
@@ -1819,15 +1792,15 @@ and non-cubic lights must take the largest length
 float	R_EXP_CalcLightAxialSize( viewLight_t *vLight ) {
 	float	max = 0;
 
-	if ( !vLight->lightDef->parms.pointLight ) {
-		idVec3	dir = vLight->lightDef->parms.target - vLight->lightDef->parms.origin;
+	if ( !vLight->parms.pointLight ) {
+		idVec3	dir = vLight->parms.target - vLight->parms.origin;
 		max = dir.Length();
 		return max;
 	}
 
 	for ( int i = 0 ; i < 3 ; i++ ) {
-		float	dist = fabs(vLight->lightDef->parms.lightCenter[i] );
-		dist += vLight->lightDef->parms.lightRadius[i];
+		float	dist = fabs(vLight->parms.lightCenter[i] );
+		dist += vLight->parms.lightRadius[i];
 		if ( dist > max ) {
 			max = dist;
 		}
@@ -2477,7 +2450,7 @@ void    RB_Exp_DrawInteractions( void ) {
 
 		int	side, sideStop;
 
-		if ( vLight->lightDef->parms.pointLight ) {
+		if ( vLight->parms.pointLight ) {
 			if ( r_sb_singleSide.GetInteger() != -1 ) {
 				side = r_sb_singleSide.GetInteger();
 				sideStop = side+1;
@@ -32,6 +32,8 @@ If you have questions concerning this license or the applicable additional terms
 
 
 frameData_t		*frameData;
+frameData_t		*smpFrameData[NUM_FRAME_DATA];
+int				smpFrame;
 backEndState_t	backEnd;
 
 
@@ -605,6 +607,8 @@ void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds ) {
 		return;
 	}
 
+	PROFILE_SCOPE( "RB_ExecuteBackEndCommands" );
+
 	backEndStartTime = Sys_Milliseconds();
 
 	// needed for editor rendering
@@ -657,3 +661,224 @@ void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds ) {
 		backEnd.c_copyFrameBuffer = 0;
 	}
 }
+
+/*
+==============================================================================================
+
+BACK END THREAD
+
+With r_smp the command list of frame N is executed by a separate thread while the
+main thread runs the game and the front end of frame N+1 into the other frameData.
+The GL context is owned by whichever thread is currently issuing GL calls, the main
+thread takes it back in R_SyncBackEnd before it touches GL or reuses a frameData.
+
+==============================================================================================
+*/
+
+typedef struct {
+	xthreadInfo				threadInfo;
+	xsignalHandle			wakeSignal;			// raised by the main thread when commands are ready
+	xsignalHandle			doneSignal;			// raised by the back end thread when they are executed
+	const emptyCommand_t *	cmds;
+	volatile bool			shutdown;
+	bool					active;				// the thread is running
+	bool					busy;				// commands were issued and not synced yet
+	bool					mainHasContext;		// the main thread owns the GL context
+	idTimer					mainTimer;			// main thread time since the last issue
+	float					backEndMsec;		// back end time of the last synced frame
+	float					mainMsec;			// main thread time while that frame was executed
+	float					stallMsec;			// main thread time waiting for it
+} smpBackEnd_t;
+
+static smpBackEnd_t		smpBackEnd;
+
+/*
+==================
+RB_BackEndThread
+==================
+*/
+static unsigned int RB_BackEndThread( void *parms ) {
+	idTimer timer;
+
+	while ( 1 ) {
+		Sys_SignalWait( smpBackEnd.wakeSignal );
+		if ( smpBackEnd.shutdown ) {
+			break;
+		}
+
+		timer.Clear();
+		timer.Start();
+
+		GLimp_ActivateContext();
+		RB_ExecuteBackEndCommands( smpBackEnd.cmds );
+		GLimp_DeactivateContext();
+
+		timer.Stop();
+		smpBackEnd.backEndMsec = timer.Milliseconds();
+
+		Sys_SignalRaise( smpBackEnd.doneSignal );
+	}
+	Mem_ShutdownThread();
+	return 0;
+}
+
+/*
+==================
+R_InitBackEndThread
+
+Called after the GL context has been created, r_smp only
+takes effect here so it needs a vid_restart to change.
+==================
+*/
+void R_InitBackEndThread( void ) {
+	if ( smpBackEnd.active || !r_smp.GetBool() ) {
+		return;
+	}
+
+	smpBackEnd.wakeSignal = Sys_SignalCreate( false );
+	smpBackEnd.doneSignal = Sys_SignalCreate( false );
+	smpBackEnd.cmds = NULL;
+	smpBackEnd.shutdown = false;
+	smpBackEnd.busy = false;
+	smpBackEnd.mainHasContext = true;
+	smpBackEnd.backEndMsec = 0.0f;
+	smpBackEnd.mainMsec = 0.0f;
+	smpBackEnd.stallMsec = 0.0f;
+	smpBackEnd.mainTimer.Clear();
+	smpBackEnd.mainTimer.Start();
+
+	Sys_CreateThread( RB_BackEndThread, NULL, THREAD_ABOVE_NORMAL, smpBackEnd.threadInfo, "renderBackEnd", g_threads, &g_thread_count );
+	smpBackEnd.active = true;
+
+	common->Printf( "using a back end thread\n" );
+}
+
+/*
+==================
+R_ShutdownBackEndThread
+
+Leaves the GL context with the main thread.
+==================
+*/
+void R_ShutdownBackEndThread( void ) {
+	if ( !smpBackEnd.active ) {
+		return;
+	}
+
+	R_SyncBackEnd();
+
+	smpBackEnd.shutdown = true;
+	Sys_SignalRaise( smpBackEnd.wakeSignal );
+	Sys_DestroyThread( smpBackEnd.threadInfo );
+
+	Sys_SignalDestroy( smpBackEnd.wakeSignal );
+	Sys_SignalDestroy( smpBackEnd.doneSignal );
+	smpBackEnd.wakeSignal = NULL;
+	smpBackEnd.doneSignal = NULL;
+	smpBackEnd.mainTimer.Stop();
+	smpBackEnd.active = false;
+}
+
+/*
+==================
+R_BackEndThreadActive
+==================
+*/
+bool R_BackEndThreadActive( void ) {
+	return smpBackEnd.active;
+}
+
+/*
+==================
+R_OnBackEndThread
+==================
+*/
+static bool R_OnBackEndThread( void ) {
+	int index;
+
+	Sys_GetThreadName( &index );
+	return ( index >= 0 && g_threads[index] == &smpBackEnd.threadInfo );
+}
+
+/*
+==================
+R_IssueBackEndCommands
+
+The command list must stay valid until the next R_SyncBackEnd,
+which is the case for anything allocated in the current frameData.
+==================
+*/
+void R_IssueBackEndCommands( const emptyCommand_t *cmds ) {
+	if ( !smpBackEnd.active ) {
+		RB_ExecuteBackEndCommands( cmds );
+		return;
+	}
+
+	// finish the previous list before handing over the context again
+	R_SyncBackEnd();
+
+	smpBackEnd.mainTimer.Stop();
+	smpBackEnd.mainMsec = smpBackEnd.mainTimer.Milliseconds();
+	smpBackEnd.mainTimer.Clear();
+	smpBackEnd.mainTimer.Start();
+
+	GLimp_DeactivateContext();
+	smpBackEnd.mainHasContext = false;
+
+	smpBackEnd.cmds = cmds;
+	smpBackEnd.busy = true;
+	Sys_SignalRaise( smpBackEnd.wakeSignal );
+}
+
+/*
+==================
+R_SyncBackEnd
+
+Does nothing without a back end thread, or when called from the back end
+thread itself, which happens when it loads an image on demand.
+==================
+*/
+void R_SyncBackEnd( void ) {
+	if ( !smpBackEnd.active || R_OnBackEndThread() ) {
+		return;
+	}
+
+	if ( smpBackEnd.busy ) {
+		idTimer timer;
+
+		timer.Start();
+		Sys_SignalWait( smpBackEnd.doneSignal );
+		timer.Stop();
+
+		smpBackEnd.stallMsec = timer.Milliseconds();
+		smpBackEnd.busy = false;
+		tr.pc.smpStallMsec += smpBackEnd.stallMsec;
+	}
+
+	if ( !smpBackEnd.mainHasContext ) {
+		GLimp_ActivateContext();
+		smpBackEnd.mainHasContext = true;
+	}
+}
+
+/*
+==================
+R_ReportSmp
+
+The overlap is the part of the back end time the main thread
+spent on the next frame instead of waiting.
+==================
+*/
+void R_ReportSmp( void ) {
+	if ( !smpBackEnd.active ) {
+		common->Printf( "smp: off, back end %i msec\n", backEnd.pc.msec );
+		return;
+	}
+
+	float overlap = smpBackEnd.backEndMsec - smpBackEnd.stallMsec;
+	if ( overlap < 0.0f ) {
+		overlap = 0.0f;
+	}
+	common->Printf( "smp: back end:%5.2f main:%5.2f stall:%5.2f overlap:%5.2f msec\n",
+		smpBackEnd.backEndMsec, smpBackEnd.mainMsec, tr.pc.smpStallMsec, overlap );
+}
@@ -0,0 +1,215 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "tr_local.h"
+
+/*
+==========================================================================================
+
+FRONT END JOBS
+
+The view setup in R_AddLightSurfaces and R_AddModelSurfaces is split into a pass
+that only reads shared renderer state and can be spread over several threads, and
+a pass on the main thread that links the results in the original list order, so
+the generated drawSurfs are identical to the serial path.
+
+The items are handed out from a shared counter to r_frontEndJobs jobs on the
+shared job threads, and the main thread helps while it waits for them.  Each job
+allocates from its own frame arena, which is refilled in chunks from the frame
+data, so the frameData allocation pointer is only touched under a lock.
+
+NOTE: the box culling counters in tr.pc are not updated atomically, so r_showCull
+is only approximate while front end jobs are enabled.
+
+==========================================================================================
+*/
+
+static const int FRAME_ARENA_CHUNK	= 0x10000;
+
+typedef struct {
+	int					threadNum;
+} frontEndJobParms_t;
+
+frameArena_t				frontEndArenas[MAX_FRONTEND_THREADS];
+
+static idParallelJobList *	frontEndJobList;
+static frontEndJobParms_t	frontEndJobParms[MAX_FRONTEND_THREADS];
+
+static frontEndJob_t		frontEndJob;
+static void *				frontEndJobData;
+static int					frontEndJobItems;
+static idSysInterlockedInteger	frontEndNextItem;
+
+// running averages for r_showFrontEndJobs
+static float				frontEndSerialMsec;
+static float				frontEndJobsMsec;
+
+/*
+=================
+R_ProcessFrontEndJobItems
+=================
+*/
+static void R_ProcessFrontEndJobItems( void *data ) {
+	int threadNum = ( (frontEndJobParms_t *)data )->threadNum;
+
+	while( 1 ) {
+		int item = frontEndNextItem.Increment() - 1;
+		if ( item >= frontEndJobItems ) {
+			break;
+		}
+		frontEndJob( item, threadNum, frontEndJobData );
+	}
+}
+
+/*
+=================
+R_InitFrontEndJobs
+=================
+*/
+void R_InitFrontEndJobs( void ) {
+	if ( frontEndJobList == NULL ) {
+		frontEndJobList = parallelJobManager->AllocJobList( "frontEnd" );
+	}
+	for ( int i = 0; i < MAX_FRONTEND_THREADS; i++ ) {
+		frontEndJobParms[i].threadNum = i;
+	}
+}
+
+/*
+=================
+R_ShutdownFrontEndJobs
+=================
+*/
+void R_ShutdownFrontEndJobs( void ) {
+	parallelJobManager->FreeJobList( frontEndJobList );
+	frontEndJobList = NULL;
+
+	memset( frontEndArenas, 0, sizeof( frontEndArenas ) );
+}
+
+/*
+=================
+R_NumFrontEndThreads
+
+Returns the number of jobs the front end work is split into,
+or 0 if the front end runs serially.
+=================
+*/
+int R_NumFrontEndThreads( void ) {
+	if ( r_frontEndJobs.GetInteger() <= 0 || parallelJobManager->GetNumProcessingThreads() == 0 ) {
+		return 0;
+	}
+	return idMath::ClampInt( 2, MAX_FRONTEND_THREADS, r_frontEndJobs.GetInteger() + 1 );
+}
+
+/*
+=================
+R_RunFrontEndJobs
+
+Runs the job for all items, and returns when all of them have completed.
+=================
+*/
+void R_RunFrontEndJobs( frontEndJob_t job, void *data, int numItems ) {
+	int i, numJobs;
+
+	// the arenas may point into frame memory from a previous frame
+	for ( i = 0; i < MAX_FRONTEND_THREADS; i++ ) {
+		frontEndArenas[i].size = frontEndArenas[i].used = 0;
+	}
+
+	numJobs = Min( R_NumFrontEndThreads(), numItems );
+	if ( numJobs <= 1 ) {
+		for ( i = 0; i < numItems; i++ ) {
+			job( i, 0, data );
+		}
+		return;
+	}
+
+	frontEndJob = job;
+	frontEndJobData = data;
+	frontEndJobItems = numItems;
+	frontEndNextItem.SetValue( 0 );
+
+	for ( i = 0; i < numJobs; i++ ) {
+		frontEndJobList->AddJob( R_ProcessFrontEndJobItems, &frontEndJobParms[i] );
+	}
+	frontEndJobList->Submit();
+	frontEndJobList->Wait();
+}
+
+/*
+=================
+R_FrameArenaAlloc
+
+Like R_FrameAlloc, the memory is freed when the current frame's back end
+completes, and it is NOT zero filled.
+=================
+*/
+void *R_FrameArenaAlloc( frameArena_t *arena, int bytes ) {
+	void	*buf;
+
+	bytes = ( bytes + 15 ) & ~15;
+	if ( arena->used + bytes > arena->size ) {
+		int size = Max( bytes, FRAME_ARENA_CHUNK );
+
+		Sys_EnterCriticalSection( CRITICAL_SECTION_TWO );
+		arena->base = (byte *)R_FrameAlloc( size );
+		Sys_LeaveCriticalSection( CRITICAL_SECTION_TWO );
+
+		arena->size = size;
+		arena->used = 0;
+	}
+	buf = arena->base + arena->used;
+	arena->used += bytes;
+	return buf;
+}
+
+/*
+=================
+R_ReportFrontEndJobs
+
+Prints the time spent in the light and model setup this frame, and
+the running averages of the serial and the job path, so the two can
+be compared by toggling r_frontEndJobs.
+=================
+*/
+void R_ReportFrontEndJobs( void ) {
+	float msec = tr.pc.frontEndLightMsec + tr.pc.frontEndModelMsec;
+
+	if ( R_NumFrontEndThreads() == 0 ) {
+		frontEndSerialMsec = frontEndSerialMsec * 0.9f + msec * 0.1f;
+	} else {
+		frontEndJobsMsec = frontEndJobsMsec * 0.9f + msec * 0.1f;
+	}
+
+	common->Printf( "lights:%5.2f models:%5.2f msec, jobs:%i  avg serial:%5.2f jobs:%5.2f\n",
+		tr.pc.frontEndLightMsec, tr.pc.frontEndModelMsec, R_NumFrontEndThreads(), frontEndSerialMsec, frontEndJobsMsec );
+}
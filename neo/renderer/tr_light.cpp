@@ -393,6 +393,7 @@ viewEntity_t *R_SetEntityDefViewEntity( idRenderEntityLocal *def ) {
 	// copy the model and weapon depth hack for back-end use
 	vModel->modelDepthHack = def->parms.modelDepthHack;
 	vModel->weaponDepthHack = def->parms.weaponDepthHack;
+	vModel->xrayIndex = def->parms.xrayIndex;
 
 	R_AxisToModelMatrix( def->parms.axis, def->parms.origin, vModel->modelMatrix );
 
@@ -499,6 +500,8 @@ viewLight_t *R_SetLightDefViewLight( idRenderLightLocal *light ) {
 	vLight->falloffImage = light->falloffImage;
 	vLight->lightShader = light->lightShader;
 	vLight->shaderRegisters = NULL;		// allocated and evaluated in R_AddLightSurfaces
+	vLight->parms = light->parms;
+	vLight->occluders = NULL;			// only added for the shadow buffer backend
 
 	// link the view light
 	vLight->next = tr.viewDef->viewLights;
@@ -648,8 +651,208 @@ void idRenderWorldLocal::CreateLightDefInteractions( idRenderLightLocal *ldef )
 	}
 }
 
+/*
+=================
+R_FindInteraction
+
+Returns the existing interaction between the entity and the light, or NULL.
+=================
+*/
+static idInteraction *R_FindInteraction( const idRenderWorldLocal *world, const idRenderEntityLocal *edef, const idRenderLightLocal *ldef ) {
+	idInteraction	*inter;
+
+	if ( r_useInteractionTable.GetBool() && world->interactionTable ) {
+		return world->interactionTable[ ldef->index * world->interactionTableWidth + edef->index ];
+	}
+	for ( inter = edef->firstInteraction; inter != NULL; inter = inter->entityNext ) {
+		if ( inter->lightDef == ldef ) {
+			break;
+		}
+	}
+	return inter;
+}
+
+/*
+=================
+idRenderWorldLocal::FindLightDefInteractions
+
+The read only half of CreateLightDefInteractions, which can be run from
+a front end job.  Looks up the existing interaction for every entity the
+light may touch, and does the reference bounds cull for the entities that
+don't have one yet.
+
+Other lights may still add viewEntities before this light is linked, so
+the in view test is left to LinkLightDefInteractions.
+
+If refs is NULL, the references are only counted.
+=================
+*/
+int idRenderWorldLocal::FindLightDefInteractions( const idRenderLightLocal *ldef, lightEntityRef_t *refs ) const {
+	areaReference_t		*eref;
+	areaReference_t		*lref;
+	idRenderEntityLocal	*edef;
+	portalArea_t		*area;
+	lightEntityRef_t	*ref;
+	int					numRefs;
+
+	numRefs = 0;
+	for ( lref = ldef->references ; lref ; lref = lref->ownerNext ) {
+		area = lref->area;
+
+		for ( eref = area->entityRefs.areaNext ; eref != &area->entityRefs ; eref = eref->areaNext ) {
+			edef = eref->entity;
+
+			if ( edef->parms.noDynamicInteractions && edef->world->generateAllInteractionsCalled ) {
+				continue;
+			}
+
+			if ( !refs ) {
+				numRefs++;
+				continue;
+			}
+
+			ref = &refs[ numRefs++ ];
+			ref->entityDef = edef;
+			ref->culled = false;
+
+			// these only matter if the entity isn't viewed when the light is linked
+			ref->skipUnviewed = false;
+			if ( !ldef->lightShader->LightCastsShadows() ) {
+				ref->skipUnviewed = true;
+			} else if ( !r_skipSuppress.GetBool() ) {
+				if ( edef->parms.suppressShadowInViewID && edef->parms.suppressShadowInViewID == tr.viewDef->renderView.viewID ) {
+					ref->skipUnviewed = true;
+				}
+				if ( edef->parms.suppressShadowInLightID && edef->parms.suppressShadowInLightID == ldef->parms.lightId ) {
+					ref->skipUnviewed = true;
+				}
+			}
+
+			ref->interaction = R_FindInteraction( this, edef, ldef );
+		}
+	}
+
+	if ( refs ) {
+		CullLightDefEntityRefs( ldef, refs, numRefs );
+	}
+
+	return numRefs;
+}
+
+/*
+=================
+idRenderWorldLocal::CullLightDefEntityRefs
+
+Culls the reference bounds of the entities without an interaction
+against the light frustum, in batches of CULL_BATCH_SIZE.
+=================
+*/
+void idRenderWorldLocal::CullLightDefEntityRefs( const idRenderLightLocal *ldef, lightEntityRef_t *refs, int numRefs ) const {
+	lightEntityRef_t	*batch[CULL_BATCH_SIZE];
+	const idBounds		*batchBounds[CULL_BATCH_SIZE];
+	const float			*batchMatrices[CULL_BATCH_SIZE];
+	float				modelMatrices[CULL_BATCH_SIZE][16];
+	byte				culled[CULL_BATCH_SIZE];
+	int					i, numBatch;
+
+	i = 0;
+	while ( i < numRefs ) {
+		for ( numBatch = 0 ; numBatch < CULL_BATCH_SIZE && i < numRefs ; i++ ) {
+			lightEntityRef_t *ref = &refs[i];
+			if ( ref->interaction != NULL ) {
+				continue;
+			}
+			const idRenderEntityLocal *edef = ref->entityDef;
+
+			// a viewEntity has the same matrix, but it may not exist yet
+			R_AxisToModelMatrix( edef->parms.axis, edef->parms.origin, modelMatrices[numBatch] );
+
+			batch[numBatch] = ref;
+			batchBounds[numBatch] = &edef->referenceBounds;
+			batchMatrices[numBatch] = modelMatrices[numBatch];
+			numBatch++;
+		}
+
+		R_CullLocalBoxes( culled, batchBounds, batchMatrices, numBatch, 6, ldef->frustum );
+
+		for ( int j = 0 ; j < numBatch ; j++ ) {
+			batch[j]->culled = ( culled[j] != 0 );
+		}
+	}
+}
+
+/*
+=================
+idRenderWorldLocal::LinkLightDefInteractions
+
+The serial half of CreateLightDefInteractions.  Creates the missing
+interactions and adds the viewEntities found by FindLightDefInteractions,
+in the same order CreateLightDefInteractions would have.
+=================
+*/
+void idRenderWorldLocal::LinkLightDefInteractions( idRenderLightLocal *ldef, const lightEntityRef_t *refs, int numRefs ) {
+	const lightEntityRef_t	*ref;
+	idRenderEntityLocal		*edef;
+	idInteraction			*inter;
+
+	for ( int i = 0 ; i < numRefs ; i++ ) {
+		ref = &refs[i];
+		edef = ref->entityDef;
+
+		// if the entity isn't viewed
+		if ( ref->skipUnviewed && edef->viewCount != tr.viewCount ) {
+			continue;
+		}
+
+		inter = ref->interaction;
+		if ( inter == NULL ) {
+			// the entity can be in more than one of the light's areas,
+			// so an earlier reference may have created it
+			inter = R_FindInteraction( this, edef, ldef );
+			if ( inter == NULL ) {
+				inter = idInteraction::AllocAndLink( edef, ldef );
+				if ( ref->culled ) {
+					inter->MakeEmpty();
+					continue;
+				}
+				R_SetEntityDefViewEntity( edef );
+				continue;
+			}
+		}
+
+		// if this entity wasn't in view already, the scissor rect will be empty,
+		// so it will only be used for shadow casting
+		if ( !inter->IsEmpty() ) {
+			R_SetEntityDefViewEntity( edef );
+		}
+	}
+}
+
 //===============================================================================================================
 
+/*
+=================
+R_CopyDrawSurfGeo
+
+The back end thread draws a frame while the front end runs the next one, and
+deforming models free and recreate the vertex caches of their surfaces every
+frame.  With the back end thread the triangles of a draw surface are copied to
+frame memory, so the back end keeps the cache handles of the frame the surface
+was added in.  The vertex cache only frees the blocks once the back end is done.
+=================
+*/
+static const srfTriangles_t *R_CopyDrawSurfGeo( const srfTriangles_t *tri ) {
+	srfTriangles_t	*copy;
+
+	if ( !R_BackEndThreadActive() ) {
+		return tri;
+	}
+
+	copy = (srfTriangles_t *)R_FrameAlloc( sizeof( *copy ) );
+	*copy = *tri;
+	return copy;
+}
+
 /*
 =================
 R_LinkLightSurf
@@ -665,7 +868,8 @@ void R_LinkLightSurf( const drawSurf_t **link, const srfTriangles_t *tri, const
 
 	drawSurf = (drawSurf_t *)R_FrameAlloc( sizeof( *drawSurf ) );
 
-	drawSurf->geo = tri;
+	drawSurf->geo = R_CopyDrawSurfGeo( tri );
+	drawSurf->sourceGeo = tri;
 	drawSurf->space = space;
 	drawSurf->material = shader;
 	drawSurf->scissorRect = scissor;
@@ -854,6 +1058,211 @@ idScreenRect	R_CalcLightScissorRectangle( viewLight_t *vLight ) {
 	return r;
 }
 
+/*
+=================
+R_LightSuppressedInView
+=================
+*/
+static bool R_LightSuppressedInView( const idRenderLightLocal *light ) {
+	if ( r_skipSuppress.GetBool() ) {
+		return false;
+	}
+	if ( light->parms.suppressLightInViewID
+	&& light->parms.suppressLightInViewID == tr.viewDef->renderView.viewID ) {
+		return true;
+	}
+	if ( light->parms.allowLightInViewID 
+	&& light->parms.allowLightInViewID != tr.viewDef->renderView.viewID ) {
+		return true;
+	}
+	return false;
+}
+
+/*
+=================
+R_EvaluateLightShader
+
+Evaluates the light shader registers.  Returns false if the light
+doesn't add anything and can be skipped.
+=================
+*/
+static bool R_EvaluateLightShader( const idRenderLightLocal *light, float *lightRegs ) {
+	const idMaterial	*lightShader = light->lightShader;
+
+	lightShader->EvaluateRegisters( lightRegs, light->parms.shaderParms, tr.viewDef, light->parms.referenceSound );
+
+	// if this is a purely additive light and no stage in the light shader evaluates
+	// to a positive light value, we can completely skip the light
+	if ( lightShader->IsFogLight() || lightShader->IsBlendLight() ) {
+		return true;
+	}
+
+	int lightStageNum;
+	for ( lightStageNum = 0 ; lightStageNum < lightShader->GetNumStages() ; lightStageNum++ ) {
+		const shaderStage_t	*lightStage = lightShader->GetStage( lightStageNum );
+
+		// ignore stages that fail the condition
+		if ( !lightRegs[ lightStage->conditionRegister ] ) {
+			continue;
+		}
+
+		const int *registers = lightStage->color.registers;
+
+		// snap tiny values to zero to avoid lights showing up with the wrong color
+		if ( lightRegs[ registers[0] ] < 0.001f ) {
+			lightRegs[ registers[0] ] = 0.0f;
+		}
+		if ( lightRegs[ registers[1] ] < 0.001f ) {
+			lightRegs[ registers[1] ] = 0.0f;
+		}
+		if ( lightRegs[ registers[2] ] < 0.001f ) {
+			lightRegs[ registers[2] ] = 0.0f;
+		}
+
+		// FIXME:	when using the following values the light shows up bright red when using nvidia drivers/hardware
+		//			this seems to have been fixed ?
+		//lightRegs[ registers[0] ] = 1.5143074e-005f;
+		//lightRegs[ registers[1] ] = 1.5483369e-005f;
+		//lightRegs[ registers[2] ] = 1.7014690e-005f;
+
+		if ( lightRegs[ registers[0] ] > 0.0f ||
+				lightRegs[ registers[1] ] > 0.0f ||
+					lightRegs[ registers[2] ] > 0.0f ) {
+			break;
+		}
+	}
+
+	// we went through all the stages and didn't find one that adds anything
+	return ( lightStageNum != lightShader->GetNumStages() );
+}
+
+/*
+=================
+R_AddLightStaticSurfaces
+
+Makes sure fog light frustums are in the vertex cache, and adds
+the prelight shadows for the static world geometry.
+=================
+*/
+static void R_AddLightStaticSurfaces( viewLight_t *vLight ) {
+	idRenderLightLocal	*light = vLight->lightDef;
+
+	// fog lights will need to draw the light frustum triangles, so make sure they
+	// are in the vertex cache
+	if ( light->lightShader->IsFogLight() ) {
+		if ( !light->frustumTris->ambientCache ) {
+			if ( !R_CreateAmbientCache( light->frustumTris, false ) ) {
+				// skip if we are out of vertex memory
+				return;
+			}
+		}
+		// touch the surface so it won't get purged
+		vertexCache.Touch( light->frustumTris->ambientCache );
+	}
+
+	// add the prelight shadows for the static world geometry
+	if ( light->parms.prelightModel && r_useOptimizedShadows.GetBool() ) {
+
+		if ( !light->parms.prelightModel->NumSurfaces() ) {
+			common->Error( "no surfs in prelight model '%s'", light->parms.prelightModel->Name() );
+		}
+
+		srfTriangles_t	*tri = light->parms.prelightModel->Surface( 0 )->geometry;
+		if ( !tri->shadowVertexes ) {
+			common->Error( "R_AddLightSurfaces: prelight model '%s' without shadowVertexes", light->parms.prelightModel->Name() );
+		}
+
+		// these shadows will all have valid bounds, and can be culled normally
+		if ( r_useShadowCulling.GetBool() ) {
+			if ( R_CullLocalBox( tri->bounds, tr.viewDef->worldSpace.modelMatrix, 5, tr.viewDef->frustum ) ) {
+				return;
+			}
+		}
+
+		// if we have been purged, re-upload the shadowVertexes
+		if ( !tri->shadowCache ) {
+			R_CreatePrivateShadowCache( tri );
+			if ( !tri->shadowCache ) {
+				return;
+			}
+		}
+
+		// touch the shadow surface so it won't get purged
+		vertexCache.Touch( tri->shadowCache );
+
+		if ( !tri->indexCache && r_useIndexBuffers.GetBool() ) {
+			vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
+		}
+		if ( tri->indexCache ) {
+			vertexCache.Touch( tri->indexCache );
+		}
+
+		R_LinkLightSurf( &vLight->globalShadows, tri, NULL, light, NULL, vLight->scissorRect, true /* FIXME? */ );
+	}
+}
+
+typedef struct {
+	viewLight_t *			vLight;
+	bool					serial;			// left to the main thread
+	bool					removed;		// suppressed in this view or doesn't add any light
+	float *					shaderRegisters;
+	idScreenRect			scissorRect;
+	lightEntityRef_t *		entityRefs;
+	int						numEntityRefs;
+} lightJob_t;
+
+/*
+=================
+R_AddLightSurfacesJob
+
+Does everything for a viewLight that doesn't modify shared state,
+the results are linked in order by R_AddLightSurfaces.
+=================
+*/
+static void R_AddLightSurfacesJob( int item, int threadNum, void *data ) {
+	lightJob_t					*job = (lightJob_t *)data + item;
+	const idRenderLightLocal	*light = job->vLight->lightDef;
+	frameArena_t				*arena = &frontEndArenas[threadNum];
+
+	job->serial = false;
+	job->removed = true;
+	job->shaderRegisters = NULL;
+	job->entityRefs = NULL;
+	job->numEntityRefs = 0;
+
+	// R_AddLightSurfaces will error out on it
+	if ( !light->lightShader ) {
+		return;
+	}
+
+	// the sound amplitude cache on the emitter isn't thread safe
+	if ( light->parms.referenceSound ) {
+		job->serial = true;
+		return;
+	}
+
+	if ( R_LightSuppressedInView( light ) ) {
+		return;
+	}
+
+	job->shaderRegisters = (float *)R_FrameArenaAlloc( arena, light->lightShader->GetNumRegisters() * sizeof( float ) );
+	if ( !R_EvaluateLightShader( light, job->shaderRegisters ) ) {
+		return;
+	}
+	job->removed = false;
+
+	if ( r_useLightScissors.GetBool() ) {
+		job->scissorRect = R_CalcLightScissorRectangle( job->vLight );
+	}
+
+	const idRenderWorldLocal *world = tr.viewDef->renderWorld;
+	int numRefs = world->FindLightDefInteractions( light, NULL );
+	if ( numRefs ) {
+		job->entityRefs = (lightEntityRef_t *)R_FrameArenaAlloc( arena, numRefs * sizeof( job->entityRefs[0] ) );
+		job->numEntityRefs = world->FindLightDefInteractions( light, job->entityRefs );
+	}
+}
+
 /*
 =================
 R_AddLightSurfaces
@@ -876,6 +1285,26 @@ void R_AddLightSurfaces( void ) {
 	viewLight_t		*vLight;
 	idRenderLightLocal *light;
 	viewLight_t		**ptr;
+	lightJob_t		*jobs, *job;
+	int				numJobs;
+	idTimer			timer;
+
+	timer.Start();
+
+	// the soft-shadow novelty test moves the lights while they are linked
+	jobs = NULL;
+	if ( R_NumFrontEndThreads() > 0 && r_lightSourceRadius.GetFloat() == 0.0f ) {
+		numJobs = 0;
+		for ( vLight = tr.viewDef->viewLights ; vLight ; vLight = vLight->next ) {
+			numJobs++;
+		}
+		jobs = (lightJob_t *)R_FrameAlloc( numJobs * sizeof( jobs[0] ) );
+		numJobs = 0;
+		for ( vLight = tr.viewDef->viewLights ; vLight ; vLight = vLight->next ) {
+			jobs[numJobs++].vLight = vLight;
+		}
+		R_RunFrontEndJobs( R_AddLightSurfacesJob, jobs, numJobs );
+	}
 
 	// go through each visible light, possibly removing some from the list
 	ptr = &tr.viewDef->viewLights;
@@ -883,71 +1312,39 @@ void R_AddLightSurfaces( void ) {
 		vLight = *ptr;
 		light = vLight->lightDef;
 
+		job = NULL;
+		if ( jobs ) {
+			assert( jobs->vLight == vLight );
+			if ( !jobs->serial ) {
+				job = jobs;
+			}
+			jobs++;
+		}
+
 		const idMaterial	*lightShader = light->lightShader;
 		if ( !lightShader ) {
 			common->Error( "R_AddLightSurfaces: NULL lightShader" );
 		}
 
-		// see if we are suppressing the light in this view
-		if ( !r_skipSuppress.GetBool() ) {
-			if ( light->parms.suppressLightInViewID
-			&& light->parms.suppressLightInViewID == tr.viewDef->renderView.viewID ) {
+		if ( job ) {
+			vLight->shaderRegisters = job->shaderRegisters;
+			if ( job->removed ) {
 				*ptr = vLight->next;
 				light->viewCount = -1;
 				continue;
 			}
-			if ( light->parms.allowLightInViewID 
-			&& light->parms.allowLightInViewID != tr.viewDef->renderView.viewID ) {
+		} else {
+			// see if we are suppressing the light in this view
+			if ( R_LightSuppressedInView( light ) ) {
 				*ptr = vLight->next;
 				light->viewCount = -1;
 				continue;
 			}
-		}
-
-		// evaluate the light shader registers
-		float *lightRegs =(float *)R_FrameAlloc( lightShader->GetNumRegisters() * sizeof( float ) );
-		vLight->shaderRegisters = lightRegs;
-		lightShader->EvaluateRegisters( lightRegs, light->parms.shaderParms, tr.viewDef, light->parms.referenceSound );
 
-		// if this is a purely additive light and no stage in the light shader evaluates
-		// to a positive light value, we can completely skip the light
-		if ( !lightShader->IsFogLight() && !lightShader->IsBlendLight() ) {
-			int lightStageNum;
-			for ( lightStageNum = 0 ; lightStageNum < lightShader->GetNumStages() ; lightStageNum++ ) {
-				const shaderStage_t	*lightStage = lightShader->GetStage( lightStageNum );
-
-				// ignore stages that fail the condition
-				if ( !lightRegs[ lightStage->conditionRegister ] ) {
-					continue;
-				}
-
-				const int *registers = lightStage->color.registers;
-
-				// snap tiny values to zero to avoid lights showing up with the wrong color
-				if ( lightRegs[ registers[0] ] < 0.001f ) {
-					lightRegs[ registers[0] ] = 0.0f;
-				}
-				if ( lightRegs[ registers[1] ] < 0.001f ) {
-					lightRegs[ registers[1] ] = 0.0f;
-				}
-				if ( lightRegs[ registers[2] ] < 0.001f ) {
-					lightRegs[ registers[2] ] = 0.0f;
-				}
-
-				// FIXME:	when using the following values the light shows up bright red when using nvidia drivers/hardware
-				//			this seems to have been fixed ?
-				//lightRegs[ registers[0] ] = 1.5143074e-005f;
-				//lightRegs[ registers[1] ] = 1.5483369e-005f;
-				//lightRegs[ registers[2] ] = 1.7014690e-005f;
-
-				if ( lightRegs[ registers[0] ] > 0.0f ||
-						lightRegs[ registers[1] ] > 0.0f ||
-							lightRegs[ registers[2] ] > 0.0f ) {
-					break;
-				}
-			}
-			if ( lightStageNum == lightShader->GetNumStages() ) {
-				// we went through all the stages and didn't find one that adds anything
+			// evaluate the light shader registers
+			float *lightRegs =(float *)R_FrameAlloc( lightShader->GetNumRegisters() * sizeof( float ) );
+			vLight->shaderRegisters = lightRegs;
+			if ( !R_EvaluateLightShader( light, lightRegs ) ) {
 				// remove the light from the viewLights list, and change its frame marker
 				// so interaction generation doesn't think the light is visible and
 				// create a shadow for it
@@ -960,7 +1357,7 @@ void R_AddLightSurfaces( void ) {
 		if ( r_useLightScissors.GetBool() ) {
 			// calculate the screen area covered by the light frustum
 			// which will be used to crop the stencil cull
-			idScreenRect scissorRect = R_CalcLightScissorRectangle( vLight );
+			idScreenRect scissorRect = job ? job->scissorRect : R_CalcLightScissorRectangle( vLight );
 			// intersect with the portal crossing scissor rectangle
 			vLight->scissorRect.Intersect( scissorRect );
 
@@ -992,62 +1389,18 @@ void R_AddLightSurfaces( void ) {
 		// create interactions with all entities the light may touch, and add viewEntities
 		// that may cast shadows, even if they aren't directly visible.  Any real work
 		// will be deferred until we walk through the viewEntities
-		tr.viewDef->renderWorld->CreateLightDefInteractions( light );
-		tr.pc.c_viewLights++;
-
-		// fog lights will need to draw the light frustum triangles, so make sure they
-		// are in the vertex cache
-		if ( lightShader->IsFogLight() ) {
-			if ( !light->frustumTris->ambientCache ) {
-				if ( !R_CreateAmbientCache( light->frustumTris, false ) ) {
-					// skip if we are out of vertex memory
-					continue;
-				}
-			}
-			// touch the surface so it won't get purged
-			vertexCache.Touch( light->frustumTris->ambientCache );
+		if ( job ) {
+			tr.viewDef->renderWorld->LinkLightDefInteractions( light, job->entityRefs, job->numEntityRefs );
+		} else {
+			tr.viewDef->renderWorld->CreateLightDefInteractions( light );
 		}
+		tr.pc.c_viewLights++;
 
-		// add the prelight shadows for the static world geometry
-		if ( light->parms.prelightModel && r_useOptimizedShadows.GetBool() ) {
-
-			if ( !light->parms.prelightModel->NumSurfaces() ) {
-				common->Error( "no surfs in prelight model '%s'", light->parms.prelightModel->Name() );
-			}
-
-			srfTriangles_t	*tri = light->parms.prelightModel->Surface( 0 )->geometry;
-			if ( !tri->shadowVertexes ) {
-				common->Error( "R_AddLightSurfaces: prelight model '%s' without shadowVertexes", light->parms.prelightModel->Name() );
-			}
-
-			// these shadows will all have valid bounds, and can be culled normally
-			if ( r_useShadowCulling.GetBool() ) {
-				if ( R_CullLocalBox( tri->bounds, tr.viewDef->worldSpace.modelMatrix, 5, tr.viewDef->frustum ) ) {
-					continue;
-				}
-			}
-
-			// if we have been purged, re-upload the shadowVertexes
-			if ( !tri->shadowCache ) {
-				R_CreatePrivateShadowCache( tri );
-				if ( !tri->shadowCache ) {
-					continue;
-				}
-			}
-
-			// touch the shadow surface so it won't get purged
-			vertexCache.Touch( tri->shadowCache );
-
-			if ( !tri->indexCache && r_useIndexBuffers.GetBool() ) {
-				vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
-			}
-			if ( tri->indexCache ) {
-				vertexCache.Touch( tri->indexCache );
-			}
-
-			R_LinkLightSurf( &vLight->globalShadows, tri, NULL, light, NULL, vLight->scissorRect, true /* FIXME? */ );
-		}
+		R_AddLightStaticSurfaces( vLight );
 	}
+
+	timer.Stop();
+	tr.pc.frontEndLightMsec += timer.Milliseconds();
 }
 
 //===============================================================================================================
@@ -1177,23 +1530,16 @@ idRenderModel *R_EntityDefDynamicModel( idRenderEntityLocal *def ) {
 
 /*
 =================
-R_AddDrawSurf
+R_LinkDrawSurf
+
+Assigns the sort value and adds the surface to the view's drawSurfs list
 =================
 */
-void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const renderEntity_t *renderEntity,
-					const idMaterial *shader, const idScreenRect &scissor ) {
-	drawSurf_t		*drawSurf;
-	const float		*shaderParms;
-	static float	refRegs[MAX_EXPRESSION_REGISTERS];	// don't put on stack, or VC++ will do a page touch
-	float			generatedShaderParms[MAX_ENTITY_SHADER_PARMS];
+static void R_LinkDrawSurf( drawSurf_t *drawSurf ) {
+	drawSurf->sourceGeo = drawSurf->geo;
+	drawSurf->geo = R_CopyDrawSurfGeo( drawSurf->geo );
 
-	drawSurf = (drawSurf_t *)R_FrameAlloc( sizeof( *drawSurf ) );
-	drawSurf->geo = tri;
-	drawSurf->space = space;
-	drawSurf->material = shader;
-	drawSurf->scissorRect = scissor;
-	drawSurf->sort = shader->GetSort() + tr.sortOffset;
-	drawSurf->dsFlags = 0;
+	drawSurf->sort = drawSurf->material->GetSort() + tr.sortOffset;
 
 	// bumping this offset each time causes surfaces with equal sort orders to still
 	// deterministically draw in the order they are added
@@ -1216,6 +1562,60 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 	}
 	tr.viewDef->drawSurfs[tr.viewDef->numDrawSurfs] = drawSurf;
 	tr.viewDef->numDrawSurfs++;
+}
+
+/*
+=================
+R_EntityShaderParms
+
+A reference shader will take the calculated stage color value from another shader
+and use that for the parm0-parm3 of the current shader, which allows a stage of
+a light model and light flares to pick up different flashing tables from
+different light shaders.
+
+refRegs must have room for the registers of the reference shader.
+=================
+*/
+static const float *R_EntityShaderParms( const renderEntity_t *renderEntity, float *refRegs, float generatedShaderParms[MAX_ENTITY_SHADER_PARMS] ) {
+	if ( renderEntity->referenceShader ) {
+		// evaluate the reference shader to find our shader parms
+		const shaderStage_t *pStage;
+
+		renderEntity->referenceShader->EvaluateRegisters( refRegs, renderEntity->shaderParms, tr.viewDef, renderEntity->referenceSound );
+		pStage = renderEntity->referenceShader->GetStage(0);
+
+		memcpy( generatedShaderParms, renderEntity->shaderParms, MAX_ENTITY_SHADER_PARMS * sizeof( float ) );
+		generatedShaderParms[0] = refRegs[ pStage->color.registers[0] ];
+		generatedShaderParms[1] = refRegs[ pStage->color.registers[1] ];
+		generatedShaderParms[2] = refRegs[ pStage->color.registers[2] ];
+
+		return generatedShaderParms;
+	}
+
+	// evaluate with the entityDef's shader parms
+	return renderEntity->shaderParms;
+}
+
+/*
+=================
+R_AddDrawSurf
+=================
+*/
+void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const renderEntity_t *renderEntity,
+					const idMaterial *shader, const idScreenRect &scissor ) {
+	drawSurf_t		*drawSurf;
+	const float		*shaderParms;
+	static float	refRegs[MAX_EXPRESSION_REGISTERS];	// don't put on stack, or VC++ will do a page touch
+	float			generatedShaderParms[MAX_ENTITY_SHADER_PARMS];
+
+	drawSurf = (drawSurf_t *)R_FrameAlloc( sizeof( *drawSurf ) );
+	drawSurf->geo = tri;
+	drawSurf->space = space;
+	drawSurf->material = shader;
+	drawSurf->scissorRect = scissor;
+	drawSurf->dsFlags = 0;
+
+	R_LinkDrawSurf( drawSurf );
 
 	// process the shader expressions for conditionals / color / texcoords
 	const float	*constRegs = shader->ConstantRegisters();
@@ -1226,27 +1626,7 @@ void R_AddDrawSurf( const srfTriangles_t *tri, const viewEntity_t *space, const
 		float *regs = (float *)R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ) );
 		drawSurf->shaderRegisters = regs;
 
-		// a reference shader will take the calculated stage color value from another shader
-		// and use that for the parm0-parm3 of the current shader, which allows a stage of
-		// a light model and light flares to pick up different flashing tables from
-		// different light shaders
-		if ( renderEntity->referenceShader ) {
-			// evaluate the reference shader to find our shader parms
-			const shaderStage_t *pStage;
-
-			renderEntity->referenceShader->EvaluateRegisters( refRegs, renderEntity->shaderParms, tr.viewDef, renderEntity->referenceSound );
-			pStage = renderEntity->referenceShader->GetStage(0);
-
-			memcpy( generatedShaderParms, renderEntity->shaderParms, sizeof( generatedShaderParms ) );
-			generatedShaderParms[0] = refRegs[ pStage->color.registers[0] ];
-			generatedShaderParms[1] = refRegs[ pStage->color.registers[1] ];
-			generatedShaderParms[2] = refRegs[ pStage->color.registers[2] ];
-
-			shaderParms = generatedShaderParms;
-		} else {
-			// evaluate with the entityDef's shader parms
-			shaderParms = renderEntity->shaderParms;
-		}
+		shaderParms = R_EntityShaderParms( renderEntity, refRegs, generatedShaderParms );
 
 		float oldFloatTime;
 		int oldTime;
@@ -1446,120 +1826,324 @@ idScreenRect R_CalcEntityScissorRectangle( viewEntity_t *vEntity ) {
 	return R_ScreenRectFromViewFrustumBounds( bounds );
 }
 
+typedef struct {
+	viewEntity_t *			vEntity;
+	drawSurf_t **			drawSurfs;		// NULL if the ambient surfaces are added on the main thread
+	int						numDrawSurfs;
+} modelJob_t;
+
 /*
 ===================
-R_AddModelSurfaces
+R_AddModelSurfacesJob
 
-Here is where dynamic models actually get instantiated, and necessary
-interactions get created.  This is all done on a sort-by-model basis
-to keep source data in cache (most likely L2) as any interactions and
-shadows are generated, since dynamic models will typically be lit by
-two or more lights.
+Clips the entity scissor rect, and for static models that don't need
+anything from the game or the vertex cache, culls the surfaces and
+evaluates their shaders.  The drawSurfs are linked in order by
+R_AddViewEntitySurfaces.
 ===================
 */
-void R_AddModelSurfaces( void ) {
-	viewEntity_t		*vEntity;
-	idInteraction		*inter, *next;
+static void R_AddModelSurfacesJob( int item, int threadNum, void *data ) {
+	modelJob_t			*job = (modelJob_t *)data + item;
+	viewEntity_t		*vEntity = job->vEntity;
+	idRenderEntityLocal	*def = vEntity->entityDef;
+	frameArena_t		*arena = &frontEndArenas[threadNum];
 	idRenderModel		*model;
+	drawSurf_t			**drawSurfs;
+	int					numDrawSurfs;
 
-	// clear the ambient surface list
-	tr.viewDef->numDrawSurfs = 0;
-	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
+	job->drawSurfs = NULL;
+	job->numDrawSurfs = 0;
+
+	if ( r_useEntityScissors.GetBool() ) {
+		// calculate the screen area covered by the entity
+		idScreenRect scissorRect = R_CalcEntityScissorRectangle( vEntity );
+		// intersect with the portal crossing scissor rectangle
+		vEntity->scissorRect.Intersect( scissorRect );
+	}
+
+	if ( vEntity->scissorRect.IsEmpty() ) {
+		return;
+	}
+
+	// callbacks and time groups go through the game, and the sound
+	// amplitude cache on the emitter isn't thread safe
+	if ( def->parms.callback || def->parms.timeGroup || def->parms.referenceSound ) {
+		return;
+	}
+	model = def->parms.hModel;
+	if ( model == NULL || model->IsDynamicModel() != DM_STATIC || model->NumSurfaces() <= 0 ) {
+		return;
+	}
 
-	// go through each entity that is either visible to the view, or to
-	// any light that intersects the view (for shadows)
-	for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+	drawSurfs = (drawSurf_t **)R_FrameArenaAlloc( arena, model->NumSurfaces() * sizeof( drawSurfs[0] ) );
+	numDrawSurfs = 0;
 
-		if ( r_useEntityScissors.GetBool() ) {
+	for ( int i = 0 ; i < model->NumSurfaces() ; i++ ) {
+		const modelSurface_t	*surf = model->Surface( i );
+
+		// for debugging, only show a single surface at a time
+		if ( r_singleSurface.GetInteger() >= 0 && i != r_singleSurface.GetInteger() ) {
+			continue;
+		}
+
+		const srfTriangles_t *tri = surf->geometry;
+		if ( !tri || !tri->numIndexes ) {
+			continue;
+		}
+		const idMaterial *shader = R_RemapShaderBySkin( surf->shader, def->parms.customSkin, def->parms.customShader );
+
+		R_GlobalShaderOverride( &shader );
+
+		if ( !shader || !shader->IsDrawn() ) {
+			continue;
+		}
+
+		if ( R_CullLocalBox( tri->bounds, vEntity->modelMatrix, 5, tr.viewDef->frustum ) ) {
+			continue;
+		}
+
+		// deforms and sky texgens allocate vertex cache memory, and guis generate subviews
+		if ( shader->Deform() != DFRM_NONE || shader->Texgen() == TG_SKYBOX_CUBE || shader->Texgen() == TG_WOBBLESKY_CUBE
+			|| shader->GetEntityGui() || shader->GlobalGui() ) {
+			return;
+		}
+
+		drawSurf_t *drawSurf = (drawSurf_t *)R_FrameArenaAlloc( arena, sizeof( *drawSurf ) );
+		drawSurf->geo = tri;
+		drawSurf->space = vEntity;
+		drawSurf->material = shader;
+		drawSurf->scissorRect = vEntity->scissorRect;
+		drawSurf->dsFlags = 0;
+
+		// process the shader expressions for conditionals / color / texcoords
+		const float	*constRegs = shader->ConstantRegisters();
+		if ( constRegs ) {
+			// shader only uses constant values
+			drawSurf->shaderRegisters = constRegs;
+		} else {
+			float	generatedShaderParms[MAX_ENTITY_SHADER_PARMS];
+			float	*refRegs = NULL;
+			float	*regs;
+
+			if ( def->parms.referenceShader ) {
+				refRegs = (float *)R_FrameArenaAlloc( arena, def->parms.referenceShader->GetNumRegisters() * sizeof( float ) );
+			}
+			regs = (float *)R_FrameArenaAlloc( arena, shader->GetNumRegisters() * sizeof( float ) );
+			shader->EvaluateRegisters( regs, R_EntityShaderParms( &def->parms, refRegs, generatedShaderParms ), tr.viewDef, NULL );
+			drawSurf->shaderRegisters = regs;
+		}
+
+		drawSurfs[numDrawSurfs++] = drawSurf;
+	}
+
+	job->drawSurfs = drawSurfs;
+	job->numDrawSurfs = numDrawSurfs;
+}
+
+/*
+===================
+R_LinkAmbientDrawSurfs
+
+Adds the surfaces prepared by R_AddModelSurfacesJob, doing the
+vertex cache work that R_AddAmbientDrawsurfs would have done.
+===================
+*/
+static void R_LinkAmbientDrawSurfs( viewEntity_t *vEntity, const modelJob_t *job ) {
+	idRenderEntityLocal	*def = vEntity->entityDef;
+
+	for ( int i = 0 ; i < job->numDrawSurfs ; i++ ) {
+		drawSurf_t		*drawSurf = job->drawSurfs[i];
+		srfTriangles_t	*tri = const_cast<srfTriangles_t *>( drawSurf->geo );
+
+		def->visibleCount = tr.viewCount;
+
+		// make sure we have an ambient cache
+		if ( !R_CreateAmbientCache( tri, drawSurf->material->ReceivesLighting() ) ) {
+			// don't add anything if the vertex cache was too full to give us an ambient cache
+			return;
+		}
+		// touch it so it won't get purged
+		vertexCache.Touch( tri->ambientCache );
+
+		if ( r_useIndexBuffers.GetBool() && !tri->indexCache ) {
+			vertexCache.Alloc( tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ), &tri->indexCache, true );
+		}
+		if ( tri->indexCache ) {
+			vertexCache.Touch( tri->indexCache );
+		}
+
+		// add the surface for drawing
+		R_LinkDrawSurf( drawSurf );
+
+		// ambientViewCount is used to allow light interactions to be rejected
+		// if the ambient surface isn't visible at all
+		tri->ambientViewCount = tr.viewCount;
+	}
+
+	// add the lightweight decal surfaces
+	for ( idRenderModelDecal *decal = def->decals; decal; decal = decal->Next() ) {
+		decal->AddDecalDrawSurf( vEntity );
+	}
+}
+
+/*
+===================
+R_AddViewEntitySurfaces
+
+Instantiates the model and adds the ambient surfaces and active interactions
+for a single viewEntity.  If job is non-NULL, it has already been run.
+===================
+*/
+static void R_AddViewEntitySurfaces( viewEntity_t *vEntity, const modelJob_t *job ) {
+	idInteraction		*inter, *next;
+	idRenderModel		*model;
+
+	if ( r_useEntityScissors.GetBool() ) {
+		// the job has already done this
+		if ( !job ) {
 			// calculate the screen area covered by the entity
 			idScreenRect scissorRect = R_CalcEntityScissorRectangle( vEntity );
 			// intersect with the portal crossing scissor rectangle
 			vEntity->scissorRect.Intersect( scissorRect );
+		}
 
-			if ( r_showEntityScissors.GetBool() ) {
-				R_ShowColoredScreenRect( vEntity->scissorRect, vEntity->entityDef->index );
-			}
+		if ( r_showEntityScissors.GetBool() ) {
+			R_ShowColoredScreenRect( vEntity->scissorRect, vEntity->entityDef->index );
 		}
+	}
 
-		float oldFloatTime;
-		int oldTime;
+	float oldFloatTime;
+	int oldTime;
 
-		game->SelectTimeGroup( vEntity->entityDef->parms.timeGroup );
+	game->SelectTimeGroup( vEntity->entityDef->parms.timeGroup );
 
-		if ( vEntity->entityDef->parms.timeGroup ) {
-			oldFloatTime = tr.viewDef->floatTime;
-			oldTime = tr.viewDef->renderView.time;
+	if ( vEntity->entityDef->parms.timeGroup ) {
+		oldFloatTime = tr.viewDef->floatTime;
+		oldTime = tr.viewDef->renderView.time;
+
+		tr.viewDef->floatTime = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup ) * 0.001;
+		tr.viewDef->renderView.time = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup );
+	}
 
-			tr.viewDef->floatTime = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup ) * 0.001;
-			tr.viewDef->renderView.time = game->GetTimeGroupTime( vEntity->entityDef->parms.timeGroup );
+	if ( tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 1 ) {
+		if ( vEntity->entityDef->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
 		}
+		return;
+	} else if ( !tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 2 ) {
+		if ( vEntity->entityDef->parms.timeGroup ) {
+			tr.viewDef->floatTime = oldFloatTime;
+			tr.viewDef->renderView.time = oldTime;
+		}
+		return;
+	}
 
-		if ( tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 1 ) {
+	// add the ambient surface if it has a visible rectangle
+	if ( !vEntity->scissorRect.IsEmpty() ) {
+		model = R_EntityDefDynamicModel( vEntity->entityDef );
+		if ( model == NULL || model->NumSurfaces() <= 0 ) {
 			if ( vEntity->entityDef->parms.timeGroup ) {
 				tr.viewDef->floatTime = oldFloatTime;
 				tr.viewDef->renderView.time = oldTime;
 			}
-			continue;
-		} else if ( !tr.viewDef->isXraySubview && vEntity->entityDef->parms.xrayIndex == 2 ) {
-			if ( vEntity->entityDef->parms.timeGroup ) {
-				tr.viewDef->floatTime = oldFloatTime;
-				tr.viewDef->renderView.time = oldTime;
-			}
-			continue;
+			return;
 		}
 
-		// add the ambient surface if it has a visible rectangle
-		if ( !vEntity->scissorRect.IsEmpty() ) {
-			model = R_EntityDefDynamicModel( vEntity->entityDef );
-			if ( model == NULL || model->NumSurfaces() <= 0 ) {
-				if ( vEntity->entityDef->parms.timeGroup ) {
-					tr.viewDef->floatTime = oldFloatTime;
-					tr.viewDef->renderView.time = oldTime;
-				}
-				continue;
-			}
-
-			R_AddAmbientDrawsurfs( vEntity );
-			tr.pc.c_visibleViewEntities++;
+		if ( job && job->drawSurfs ) {
+			R_LinkAmbientDrawSurfs( vEntity, job );
 		} else {
-			tr.pc.c_shadowViewEntities++;
+			R_AddAmbientDrawsurfs( vEntity );
 		}
+		tr.pc.c_visibleViewEntities++;
+	} else {
+		tr.pc.c_shadowViewEntities++;
+	}
 
-		//
-		// for all the entity / light interactions on this entity, add them to the view
-		//
-		if ( tr.viewDef->isXraySubview ) {
-			if ( vEntity->entityDef->parms.xrayIndex == 2 ) {
-				for ( inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
-					next = inter->entityNext;
-					if ( inter->lightDef->viewCount != tr.viewCount ) {
-						continue;
-					}
-					inter->AddActiveInteraction();
-				}
-			}
-		} else {
-			// all empty interactions are at the end of the list so once the
-			// first is encountered all the remaining interactions are empty
+	//
+	// for all the entity / light interactions on this entity, add them to the view
+	//
+	if ( tr.viewDef->isXraySubview ) {
+		if ( vEntity->entityDef->parms.xrayIndex == 2 ) {
 			for ( inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
 				next = inter->entityNext;
-
-				// skip any lights that aren't currently visible
-				// this is run after any lights that are turned off have already
-				// been removed from the viewLights list, and had their viewCount cleared
 				if ( inter->lightDef->viewCount != tr.viewCount ) {
 					continue;
 				}
 				inter->AddActiveInteraction();
 			}
 		}
+	} else {
+		// all empty interactions are at the end of the list so once the
+		// first is encountered all the remaining interactions are empty
+		for ( inter = vEntity->entityDef->firstInteraction; inter != NULL && !inter->IsEmpty(); inter = next ) {
+			next = inter->entityNext;
+
+			// skip any lights that aren't currently visible
+			// this is run after any lights that are turned off have already
+			// been removed from the viewLights list, and had their viewCount cleared
+			if ( inter->lightDef->viewCount != tr.viewCount ) {
+				continue;
+			}
+			inter->AddActiveInteraction();
+		}
+	}
 
-		if ( vEntity->entityDef->parms.timeGroup ) {
-			tr.viewDef->floatTime = oldFloatTime;
-			tr.viewDef->renderView.time = oldTime;
+	if ( vEntity->entityDef->parms.timeGroup ) {
+		tr.viewDef->floatTime = oldFloatTime;
+		tr.viewDef->renderView.time = oldTime;
+	}
+}
+
+/*
+===================
+R_AddModelSurfaces
+
+Here is where dynamic models actually get instantiated, and necessary
+interactions get created.  This is all done on a sort-by-model basis
+to keep source data in cache (most likely L2) as any interactions and
+shadows are generated, since dynamic models will typically be lit by
+two or more lights.
+===================
+*/
+void R_AddModelSurfaces( void ) {
+	viewEntity_t		*vEntity;
+	modelJob_t			*jobs;
+	int					numJobs;
+	idTimer				timer;
+
+	timer.Start();
+
+	// clear the ambient surface list
+	tr.viewDef->numDrawSurfs = 0;
+	tr.viewDef->maxDrawSurfs = 0;	// will be set to INITIAL_DRAWSURFS on R_AddDrawSurf
+
+	// the material override and bounds checking tools aren't thread safe
+	if ( R_NumFrontEndThreads() > 0 && !r_checkBounds.GetBool() && r_materialOverride.GetString()[0] == '\0' ) {
+		numJobs = 0;
+		for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+			numJobs++;
 		}
+		jobs = (modelJob_t *)R_FrameAlloc( numJobs * sizeof( jobs[0] ) );
+		numJobs = 0;
+		for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+			jobs[numJobs++].vEntity = vEntity;
+		}
+		R_RunFrontEndJobs( R_AddModelSurfacesJob, jobs, numJobs );
 
+		for ( int i = 0 ; i < numJobs ; i++ ) {
+			R_AddViewEntitySurfaces( jobs[i].vEntity, &jobs[i] );
+		}
+	} else {
+		// go through each entity that is either visible to the view, or to
+		// any light that intersects the view (for shadows)
+		for ( vEntity = tr.viewDef->viewEntitys; vEntity; vEntity = vEntity->next ) {
+			R_AddViewEntitySurfaces( vEntity, NULL );
+		}
 	}
+
+	timer.Stop();
+	tr.pc.frontEndModelMsec += timer.Milliseconds();
 }
 
 /*
@@ -1617,3 +2201,57 @@ void R_RemoveUnecessaryViewLights( void ) {
 		}
 	}
 }
+
+/*
+=====================
+R_AddViewLightOccluders
+
+The shadow buffer backend renders every surface that interacts with a light
+into the shadow map.  The interaction chain of a lightDef changes while the
+front end runs the next frame, so the surfaces are copied to frame memory.
+=====================
+*/
+void R_AddViewLightOccluders( void ) {
+	viewLight_t		*vLight;
+
+	if ( idStr::Icmp( r_renderer.GetString(), "exp" ) ) {
+		return;
+	}
+
+	for ( vLight = tr.viewDef->viewLights ; vLight ; vLight = vLight->next ) {
+		for ( idInteraction *inter = vLight->lightDef->firstInteraction ; inter ; inter = inter->lightNext ) {
+			const idRenderEntityLocal *entityDef = inter->entityDef;
+			if ( !entityDef ) {
+				continue;
+			}
+			if ( inter->numSurfaces < 1 ) {
+				continue;
+			}
+
+			viewOccluder_t *occluder = (viewOccluder_t *)R_FrameAlloc( sizeof( *occluder ) );
+			memcpy( occluder->modelMatrix, entityDef->modelMatrix, sizeof( occluder->modelMatrix ) );
+			occluder->referenceBounds = entityDef->referenceBounds;
+			occluder->surfaces = (viewOccluderSurf_t *)R_FrameAlloc( inter->numSurfaces * sizeof( occluder->surfaces[0] ) );
+			occluder->numSurfaces = 0;
+
+			for ( int i = 0 ; i < inter->numSurfaces ; i++ ) {
+				const surfaceInteraction_t *surfInt = &inter->surfaces[i];
+				if ( !surfInt->ambientTris ) {
+					continue;
+				}
+				if ( !surfInt->ambientTris->ambientCache ) {
+					if ( !R_CreateAmbientCache( surfInt->ambientTris, false ) ) {
+						continue;
+					}
+				}
+				viewOccluderSurf_t *surf = &occluder->surfaces[occluder->numSurfaces++];
+				surf->ambientTris = R_CopyDrawSurfGeo( surfInt->ambientTris );
+				surf->shader = surfInt->shader;
+				surf->expCulled = 0;
+			}
+
+			occluder->next = vLight->occluders;
+			vLight->occluders = occluder;
+		}
+	}
+}
@@ -110,6 +110,7 @@ static const int	DSF_VIEW_INSIDE_SHADOW	= 1;
 
 typedef struct drawSurf_s {
 	const srfTriangles_t	*geo;
+	const srfTriangles_t	*sourceGeo;	// the model surface, geo is a frame copy of it with the back end thread
 	const struct viewEntity_s *space;
 	const idMaterial		*material;	// may be NULL for shadow volumes
 	float					sort;		// material->sort, modified by gui / entity sort offsets
@@ -295,6 +296,22 @@ public:
 // which the front end may be modifying simultaniously if running in SMP mode.
 // a viewLight may exist even without any surfaces, and may be relevent for fogging,
 // but should never exist if its volume does not intersect the view frustum
+// the shadow casting surfaces of an entity lit by a viewLight, copied from the
+// interaction chain for the shadow buffer back end
+typedef struct {
+	const srfTriangles_t *	ambientTris;
+	const idMaterial *		shader;
+	int						expCulled;
+} viewOccluderSurf_t;
+
+typedef struct viewOccluder_s {
+	struct viewOccluder_s *	next;
+	float					modelMatrix[16];
+	idBounds				referenceBounds;
+	int						numSurfaces;
+	viewOccluderSurf_t *	surfaces;
+} viewOccluder_t;
+
 typedef struct viewLight_s {
 	struct viewLight_s *	next;
 
@@ -326,6 +343,8 @@ typedef struct viewLight_s {
 	const idMaterial *		lightShader;				// light shader used by backend
 	const float	*			shaderRegisters;			// shader registers used by backend
 	idImage *				falloffImage;				// falloff image used by backend
+	renderLight_t			parms;						// light parms used by the shadow buffer backend
+	viewOccluder_t *		occluders;					// shadow casters used by the shadow buffer backend
 
 	const struct drawSurf_s	*globalShadows;				// shadow everything
 	const struct drawSurf_s	*localInteractions;			// don't get local shadows
@@ -356,6 +375,7 @@ typedef struct viewEntity_s {
 
 	bool				weaponDepthHack;
 	float				modelDepthHack;
+	int					xrayIndex;
 
 	float				modelMatrix[16];		// local coords to global coords
 	float				modelViewMatrix[16];	// local coords to eye coords
@@ -522,7 +542,7 @@ typedef struct frameMemoryBlock_s {
 // all of the information needed by the back end must be
 // contained in a frameData_t.  This entire structure is
 // duplicated so the front and back end can run in parallel
-// on an SMP machine (OBSOLETE: this capability has been removed)
+// on an SMP machine
 typedef struct {
 	// one or more blocks of memory for all frame
 	// temporary allocations
@@ -542,7 +562,11 @@ typedef struct {
 	emptyCommand_t	*cmdHead, *cmdTail;		// may be of other command type based on commandId
 } frameData_t;
 
-extern	frameData_t	*frameData;
+const int NUM_FRAME_DATA = 2;
+
+extern	frameData_t	*frameData;						// the one the front end is building
+extern	frameData_t	*smpFrameData[NUM_FRAME_DATA];
+extern	int			smpFrame;
 
 //=======================================================================
 
@@ -588,6 +612,9 @@ typedef struct {
 	int		c_entityUpdates, c_lightUpdates, c_entityReferences, c_lightReferences;
 	int		c_guiSurfs;
 	int		frontEndMsec;		// sum of time in all RE_RenderScene's in a frame
+	float	frontEndLightMsec;	// time in R_AddLightSurfaces
+	float	frontEndModelMsec;	// time in R_AddModelSurfaces
+	float	smpStallMsec;		// time the front end waited for the back end thread
 } performanceCounters_t;
 
 
@@ -857,6 +884,7 @@ extern idCVar r_useInteractionTable;	// create a full entityDefs * lightDefs tab
 extern idCVar r_useNodeCommonChildren;	// stop pushing reference bounds early when possible
 extern idCVar r_useSilRemap;			// 1 = consider verts with the same XYZ, but different ST the same for shadows
 extern idCVar r_useCulling;				// 0 = none, 1 = sphere, 2 = sphere + box
+extern idCVar r_useBatchCulling;		// cull reference bounds in batches with the SIMD processor
 extern idCVar r_useLightCulling;		// 0 = none, 1 = box, 2 = exact clip of polyhedron faces
 extern idCVar r_useLightScissors;		// 1 = use custom scissor rectangle for each light
 extern idCVar r_useClippedLightScissors;// 0 = full screen when near clipped, 1 = exact when near clipped, 2 = exact always
@@ -885,6 +913,8 @@ extern idCVar r_useIndexBuffers;		// if 0, don't use ARB_vertex_buffer_object fo
 extern idCVar r_useEntityCallbacks;		// if 0, issue the callback immediately at update time, rather than defering
 extern idCVar r_lightAllBackFaces;		// light all the back faces, even when they would be shadowed
 extern idCVar r_useDepthBoundsTest;     // use depth bounds test to reduce shadow fill
+extern idCVar r_frontEndJobs;			// number of jobs besides the main thread for the light and model setup, 0 = serial
+extern idCVar r_smp;					// run the back end in its own thread, overlapped with the next frame's front end
 
 extern idCVar r_skipPostProcess;		// skip all post-process renderings
 extern idCVar r_skipSuppress;			// ignore the per-view suppressions
@@ -928,7 +958,7 @@ extern idCVar r_showLightScale;			// report the scale factor applied to drawing
 extern idCVar r_showIntensity;			// draw the screen colors based on intensity, red = 0, green = 128, blue = 255
 extern idCVar r_showDefs;				// report the number of modeDefs and lightDefs in view
 extern idCVar r_showTrace;				// show the intersection of an eye trace with the world
-extern idCVar r_showSmp;				// show which end (front or back) is blocking
+extern idCVar r_showSmp;				// report back end, stall and overlap times for the back end thread
 extern idCVar r_showDepth;				// display the contents of the depth buffer and the depth range
 extern idCVar r_showImages;				// draw all images to screen instead of rendering
 extern idCVar r_showTris;				// enables wireframe rendering of the world
@@ -955,6 +985,7 @@ extern idCVar r_showSurfaces;			// report surface/light/shadow counts
 extern idCVar r_showPrimitives;			// report vertex/index/draw counts
 extern idCVar r_showPortals;			// draw portal outlines in color based on passed / not passed
 extern idCVar r_showAlloc;				// report alloc/free counts
+extern idCVar r_showFrontEndJobs;		// report light and model setup time for serial and job modes
 extern idCVar r_showSkel;				// draw the skeleton when model animates
 extern idCVar r_showOverDraw;			// show overdraw
 extern idCVar r_jointNameScale;			// size of joint names when r_showskel is set to 1
@@ -1137,6 +1168,10 @@ bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int nu
 bool R_RadiusCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 bool R_CornerCullLocalBox( const idBounds &bounds, const float modelMatrix[16], int numPlanes, const idPlane *planes );
 
+// culls many boxes against the same planes at once, culled[i] is set for each box outside
+const int CULL_BATCH_SIZE = 64;
+void R_CullLocalBoxes( byte *culled, const idBounds * const *bounds, const float * const *modelMatrices, int numBoxes, int numPlanes, const idPlane *planes );
+
 void R_AxisToModelMatrix( const idMat3 &axis, const idVec3 &origin, float modelMatrix[16] );
 
 // note that many of these assume a normalized matrix, and will not work with scaled axis
@@ -1207,6 +1242,7 @@ void R_SetLightProject( idPlane lightProject[4], const idVec3 origin, const idVe
 void R_AddLightSurfaces( void );
 void R_AddModelSurfaces( void );
 void R_RemoveUnecessaryViewLights( void );
+void R_AddViewLightOccluders( void );
 
 void R_FreeDerivedData( void );
 void R_ReCreateWorldReferences( void );
@@ -1572,6 +1608,34 @@ void *R_StaticAlloc( int bytes );		// just malloc with error checking
 void *R_ClearedStaticAlloc( int bytes );	// with memset
 void R_StaticFree( void *data );
 
+/*
+============================================================
+
+FRONT END JOBS
+
+============================================================
+*/
+
+const int MAX_FRONTEND_THREADS = 8;		// jobs, including the main thread
+
+// frame temporary memory for a single thread, refilled in chunks from R_FrameAlloc
+typedef struct {
+	byte *		base;
+	int			size;
+	int			used;
+} frameArena_t;
+
+extern frameArena_t	frontEndArenas[MAX_FRONTEND_THREADS];
+
+typedef void (*frontEndJob_t)( int item, int threadNum, void *data );
+
+void R_InitFrontEndJobs( void );
+void R_ShutdownFrontEndJobs( void );
+int R_NumFrontEndThreads( void );
+void R_RunFrontEndJobs( frontEndJob_t job, void *data, int numItems );
+void *R_FrameArenaAlloc( frameArena_t *arena, int bytes );
+void R_ReportFrontEndJobs( void );
+
 
 /*
 =============================================================
@@ -1616,6 +1680,17 @@ void RB_ShowImages( void );
 
 void RB_ExecuteBackEndCommands( const emptyCommand_t *cmds );
 
+// the back end thread is started with the GL context if r_smp is set
+void R_InitBackEndThread( void );
+void R_ShutdownBackEndThread( void );
+bool R_BackEndThreadActive( void );
+// hands the command list to the back end thread, or executes it directly
+void R_IssueBackEndCommands( const emptyCommand_t *cmds );
+// waits for the back end thread and gives the GL context back to the calling
+// thread, must be called before the front end touches GL or the back end state
+void R_SyncBackEnd( void );
+void R_ReportSmp( void );
+
 
 /*
 =============================================================
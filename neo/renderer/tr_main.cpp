@@ -179,13 +179,16 @@ void R_ShowColoredScreenRect( const idScreenRect &rect, int colorIndex ) {
 /*
 ====================
 R_ToggleSmpFrame
+
+Switches the front end to the other frameData.  The back end
+must have finished with that frame, which R_SyncBackEnd guarantees
+before each new command list is issued.
 ====================
 */
 void R_ToggleSmpFrame( void ) {
 	if ( r_lockSurfaces.GetBool() ) {
 		return;
 	}
-	R_FreeDeferredTriSurfs( frameData );
 
 	// clear frame-temporary data
 	frameData_t		*frame;
@@ -194,7 +197,11 @@ void R_ToggleSmpFrame( void ) {
 	// update the highwater mark
 	R_CountFrameData();
 
-	frame = frameData;
+	smpFrame++;
+	frame = frameData = smpFrameData[ smpFrame % NUM_FRAME_DATA ];
+
+	// anything freed the last time this frame was built can go now
+	R_FreeDeferredTriSurfs( frame );
 
 	// reset the memory allocation to the first block
 	frame->alloc = frame->memory;
@@ -221,20 +228,26 @@ void R_ShutdownFrameData( void ) {
 	frameData_t *frame;
 	frameMemoryBlock_t *block;
 
+	// the back end thread may still be reading the last frame
+	R_SyncBackEnd();
+
 	// free any current data
-	frame = frameData;
-	if ( !frame ) {
-		return;
-	}
+	for ( int i = 0 ; i < NUM_FRAME_DATA ; i++ ) {
+		frame = smpFrameData[i];
+		if ( !frame ) {
+			continue;
+		}
 
-	R_FreeDeferredTriSurfs( frame );
+		R_FreeDeferredTriSurfs( frame );
 
-	frameMemoryBlock_t *nextBlock;
-	for ( block = frame->memory ; block ; block = nextBlock ) {
-		nextBlock = block->next;
-		Mem_Free( block );
+		frameMemoryBlock_t *nextBlock;
+		for ( block = frame->memory ; block ; block = nextBlock ) {
+			nextBlock = block->next;
+			Mem_Free( block );
+		}
+		Mem_Free( frame );
+		smpFrameData[i] = NULL;
 	}
-	Mem_Free( frame );
 	frameData = NULL;
 }
 
@@ -250,18 +263,23 @@ void R_InitFrameData( void ) {
 
 	R_ShutdownFrameData();
 
-	frameData = (frameData_t *)Mem_ClearedAlloc( sizeof( *frameData ));
-	frame = frameData;
-	size = MEMORY_BLOCK_SIZE;
-	block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
-	if ( !block ) {
-		common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
+	for ( int i = 0 ; i < NUM_FRAME_DATA ; i++ ) {
+		smpFrameData[i] = (frameData_t *)Mem_ClearedAlloc( sizeof( *smpFrameData[i] ));
+		frame = smpFrameData[i];
+		size = MEMORY_BLOCK_SIZE;
+		block = (frameMemoryBlock_t *)Mem_Alloc( size + sizeof( *block ) );
+		if ( !block ) {
+			common->FatalError( "R_InitFrameData: Mem_Alloc() failed" );
+		}
+		block->size = size;
+		block->used = 0;
+		block->next = NULL;
+		frame->memory = block;
+		frame->alloc = block;
+		frame->memoryHighwater = 0;
 	}
-	block->size = size;
-	block->used = 0;
-	block->next = NULL;
-	frame->memory = block;
-	frame->memoryHighwater = 0;
+	smpFrame = 0;
+	frameData = smpFrameData[0];
 
 	R_ToggleSmpFrame();
 }
@@ -679,6 +697,36 @@ bool R_CullLocalBox( const idBounds &bounds, const float modelMatrix[16], int nu
 	return R_CornerCullLocalBox( bounds, modelMatrix, numPlanes, planes );
 }
 
+/*
+=================
+R_CullLocalBoxes
+
+Batched R_CullLocalBox for boxes that are all tested against the same planes.
+The SIMD processor transforms several boxes at once and does the exact box to
+plane test, which gives the same result as the corner cull without the
+sphere pre-test.  The single box path is used for the cheaper r_useCulling modes.
+=================
+*/
+void R_CullLocalBoxes( byte *culled, const idBounds * const *bounds, const float * const *modelMatrices, int numBoxes, int numPlanes, const idPlane *planes ) {
+	int		i;
+
+	if ( r_useCulling.GetInteger() < 2 || !r_useBatchCulling.GetBool() ) {
+		for ( i = 0 ; i < numBoxes ; i++ ) {
+			culled[i] = R_CullLocalBox( *bounds[i], modelMatrices[i], numPlanes, planes );
+		}
+		return;
+	}
+
+	SIMDProcessor->CullBoxes( culled, planes, numPlanes, bounds, modelMatrices, numBoxes );
+
+	int numCulled = 0;
+	for ( i = 0 ; i < numBoxes ; i++ ) {
+		numCulled += culled[i];
+	}
+	tr.pc.c_box_cull_out += numCulled;
+	tr.pc.c_box_cull_in += numBoxes - numCulled;
+}
+
 /*
 ==========================
 R_TransformModelToClip
@@ -1095,6 +1143,8 @@ Parms will typically be allocated with R_FrameAlloc
 void R_RenderView( viewDef_t *parms ) {
 	viewDef_t		*oldView;
 
+	PROFILE_SCOPE( "R_RenderView" );
+
 	if ( parms->renderView.width <= 0 || parms->renderView.height <= 0 ) {
 		return;
 	}
@@ -1138,6 +1188,9 @@ void R_RenderView( viewDef_t *parms ) {
 	// any viewLight that didn't have visible surfaces can have it's shadows removed
 	R_RemoveUnecessaryViewLights();
 
+	// copy the shadow casters of the lights for the shadow buffer back end
+	R_AddViewLightOccluders();
+
 	// sort all the ambient surfaces for translucency ordering
 	R_SortDrawSurfs();
 
@@ -468,7 +468,7 @@ bool	R_GenerateSurfaceSubview( drawSurf_t *drawSurf ) {
 	// already seeing through
 	for ( parms = tr.viewDef ; parms ; parms = parms->superView ) {
 		if ( parms->subviewSurface
-			&& parms->subviewSurface->geo == drawSurf->geo
+			&& parms->subviewSurface->sourceGeo == drawSurf->sourceGeo
 			&& parms->subviewSurface->space->entityDef == drawSurf->space->entityDef ) {
 			break;
 		}
@@ -206,6 +206,9 @@ R_PurgeTriSurfData
 ===============
 */
 void R_PurgeTriSurfData( frameData_t *frame ) {
+	// the back end thread may still reference surfaces freed this frame
+	R_SyncBackEnd();
+
 	// free deferred triangle surfaces
 	R_FreeDeferredTriSurfs( frame );
 
@@ -0,0 +1,204 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../idlib/precompiled.h"
+#pragma hdrstop
+
+#if defined(__i386__) || defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+/*
+===============
+Sys_GetCPUId
+===============
+*/
+#if defined(__i386__) || defined(__x86_64__)
+
+static cpuid_t Sys_GetCPUId( void ) {
+	unsigned int eax, ebx, ecx, edx, maxFunc;
+	int flags;
+
+	// verify we're at least a Pentium or 486 with CPUID support
+	if ( !__get_cpuid( 0, &maxFunc, &ebx, &ecx, &edx ) ) {
+		return CPUID_UNSUPPORTED;
+	}
+
+	// check for an AMD, the vendor string is "AuthenticAMD"
+	if ( ebx == 0x68747541 && edx == 0x69746e65 && ecx == 0x444d4163 ) {
+		flags = CPUID_AMD;
+	} else {
+		flags = CPUID_INTEL;
+	}
+
+	// get CPU feature bits
+	__get_cpuid( 1, &eax, &ebx, &ecx, &edx );
+
+	// bit 23 of EDX denotes MMX existence
+	if ( edx & ( 1 << 23 ) ) {
+		flags |= CPUID_MMX;
+	}
+
+	// bit 25 of EDX denotes SSE existence
+	if ( edx & ( 1 << 25 ) ) {
+		flags |= CPUID_SSE;
+	}
+
+	// bit 26 of EDX denotes SSE2 existence
+	if ( edx & ( 1 << 26 ) ) {
+		flags |= CPUID_SSE2;
+	}
+
+	// bit 0 of ECX denotes SSE3 existence
+	if ( ecx & ( 1 << 0 ) ) {
+		flags |= CPUID_SSE3;
+	}
+
+	// bit 28 of EDX denotes HTT existence
+	if ( edx & ( 1 << 28 ) ) {
+		flags |= CPUID_HTT;
+	}
+
+	// bit 15 of EDX denotes CMOV existence
+	if ( edx & ( 1 << 15 ) ) {
+		flags |= CPUID_CMOV;
+	}
+
+	// bit 28 of ECX denotes AVX existence and bit 27 that the OS uses XSAVE/XRSTOR,
+	// in which case XCR0 tells if the OS saves both the XMM and YMM registers
+	if ( ( ecx & ( 1 << 28 ) ) && ( ecx & ( 1 << 27 ) ) ) {
+		unsigned int xcr0, xcr0High;
+		__asm__ __volatile__( ".byte 0x0f, 0x01, 0xd0" : "=a" (xcr0), "=d" (xcr0High) : "c" (0) );
+		if ( ( xcr0 & 6 ) == 6 ) {
+			flags |= CPUID_AVX;
+
+			// bit 12 of ECX denotes FMA3 existence
+			if ( ecx & ( 1 << 12 ) ) {
+				flags |= CPUID_FMA3;
+			}
+
+			// bit 5 of EBX in the structured extended feature flags denotes AVX2 existence
+			if ( maxFunc >= 7 ) {
+				__cpuid_count( 7, 0, eax, ebx, ecx, edx );
+				if ( ebx & ( 1 << 5 ) ) {
+					flags |= CPUID_AVX2;
+				}
+			}
+		}
+	}
+
+	// bit 31 of EDX in the AMD-specific functions denotes 3DNow! support
+	if ( __get_cpuid( 0x80000001, &eax, &ebx, &ecx, &edx ) && ( edx & ( 1u << 31 ) ) ) {
+		flags |= CPUID_3DNOW;
+	}
+
+	return (cpuid_t)flags;
+}
+
+#else
+
+static cpuid_t Sys_GetCPUId( void ) {
+	return CPUID_GENERIC;
+}
+
+#endif
+
+/*
+===============
+Sys_GetProcessorId
+===============
+*/
+cpuid_t Sys_GetProcessorId( void ) {
+	static cpuid_t cpuid = CPUID_NONE;
+
+	if ( cpuid == CPUID_NONE ) {
+		cpuid = Sys_GetCPUId();
+	}
+	return cpuid;
+}
+
+/*
+===============
+Sys_GetProcessorString
+===============
+*/
+const char *Sys_GetProcessorString( void ) {
+	static char processorString[256];
+	idStr string;
+
+	if ( processorString[0] ) {
+		return processorString;
+	}
+
+	cpuid_t cpuid = Sys_GetProcessorId();
+
+	if ( cpuid & CPUID_AMD ) {
+		string += "AMD CPU";
+	} else if ( cpuid & CPUID_INTEL ) {
+		string += "Intel CPU";
+	} else if ( cpuid & CPUID_UNSUPPORTED ) {
+		string += "unsupported CPU";
+	} else {
+		string += "generic CPU";
+	}
+
+	string += " with ";
+	if ( cpuid & CPUID_MMX ) {
+		string += "MMX & ";
+	}
+	if ( cpuid & CPUID_3DNOW ) {
+		string += "3DNow! & ";
+	}
+	if ( cpuid & CPUID_SSE ) {
+		string += "SSE & ";
+	}
+	if ( cpuid & CPUID_SSE2 ) {
+		string += "SSE2 & ";
+	}
+	if ( cpuid & CPUID_SSE3 ) {
+		string += "SSE3 & ";
+	}
+	if ( cpuid & CPUID_AVX ) {
+		string += "AVX & ";
+	}
+	if ( cpuid & CPUID_AVX2 ) {
+		string += "AVX2 & ";
+	}
+	if ( cpuid & CPUID_FMA3 ) {
+		string += "FMA3 & ";
+	}
+	if ( cpuid & CPUID_HTT ) {
+		string += "HTT & ";
+	}
+	string.StripTrailing( " & " );
+	string.StripTrailing( " with " );
+
+	// the string is returned from a plain buffer as the idStr memory is gone when static objects are destroyed
+	idStr::Copynz( processorString, string.c_str(), sizeof( processorString ) );
+	return processorString;
+}
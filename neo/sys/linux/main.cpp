@@ -201,24 +201,6 @@ void Sys_Shutdown( void ) {
 	Posix_Shutdown();
 }
 
-/*
-===============
-Sys_GetProcessorId
-===============
-*/
-cpuid_t Sys_GetProcessorId( void ) {
-	return CPUID_GENERIC;
-}
-
-/*
-===============
-Sys_GetProcessorString
-===============
-*/
-const char *Sys_GetProcessorString( void ) {
-	return "generic";
-}
-
 /*
 ===============
 Sys_FPU_EnableExceptions
@@ -35,6 +35,7 @@ If you have questions concerning this license or the applicable additional terms
 #include <sys/time.h>
 #include <pwd.h>
 #include <pthread.h>
+#include <sched.h>
 
 #include "../../idlib/precompiled.h"
 #include "posix_public.h"
@@ -142,6 +143,124 @@ void Sys_TriggerEvent( int index ) {
 	Sys_LeaveCriticalSection( MAX_LOCAL_CRITICAL_SECTIONS - 1 );
 }
 
+/*
+======================================================
+signals
+each signal has its own mutex and condition, unlike the trigger events any number of threads may wait on them
+
+a thread blocked in Sys_SignalWait can be cancelled by Sys_DestroyThread, the cleanup handler releases the mutex
+======================================================
+*/
+
+struct xsignal_s {
+	pthread_mutex_t	mutex;
+	pthread_cond_t	cond;
+	bool			signaled;
+	bool			manualReset;
+};
+
+/*
+==================
+Sys_SignalCreate
+==================
+*/
+xsignalHandle Sys_SignalCreate( bool manualReset ) {
+	xsignalHandle signal = new xsignal_s;
+	pthread_mutex_init( &signal->mutex, NULL );
+	pthread_cond_init( &signal->cond, NULL );
+	signal->signaled = false;
+	signal->manualReset = manualReset;
+	return signal;
+}
+
+/*
+==================
+Sys_SignalDestroy
+==================
+*/
+void Sys_SignalDestroy( xsignalHandle signal ) {
+	if ( !signal ) {
+		return;
+	}
+	pthread_cond_destroy( &signal->cond );
+	pthread_mutex_destroy( &signal->mutex );
+	delete signal;
+}
+
+/*
+==================
+Sys_SignalRaise
+==================
+*/
+void Sys_SignalRaise( xsignalHandle signal ) {
+	pthread_mutex_lock( &signal->mutex );
+	signal->signaled = true;
+	if ( signal->manualReset ) {
+		pthread_cond_broadcast( &signal->cond );
+	} else {
+		pthread_cond_signal( &signal->cond );
+	}
+	pthread_mutex_unlock( &signal->mutex );
+}
+
+/*
+==================
+Sys_SignalClear
+==================
+*/
+void Sys_SignalClear( xsignalHandle signal ) {
+	pthread_mutex_lock( &signal->mutex );
+	signal->signaled = false;
+	pthread_mutex_unlock( &signal->mutex );
+}
+
+/*
+==================
+Posix_SignalUnlock
+==================
+*/
+static void Posix_SignalUnlock( void *mutex ) {
+	pthread_mutex_unlock( (pthread_mutex_t *)mutex );
+}
+
+/*
+==================
+Sys_SignalWait
+==================
+*/
+bool Sys_SignalWait( xsignalHandle signal, int timeout ) {
+	bool result;
+
+	pthread_mutex_lock( &signal->mutex );
+	pthread_cleanup_push( Posix_SignalUnlock, &signal->mutex );
+	if ( timeout == SIGNAL_WAIT_INFINITE ) {
+		while ( !signal->signaled ) {
+			pthread_cond_wait( &signal->cond, &signal->mutex );
+		}
+	} else {
+		struct timeval now;
+		struct timespec abstime;
+		gettimeofday( &now, NULL );
+		abstime.tv_sec = now.tv_sec + timeout / 1000;
+		abstime.tv_nsec = now.tv_usec * 1000 + ( timeout % 1000 ) * 1000000;
+		if ( abstime.tv_nsec >= 1000000000 ) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= 1000000000;
+		}
+		while ( !signal->signaled ) {
+			if ( pthread_cond_timedwait( &signal->cond, &signal->mutex, &abstime ) == ETIMEDOUT ) {
+				break;
+			}
+		}
+	}
+	result = signal->signaled;
+	if ( !signal->manualReset ) {
+		signal->signaled = false;
+	}
+	pthread_cleanup_pop( 1 );
+	return result;
+}
+
 /*
 ======================================================
 thread create and destroy
@@ -238,6 +357,28 @@ const char* Sys_GetThreadName( int *index ) {
 	return "main";
 }
 
+/*
+==================
+Sys_Yield
+==================
+*/
+void Sys_Yield( void ) {
+	sched_yield();
+}
+
+/*
+==================
+Sys_GetProcessorCount
+==================
+*/
+int Sys_GetProcessorCount( void ) {
+	long count = sysconf( _SC_NPROCESSORS_ONLN );
+	if ( count < 1 ) {
+		return 1;
+	}
+	return (int)count;
+}
+
 /*
 =========================================================
 Async Thread
@@ -56,6 +56,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #define ID_INLINE						__forceinline
 #define ID_STATIC_TEMPLATE				static
+#define ID_THREAD_LOCAL					__declspec( thread )
 
 #define assertmem( x, y )				assert( _CrtIsValidPointer( x, y, true ) )
 
@@ -95,6 +96,13 @@ If you have questions concerning this license or the applicable additional terms
 #define ID_INLINE						inline
 #define ID_STATIC_TEMPLATE
 
+// Apple's gcc has no thread local storage
+#if defined( __clang__ ) && defined( __has_feature )
+#if __has_feature( tls )
+#define ID_THREAD_LOCAL					__thread
+#endif
+#endif
+
 #define assertmem( x, y )
 
 #endif
@@ -128,6 +136,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #define ID_INLINE						inline
 #define ID_STATIC_TEMPLATE
+#define ID_THREAD_LOCAL					__thread
 
 #define assertmem( x, y )
 
@@ -139,6 +148,13 @@ If you have questions concerning this license or the applicable additional terms
 #define id_attribute(x)  
 #endif
 
+// per thread where the compiler supports thread local storage, shared by all threads otherwise
+#ifdef ID_THREAD_LOCAL
+#define ID_THREAD_LOCAL_IF_AVAILABLE	ID_THREAD_LOCAL
+#else
+#define ID_THREAD_LOCAL_IF_AVAILABLE
+#endif
+
 typedef enum {
 	CPUID_NONE							= 0x00000,
 	CPUID_UNSUPPORTED					= 0x00001,	// unsupported (386/486)
@@ -154,7 +170,10 @@ typedef enum {
 	CPUID_HTT							= 0x01000,	// Hyper-Threading Technology
 	CPUID_CMOV							= 0x02000,	// Conditional Move (CMOV) and fast floating point comparison (FCOMI) instructions
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
-	CPUID_DAZ							= 0x08000	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
+	CPUID_AVX							= 0x10000,	// Advanced Vector Extensions, only set when the OS saves the YMM registers
+	CPUID_AVX2							= 0x20000,	// Advanced Vector Extensions 2
+	CPUID_FMA3							= 0x40000	// Fused Multiply-Add with three operands
 } cpuid_t;
 
 typedef enum {
@@ -233,7 +252,8 @@ typedef struct sysMemoryStats_s {
 
 typedef unsigned long address_t;
 
-template<class type> class idList;		// for Sys_ListFiles
+template<class type> class idListHeapAllocator;
+template<class type, class allocator_t = idListHeapAllocator<type> > class idList;		// for Sys_ListFiles
 
 
 void			Sys_Init( void );
@@ -526,6 +546,65 @@ enum {
 void				Sys_WaitForEvent( int index = TRIGGER_EVENT_ZERO );
 void				Sys_TriggerEvent( int index = TRIGGER_EVENT_ZERO );
 
+// signals are dynamically allocated events for worker threads
+// an auto reset signal is cleared when a single wait returns, a manual reset signal stays raised until cleared
+// unlike the trigger events any number of signals can be created and any number of threads can wait on them
+const int SIGNAL_WAIT_INFINITE		= -1;
+
+typedef struct xsignal_s *			xsignalHandle;
+
+xsignalHandle		Sys_SignalCreate( bool manualReset );
+void				Sys_SignalDestroy( xsignalHandle signal );
+void				Sys_SignalRaise( xsignalHandle signal );
+void				Sys_SignalClear( xsignalHandle signal );
+// returns false if the timeout (in milliseconds) expired before the signal was raised
+bool				Sys_SignalWait( xsignalHandle signal, int timeout = SIGNAL_WAIT_INFINITE );
+
+// interlocked operations are lock-free and guaranteed to be thread-safe
+// all of them return the resulting value except for the exchanges, which return the previous value
+#if defined(_WIN32)
+
+ID_INLINE int		Sys_InterlockedIncrement( volatile int &value ) { return InterlockedIncrement( (volatile LONG *)&value ); }
+ID_INLINE int		Sys_InterlockedDecrement( volatile int &value ) { return InterlockedDecrement( (volatile LONG *)&value ); }
+ID_INLINE int		Sys_InterlockedAdd( volatile int &value, int i ) { return InterlockedExchangeAdd( (volatile LONG *)&value, i ) + i; }
+ID_INLINE int		Sys_InterlockedExchange( volatile int &value, int exchange ) { return InterlockedExchange( (volatile LONG *)&value, exchange ); }
+ID_INLINE int		Sys_InterlockedCompareExchange( volatile int &value, int comparand, int exchange ) { return InterlockedCompareExchange( (volatile LONG *)&value, exchange, comparand ); }
+ID_INLINE void *	Sys_InterlockedCompareExchangePointer( void * volatile &ptr, void *comparand, void *exchange ) { return InterlockedCompareExchangePointer( &ptr, exchange, comparand ); }
+
+#else
+
+ID_INLINE int		Sys_InterlockedIncrement( volatile int &value ) { return __sync_add_and_fetch( &value, 1 ); }
+ID_INLINE int		Sys_InterlockedDecrement( volatile int &value ) { return __sync_sub_and_fetch( &value, 1 ); }
+ID_INLINE int		Sys_InterlockedAdd( volatile int &value, int i ) { return __sync_add_and_fetch( &value, i ); }
+ID_INLINE int		Sys_InterlockedExchange( volatile int &value, int exchange ) { __sync_synchronize(); return __sync_lock_test_and_set( &value, exchange ); }
+ID_INLINE int		Sys_InterlockedCompareExchange( volatile int &value, int comparand, int exchange ) { return __sync_val_compare_and_swap( &value, comparand, exchange ); }
+ID_INLINE void *	Sys_InterlockedCompareExchangePointer( void * volatile &ptr, void *comparand, void *exchange ) { return __sync_val_compare_and_swap( &ptr, comparand, exchange ); }
+
+#endif
+
+// lock-free counter built on the interlocked operations
+class idSysInterlockedInteger {
+public:
+					idSysInterlockedInteger( void ) : value( 0 ) {}
+
+	int				Increment( void ) { return Sys_InterlockedIncrement( value ); }
+	int				Decrement( void ) { return Sys_InterlockedDecrement( value ); }
+	int				Add( int v ) { return Sys_InterlockedAdd( value, v ); }
+	int				Exchange( int v ) { return Sys_InterlockedExchange( value, v ); }
+	int				CompareExchange( int comparand, int exchange ) { return Sys_InterlockedCompareExchange( value, comparand, exchange ); }
+	int				GetValue( void ) const { return value; }
+	void			SetValue( int v ) { value = v; }
+
+private:
+	volatile int	value;
+};
+
+// give up the rest of the time slice of the calling thread
+void				Sys_Yield( void );
+
+// number of logical processors available to the process
+int					Sys_GetProcessorCount( void );
+
 /*
 ==============================================================
 
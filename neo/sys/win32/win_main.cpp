@@ -152,6 +152,30 @@ const char* Sys_GetThreadName(int *index) {
 	return "main";
 }
 
+/*
+==================
+Sys_Yield
+==================
+*/
+void Sys_Yield( void ) {
+	SwitchToThread();
+}
+
+/*
+==================
+Sys_GetProcessorCount
+==================
+*/
+int Sys_GetProcessorCount( void ) {
+	SYSTEM_INFO info;
+
+	GetSystemInfo( &info );
+	if ( info.dwNumberOfProcessors < 1 ) {
+		return 1;
+	}
+	return info.dwNumberOfProcessors;
+}
+
 
 /*
 ==================
@@ -200,6 +224,62 @@ void Sys_TriggerEvent( int index ) {
 	SetEvent( win32.backgroundDownloadSemaphore );
 }
 
+struct xsignal_s {
+	HANDLE			handle;
+};
+
+/*
+==================
+Sys_SignalCreate
+==================
+*/
+xsignalHandle Sys_SignalCreate( bool manualReset ) {
+	xsignalHandle signal = new xsignal_s;
+	signal->handle = CreateEvent( NULL, manualReset, FALSE, NULL );
+	return signal;
+}
+
+/*
+==================
+Sys_SignalDestroy
+==================
+*/
+void Sys_SignalDestroy( xsignalHandle signal ) {
+	if ( !signal ) {
+		return;
+	}
+	CloseHandle( signal->handle );
+	delete signal;
+}
+
+/*
+==================
+Sys_SignalRaise
+==================
+*/
+void Sys_SignalRaise( xsignalHandle signal ) {
+	SetEvent( signal->handle );
+}
+
+/*
+==================
+Sys_SignalClear
+==================
+*/
+void Sys_SignalClear( xsignalHandle signal ) {
+	ResetEvent( signal->handle );
+}
+
+/*
+==================
+Sys_SignalWait
+==================
+*/
+bool Sys_SignalWait( xsignalHandle signal, int timeout ) {
+	DWORD result = WaitForSingleObject( signal->handle, timeout == SIGNAL_WAIT_INFINITE ? INFINITE : timeout );
+	return ( result == WAIT_OBJECT_0 );
+}
+
 
 
 #pragma optimize( "", on )
@@ -1075,6 +1155,15 @@ void Sys_Init( void ) {
 		if ( win32.cpuid & CPUID_SSE3 ) {
 			string += "SSE3 & ";
 		}
+		if ( win32.cpuid & CPUID_AVX ) {
+			string += "AVX & ";
+		}
+		if ( win32.cpuid & CPUID_AVX2 ) {
+			string += "AVX2 & ";
+		}
+		if ( win32.cpuid & CPUID_FMA3 ) {
+			string += "FMA3 & ";
+		}
 		if ( win32.cpuid & CPUID_HTT ) {
 			string += "HTT & ";
 		}
@@ -1104,6 +1193,12 @@ void Sys_Init( void ) {
 				id |= CPUID_SSE2;
 			} else if ( token.Icmp( "sse3" ) == 0 ) {
 				id |= CPUID_SSE3;
+			} else if ( token.Icmp( "avx" ) == 0 ) {
+				id |= CPUID_AVX;
+			} else if ( token.Icmp( "avx2" ) == 0 ) {
+				id |= CPUID_AVX2;
+			} else if ( token.Icmp( "fma3" ) == 0 ) {
+				id |= CPUID_FMA3;
 			} else if ( token.Icmp( "htt" ) == 0 ) {
 				id |= CPUID_HTT;
 			}
@@ -778,6 +778,12 @@ bool idAASBuild::Build( const idStr &fileName, const idAASSettings *settings ) {
 	name.SetFileExtension( aasSettings->fileExtension );
 	file->Write( name, mapFile->GetGeometryCRC() );
 
+	// precalculate the routing tables
+	if ( aasSettings->writeRouteTables ) {
+		idAASRoute route;
+		route.Build( name, mapFile->GetGeometryCRC() );
+	}
+
 	// delete the map file
 	delete mapFile;
 
@@ -832,6 +838,12 @@ bool idAASBuild::BuildReachability( const idStr &fileName, const idAASSettings *
 	// write the file
 	file->Write( name, mapFile->GetGeometryCRC() );
 
+	// precalculate the routing tables
+	if ( aasSettings->writeRouteTables ) {
+		idAASRoute route;
+		route.Build( name, mapFile->GetGeometryCRC() );
+	}
+
 	// delete the map file
 	delete mapFile;
 
@@ -840,6 +852,38 @@ bool idAASBuild::BuildReachability( const idStr &fileName, const idAASSettings *
 	return true;
 }
 
+/*
+============
+idAASBuild::BuildRouteTables
+============
+*/
+bool idAASBuild::BuildRouteTables( const idStr &fileName, const idAASSettings *settings ) {
+	idMapFile * mapFile;
+	idStr name;
+	idAASRoute route;
+	bool ok;
+
+	aasSettings = settings;
+
+	name = fileName;
+	name.SetFileExtension( "map" );
+
+	// the routing tables are only used with the map the AAS file was created for
+	mapFile = new idMapFile;
+	if ( !mapFile->Parse( name ) ) {
+		delete mapFile;
+		common->Error( "Couldn't load map file: '%s'", name.c_str() );
+		return false;
+	}
+
+	name.SetFileExtension( aasSettings->fileExtension );
+	ok = route.Build( name, mapFile->GetGeometryCRC() );
+
+	delete mapFile;
+
+	return ok;
+}
+
 /*
 ============
 ParseOptions
@@ -866,6 +910,9 @@ int ParseOptions( const idCmdArgs &args, idAASSettings &settings ) {
 		} else if ( str.Icmp( "noOptimize" ) == 0 ) {
 			settings.noOptimize = true;
 			common->Printf( "noOptimize = true\n" );
+		} else if ( str.Icmp( "routeTables" ) == 0 ) {
+			settings.writeRouteTables = true;
+			common->Printf( "writeRouteTables = true\n" );
 		}
 	}
 	return args.Argc() - 1;
@@ -887,7 +934,8 @@ void RunAAS_f( const idCmdArgs &args ) {
 					"options:\n"
 					"  -usePatches        = use bezier patches for collision detection.\n"
 					"  -writeBrushMap     = write a brush map with the AAS geometry.\n"
-					"  -playerFlood       = use player spawn points as valid AAS positions.\n" );
+					"  -playerFlood       = use player spawn points as valid AAS positions.\n"
+					"  -routeTables       = precalculate the routing tables.\n" );
 		return;
 	}
 
@@ -1029,3 +1077,49 @@ void RunReach_f( const idCmdArgs &args ) {
 	common->SetRefreshOnPrint( false );
 	common->PrintWarnings();
 }
+
+/*
+============
+RunAASRoutes_f
+============
+*/
+void RunAASRoutes_f( const idCmdArgs &args ) {
+	int i;
+	idAASBuild aas;
+	idAASSettings settings;
+
+	if ( args.Argc() <= 1 ) {
+		common->Printf( "runAASRoutes <mapfile>\n" );
+		return;
+	}
+
+	common->ClearWarnings( "calculating AAS routing tables" );
+
+	common->SetRefreshOnPrint( true );
+
+	// get the aas settings definitions
+	const idDict *dict = gameEdit->FindEntityDefDict( "aas_types", false );
+	if ( !dict ) {
+		common->Error( "Unable to find entityDef for 'aas_types'" );
+	}
+
+	const idKeyValue *kv = dict->MatchPrefix( "type" );
+	while( kv != NULL ) {
+		const idDict *settingsDict = gameEdit->FindEntityDefDict( kv->GetValue(), false );
+		if ( !settingsDict ) {
+			common->Warning( "Unable to find '%s' in def/aas.def", kv->GetValue().c_str() );
+		} else {
+			settings.FromDict( kv->GetValue(), settingsDict );
+			i = ParseOptions( args, settings );
+			aas.BuildRouteTables( idStr("maps/") + args.Argv(i), &settings );
+		}
+
+		kv = dict->MatchPrefix( "type", kv );
+		if ( kv ) {
+			common->Printf( "=======================================================\n" );
+		}
+	}
+
+	common->SetRefreshOnPrint( false );
+	common->PrintWarnings();
+}
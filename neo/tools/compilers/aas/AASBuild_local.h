@@ -36,6 +36,7 @@ If you have questions concerning this license or the applicable additional terms
 #include "BrushBSP.h"
 #include "AASReach.h"
 #include "AASCluster.h"
+#include "AASRoute.h"
 
 
 //===============================================================
@@ -79,6 +80,7 @@ public:
 							~idAASBuild( void );
 	bool					Build( const idStr &fileName, const idAASSettings *settings );
 	bool					BuildReachability( const idStr &fileName, const idAASSettings *settings );
+	bool					BuildRouteTables( const idStr &fileName, const idAASSettings *settings );
 	void					Shutdown( void );
 
 private:
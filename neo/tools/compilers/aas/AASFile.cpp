@@ -149,6 +149,7 @@ idAASSettings::idAASSettings( void ) {
 	writeBrushMap = false;
 	playerFlood = false;
 	noOptimize = false;
+	writeRouteTables = false;
 	allowSwimReachabilities = false;
 	allowFlyReachabilities = false;
 	fileExtension = "aas48";
@@ -598,6 +599,7 @@ idAASFileLocal::~idAASFileLocal( void ) {
 			delete reach;
 		}
 	}
+	DeleteRouteTables();
 }
 
 /*
@@ -606,6 +608,7 @@ idAASFileLocal::Clear
 ================
 */
 void idAASFileLocal::Clear( void ) {
+	DeleteRouteTables();
 	planeList.Clear();
 	vertices.Clear();
 	edges.Clear();
@@ -1191,6 +1194,9 @@ bool idAASFileLocal::Load( const idStr &fileName, unsigned int mapFileCRC ) {
 		src.Error( "idAASFileLocal::Load: tree depth = %d", depth );
 	}
 
+	// the precalculated routing tables are optional
+	LoadRouteTables();
+
 	common->Printf( "done.\n" );
 
 	return true;
@@ -1216,6 +1222,14 @@ int idAASFileLocal::MemorySize( void ) const {
 	size += portalIndex.Size();
 	size += clusters.Size();
 	size += sizeof( idReachability_Walk ) * NumReachabilities();
+	for ( int i = 0; i < routeTables.Num(); i++ ) {
+		size += routeTables[i]->clusterOffset.Size();
+		size += routeTables[i]->areaTravelTimes.Size();
+		size += routeTables[i]->areaReach.Size();
+		size += routeTables[i]->portalOffset.Size();
+		size += routeTables[i]->portalTravelTimes.Size();
+		size += routeTables[i]->portalReach.Size();
+	}
 
 	return size;
 }
@@ -1229,6 +1243,7 @@ void idAASFileLocal::PrintInfo( void ) const {
 	common->Printf( "%6d KB file size\n", MemorySize() >> 10 );
 	common->Printf( "%6d areas\n", areas.Num() );
 	common->Printf( "%6d max tree depth\n", MaxTreeDepth() );
+	common->Printf( "%6d routing tables\n", routeTables.Num() );
 	ReportRoutingEfficiency();
 }
 
@@ -1312,3 +1327,312 @@ void idAASFileLocal::DeleteClusters( void ) {
 	memset( &cluster, 0, sizeof( portal ) );
 	clusters.Append( cluster );
 }
+
+/*
+================
+idAASFileLocal::DeleteRouteTables
+================
+*/
+void idAASFileLocal::DeleteRouteTables( void ) {
+	routeTables.DeleteContents( true );
+}
+
+/*
+================
+RouteTable_UpdateCRC
+================
+*/
+static void RouteTable_UpdateCRC( unsigned long &crc, int value ) {
+	value = LittleLong( value );
+	CRC32_UpdateChecksum( crc, &value, sizeof( value ) );
+}
+
+/*
+================
+RouteTable_UpdateCRC
+================
+*/
+static void RouteTable_UpdateCRC( unsigned long &crc, const idVec3 &v ) {
+	float f;
+
+	for ( int i = 0; i < 3; i++ ) {
+		f = LittleFloat( v[i] );
+		CRC32_UpdateChecksum( crc, &f, sizeof( f ) );
+	}
+}
+
+/*
+================
+idAASFileLocal::RoutingCRC
+
+  Checksum of everything the routing tables depend on. Used to detect
+  routing tables that were calculated for a different version of the AAS file.
+================
+*/
+unsigned int idAASFileLocal::RoutingCRC( void ) const {
+	int i;
+	unsigned long c;
+	idReachability *reach;
+
+	CRC32_InitChecksum( c );
+	for ( i = 0; i < areas.Num(); i++ ) {
+		RouteTable_UpdateCRC( c, areas[i].flags );
+		RouteTable_UpdateCRC( c, areas[i].travelFlags );
+		RouteTable_UpdateCRC( c, areas[i].cluster );
+		RouteTable_UpdateCRC( c, areas[i].clusterAreaNum );
+		for ( reach = areas[i].reach; reach; reach = reach->next ) {
+			RouteTable_UpdateCRC( c, reach->travelType );
+			RouteTable_UpdateCRC( c, reach->toAreaNum );
+			RouteTable_UpdateCRC( c, reach->travelTime );
+			RouteTable_UpdateCRC( c, reach->start );
+			RouteTable_UpdateCRC( c, reach->end );
+		}
+	}
+	for ( i = 0; i < portals.Num(); i++ ) {
+		RouteTable_UpdateCRC( c, portals[i].areaNum );
+		RouteTable_UpdateCRC( c, portals[i].clusters[0] );
+		RouteTable_UpdateCRC( c, portals[i].clusters[1] );
+	}
+	for ( i = 0; i < clusters.Num(); i++ ) {
+		RouteTable_UpdateCRC( c, clusters[i].numReachableAreas );
+		RouteTable_UpdateCRC( c, clusters[i].firstPortal );
+		RouteTable_UpdateCRC( c, clusters[i].numPortals );
+	}
+	CRC32_FinishChecksum( c );
+
+	return c;
+}
+
+/*
+================
+RouteTable_WriteInts
+================
+*/
+static void RouteTable_WriteInts( idFile *fp, const idList<int> &list ) {
+	for ( int i = 0; i < list.Num(); i++ ) {
+		fp->WriteInt( list[i] );
+	}
+}
+
+/*
+================
+RouteTable_WriteShorts
+================
+*/
+static void RouteTable_WriteShorts( idFile *fp, const idList<unsigned short> &list ) {
+	for ( int i = 0; i < list.Num(); i++ ) {
+		fp->WriteUnsignedShort( list[i] );
+	}
+}
+
+/*
+================
+RouteTable_ReadInts
+================
+*/
+static bool RouteTable_ReadInts( idFile *fp, idList<int> &list, int num ) {
+	list.SetNum( num );
+	if ( num && fp->Read( list.Ptr(), num * sizeof( int ) ) != num * (int)sizeof( int ) ) {
+		return false;
+	}
+	for ( int i = 0; i < num; i++ ) {
+		list[i] = LittleLong( list[i] );
+	}
+	return true;
+}
+
+/*
+================
+RouteTable_ReadShorts
+================
+*/
+static bool RouteTable_ReadShorts( idFile *fp, idList<unsigned short> &list, int num ) {
+	list.SetNum( num );
+	if ( num && fp->Read( list.Ptr(), num * sizeof( unsigned short ) ) != num * (int)sizeof( unsigned short ) ) {
+		return false;
+	}
+	for ( int i = 0; i < num; i++ ) {
+		list[i] = LittleShort( list[i] );
+	}
+	return true;
+}
+
+/*
+================
+RouteTable_ReadBytes
+================
+*/
+static bool RouteTable_ReadBytes( idFile *fp, idList<byte> &list, int num ) {
+	list.SetNum( num );
+	return ( !num || fp->Read( list.Ptr(), num ) == num );
+}
+
+/*
+================
+idAASFileLocal::RouteTableValid
+
+  Makes sure all the offsets stay within the tables.
+================
+*/
+bool idAASFileLocal::RouteTableValid( const aasRouteTable_t *table ) const {
+	int i, n;
+
+	for ( i = 0; i < clusters.Num(); i++ ) {
+		n = clusters[i].numReachableAreas;
+		if ( table->clusterOffset[i] < -1 || table->clusterOffset[i] + n * n > table->areaTravelTimes.Num() ) {
+			return false;
+		}
+	}
+	for ( i = 0; i < areas.Num(); i++ ) {
+		if ( table->portalOffset[i] < -1 || table->portalOffset[i] + portals.Num() > table->portalTravelTimes.Num() ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+================
+idAASFileLocal::WriteRouteTables
+
+  The routing tables are written to a binary file next to the AAS file.
+  Everything after the header is compressed.
+================
+*/
+bool idAASFileLocal::WriteRouteTables( void ) const {
+	int i, size;
+	idStr fileName;
+	idFile *fp;
+	idCompressor *compressor;
+	const aasRouteTable_t *table;
+
+	fileName = name + "." AAS_ROUTE_FILEEXT;
+
+	common->Printf( "writing %s\n", fileName.c_str() );
+
+	fp = fileSystem->OpenFileWrite( fileName, "fs_devpath" );
+	if ( !fp ) {
+		common->Warning( "Error opening %s", fileName.c_str() );
+		return false;
+	}
+
+	fp->WriteString( AAS_ROUTE_FILEID );
+	fp->WriteInt( AAS_ROUTE_FILEVERSION );
+	fp->WriteUnsignedInt( crc );
+	fp->WriteUnsignedInt( RoutingCRC() );
+	fp->WriteInt( areas.Num() );
+	fp->WriteInt( portals.Num() );
+	fp->WriteInt( clusters.Num() );
+	fp->WriteInt( routeTables.Num() );
+
+	compressor = idCompressor::AllocLZW();
+	compressor->Init( fp, true, 8 );
+
+	size = 0;
+	for ( i = 0; i < routeTables.Num(); i++ ) {
+		table = routeTables[i];
+
+		compressor->WriteInt( table->travelFlags );
+		compressor->WriteInt( table->areaTravelTimes.Num() );
+		compressor->WriteInt( table->portalTravelTimes.Num() );
+		RouteTable_WriteInts( compressor, table->clusterOffset );
+		RouteTable_WriteInts( compressor, table->portalOffset );
+		RouteTable_WriteShorts( compressor, table->areaTravelTimes );
+		compressor->Write( table->areaReach.Ptr(), table->areaReach.Num() );
+		RouteTable_WriteShorts( compressor, table->portalTravelTimes );
+		compressor->Write( table->portalReach.Ptr(), table->portalReach.Num() );
+
+		size += ( table->areaTravelTimes.Num() + table->portalTravelTimes.Num() ) * ( sizeof( unsigned short ) + sizeof( byte ) );
+	}
+
+	compressor->FinishCompress();
+	delete compressor;
+
+	common->Printf( "%6d KB routing tables\n", size >> 10 );
+	common->Printf( "%6d KB compressed\n", fp->Length() >> 10 );
+
+	fileSystem->CloseFile( fp );
+
+	return true;
+}
+
+/*
+================
+idAASFileLocal::LoadRouteTables
+================
+*/
+bool idAASFileLocal::LoadRouteTables( void ) {
+	int i, version, numAreas, numPortals, numClusters, numTables, numAreaEntries, numPortalEntries;
+	unsigned int c, routingCRC;
+	idStr fileName, id;
+	idFile *fp;
+	idCompressor *compressor;
+	aasRouteTable_t *table;
+	bool ok;
+
+	DeleteRouteTables();
+
+	fileName = name + "." AAS_ROUTE_FILEEXT;
+
+	fp = fileSystem->OpenFileRead( fileName );
+	if ( !fp ) {
+		return false;
+	}
+
+	fp->ReadString( id );
+	fp->ReadInt( version );
+	if ( id != AAS_ROUTE_FILEID || version != AAS_ROUTE_FILEVERSION ) {
+		common->Warning( "Routing tables '%s' have the wrong version", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	fp->ReadUnsignedInt( c );
+	fp->ReadUnsignedInt( routingCRC );
+	fp->ReadInt( numAreas );
+	fp->ReadInt( numPortals );
+	fp->ReadInt( numClusters );
+	fp->ReadInt( numTables );
+	if ( c != crc || numAreas != areas.Num() || numPortals != portals.Num() || numClusters != clusters.Num() || routingCRC != RoutingCRC() ) {
+		common->Warning( "Routing tables '%s' are out of date", fileName.c_str() );
+		fileSystem->CloseFile( fp );
+		return false;
+	}
+
+	compressor = idCompressor::AllocLZW();
+	compressor->Init( fp, false, 8 );
+
+	ok = true;
+	for ( i = 0; i < numTables && ok; i++ ) {
+		table = new aasRouteTable_t;
+		routeTables.Append( table );
+
+		compressor->ReadInt( table->travelFlags );
+		compressor->ReadInt( numAreaEntries );
+		compressor->ReadInt( numPortalEntries );
+		if ( numAreaEntries < 0 || numPortalEntries < 0 ) {
+			ok = false;
+			break;
+		}
+		ok &= RouteTable_ReadInts( compressor, table->clusterOffset, numClusters );
+		ok &= RouteTable_ReadInts( compressor, table->portalOffset, numAreas );
+		ok &= RouteTable_ReadShorts( compressor, table->areaTravelTimes, numAreaEntries );
+		ok &= RouteTable_ReadBytes( compressor, table->areaReach, numAreaEntries );
+		ok &= RouteTable_ReadShorts( compressor, table->portalTravelTimes, numPortalEntries );
+		ok &= RouteTable_ReadBytes( compressor, table->portalReach, numPortalEntries );
+		ok = ok && RouteTableValid( table );
+	}
+
+	delete compressor;
+	fileSystem->CloseFile( fp );
+
+	if ( !ok ) {
+		common->Warning( "Routing tables '%s' are corrupt", fileName.c_str() );
+		DeleteRouteTables();
+		return false;
+	}
+
+	common->Printf( "loaded %d routing tables from %s\n", routeTables.Num(), fileName.c_str() );
+
+	return true;
+}
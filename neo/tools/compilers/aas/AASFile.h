@@ -40,6 +40,10 @@ If you have questions concerning this license or the applicable additional terms
 #define AAS_FILEID					"DewmAAS"
 #define AAS_FILEVERSION				"1.07"
 
+#define AAS_ROUTE_FILEID			"DewmAASRoute"
+#define AAS_ROUTE_FILEVERSION		1
+#define AAS_ROUTE_FILEEXT			"route"
+
 // travel flags
 #define TFL_INVALID					BIT(0)		// not valid
 #define TFL_WALK					BIT(1)		// walking
@@ -207,6 +211,17 @@ typedef struct aasTrace_s {
 								aasTrace_s( void ) { areas = NULL; points = NULL; getOutOfSolid = false; flags = travelFlags = maxAreas = 0; }
 } aasTrace_t;
 
+// routing tables precalculated for one set of travel flags
+typedef struct aasRouteTable_s {
+	int							travelFlags;		// travel flags the tables are calculated for
+	idList<int>					clusterOffset;		// per cluster offset into the area tables, -1 if the cluster has no tables
+	idList<unsigned short>		areaTravelTimes;	// per cluster numReachableAreas travel times towards each reachable goal area
+	idList<byte>				areaReach;			// reversed reachability number used to get into each area
+	idList<int>					portalOffset;		// per goal area offset into the portal tables, -1 if the area has no tables
+	idList<unsigned short>		portalTravelTimes;	// per goal area travel times from each portal
+	idList<byte>				portalReach;		// reachability number used to leave each portal
+} aasRouteTable_t;
+
 // settings
 class idAASSettings {
 public:
@@ -217,6 +232,7 @@ public:
 	bool						writeBrushMap;
 	bool						playerFlood;
 	bool						noOptimize;
+	bool						writeRouteTables;
 	bool						allowSwimReachabilities;
 	bool						allowFlyReachabilities;
 	idStr						fileExtension;
@@ -311,6 +327,9 @@ public:
 
 	const idAASSettings &		GetSettings( void ) const { return settings; }
 
+	int							GetNumRouteTables( void ) const { return routeTables.Num(); }
+	const aasRouteTable_t *		GetRouteTable( int travelFlags ) const;
+
 	void						SetPortalMaxTravelTime( int index, int time ) { portals[index].maxAreaTravelTime = time; }
 	void						SetAreaTravelFlag( int index, int flag ) { areas[index].travelFlags |= flag; }
 	void						RemoveAreaTravelFlag( int index, int flag ) { areas[index].travelFlags &= ~flag; }
@@ -346,6 +365,16 @@ protected:
 	idList<aasIndex_t>			portalIndex;
 	idList<aasCluster_t>		clusters;
 	idAASSettings				settings;
+	idList<aasRouteTable_t *>	routeTables;
 };
 
+ID_INLINE const aasRouteTable_t *idAASFile::GetRouteTable( int travelFlags ) const {
+	for ( int i = 0; i < routeTables.Num(); i++ ) {
+		if ( routeTables[i]->travelFlags == travelFlags ) {
+			return routeTables[i];
+		}
+	}
+	return NULL;
+}
+
 #endif /* !__AASFILE_H__ */
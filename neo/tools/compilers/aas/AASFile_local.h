@@ -41,6 +41,7 @@ class idAASFileLocal : public idAASFile {
 	friend class idAASBuild;
 	friend class idAASReach;
 	friend class idAASCluster;
+	friend class idAASRoute;
 public:
 								idAASFileLocal( void );
 	virtual 					~idAASFileLocal( void );
@@ -64,6 +65,9 @@ public:
 public:
 	bool						Load( const idStr &fileName, unsigned int mapFileCRC );
 	bool						Write( const idStr &fileName, unsigned int mapFileCRC );
+	bool						LoadRouteTables( void );
+	bool						WriteRouteTables( void ) const;
+	unsigned int				RoutingCRC( void ) const;
 
 	int							MemorySize( void ) const;
 	void						ReportRoutingEfficiency( void ) const;
@@ -74,6 +78,7 @@ public:
 	void						Clear( void );
 	void						DeleteReachabilities( void );
 	void						DeleteClusters( void );
+	void						DeleteRouteTables( void );
 
 private:
 	bool						ParseIndex( idLexer &src, idList<aasIndex_t> &indexes );
@@ -94,6 +99,7 @@ private:
 	int							AreaContentsTravelFlags( int areaNum ) const;
 	idVec3						AreaReachableGoal( int areaNum ) const;
 	int							NumReachabilities( void ) const;
+	bool						RouteTableValid( const aasRouteTable_t *table ) const;
 };
 
 #endif /* !__AASFILELOCAL_H__ */
@@ -0,0 +1,543 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#include "../../../idlib/precompiled.h"
+#pragma hdrstop
+
+#include "AASFile.h"
+#include "AASFile_local.h"
+#include "AASRoute.h"
+
+// must be the same as in the game routing code
+#define LEDGE_TRAVELTIME_PANALTY	250
+
+
+/*
+================
+idAASRoute::idAASRoute
+================
+*/
+idAASRoute::idAASRoute( void ) {
+	file = NULL;
+	areaTravelTimes = NULL;
+	areaUpdate = NULL;
+	portalUpdate = NULL;
+}
+
+/*
+================
+idAASRoute::~idAASRoute
+================
+*/
+idAASRoute::~idAASRoute( void ) {
+	Free();
+}
+
+/*
+================
+idAASRoute::Free
+================
+*/
+void idAASRoute::Free( void ) {
+	Mem_Free( areaTravelTimes );
+	areaTravelTimes = NULL;
+	Mem_Free( areaUpdate );
+	areaUpdate = NULL;
+	Mem_Free( portalUpdate );
+	portalUpdate = NULL;
+	delete file;
+	file = NULL;
+}
+
+/*
+================
+idAASRoute::AreaTravelTime
+================
+*/
+unsigned short idAASRoute::AreaTravelTime( int areaNum, const idVec3 &start, const idVec3 &end ) const {
+	float dist;
+
+	dist = ( end - start ).Length();
+
+	if ( file->areas[areaNum].travelFlags & TFL_CROUCH ) {
+		dist *= 100.0f / 100.0f;
+	} else if ( file->areas[areaNum].travelFlags & TFL_WATER ) {
+		dist *= 100.0f / 150.0f;
+	} else {
+		dist *= 100.0f / 300.0f;
+	}
+	if ( dist < 1.0f ) {
+		return 1;
+	}
+	return (unsigned short) idMath::FtoiFast( dist );
+}
+
+/*
+================
+idAASRoute::CalculateAreaTravelTimes
+================
+*/
+void idAASRoute::CalculateAreaTravelTimes( void ) {
+	int n, i, j, numReach, numRevReach, numAreaTravelTimes, t, maxt;
+	unsigned short *timePtr;
+	idReachability *reach, *rev_reach;
+
+	// get total memory for all area travel times
+	numAreaTravelTimes = 0;
+	for ( n = 0; n < file->areas.Num(); n++ ) {
+
+		if ( !(file->areas[n].flags & (AREA_REACHABLE_WALK|AREA_REACHABLE_FLY)) ) {
+			continue;
+		}
+
+		numReach = 0;
+		for ( reach = file->areas[n].reach; reach; reach = reach->next ) {
+			numReach++;
+		}
+
+		numRevReach = 0;
+		for ( rev_reach = file->areas[n].rev_reach; rev_reach; rev_reach = rev_reach->rev_next ) {
+			numRevReach++;
+		}
+		numAreaTravelTimes += numReach * numRevReach;
+	}
+
+	areaTravelTimes = (unsigned short *) Mem_Alloc( numAreaTravelTimes * sizeof( unsigned short ) );
+	timePtr = areaTravelTimes;
+
+	for ( n = 0; n < file->areas.Num(); n++ ) {
+
+		if ( !(file->areas[n].flags & (AREA_REACHABLE_WALK|AREA_REACHABLE_FLY)) ) {
+			continue;
+		}
+
+		// for each reachability that starts in this area calculate the travel time
+		// towards all the reachabilities that lead towards this area
+		for ( maxt = i = 0, reach = file->areas[n].reach; reach; reach = reach->next, i++ ) {
+			if ( i >= MAX_REACH_PER_AREA ) {
+				common->Error( "i >= MAX_REACH_PER_AREA" );
+			}
+			reach->number = i;
+			reach->disableCount = 0;
+			reach->areaTravelTimes = timePtr;
+			for ( j = 0, rev_reach = file->areas[n].rev_reach; rev_reach; rev_reach = rev_reach->rev_next, j++ ) {
+				t = AreaTravelTime( n, reach->start, rev_reach->end );
+				reach->areaTravelTimes[j] = t;
+				if ( t > maxt ) {
+					maxt = t;
+				}
+			}
+			timePtr += j;
+		}
+
+		// if this area is a portal
+		if ( file->areas[n].cluster < 0 ) {
+			// set the maximum travel time through this portal
+			file->portals[-file->areas[n].cluster].maxAreaTravelTime = maxt;
+		}
+	}
+}
+
+/*
+================
+idAASRoute::ClusterAreaNum
+================
+*/
+int idAASRoute::ClusterAreaNum( int clusterNum, int areaNum ) const {
+	int side, areaCluster;
+
+	areaCluster = file->areas[areaNum].cluster;
+	if ( areaCluster > 0 ) {
+		return file->areas[areaNum].clusterAreaNum;
+	}
+	else {
+		side = file->portals[-areaCluster].clusters[0] != clusterNum;
+		return file->portals[-areaCluster].clusterAreaNum[side];
+	}
+}
+
+/*
+================
+idAASRoute::FloodArea
+
+  Same as idAASLocal::UpdateAreaRoutingCache in the game code.
+================
+*/
+void idAASRoute::FloodArea( int clusterNum, int goalAreaNum, int travelFlags, unsigned short *travelTimes, byte *reachabilities ) {
+	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
+	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
+	aasRouteUpdate_t *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
+	idReachability *reach;
+	const aasArea_t *nextArea;
+
+	// number of reachability areas within this cluster
+	numReachableAreas = file->clusters[clusterNum].numReachableAreas;
+
+	// number of the start area within the cluster
+	clusterAreaNum = ClusterAreaNum( clusterNum, goalAreaNum );
+	if ( clusterAreaNum >= numReachableAreas ) {
+		return;
+	}
+
+	travelTimes[clusterAreaNum] = 1;
+	badTravelFlags = ~travelFlags;
+	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
+
+	// initialize first update
+	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate->areaNum = goalAreaNum;
+	curUpdate->areaTravelTimes = startAreaTravelTimes;
+	curUpdate->tmpTravelTime = 1;
+	curUpdate->next = NULL;
+	curUpdate->prev = NULL;
+	updateListStart = curUpdate;
+	updateListEnd = curUpdate;
+
+	// while there are updates in the list
+	while( updateListStart ) {
+
+		curUpdate = updateListStart;
+		if ( curUpdate->next ) {
+			curUpdate->next->prev = NULL;
+		}
+		else {
+			updateListEnd = NULL;
+		}
+		updateListStart = curUpdate->next;
+
+		curUpdate->isInList = false;
+
+		for ( i = 0, reach = file->areas[curUpdate->areaNum].rev_reach; reach; reach = reach->rev_next, i++ ) {
+
+			// if the reachability uses an undesired travel type
+			if ( reach->travelType & badTravelFlags ) {
+				continue;
+			}
+
+			// next area the reversed reachability leads to
+			nextAreaNum = reach->fromAreaNum;
+			nextArea = &file->areas[nextAreaNum];
+
+			// if traveling through the next area requires an undesired travel flag
+			if ( nextArea->travelFlags & badTravelFlags ) {
+				continue;
+			}
+
+			// get the cluster number of the area
+			cluster = nextArea->cluster;
+			// don't leave the cluster, however do flood into cluster portals
+			if ( cluster > 0 && cluster != clusterNum ) {
+				continue;
+			}
+
+			// get the number of the area in the cluster
+			clusterAreaNum = ClusterAreaNum( clusterNum, nextAreaNum );
+			if ( clusterAreaNum >= numReachableAreas ) {
+				continue;	// should never happen
+			}
+
+			// time already travelled plus the traveltime through the current area
+			// plus the travel time of the reachability towards the next area
+			t = curUpdate->tmpTravelTime + curUpdate->areaTravelTimes[i] + reach->travelTime;
+
+			if ( !travelTimes[clusterAreaNum] || t < travelTimes[clusterAreaNum] ) {
+
+				travelTimes[clusterAreaNum] = t;
+				reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
+				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate->areaNum = nextAreaNum;
+				nextUpdate->tmpTravelTime = t;
+				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
+
+				// if we are not allowed to fly
+				if ( badTravelFlags & TFL_FLY ) {
+					// avoid areas near ledges
+					if ( file->areas[nextAreaNum].flags & AREA_LEDGE ) {
+						nextUpdate->tmpTravelTime += LEDGE_TRAVELTIME_PANALTY;
+					}
+				}
+
+				if ( !nextUpdate->isInList ) {
+					nextUpdate->next = NULL;
+					nextUpdate->prev = updateListEnd;
+					if ( updateListEnd ) {
+						updateListEnd->next = nextUpdate;
+					}
+					else {
+						updateListStart = nextUpdate;
+					}
+					updateListEnd = nextUpdate;
+					nextUpdate->isInList = true;
+				}
+			}
+		}
+	}
+}
+
+/*
+================
+idAASRoute::FloodPortals
+
+  Same as idAASLocal::UpdatePortalRoutingCache in the game code
+  except that the area travel times are read from the area tables.
+================
+*/
+bool idAASRoute::FloodPortals( const aasRouteTable_t *table, int clusterNum, int goalAreaNum, unsigned short *travelTimes, byte *reachabilities ) {
+	int i, portalNum, clusterAreaNum, goalClusterAreaNum, numReachableAreas;
+	unsigned short t;
+	const aasPortal_t *portal;
+	const aasCluster_t *cluster;
+	const unsigned short *cacheTravelTimes;
+	const byte *cacheReachabilities;
+	aasRouteUpdate_t *updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
+
+	curUpdate = &portalUpdate[file->portals.Num()];
+	curUpdate->cluster = clusterNum;
+	curUpdate->areaNum = goalAreaNum;
+	curUpdate->tmpTravelTime = 1;
+
+	//put the area to start with in the current read list
+	curUpdate->next = NULL;
+	curUpdate->prev = NULL;
+	updateListStart = curUpdate;
+	updateListEnd = curUpdate;
+
+	// while there are updates in the current list
+	while( updateListStart ) {
+
+		curUpdate = updateListStart;
+		// remove the current update from the list
+		if ( curUpdate->next ) {
+			curUpdate->next->prev = NULL;
+		}
+		else {
+			updateListEnd = NULL;
+		}
+		updateListStart = curUpdate->next;
+		// current update is removed from the list
+		curUpdate->isInList = false;
+
+		cluster = &file->clusters[curUpdate->cluster];
+		numReachableAreas = cluster->numReachableAreas;
+
+		// the game would route towards an area without area cache
+		goalClusterAreaNum = ClusterAreaNum( curUpdate->cluster, curUpdate->areaNum );
+		if ( goalClusterAreaNum >= numReachableAreas ) {
+			for ( ; updateListStart; updateListStart = updateListStart->next ) {
+				updateListStart->isInList = false;
+			}
+			return false;
+		}
+		cacheTravelTimes = &table->areaTravelTimes[table->clusterOffset[curUpdate->cluster] + goalClusterAreaNum * numReachableAreas];
+		cacheReachabilities = &table->areaReach[table->clusterOffset[curUpdate->cluster] + goalClusterAreaNum * numReachableAreas];
+
+		// take all portals of the cluster
+		for ( i = 0; i < cluster->numPortals; i++ ) {
+			portalNum = file->portalIndex[cluster->firstPortal + i];
+			portal = &file->portals[portalNum];
+
+			clusterAreaNum = ClusterAreaNum( curUpdate->cluster, portal->areaNum );
+			if ( clusterAreaNum >= numReachableAreas ) {
+				continue;
+			}
+
+			t = cacheTravelTimes[clusterAreaNum];
+			if ( t == 0 ) {
+				continue;
+			}
+			t += curUpdate->tmpTravelTime;
+
+			if ( !travelTimes[portalNum] || t < travelTimes[portalNum] ) {
+
+				travelTimes[portalNum] = t;
+				reachabilities[portalNum] = cacheReachabilities[clusterAreaNum];
+				nextUpdate = &portalUpdate[portalNum];
+				if ( portal->clusters[0] == curUpdate->cluster ) {
+					nextUpdate->cluster = portal->clusters[1];
+				}
+				else {
+					nextUpdate->cluster = portal->clusters[0];
+				}
+				nextUpdate->areaNum = portal->areaNum;
+				// add travel time through the actual portal area for the next update
+				nextUpdate->tmpTravelTime = t + portal->maxAreaTravelTime;
+
+				if ( !nextUpdate->isInList ) {
+
+					nextUpdate->next = NULL;
+					nextUpdate->prev = updateListEnd;
+					if ( updateListEnd ) {
+						updateListEnd->next = nextUpdate;
+					}
+					else {
+						updateListStart = nextUpdate;
+					}
+					updateListEnd = nextUpdate;
+					nextUpdate->isInList = true;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+/*
+================
+idAASRoute::BuildTable
+================
+*/
+aasRouteTable_t *idAASRoute::BuildTable( int travelFlags ) {
+	int i, j, n, offset, areaNum, clusterNum, clusterAreaNum, numPortals, numTables;
+	aasRouteTable_t *table;
+	const aasArea_t *area;
+
+	table = new aasRouteTable_t;
+	table->travelFlags = travelFlags;
+
+	// area tables, one for each reachable area in each cluster
+	offset = 0;
+	table->clusterOffset.SetNum( file->clusters.Num() );
+	for ( i = 0; i < file->clusters.Num(); i++ ) {
+		n = file->clusters[i].numReachableAreas;
+		table->clusterOffset[i] = offset;
+		offset += n * n;
+	}
+	table->areaTravelTimes.SetNum( offset );
+	table->areaReach.SetNum( offset );
+	memset( table->areaTravelTimes.Ptr(), 0, offset * sizeof( unsigned short ) );
+	memset( table->areaReach.Ptr(), 0, offset * sizeof( byte ) );
+
+	for ( areaNum = 1; areaNum < file->areas.Num(); areaNum++ ) {
+		area = &file->areas[areaNum];
+		// a portal area is the goal area in both the front and back cluster
+		for ( j = 0; j < 2; j++ ) {
+			if ( area->cluster > 0 ) {
+				if ( j ) {
+					break;
+				}
+				clusterNum = area->cluster;
+			} else if ( area->cluster < 0 ) {
+				clusterNum = file->portals[-area->cluster].clusters[j];
+				if ( j && clusterNum == file->portals[-area->cluster].clusters[0] ) {
+					break;
+				}
+			} else {
+				break;
+			}
+			n = file->clusters[clusterNum].numReachableAreas;
+			clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
+			if ( clusterAreaNum >= n ) {
+				continue;
+			}
+			offset = table->clusterOffset[clusterNum] + clusterAreaNum * n;
+			FloodArea( clusterNum, areaNum, travelFlags, &table->areaTravelTimes[offset], &table->areaReach[offset] );
+		}
+	}
+
+	// portal tables, one for each reachable goal area
+	numPortals = file->portals.Num();
+	numTables = 0;
+	table->portalOffset.SetNum( file->areas.Num() );
+	for ( areaNum = 0; areaNum < file->areas.Num(); areaNum++ ) {
+		table->portalOffset[areaNum] = -1;
+		area = &file->areas[areaNum];
+		if ( area->cluster > 0 ) {
+			clusterNum = area->cluster;
+		} else if ( area->cluster < 0 ) {
+			// the game assumes a goal portal area is part of the front cluster
+			clusterNum = file->portals[-area->cluster].clusters[0];
+		} else {
+			continue;
+		}
+		if ( ClusterAreaNum( clusterNum, areaNum ) >= file->clusters[clusterNum].numReachableAreas ) {
+			continue;
+		}
+		table->portalOffset[areaNum] = numTables * numPortals;
+		numTables++;
+	}
+	table->portalTravelTimes.SetNum( numTables * numPortals );
+	table->portalReach.SetNum( numTables * numPortals );
+	memset( table->portalTravelTimes.Ptr(), 0, numTables * numPortals * sizeof( unsigned short ) );
+	memset( table->portalReach.Ptr(), 0, numTables * numPortals * sizeof( byte ) );
+
+	for ( areaNum = 0; areaNum < file->areas.Num(); areaNum++ ) {
+		offset = table->portalOffset[areaNum];
+		if ( offset < 0 ) {
+			continue;
+		}
+		area = &file->areas[areaNum];
+		clusterNum = area->cluster > 0 ? area->cluster : file->portals[-area->cluster].clusters[0];
+		if ( !FloodPortals( table, clusterNum, areaNum, &table->portalTravelTimes[offset], &table->portalReach[offset] ) ) {
+			table->portalOffset[areaNum] = -1;
+		}
+	}
+
+	return table;
+}
+
+/*
+================
+idAASRoute::Build
+================
+*/
+bool idAASRoute::Build( const idStr &fileName, unsigned int mapFileCRC ) {
+	int startTime;
+	bool ok;
+
+	startTime = Sys_Milliseconds();
+
+	common->Printf( "[Routing Tables]\n" );
+
+	// load the file the same way the game does so the reachabilities are in the same order
+	file = new idAASFileLocal();
+	if ( !file->Load( fileName, mapFileCRC ) ) {
+		common->Warning( "Couldn't load AAS file: '%s'", fileName.c_str() );
+		Free();
+		return false;
+	}
+
+	CalculateAreaTravelTimes();
+
+	areaUpdate = (aasRouteUpdate_t *) Mem_ClearedAlloc( file->areas.Num() * sizeof( aasRouteUpdate_t ) );
+	portalUpdate = (aasRouteUpdate_t *) Mem_ClearedAlloc( ( file->portals.Num() + 1 ) * sizeof( aasRouteUpdate_t ) );
+
+	// the travel flags used by the AI
+	file->DeleteRouteTables();
+	file->routeTables.Append( BuildTable( TFL_WALK|TFL_AIR ) );
+	if ( file->settings.allowFlyReachabilities ) {
+		file->routeTables.Append( BuildTable( TFL_WALK|TFL_AIR|TFL_FLY ) );
+	}
+
+	ok = file->WriteRouteTables();
+
+	Free();
+
+	common->Printf( "%6d seconds to calculate the routing tables\n", ( Sys_Milliseconds() - startTime ) / 1000 );
+
+	return ok;
+}
@@ -0,0 +1,78 @@
+/*
+===========================================================================
+
+Doom 3 GPL Source Code
+Copyright (C) 1999-2011 id Software LLC, a ZeniMax Media company. 
+
+This file is part of the Doom 3 GPL Source Code (?Doom 3 Source Code?).  
+
+Doom 3 Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#ifndef __AASROUTE_H__
+#define __AASROUTE_H__
+
+/*
+===============================================================================
+
+	Routing Tables
+
+	Precalculates the travel times the game would otherwise calculate when
+	routing the first time towards an area. The floods are the same as the
+	ones in the game code so the tables can be used instead of the routing cache.
+
+===============================================================================
+*/
+
+typedef struct aasRouteUpdate_s {
+	int							cluster;				// cluster number of this update
+	int							areaNum;				// area number of this update
+	unsigned short				tmpTravelTime;			// temporary travel time
+	unsigned short *			areaTravelTimes;		// travel times within the area
+	struct aasRouteUpdate_s *	next;					// next in list
+	struct aasRouteUpdate_s *	prev;					// prev in list
+	bool						isInList;				// true if the update is in the list
+} aasRouteUpdate_t;
+
+class idAASRoute {
+
+public:
+							idAASRoute( void );
+							~idAASRoute( void );
+
+	bool					Build( const idStr &fileName, unsigned int mapFileCRC );
+
+private:
+	idAASFileLocal *		file;
+	unsigned short *		areaTravelTimes;
+	aasRouteUpdate_t *		areaUpdate;
+	aasRouteUpdate_t *		portalUpdate;
+
+private:
+	unsigned short			AreaTravelTime( int areaNum, const idVec3 &start, const idVec3 &end ) const;
+	void					CalculateAreaTravelTimes( void );
+	int						ClusterAreaNum( int clusterNum, int areaNum ) const;
+	void					FloodArea( int clusterNum, int areaNum, int travelFlags, unsigned short *travelTimes, byte *reachabilities );
+	bool					FloodPortals( const aasRouteTable_t *table, int clusterNum, int areaNum, unsigned short *travelTimes, byte *reachabilities );
+	aasRouteTable_t *		BuildTable( int travelFlags );
+	void					Free( void );
+};
+
+#endif /* !__AASROUTE_H__ */